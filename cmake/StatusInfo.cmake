@@ -65,6 +65,12 @@ else()
     message("Build tests           : No (default)")
 endif()
 
+if(WITH_BENCHMARKS)
+    message("Build benchmarks      : Yes (target: mangos_bench)")
+else()
+    message("Build benchmarks      : No (default)")
+endif()
+
 if(WITHOUT_GIT)
     message("Use GIT revision hash : No")
     message("")
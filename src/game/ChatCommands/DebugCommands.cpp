@@ -57,8 +57,12 @@
 #include "Pet.h"
 #include "Map.h"
 #include "MapManager.h"
+#include "MoveMap.h"
 #include "TransportMap.h"
 #include "Transports.h"
+#include "World.h"
+#include "WorldNetwork.h"
+#include "OpcodeProfiler.h"
 
 /**
  * @brief Handler for HandleDebugSendSpellFailCommand command.
@@ -1705,6 +1709,330 @@ bool ChatHandler::HandleDebugSpellModsCommand(char* args)
     return true;
 }
 
+/**
+ * @brief `.debug mapregions` -- the region pass on the caller's map, against the serial one.
+ *
+ * Both averages cover only the cell pass of Map::Update, which is the part the region
+ * pass replaces; compare them on the same map before and after MapUpdate.Regions.Enabled.
+ */
+bool ChatHandler::HandleDebugMapRegionsCommand(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    Map* map = player->GetMap();
+    Map::RegionTickStats const& stats = map->GetRegionTickStats();
+
+    PSendSysMessage("map %u (%s)  region pass %s", map->GetId(), map->GetMapName(),
+                    sWorld.getConfig(CONFIG_BOOL_MAPUPDATE_REGIONS) ? "enabled" : "disabled");
+    PSendSysMessage("serial   passes %u  avg %u us", stats.serialPasses,
+                    stats.serialPasses ? uint32(stats.serialPassUs / stats.serialPasses) : 0);
+    PSendSysMessage("regions  passes %u  avg %u us  last %u regions", stats.regionPasses,
+                    stats.regionPasses ? uint32(stats.regionPassUs / stats.regionPasses) : 0,
+                    stats.lastRegionCount);
+    PSendSysMessage("regions ticked %u  cells %u  seam handoffs %u  barrier ticks %u  pool workers %u",
+                    stats.regionsTicked, stats.cellsTicked, stats.seamHandoffs, stats.deferredTicks,
+                    uint32(sMapMgr.GetMapUpdater().worker_count()));
+    return true;
+}
+
+/**
+ * @brief `.debug mapvisibility` -- the batched visibility pass on the caller's map.
+ *
+ * "immediate" is the grid visits the same relocations would have made had each been
+ * resolved as it happened; "pass" is what the batched passes made instead. Averages are
+ * per pass, so per tick that had a relocation.
+ */
+bool ChatHandler::HandleDebugMapVisibilityCommand(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    Map* map = player->GetMap();
+    Map::VisibilityPassStats const& stats = map->GetVisibilityPassStats();
+
+    PSendSysMessage("map %u (%s)  batched visibility pass %s", map->GetId(), map->GetMapName(),
+                    World::GetVisibilityBatchedPass() ? "enabled" : "disabled");
+    if (!stats.passes)
+    {
+        SendSysMessage("no pass has run");
+        return true;
+    }
+
+    PSendSysMessage("passes %u  relocations %u  objects %u  (avg %u relocations, %u objects a pass)",
+                    stats.passes, uint32(stats.relocations), uint32(stats.objects),
+                    uint32(stats.relocations / stats.passes), uint32(stats.objects / stats.passes));
+    PSendSysMessage("grid visits: immediate %u  pass %u  (avg %u against %u a pass)",
+                    uint32(stats.immediateVisits), uint32(stats.sweeps),
+                    uint32(stats.immediateVisits / stats.passes), uint32(stats.sweeps / stats.passes));
+    PSendSysMessage("cameras offered by the viewer hash %u  (avg %u an object)",
+                    uint32(stats.cameraChecks), stats.objects ? uint32(stats.cameraChecks / stats.objects) : 0);
+    return true;
+}
+
+/**
+ * @brief `.debug mapworkers` -- how each map pool worker has spent its time.
+ *
+ * Busy and idle are wall time since the pool started. A worker that is mostly idle while
+ * another is mostly busy is the straggler the stealing is meant to remove.
+ */
+bool ChatHandler::HandleDebugMapWorkersCommand(char* /*args*/)
+{
+    std::vector<MapUpdater::WorkerStats> workers;
+    sMapMgr.GetMapUpdater().worker_stats(workers);
+
+    if (workers.empty())
+    {
+        SendSysMessage("map pool not running: maps tick on the world thread");
+        return true;
+    }
+
+    for (size_t i = 0; i < workers.size(); ++i)
+    {
+        MapUpdater::WorkerStats const& w = workers[i];
+        uint64 total = w.busyUs + w.idleUs;
+        PSendSysMessage("worker %u  busy %u ms  idle %u ms  (%u%% busy)  tasks %u  steals %u",
+                        uint32(i), uint32(w.busyUs / 1000), uint32(w.idleUs / 1000),
+                        total ? uint32(w.busyUs * 100 / total) : 0, w.tasks, w.steals);
+    }
+    return true;
+}
+
+/**
+ * @brief `.debug authlookups` -- the login lookup stage, for reading a login storm.
+ *
+ * Queue depth and wait are what a player sees as "authenticating..."; lookups per batch
+ * is how much of that the multi-row queries are absorbing.
+ */
+bool ChatHandler::HandleDebugAuthLookupsCommand(char* /*args*/)
+{
+    AccountLookupStage::Stats stats;
+    sWorldNetwork.GetAuthLookupStats(stats);
+
+    PSendSysMessage("queued %u  peak %u", stats.queued, stats.peakQueued);
+    PSendSysMessage("lookups %u  batches %u  avg batch %u  largest %u",
+                    uint32(stats.lookups), uint32(stats.batches),
+                    stats.batches ? uint32(stats.lookups / stats.batches) : 0, stats.largestBatch);
+    PSendSysMessage("wait avg %u us  max %u us",
+                    stats.lookups ? uint32(stats.totalWaitUs / stats.lookups) : 0,
+                    uint32(stats.maxWaitUs));
+    return true;
+}
+
+/**
+ * @brief `.debug prefetch` -- the grid prefetcher, for reading the hitch on a grid crossing.
+ *
+ * A hit is a grid load that found its tile already read, a miss one that still read it
+ * in the map tick. Terrain and navmesh are counted apart: they are read by the same job
+ * but loaded at different moments.
+ */
+bool ChatHandler::HandleDebugPrefetchCommand(char* /*args*/)
+{
+    GridPrefetcher::Stats stats;
+    sTerrainMgr.Prefetcher().GetStats(stats);
+    MMAP::MMapManager const* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+
+    PSendSysMessage("prefetch %s, lookahead %u s", sWorld.getConfig(CONFIG_BOOL_TERRAIN_PREFETCH) ? "on" : "off",
+                    sWorld.getConfig(CONFIG_UINT32_TERRAIN_PREFETCH_LOOKAHEAD));
+    PSendSysMessage("queued %u  requests %u  duplicates %u  dropped %u  read %u",
+                    stats.queued, uint32(stats.requests), uint32(stats.duplicates),
+                    uint32(stats.dropped), uint32(stats.prefetched));
+    uint64 const loads = stats.hits + stats.misses;
+    PSendSysMessage("terrain  hits %u  misses %u  (%u%% hit)", uint32(stats.hits), uint32(stats.misses),
+                    loads ? uint32(stats.hits * 100 / loads) : 0);
+    uint32 const tiles = mmap->getPrefetchHits() + mmap->getPrefetchMisses();
+    PSendSysMessage("navmesh  hits %u  misses %u  (%u%% hit)  unused %u", mmap->getPrefetchHits(),
+                    mmap->getPrefetchMisses(), tiles ? mmap->getPrefetchHits() * 100 / tiles : 0,
+                    mmap->getPrefetchDropped());
+    return true;
+}
+
+/**
+ * @brief `.debug opcodes [on|off|reset|dump|#count]` -- client packet handlers by total time.
+ *
+ * Without arguments lists the ten opcodes whose handlers have cost the most since the
+ * profiler was switched on or last reset; a number lists that many instead. `dump`
+ * writes OpcodeProfiler.DumpFile immediately.
+ */
+bool ChatHandler::HandleDebugOpcodesCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        OpcodeProfiler::Reset();
+        SendSysMessage("opcode profile reset");
+        return true;
+    }
+
+    if (ExtractLiteralArg(&args, "dump"))
+    {
+        SendSysMessage(OpcodeProfiler::WriteDump() ? "opcode profile written" : "opcode profile dump file not writable");
+        return true;
+    }
+
+    bool const on = ExtractLiteralArg(&args, "on") != NULL;
+    if (on || ExtractLiteralArg(&args, "off"))
+    {
+        OpcodeProfiler::SetEnabled(on);
+        PSendSysMessage("opcode profiler %s", on ? "on" : "off");
+        return true;
+    }
+
+    uint32 limit = 10;
+    if (*args && !ExtractUInt32(&args, limit))
+    {
+        return false;
+    }
+
+    std::vector<OpcodeProfiler::Row> rows;
+    double seconds = OpcodeProfiler::Collect(rows);
+
+    PSendSysMessage("opcode profiler %s, %u opcodes over %u s",
+                    OpcodeProfiler::IsEnabled() ? "on" : "off", uint32(rows.size()), uint32(seconds));
+
+    for (size_t i = 0; i < rows.size() && i < limit; ++i)
+    {
+        OpcodeProfiler::Row const& row = rows[i];
+        PSendSysMessage("%s  calls %u (%u/s)  total %u ms  p50 %u us  p99 %u us  max %u us",
+                        LookupOpcodeName(row.opcode), uint32(row.count),
+                        seconds > 0.0 ? uint32(row.count / seconds) : 0, uint32(row.totalNs / 1000000),
+                        uint32(row.p50Ns / 1000), uint32(row.p99Ns / 1000), uint32(row.maxNs / 1000));
+    }
+    return true;
+}
+
+/**
+ * @brief Prints one tick owner's per-phase figures, one line per phase that has run.
+ */
+static void ShowTickHistory(ChatHandler& handler, TickProfiler::History const& history)
+{
+    TickProfiler::ZoneStats stats[TICK_ZONE_COUNT];
+    history.Snapshot(stats);
+
+    if (!stats[TICK_ZONE_TOTAL].ticks)
+    {
+        handler.SendSysMessage("  no ticks recorded");
+        return;
+    }
+
+    for (uint32 z = 0; z < TICK_ZONE_COUNT; ++z)
+    {
+        TickProfiler::ZoneStats const& zone = stats[z];
+        if (!zone.ticks)
+        {
+            continue;
+        }
+
+        handler.PSendSysMessage("  %-16s avg %u us  p50 %u us  p99 %u us  max %u us  (%u ticks)",
+                                TickProfiler::ZoneName(TickZone(z)), uint32(zone.totalUs / zone.ticks),
+                                uint32(zone.p50Us), uint32(zone.p99Us), uint32(zone.maxUs), uint32(zone.ticks));
+    }
+}
+
+/**
+ * @brief `.debug ticks [on|off|reset|#mapid [#instanceid]]` -- where world and map ticks go.
+ *
+ * Shows the world tick and one map's tick phase by phase: the map given, or the
+ * player's own. `reset` clears the same two. Ticks over TickProfiler.SlowTickThreshold
+ * are broken down in the server log as they happen.
+ */
+bool ChatHandler::HandleDebugTicksCommand(char* args)
+{
+    bool const on = ExtractLiteralArg(&args, "on") != NULL;
+    if (on || ExtractLiteralArg(&args, "off"))
+    {
+        TickProfiler::SetEnabled(on);
+        PSendSysMessage("tick profiler %s", on ? "on" : "off");
+        return true;
+    }
+
+    bool const reset = ExtractLiteralArg(&args, "reset") != NULL;
+
+    Map* map = NULL;
+    if (*args)
+    {
+        uint32 mapId;
+        uint32 instanceId = 0;
+        if (!ExtractUInt32(&args, mapId) || (*args && !ExtractUInt32(&args, instanceId)))
+        {
+            return false;
+        }
+
+        map = sMapMgr.FindMap(mapId, instanceId);
+        if (!map)
+        {
+            PSendSysMessage("map %u instance %u is not loaded", mapId, instanceId);
+            SetSentErrorMessage(true);
+            return false;
+        }
+    }
+    else if (m_session && m_session->GetPlayer())
+    {
+        map = m_session->GetPlayer()->GetMap();
+    }
+
+    if (reset)
+    {
+        sWorld.GetTickHistory().Reset();
+        if (map)
+        {
+            map->GetTickHistory().Reset();
+        }
+        SendSysMessage("tick profile reset");
+        return true;
+    }
+
+    PSendSysMessage("tick profiler %s", TickProfiler::IsEnabled() ? "on" : "off");
+    SendSysMessage("world:");
+    ShowTickHistory(*this, sWorld.GetTickHistory());
+    if (map)
+    {
+        PSendSysMessage("map %u (%s) instance %u:", map->GetId(), map->GetMapName(), map->GetInstanceId());
+        ShowTickHistory(*this, map->GetTickHistory());
+    }
+    return true;
+}
+
+/// Print one database's async shards for `.debug dbqueues`.
+static void ShowDbQueues(ChatHandler& handler, char const* name, Database& db, bool resetPeaks)
+{
+    std::vector<SqlDelayThread::Stats> stats;
+    db.GetAsyncStats(stats, resetPeaks);
+
+    handler.PSendSysMessage("%s: %u async connection(s)", name, uint32(stats.size()));
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        SqlDelayThread::Stats const& shard = stats[i];
+        uint64 const runs = shard.executed ? shard.executed : 1;
+        handler.PSendSysMessage("  #%u  queued %u  run " UI64FMTD "  wait avg %u ms max %u ms  exec avg %u ms max %u ms",
+                                uint32(i), shard.queued, shard.executed,
+                                uint32(shard.waitMs / runs), shard.waitMaxMs,
+                                uint32(shard.execMs / runs), shard.execMaxMs);
+    }
+}
+
+/**
+ * @brief `.debug dbqueues [reset]` -- the async database queues, connection by connection.
+ *
+ * A character's saves all go to one connection of CharacterDatabaseAsyncConnections;
+ * one shard far behind the others means a few characters are doing most of the writing.
+ * Below them, the character saves and the statements each one wrote. `reset` clears
+ * the maxima after showing them.
+ */
+bool ChatHandler::HandleDebugDbQueuesCommand(char* args)
+{
+    bool const reset = ExtractLiteralArg(&args, "reset") != NULL;
+    if (*args)
+    {
+        return false;
+    }
+
+    ShowDbQueues(*this, "world", WorldDatabase, reset);
+    ShowDbQueues(*this, "character", CharacterDatabase, reset);
+    ShowDbQueues(*this, "login", LoginDatabase, reset);
+
+    PlayerSaveStats saves;
+    Player::GetSaveStats(saves, reset);
+    PSendSysMessage("character saves: " UI64FMTD ", statements avg %u max %u", saves.saves,
+                    uint32(saves.saves ? saves.statements / saves.saves : 0), saves.maxStatements);
+    return true;
+}
+
 /**
  * @brief `.debug minion` -- where a player's minions actually are, deck boundary and all.
  *
@@ -0,0 +1,172 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file GridPrefetcher.cpp
+ * @brief The grid prefetch thread.
+ */
+
+#include "GridPrefetcher.h"
+
+#include "GridMap.h"
+
+#include <algorithm>
+
+namespace
+{
+    /// Requests held at once. The map asks again every prediction pass, so a request
+    /// that falls off the end is re-issued if it is still wanted; a deep queue would only
+    /// be reading where players were heading several seconds ago.
+    const size_t MAX_QUEUED = 64;
+}
+
+GridPrefetcher::GridPrefetcher()
+    : m_reading(NULL), m_stopping(false), m_stats()
+{
+}
+
+GridPrefetcher::~GridPrefetcher()
+{
+    Stop();
+}
+
+void GridPrefetcher::Request(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_stopping)
+    {
+        return;
+    }
+
+    for (std::deque<Job>::const_iterator itr = m_queue.begin(); itr != m_queue.end(); ++itr)
+    {
+        if (itr->terrain == terrain && itr->x == x && itr->y == y)
+        {
+            ++m_stats.duplicates;
+            return;
+        }
+    }
+
+    if (!m_thread.joinable())
+    {
+        m_thread = std::thread(&GridPrefetcher::Run, this);
+    }
+
+    // The oldest request is the stalest guess; it goes first when the queue is full.
+    if (m_queue.size() >= MAX_QUEUED)
+    {
+        m_queue.pop_front();
+        ++m_stats.dropped;
+    }
+
+    Job job;
+    job.terrain = terrain;
+    job.x = x;
+    job.y = y;
+    m_queue.push_back(job);
+
+    ++m_stats.requests;
+    m_stats.queued = uint32(m_queue.size());
+    m_wake.notify_one();
+}
+
+void GridPrefetcher::Forget(TerrainInfo const* terrain)
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+                                 [terrain](Job const& job) { return job.terrain == terrain; }),
+                  m_queue.end());
+    m_stats.queued = uint32(m_queue.size());
+    m_idle.wait(guard, [this, terrain] { return m_reading != terrain; });
+}
+
+void GridPrefetcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stopping = true;
+        m_queue.clear();
+        m_stats.queued = 0;
+        m_wake.notify_one();
+    }
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void GridPrefetcher::NoteGridLoad(bool resident)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (resident)
+    {
+        ++m_stats.hits;
+    }
+    else
+    {
+        ++m_stats.misses;
+    }
+}
+
+void GridPrefetcher::GetStats(Stats& stats) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    stats = m_stats;
+}
+
+void GridPrefetcher::Run()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_wake.wait(guard, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+
+            job = m_queue.front();
+            m_queue.pop_front();
+            m_stats.queued = uint32(m_queue.size());
+            m_reading = job.terrain;
+        }
+
+        // Outside the lock: this is the disk read the map tick no longer waits for.
+        bool const read = job.terrain->Prefetch(job.x, job.y);
+
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_reading = NULL;
+            if (read)
+            {
+                ++m_stats.prefetched;
+            }
+        }
+        m_idle.notify_all();
+    }
+}
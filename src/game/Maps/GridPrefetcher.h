@@ -0,0 +1,113 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file GridPrefetcher.h
+ * @brief Reads the terrain and navmesh tiles of grids players are about to enter.
+ *
+ * A grid's first load used to do its disk reads inside the map tick that needed it: the
+ * terrain tile on the first height query, the navmesh tile in TerrainInfo::Load(). A
+ * flyer or a taxi crosses a grid every twenty seconds or so, and each crossing stalled
+ * the whole continent's tick on those reads.
+ *
+ * The map predicts where its players are heading and asks for those grids here. One
+ * thread of this class's own reads them: the terrain tile is published straight into
+ * the terrain's table, which is built to take a tile from any thread, and the navmesh
+ * tile is left with the MMapManager for the grid load to add. Only the object grid is
+ * still loaded in the tick -- it creates world objects, and those belong to the map.
+ */
+
+#ifndef MANGOS_H_GRIDPREFETCHER
+#define MANGOS_H_GRIDPREFETCHER
+
+#include "Platform/Define.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class TerrainInfo;
+
+class GridPrefetcher
+{
+    public:
+
+        /// A snapshot of the counters, for `.debug prefetch`.
+        struct Stats
+        {
+            uint32 queued;          ///< requests waiting right now
+            uint64 requests;        ///< requests accepted
+            uint64 duplicates;      ///< requests for a grid already queued
+            uint64 dropped;         ///< requests pushed out of a full queue, unread
+            uint64 prefetched;      ///< grids whose terrain tile this thread read
+            uint64 hits;            ///< grid loads that found their terrain tile resident
+            uint64 misses;          ///< grid loads that still had it to read
+        };
+
+        GridPrefetcher();
+        ~GridPrefetcher();
+
+        GridPrefetcher(const GridPrefetcher&) = delete;
+        GridPrefetcher& operator=(const GridPrefetcher&) = delete;
+
+        /// Queue grid (x, y) of @p terrain, in the coordinates TerrainInfo::Load() takes.
+        void Request(TerrainInfo* terrain, uint32 x, uint32 y);
+
+        /// Drop every request for @p terrain and wait out one being read, so the terrain
+        /// can be deleted. The only way a terrain leaves this class.
+        void Forget(TerrainInfo const* terrain);
+
+        /// Drop what is queued and stop the thread. Requests after this are ignored.
+        void Stop();
+
+        /// Counts one grid load, by whether its terrain tile was already resident.
+        void NoteGridLoad(bool resident);
+
+        void GetStats(Stats& stats) const;
+
+    private:
+
+        struct Job
+        {
+            TerrainInfo* terrain;
+            uint32 x;
+            uint32 y;
+        };
+
+        void Run();
+
+        mutable std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;     ///< signalled when a job finishes
+        std::deque<Job> m_queue;
+        TerrainInfo* m_reading;             ///< the terrain of the job being read, if any
+        bool m_stopping;
+        std::thread m_thread;               ///< started by the first Request()
+
+        Stats m_stats;                      ///< guarded by m_lock
+};
+
+#endif
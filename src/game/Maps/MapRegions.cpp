@@ -0,0 +1,122 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file MapRegions.cpp
+ * @brief Implementation of the per-tick region partition.
+ */
+
+#include "MapRegions.h"
+
+namespace
+{
+    thread_local MapRegionPlan const* t_currentPlan = NULL;
+    thread_local MapRegionPlan::Region const* t_currentRegion = NULL;
+}
+
+MapRegionPlan::MapRegionPlan(uint32 gridsPerSide)
+    : m_gridsPerSide(gridsPerSide ? gridsPerSide : 1), m_cellCount(0)
+{
+    if (m_gridsPerSide > MAX_NUMBER_OF_GRIDS)
+    {
+        m_gridsPerSide = MAX_NUMBER_OF_GRIDS;
+    }
+
+    m_cellsPerSide = m_gridsPerSide * MAX_NUMBER_OF_CELLS;
+    m_regionsPerSide = (MAX_NUMBER_OF_GRIDS + m_gridsPerSide - 1) / m_gridsPerSide;
+
+    m_regions.resize(m_regionsPerSide * m_regionsPerSide);
+    for (uint32 y = 0; y < m_regionsPerSide; ++y)
+    {
+        for (uint32 x = 0; x < m_regionsPerSide; ++x)
+        {
+            Region& region = m_regions[y * m_regionsPerSide + x];
+            region.regionX = x;
+            region.regionY = y;
+        }
+    }
+}
+
+void MapRegionPlan::Reset()
+{
+    for (uint32 colour = 0; colour < COLOUR_COUNT; ++colour)
+    {
+        for (Region* region : m_byColour[colour])
+        {
+            region->cells.clear();
+        }
+        m_byColour[colour].clear();
+    }
+    m_cellCount = 0;
+}
+
+void MapRegionPlan::AddCell(CellPair const& cell)
+{
+    uint32 rx = RegionXOf(cell);
+    uint32 ry = RegionYOf(cell);
+    Region& region = m_regions[ry * m_regionsPerSide + rx];
+
+    // First cell of this region this tick: it joins its colour's run list.
+    if (region.cells.empty())
+    {
+        m_byColour[(rx & 1) | ((ry & 1) << 1)].push_back(&region);
+    }
+
+    region.cells.push_back(cell);
+    ++m_cellCount;
+}
+
+uint32 MapRegionPlan::RegionCount() const
+{
+    uint32 count = 0;
+    for (uint32 colour = 0; colour < COLOUR_COUNT; ++colour)
+    {
+        count += uint32(m_byColour[colour].size());
+    }
+    return count;
+}
+
+MapRegionPlan::Region const* MapRegionPlan::CurrentRegion()
+{
+    return t_currentRegion;
+}
+
+MapRegionPlan const* MapRegionPlan::CurrentPlan()
+{
+    return t_currentPlan;
+}
+
+MapRegionPlan::RegionScope::RegionScope(MapRegionPlan const& plan, Region const& region)
+    : m_prevPlan(t_currentPlan), m_prevRegion(t_currentRegion)
+{
+    t_currentPlan = &plan;
+    t_currentRegion = &region;
+}
+
+MapRegionPlan::RegionScope::~RegionScope()
+{
+    t_currentPlan = m_prevPlan;
+    t_currentRegion = m_prevRegion;
+}
@@ -0,0 +1,150 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file MapRegions.h
+ * @brief Grid-aligned partition of one map tick's marked cells into regions.
+ *
+ * A continent's cell pass is the bulk of its Map::Update, and it is the only part that
+ * splits along space: every creature the pass ticks lives in exactly one cell, and what
+ * it touches lies within the visibility distance of that cell. The plan cuts the marked
+ * cells into square regions of whole grids and colours them like a 2x2 checkerboard.
+ * Two regions of the same colour are separated by one region of another, and objects
+ * on both sides of it reach into that region; so as long as a region is more than
+ * twice as wide as anything can reach, the regions of one colour can be ticked at the
+ * same time and never touch the same object.
+ *
+ * The colours run one after another, with a barrier between them. Anything a region
+ * cannot finish on its own is queued while the colour runs and done, on the map's own
+ * thread, once the whole colour has stopped: a creature walking out of the region (the
+ * seam handoff), and the tick of every object not on the allowlist of region-local
+ * ones. Only a plain creature spawn -- alive, out of combat, unowned, with no script,
+ * EventAI, pool or link -- ticks inside a region; game objects, dynamic objects and
+ * everything else tick at the barrier (see Map::DeferRegionTick()).
+ */
+
+#ifndef MANGOS_MAP_REGIONS_H
+#define MANGOS_MAP_REGIONS_H
+
+#include "Platform/Define.h"
+#include "GridDefines.h"
+
+#include <vector>
+
+/**
+ * @brief The marked cells of one tick, bucketed into grid-aligned regions by colour.
+ */
+class MapRegionPlan
+{
+    public:
+
+        /// Checkerboard colours: (region x & 1) | (region y & 1) << 1.
+        static const uint32 COLOUR_COUNT = 4;
+
+        /// One region's share of the tick.
+        struct Region
+        {
+            uint32 regionX;               ///< Region column, in units of the region size
+            uint32 regionY;               ///< Region row, in units of the region size
+            std::vector<CellPair> cells;  ///< Marked cells inside it, in marking order
+        };
+
+        /**
+         * @param gridsPerSide Edge of a region, in grids. Clamped to at least one.
+         */
+        explicit MapRegionPlan(uint32 gridsPerSide);
+
+        /// Drop every cell, keeping the buckets' storage for the next tick.
+        void Reset();
+
+        /// File a marked cell into its region.
+        void AddCell(CellPair const& cell);
+
+        /// The regions of colour @p colour that received at least one cell this tick.
+        std::vector<Region*> const& RegionsOf(uint32 colour) const { return m_byColour[colour]; }
+
+        /// How many cells were filed since the last Reset().
+        uint32 CellCount() const { return m_cellCount; }
+
+        /// How many distinct regions were touched since the last Reset().
+        uint32 RegionCount() const;
+
+        /// Region edge, in grids.
+        uint32 GridsPerSide() const { return m_gridsPerSide; }
+
+        /// Region edge, in yards. Nothing a ticked object does may reach further than half of this.
+        float ReachLimit() const { return m_gridsPerSide * SIZE_OF_GRIDS; }
+
+        /// True if @p cell lies inside @p region.
+        bool Contains(Region const& region, CellPair const& cell) const
+        {
+            return RegionXOf(cell) == region.regionX && RegionYOf(cell) == region.regionY;
+        }
+
+        /**
+         * @brief The region the calling thread is ticking, or NULL outside a region pass.
+         *
+         * Thread-local, set by RegionScope. This is how the relocation paths tell a seam
+         * crossing from an ordinary move without any map-wide state.
+         */
+        static Region const* CurrentRegion();
+
+        /// The plan CurrentRegion() belongs to, or NULL outside a region pass.
+        static MapRegionPlan const* CurrentPlan();
+
+        /**
+         * @brief Marks the calling thread as ticking @p region for its lifetime.
+         */
+        class RegionScope
+        {
+            public:
+                RegionScope(MapRegionPlan const& plan, Region const& region);
+                ~RegionScope();
+
+            private:
+                RegionScope(RegionScope const&);
+                RegionScope& operator=(RegionScope const&);
+
+                MapRegionPlan const* m_prevPlan;
+                Region const* m_prevRegion;
+        };
+
+    private:
+
+        uint32 RegionXOf(CellPair const& cell) const { return cell.x_coord / m_cellsPerSide; }
+        uint32 RegionYOf(CellPair const& cell) const { return cell.y_coord / m_cellsPerSide; }
+
+        uint32 m_gridsPerSide;
+        uint32 m_cellsPerSide;
+        uint32 m_regionsPerSide;
+        uint32 m_cellCount;
+
+        /// Every region of the map, row-major; most stay empty on any given tick.
+        std::vector<Region> m_regions;
+        /// The non-empty regions of this tick, split by colour.
+        std::vector<Region*> m_byColour[COLOUR_COUNT];
+};
+
+#endif
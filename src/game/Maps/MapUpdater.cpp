@@ -25,7 +25,7 @@
 
 /**
  * @file MapUpdater.cpp
- * @brief Implementation of the parallel map-update worker pool.
+ * @brief Implementation of the work-stealing map-update worker pool.
  */
 
 #include "MapUpdater.h"
@@ -33,11 +33,22 @@
 #include "Map.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
+#include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
+namespace
+{
+    uint64 ElapsedUs(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - since).count();
+    }
+}
+
 MapUpdater::MapUpdater()
-    : m_pending(0), m_stop(false)
+    : m_queued(0), m_pending(0), m_stop(false), m_nextHelperQueue(0)
 {
 }
 
@@ -58,10 +69,18 @@ int MapUpdater::activate(size_t num_threads)
         m_stop = false;
     }
 
+    // Every deque exists before the first worker starts: a worker steals by index and
+    // must never see a half-built vector.
+    m_queues.clear();
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+        m_queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue));
+    }
+
     m_workers.reserve(num_threads);
     for (size_t i = 0; i < num_threads; ++i)
     {
-        m_workers.emplace_back([this] { workerLoop(); });
+        m_workers.emplace_back([this, i] { workerLoop(i); });
     }
 
     return 0;
@@ -108,7 +127,7 @@ bool MapUpdater::activated()
 
 int MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::unique_lock<std::mutex> guard(m_mutex);
+    std::lock_guard<std::mutex> guard(m_mutex);
 
     if (m_stop || m_workers.empty())
     {
@@ -116,17 +135,16 @@ int MapUpdater::schedule_update(Map& map, uint32 diff)
         return -1;
     }
 
-    m_tasks.push(Task(&map, diff));
+    m_staged.push_back(Task(&map, diff, map.GetUpdateCostHint()));
     ++m_pending;
 
-    guard.unlock();
-    m_taskAdded.notify_one();
-
     return 0;
 }
 
 int MapUpdater::wait()
 {
+    dispatch();
+
     std::unique_lock<std::mutex> guard(m_mutex);
 
     m_taskDone.wait(guard, [this] { return m_pending == 0; });
@@ -134,7 +152,166 @@ int MapUpdater::wait()
     return 0;
 }
 
-void MapUpdater::workerLoop()
+void MapUpdater::dispatch()
+{
+    std::vector<Task> staged;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        staged.swap(m_staged);
+    }
+
+    if (staged.empty())
+    {
+        return;
+    }
+
+    // Longest processing time first: sort by last tick's cost, then deal each map to the
+    // least-loaded deque. A deque therefore holds its heaviest map at the front, where its
+    // owner starts, and its lightest at the back, where a thief takes from.
+    std::stable_sort(staged.begin(), staged.end(),
+                     [](Task const& a, Task const& b) { return a.cost > b.cost; });
+
+    std::vector<uint64> load(m_queues.size(), 0);
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        // Counted before it is pushed: a thief may take a task the instant it lands, and
+        // the count must never be lowered past what was raised.
+        m_queued += staged.size();
+
+        for (Task const& task : staged)
+        {
+            size_t target = std::min_element(load.begin(), load.end()) - load.begin();
+            // A map never ticked before costs nothing yet; count it as one unit so a burst
+            // of new instances still spreads instead of piling onto the first deque.
+            load[target] += task.cost ? task.cost : 1;
+            push(target, task);
+        }
+    }
+    m_taskAdded.notify_all();
+}
+
+void MapUpdater::push(size_t index, Task const& task)
+{
+    WorkerQueue& q = *m_queues[index];
+    std::lock_guard<std::mutex> guard(q.mutex);
+    q.queue.push_back(task);
+}
+
+bool MapUpdater::take(size_t index, Task& task)
+{
+    {
+        WorkerQueue& own = *m_queues[index];
+        std::lock_guard<std::mutex> guard(own.mutex);
+        if (!own.queue.empty())
+        {
+            task = own.queue.front();
+            own.queue.pop_front();
+            --m_queued;
+            return true;
+        }
+    }
+
+    // Steal from the back of the next non-empty deque, starting beside our own so the
+    // thieves of one tick do not all descend on worker 0.
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+        WorkerQueue& victim = *m_queues[(index + i) % m_queues.size()];
+        std::lock_guard<std::mutex> guard(victim.mutex);
+        if (!victim.queue.empty())
+        {
+            task = victim.queue.back();
+            victim.queue.pop_back();
+            --m_queued;
+            ++m_queues[index]->steals;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MapUpdater::worker_stats(std::vector<WorkerStats>& out) const
+{
+    out.clear();
+    for (std::unique_ptr<WorkerQueue> const& q : m_queues)
+    {
+        WorkerStats stats;
+        stats.busyUs = q->busyUs.load(std::memory_order_relaxed);
+        stats.idleUs = q->idleUs.load(std::memory_order_relaxed);
+        stats.tasks  = q->tasks.load(std::memory_order_relaxed);
+        stats.steals = q->steals.load(std::memory_order_relaxed);
+        out.push_back(stats);
+    }
+}
+
+void MapUpdater::run_parallel(std::vector<std::function<void()> > const& jobs)
+{
+    if (jobs.empty())
+    {
+        return;
+    }
+
+    std::shared_ptr<JobBatch> batch = std::make_shared<JobBatch>(jobs);
+
+    // One helper per job beyond the caller's own, capped by the pool. Asking for more
+    // than there are idle workers costs nothing but a queue entry that finds no work.
+    size_t helpers = std::min(jobs.size() - 1, m_workers.size());
+    if (helpers)
+    {
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (!m_stop)
+            {
+                // Spread over the deques: an idle worker steals the helper from whichever
+                // busy worker it landed on.
+                m_queued += helpers;
+                for (size_t i = 0; i < helpers; ++i)
+                {
+                    push((m_nextHelperQueue + i) % m_queues.size(), Task(batch));
+                }
+                m_nextHelperQueue = (m_nextHelperQueue + helpers) % m_queues.size();
+                queued = true;
+            }
+        }
+        if (queued)
+        {
+            m_taskAdded.notify_all();
+        }
+    }
+
+    batch->drain();
+
+    std::unique_lock<std::mutex> guard(batch->mutex);
+    batch->finished.wait(guard, [&batch] { return batch->done == batch->count; });
+}
+
+void MapUpdater::JobBatch::drain()
+{
+    for (;;)
+    {
+        size_t index = next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count)
+        {
+            return;
+        }
+
+        jobs[index]();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            last = (++done == count);
+        }
+        if (last)
+        {
+            finished.notify_all();
+        }
+    }
+}
+
+void MapUpdater::workerLoop(size_t index)
 {
     // Map::Update() issues queries (respawns, saves, instance state), so these
     // threads are MySQL client threads and must register like any other. They
@@ -142,31 +319,47 @@ void MapUpdater::workerLoop()
     // in the default configuration.
     DbThreadGuard dbThread(&WorldDatabase);
 
+    WorkerQueue& self = *m_queues[index];
+
     for (;;)
     {
-        Task task(nullptr, 0);
+        Task task;
 
+        if (!take(index, task))
         {
             std::unique_lock<std::mutex> guard(m_mutex);
 
-            m_taskAdded.wait(guard, [this] { return m_stop || !m_tasks.empty(); });
-
-            // Only retire once the queue is genuinely empty, so a stop racing with a
+            // Only retire once every deque is genuinely empty, so a stop racing with a
             // still-queued tick cannot drop that map's update on the floor.
-            if (m_tasks.empty())
+            if (m_queued == 0 && m_stop)
             {
-                if (m_stop)
-                {
-                    return;
-                }
-                continue;
+                return;
             }
 
-            task = m_tasks.front();
-            m_tasks.pop();
+            std::chrono::steady_clock::time_point idleSince = std::chrono::steady_clock::now();
+            m_taskAdded.wait(guard, [this] { return m_stop || m_queued > 0; });
+            self.idleUs += ElapsedUs(idleSince);
+            continue;
         }
 
-        task.first->Update(task.second);
+        std::chrono::steady_clock::time_point busySince = std::chrono::steady_clock::now();
+        ++self.tasks;
+
+        // A helper for some map's region pass. Its owner is waiting on the batch, not on
+        // m_pending, so there is nothing to count down.
+        if (task.batch)
+        {
+            task.batch->drain();
+            self.busyUs += ElapsedUs(busySince);
+            continue;
+        }
+
+        task.map->Update(task.diff);
+
+        uint64 tickUs = ElapsedUs(busySince);
+        self.busyUs += tickUs;
+        // Next tick's cost hint. Only this task touches the map until m_pending drops.
+        task.map->SetUpdateCostHint(uint32(std::min<uint64>(tickUs, 0xFFFFFFFF)));
 
         {
             std::lock_guard<std::mutex> guard(m_mutex);
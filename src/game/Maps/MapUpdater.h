@@ -25,10 +25,14 @@
 
 /**
  * @file MapUpdater.h
- * @brief Worker pool that ticks maps in parallel.
+ * @brief Work-stealing worker pool that ticks maps in parallel.
  *
  * The world thread hands each map's Update() to this pool via schedule_update(), then
- * blocks in wait() until the whole tick has been processed.
+ * blocks in wait() until the whole tick has been processed. The maps of a tick are
+ * released together at wait(), longest first: each map's previous tick is its cost, so
+ * the continent that set last tick's floor starts before the instances that fit around
+ * it. Every worker owns a deque; one that runs dry steals from the others instead of
+ * sleeping while a straggler's queue still holds work.
  */
 
 #ifndef _MAP_UPDATER_H_INCLUDED
@@ -36,10 +40,13 @@
 
 #include "Platform/Define.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -53,6 +60,15 @@ class MapUpdater
 {
     public:
 
+        /// One worker's account since activate(). Times are wall-clock microseconds.
+        struct WorkerStats
+        {
+            uint64 busyUs;     ///< Running map ticks or region jobs
+            uint64 idleUs;     ///< Asleep, waiting for work
+            uint32 tasks;      ///< Tasks run, map ticks and region helpers alike
+            uint32 steals;     ///< Of those, tasks taken from another worker's deque
+        };
+
         MapUpdater();
         ~MapUpdater();
 
@@ -60,13 +76,17 @@ class MapUpdater
         MapUpdater& operator=(const MapUpdater&) = delete;
 
         /**
-         * @brief Queue map.Update(diff) for a worker.
+         * @brief Stage map.Update(diff) for this tick.
+         *
+         * Nothing runs until wait(): the tick's maps are ordered by cost only once they
+         * are all known.
+         *
          * @return 0 on success, -1 if the pool is not running.
          */
         int schedule_update(Map& map, uint32 diff);
 
         /**
-         * @brief Block until every scheduled update has finished.
+         * @brief Release the staged updates, then block until every one has finished.
          *
          * This is the tick barrier: the world thread must not advance until every map
          * queued this tick has been updated.
@@ -90,23 +110,105 @@ class MapUpdater
         /// True while worker threads are running.
         bool activated();
 
-    private:
+        /// Number of worker threads, 0 when the pool is not running.
+        size_t worker_count() const { return m_workers.size(); }
 
-        /// One queued map tick.
-        typedef std::pair<Map*, uint32> Task;
+        /// A snapshot of every worker's busy and idle time, indexed by worker.
+        void worker_stats(std::vector<WorkerStats>& out) const;
 
-        /// Worker body: run tasks until stopped and the queue has drained.
-        void workerLoop();
+        /**
+         * @brief Run @p jobs to completion, spreading them over whichever workers are idle.
+         *
+         * Meant to be called from inside a map tick that is itself running on this pool,
+         * which is why the caller never just waits: it claims and runs jobs alongside the
+         * helpers it queued, and only blocks for jobs another thread has already started.
+         * A pool with every worker busy therefore degrades to running the jobs inline
+         * rather than deadlocking.
+         *
+         * Helpers are not counted towards wait(): a late helper finds the batch drained
+         * and returns at once.
+         */
+        void run_parallel(std::vector<std::function<void()> > const& jobs);
 
-        std::vector<std::thread> m_workers;
-        std::queue<Task>         m_tasks;
+    private:
 
-        std::mutex              m_mutex;      ///< Guards m_tasks, m_pending and m_stop
-        std::condition_variable m_taskAdded;  ///< Wakes a worker when work arrives
+        /// A set of jobs run by the caller of run_parallel() and any helpers it woke.
+        struct JobBatch
+        {
+            explicit JobBatch(std::vector<std::function<void()> > const& j)
+                : jobs(j), count(j.size()), next(0), done(0) {}
+
+            /// Claim and run jobs until none are left unclaimed.
+            void drain();
+
+            /// Only touched for a claimed index: the caller outlives every claimed job,
+            /// but not the late helpers that find nothing left to claim.
+            std::vector<std::function<void()> > const& jobs;
+            size_t const count;         ///< jobs.size(), readable after the caller returns
+            std::atomic<size_t> next;   ///< Next unclaimed job
+            size_t done;                ///< Finished jobs, guarded by mutex
+
+            std::mutex              mutex;
+            std::condition_variable finished;
+        };
+
+        /// One queued unit of work: a map tick, or a helper joining a job batch.
+        struct Task
+        {
+            Task() : map(nullptr), diff(0), cost(0) {}
+            Task(Map* m, uint32 d, uint32 c) : map(m), diff(d), cost(c) {}
+            explicit Task(std::shared_ptr<JobBatch> const& b) : map(nullptr), diff(0), cost(0), batch(b) {}
+
+            Map* map;
+            uint32 diff;
+            uint32 cost;        ///< The map's previous tick, in microseconds
+            std::shared_ptr<JobBatch> batch;
+        };
+
+        /// A worker's own deque. Its owner takes from the front, thieves from the back.
+        struct WorkerQueue
+        {
+            WorkerQueue() : busyUs(0), idleUs(0), tasks(0), steals(0) {}
+
+            std::mutex       mutex;   ///< Guards queue only
+            std::deque<Task> queue;
+
+            std::atomic<uint64> busyUs;
+            std::atomic<uint64> idleUs;
+            std::atomic<uint32> tasks;
+            std::atomic<uint32> steals;
+        };
+
+        /// Worker body: run tasks until stopped and every deque has drained.
+        void workerLoop(size_t index);
+
+        /// Take the next task for worker @p index: its own deque first, then a victim's.
+        bool take(size_t index, Task& task);
+
+        /// Deal the staged map ticks to the deques, longest first, and wake the workers.
+        void dispatch();
+
+        /// Append @p task to worker @p index's deque. The caller holds m_mutex and has
+        /// already raised m_queued for it.
+        void push(size_t index, Task const& task);
+
+        std::vector<std::thread>                   m_workers;
+        std::vector<std::unique_ptr<WorkerQueue> > m_queues;
+
+        std::vector<Task> m_staged;   ///< Map ticks scheduled but not yet dispatched
+
+        std::mutex              m_mutex;      ///< Guards m_staged, m_pending and m_stop
+        std::condition_variable m_taskAdded;  ///< Wakes sleeping workers when work arrives
         std::condition_variable m_taskDone;   ///< Wakes wait() once m_pending hits zero
 
-        size_t m_pending; ///< Scheduled but not yet finished updates
+        /// Tasks sitting in any deque. Raised under m_mutex, before the push, so a worker
+        /// deciding to sleep cannot miss the wake-up; lowered lock-free by whoever takes
+        /// the task.
+        std::atomic<size_t> m_queued;
+
+        size_t m_pending; ///< Scheduled but not yet finished map updates
         bool   m_stop;    ///< Set by deactivate() to retire the workers
+        size_t m_nextHelperQueue; ///< Round-robin start for run_parallel() helpers, under m_mutex
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
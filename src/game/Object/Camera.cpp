@@ -212,18 +212,18 @@ template<class T>
  *
  * @param target The world object whose visibility should be updated.
  * @param data The update packet data being built.
- * @param vis The set of currently visible objects.
+ * @param vis Receives the objects that became visible.
  */
-void Camera::UpdateVisibilityOf(T* target, UpdateData& data, std::set<WorldObject*>& vis)
+void Camera::UpdateVisibilityOf(T* target, UpdateData& data, std::vector<WorldObject*>& vis)
 {
     m_owner.template UpdateVisibilityOf<T>(m_source, target, data, vis);
 }
 
-template void Camera::UpdateVisibilityOf(Player*        , UpdateData& , std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(Creature*      , UpdateData& , std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(Corpse*        , UpdateData& , std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(GameObject*    , UpdateData& , std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(DynamicObject* , UpdateData& , std::set<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(Player*        , UpdateData& , std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(Creature*      , UpdateData& , std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(Corpse*        , UpdateData& , std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(GameObject*    , UpdateData& , std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(DynamicObject* , UpdateData& , std::vector<WorldObject*>&);
 
 /**
  * @brief Rebuilds visibility for the camera owner around the current source.
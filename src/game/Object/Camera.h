@@ -26,7 +26,7 @@
 #ifndef MANGOSSERVER_CAMERA_H
 #define MANGOSSERVER_CAMERA_H
 
-#include <set>
+#include <vector>
 #include <list>
 #include "GridDefines.h"
 
@@ -57,7 +57,7 @@ class Camera
         void ResetView(bool update_far_sight_field = true);
 
         template<class T>
-        void UpdateVisibilityOf(T* obj, UpdateData& d, std::set<WorldObject*>& vis);
+        void UpdateVisibilityOf(T* obj, UpdateData& d, std::vector<WorldObject*>& vis);
         void UpdateVisibilityOf(WorldObject* obj);
 
         void ReceivePacket(WorldPacket* data);
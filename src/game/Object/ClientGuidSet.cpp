@@ -0,0 +1,188 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file ClientGuidSet.cpp
+ * @brief Implementation of the flat client visibility set.
+ */
+
+#include "ClientGuidSet.h"
+
+#include <algorithm>
+
+namespace
+{
+    /// The table a first insert allocates: room for a quiet corner of the world.
+    const uint32 INITIAL_SLOTS = 64;
+}
+
+bool ClientGuidSet::Insert(ObjectGuid guid)
+{
+    uint64 const key = guid.GetRawValue();
+    if (key == 0)
+    {
+        return false;
+    }
+
+    if ((m_size + 1) * 2 > m_keys.size())
+    {
+        Grow();
+    }
+
+    uint32 slot = FindSlot(key);
+    if (m_keys[slot] == key)
+    {
+        return false;
+    }
+
+    m_keys[slot] = key;
+    m_seenIn[slot] = m_sweep;                               // new in reach is seen in reach
+    ++m_size;
+    return true;
+}
+
+bool ClientGuidSet::Erase(ObjectGuid guid)
+{
+    uint64 const key = guid.GetRawValue();
+    if (m_size == 0 || key == 0)
+    {
+        return false;
+    }
+
+    uint32 hole = FindSlot(key);
+    if (m_keys[hole] == 0)
+    {
+        return false;
+    }
+
+    // Close the hole: walk the rest of the run and pull back every member whose probe
+    // would pass over the hole to reach it.
+    uint32 const mask = uint32(m_keys.size()) - 1;
+    for (uint32 next = (hole + 1) & mask; m_keys[next] != 0; next = (next + 1) & mask)
+    {
+        uint32 const home = Hash(m_keys[next]) & mask;
+        bool const passesHole = next > hole ? (home <= hole || home > next)
+                                            : (home <= hole && home > next);
+        if (passesHole)
+        {
+            m_keys[hole] = m_keys[next];
+            m_seenIn[hole] = m_seenIn[next];
+            hole = next;
+        }
+    }
+
+    m_keys[hole] = 0;
+    --m_size;
+    return true;
+}
+
+void ClientGuidSet::Clear()
+{
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    std::fill(m_keys.begin(), m_keys.end(), uint64(0));
+    m_size = 0;
+}
+
+void ClientGuidSet::BeginSweep()
+{
+    if (++m_sweep == 0)
+    {
+        // Four billion sweeps on one player: restamp rather than let an old stamp match.
+        std::fill(m_seenIn.begin(), m_seenIn.end(), uint32(0));
+        m_sweep = 1;
+    }
+}
+
+bool ClientGuidSet::MarkSeen(ObjectGuid guid)
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+
+    uint32 slot = FindSlot(guid.GetRawValue());
+    if (m_keys[slot] == 0)
+    {
+        return false;
+    }
+
+    m_seenIn[slot] = m_sweep;
+    return true;
+}
+
+bool ClientGuidSet::IsUnseen(ObjectGuid guid) const
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+
+    uint32 slot = FindSlot(guid.GetRawValue());
+    return m_keys[slot] != 0 && m_seenIn[slot] != m_sweep;
+}
+
+void ClientGuidSet::TakeUnseen(std::vector<ObjectGuid>& left)
+{
+    // Collect first: an erase shifts members back into slots this loop has passed.
+    size_t const first = left.size();
+    for (uint32 slot = 0; slot < m_keys.size(); ++slot)
+    {
+        if (m_keys[slot] != 0 && m_seenIn[slot] != m_sweep)
+        {
+            left.push_back(ObjectGuid(m_keys[slot]));
+        }
+    }
+
+    for (size_t i = first; i < left.size(); ++i)
+    {
+        Erase(left[i]);
+    }
+}
+
+void ClientGuidSet::Grow()
+{
+    std::vector<uint64> keys;
+    std::vector<uint32> seenIn;
+    keys.swap(m_keys);
+    seenIn.swap(m_seenIn);
+
+    uint32 const slots = keys.empty() ? INITIAL_SLOTS : uint32(keys.size()) * 2;
+    m_keys.assign(slots, 0);
+    m_seenIn.assign(slots, 0);
+
+    for (uint32 i = 0; i < keys.size(); ++i)
+    {
+        if (keys[i] != 0)
+        {
+            uint32 slot = FindSlot(keys[i]);
+            m_keys[slot] = keys[i];
+            m_seenIn[slot] = seenIn[i];
+        }
+    }
+}
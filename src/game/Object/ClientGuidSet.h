@@ -0,0 +1,154 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file ClientGuidSet.h
+ * @brief The objects a player's client holds, as a flat hash set.
+ *
+ * Every update build and broadcast asks whether the client has an object
+ * (Player::HaveAtClient()), and every visibility sweep used to copy the whole set,
+ * one tree node per object, to find by elimination what had gone out of range. This
+ * keeps the raw GUIDs in one open-addressed array, and answers the sweep's question
+ * in place: each member carries the number of the last sweep that saw it, so what a
+ * sweep did not see is what left.
+ */
+
+#ifndef MANGOS_CLIENT_GUID_SET_H
+#define MANGOS_CLIENT_GUID_SET_H
+
+#include "Platform/Define.h"
+#include "ObjectGuid.h"
+
+#include <vector>
+
+/**
+ * @brief A set of ObjectGuids with a one-pass sweep for what has left.
+ *
+ * Linear probing over a power-of-two table, never more than half full; an erase
+ * shifts the rest of its run back rather than leaving a tombstone, so a lookup
+ * never walks past a deleted slot. The empty guid marks a free slot and is never
+ * a member.
+ *
+ * A sweep is BeginSweep(), then MarkSeen() for everything still in reach -- and
+ * Insert() for everything newly in reach, which counts as seen -- then
+ * TakeUnseen() for the rest.
+ */
+class ClientGuidSet
+{
+    public:
+
+        ClientGuidSet() : m_size(0), m_sweep(1) {}
+
+        /// Add @p guid. False if it was a member already.
+        bool Insert(ObjectGuid guid);
+
+        /// Remove @p guid. False if it was not a member.
+        bool Erase(ObjectGuid guid);
+
+        bool Contains(ObjectGuid guid) const
+        {
+            if (m_size == 0)
+            {
+                return false;
+            }
+            return m_keys[FindSlot(guid.GetRawValue())] != 0;
+        }
+
+        uint32 Size() const { return m_size; }
+        bool Empty() const { return m_size == 0; }
+
+        /// Remove everything; keeps the table.
+        void Clear();
+
+        /// Start a sweep: every member counts as unseen until marked.
+        void BeginSweep();
+
+        /// Note that @p guid is still in reach. False if it is not a member.
+        bool MarkSeen(ObjectGuid guid);
+
+        /// True if @p guid is a member the current sweep has not seen.
+        bool IsUnseen(ObjectGuid guid) const;
+
+        /// Remove every member the current sweep has not seen, appending each to @p left.
+        void TakeUnseen(std::vector<ObjectGuid>& left);
+
+        /// Walks the members in table order.
+        class const_iterator
+        {
+            public:
+                const_iterator(uint64 const* slot, uint64 const* end) : m_slot(slot), m_end(end) { Skip(); }
+
+                ObjectGuid operator*() const { return ObjectGuid(*m_slot); }
+                const_iterator& operator++() { ++m_slot; Skip(); return *this; }
+                bool operator!=(const_iterator const& other) const { return m_slot != other.m_slot; }
+
+            private:
+                void Skip()
+                {
+                    while (m_slot != m_end && *m_slot == 0)
+                    {
+                        ++m_slot;
+                    }
+                }
+
+                uint64 const* m_slot;
+                uint64 const* m_end;
+        };
+
+        const_iterator begin() const { return const_iterator(m_keys.data(), m_keys.data() + m_keys.size()); }
+        const_iterator end() const { return const_iterator(m_keys.data() + m_keys.size(), m_keys.data() + m_keys.size()); }
+
+    private:
+
+        /// The slot holding @p key, or the free slot ending its run. The table must not be empty.
+        uint32 FindSlot(uint64 key) const
+        {
+            uint32 const mask = uint32(m_keys.size()) - 1;
+            uint32 slot = Hash(key) & mask;
+            while (m_keys[slot] != 0 && m_keys[slot] != key)
+            {
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+
+        /// Mixes the counter, type and entry bits of a raw guid, which are far from random.
+        static uint32 Hash(uint64 key)
+        {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+            return uint32(key);
+        }
+
+        void Grow();
+
+        std::vector<uint64> m_keys;         ///< raw guids; 0 is a free slot
+        std::vector<uint32> m_seenIn;       ///< per slot, the last sweep that saw it
+        uint32 m_size;
+        uint32 m_sweep;
+};
+
+#endif
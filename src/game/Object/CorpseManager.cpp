@@ -158,11 +158,13 @@ void CorpseManager::AddCorpsesToGrid(GridPair const& gridpair, GridType& grid, M
             if (corpse->GetInstanceId() == map->GetInstanceId())
             {
                 grid.AddWorldObject(corpse);
+                map->IndexGridPosition(corpse, Cell(MaNGOS::ComputeCellPair(corpse->Where().X(), corpse->Where().Y())));
             }
         }
         else
         {
             grid.AddWorldObject(corpse);
+            map->IndexGridPosition(corpse, Cell(MaNGOS::ComputeCellPair(corpse->Where().X(), corpse->Where().Y())));
         }
     });
 }
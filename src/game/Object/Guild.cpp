@@ -328,7 +328,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
     // If player not in game data in data field will be loaded from guild tables, no need to update it!!
     if (pl)
     {
-        pl->SetInGuild(m_Id);
+        pl->SetInGuild(m_Id, m_Name);                       // not in GuildMgr yet if this is the founder
         pl->SetRank(newmember.RankId);
         pl->SetGuildIdInvited(0);
     }
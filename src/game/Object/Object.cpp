@@ -266,6 +266,12 @@ WorldObject::WorldObject() :
  */
 WorldObject::~WorldObject()
 {
+    // A row must never outlive its object.
+    if (m_positionSlot.index)
+    {
+        m_positionSlot.index->Remove(m_positionSlot);
+    }
+
 #ifdef ENABLE_ELUNA
     delete elunaEvents;
     elunaEvents = nullptr;
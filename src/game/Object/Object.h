@@ -34,15 +34,18 @@
 #include <vector>
 #include "ByteBuffer.h"
 #include "UpdateFields.h"
+#include "ValuesBlockCache.h"
 #include "UpdateData.h"
 #include "ObjectGuid.h"
 #include "Camera.h"
 #include "GameTime.h"
 #include "Geometry/Placement.h"
+#include "CellPositionIndex.h"
 #ifdef ENABLE_ELUNA
 #include "LuaValue.h"
 #endif /* ENABLE_ELUNA */
 
+#include <list>
 #include <set>
 #include <string>
 
@@ -97,6 +100,7 @@ class UpdateData;
 class WorldSession;
 class Creature;
 class GameObject;
+class Object;
 class Player;
 class Unit;
 class Group;
@@ -320,6 +324,7 @@ class Object
 
         uint8 GetTypeId() const { return m_objectTypeId; }
         bool isType(TypeMask mask) const { return (mask & m_objectType); }
+        uint16 GetTypeMask() const { return m_objectType; }
 
         virtual void BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const;
         void SendCreateUpdateToPlayer(Player* player);
@@ -334,6 +339,12 @@ class Object
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
+        /// Fill @p key with what this object's pending values block looks like to @p target.
+        void GetValuesViewKey(Player* target, ValuesViewKey& key) const;
+
+        /// As above, reusing the bytes @p cache holds for a viewer with the same key.
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesBlockCache& cache) const;
+
         virtual void DestroyForPlayer(Player* target, bool anim = false) const;
 
         const int32& GetInt32Value(uint16 index) const
@@ -597,7 +608,12 @@ class Object
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesBlockCache* cache = NULL);
+
+        /// A unit field as @p target is sent it; the viewer-dependent ones are rewritten here.
+        uint32 UnitValueForViewer(uint16 index, Player* target, bool perCasterAuraState) const;
+        /// A game object field as a viewer is sent it; only GAMEOBJECT_DYNAMIC depends on the viewer.
+        uint32 GameObjectValueForViewer(uint16 index, bool activateToQuest) const;
 
         uint16 m_objectType;
 
@@ -693,10 +709,13 @@ class WorldObject : public Object
 
         /// The extent lives in the component; this only pushes a new value in when the
         /// per-class formula's inputs change (a model, a scale -- rarely).
-        void RefreshBoundingRadius() { m_placement.Resize(ComputeBoundingRadius()); }
+        void RefreshBoundingRadius();
 
         void OnScaleChanged() override { RefreshBoundingRadius(); }
 
+        /// The object's row in its cell's position index. Map files and drops it.
+        CellPositionIndex::Slot& GetPositionSlot() { return m_positionSlot; }
+
         uint32 GetMapId() const { return m_mapId; }
         uint32 GetInstanceId() const { return m_InstanceId; }
 
@@ -832,6 +851,7 @@ class WorldObject : public Object
         uint32 m_phaseMask;                                 // in area phase state
 
         Geometry::Placement m_placement;
+        CellPositionIndex::Slot m_positionSlot;
         ViewPoint m_viewPoint;
         WorldUpdateCounter m_updateTracker;
         bool m_isActiveObject;
@@ -858,6 +878,9 @@ bool InFrontPhased(WorldObject const& a, WorldObject const& b, float dist, float
 bool InBackPhased(WorldObject const& a, WorldObject const& b, float dist, float arc);
 bool HasLineOfSight(WorldObject const& a, WorldObject const& b);
 bool HasLineOfSight(WorldObject const& a, Geometry::Vector3 const& point);
+/// Drops every target A has no line of sight to. The same answer as HasLineOfSight per
+/// target, but the sight lines are traced through the map's collision together.
+void KeepInLineOfSight(WorldObject const& a, std::list<Unit*>& targets);
 bool IsPlaceable(WorldObject const& obj);
 
 // Terrain and grid answers about a position. The component supplies the geometry; the
@@ -223,6 +223,77 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     data->AddUpdateBlock();
 }
 
+/**
+ * @brief Describe this object's pending values block as @p target would receive it
+ * @param target Viewer
+ * @param key Filled with the viewer's key
+ *
+ * Mirrors BuildValuesUpdateBlockForPlayer: the update mask depends on the viewer
+ * only through Player::_SetUpdateBits (own fields or visible ones), and the field
+ * values only through UnitValueForViewer / GameObjectValueForViewer. Only the
+ * viewer-dependent fields this delta actually carries are evaluated.
+ */
+void Object::GetValuesViewKey(Player* target, ValuesViewKey& key) const
+{
+    key.self = target == this;
+    key.count = 0;
+
+    if (isType(TYPEMASK_UNIT))
+    {
+        bool const perCasterAuraState = ((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE);
+
+        if (GetTypeId() == TYPEID_UNIT && m_changedValues[UNIT_NPC_FLAGS])
+        {
+            key.values[key.count++] = UnitValueForViewer(UNIT_NPC_FLAGS, target, perCasterAuraState);
+        }
+        if (perCasterAuraState || m_changedValues[UNIT_FIELD_AURASTATE])
+        {
+            key.values[key.count++] = UnitValueForViewer(UNIT_FIELD_AURASTATE, target, perCasterAuraState);
+        }
+        if (m_changedValues[UNIT_FIELD_FLAGS])
+        {
+            key.values[key.count++] = UnitValueForViewer(UNIT_FIELD_FLAGS, target, perCasterAuraState);
+        }
+        if (m_changedValues[UNIT_DYNAMIC_FLAGS])
+        {
+            key.values[key.count++] = UnitValueForViewer(UNIT_DYNAMIC_FLAGS, target, perCasterAuraState);
+        }
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
+    {
+        bool const activateToQuest = ((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster();
+        key.values[key.count++] = GameObjectValueForViewer(GAMEOBJECT_DYNAMIC, activateToQuest);
+    }
+}
+
+/**
+ * @brief Append an object's values block for one viewer, through a cache
+ * @param data Viewer's update data
+ * @param target Viewer
+ * @param cache Blocks already built for this delta
+ *
+ * The first viewer of each key has its block built in place in its own buffer, and
+ * those bytes are kept for every later viewer with the same key.
+ */
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesBlockCache& cache) const
+{
+    ValuesViewKey key;
+    GetValuesViewKey(target, key);
+
+    ByteBuffer& buf = data->GetBuffer();
+
+    if (std::vector<uint8> const* bytes = cache.Find(key))
+    {
+        buf.append(bytes->data(), bytes->size());
+        data->AddUpdateBlock();
+        return;
+    }
+
+    size_t const start = buf.wpos();
+    BuildValuesUpdateBlockForPlayer(data, target);
+    cache.Store(key, buf.contents() + start, buf.wpos() - start);
+}
+
 /**
  * @brief Build out of range update block
  * @param data Update data buffer
@@ -561,127 +632,7 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
         {
             if (updateMask->GetBit(index))
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
-
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (!target->canSeeSpellClickOn((Creature*)this))
-                        {
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                            {
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                            }
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                            {
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                            }
-                        }
-                    }
-
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
-                {
-                    if (IsPerCasterAuraState)
-                    {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                        {
-                            *data << m_uint32Values[index];
-                        }
-                        else
-                        {
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
-                        }
-                    }
-                    else
-                    {
-                        *data << m_uint32Values[index];
-                    }
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-                }
-
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
-
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                // Hide special-info for non empathy-casters,
-                // Hide lootable animation for unallowed players
-                else if (index == UNIT_DYNAMIC_FLAGS)
-                {
-                    uint32 dynflagsValue = m_uint32Values[index];
-
-                    // Checking SPELL_AURA_EMPATHY and caster
-                    if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO && ((Unit*)this)->IsAlive())
-                    {
-                        bool bIsEmpathy = false;
-                        bool bIsCaster = false;
-                        Unit::AuraList const& mAuraEmpathy = ((Unit*)this)->GetAurasByType(SPELL_AURA_EMPATHY);
-                        for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
-                        {
-                            bIsEmpathy = true;        // Empathy by aura set
-
-                            if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
-                            {
-                                bIsCaster = true;  // target is the caster of an empathy aura
-                            }
-                        }
-
-                        if (bIsEmpathy && !bIsCaster) // Empathy by aura, but target is not the caster
-                        {
-                            dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
-                        }
-                    }
-
-                    // Checking lootable
-                    if (dynflagsValue & UNIT_DYNFLAG_LOOTABLE && GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (!target->isAllowedToLoot((Creature*)this))
-                        {
-                            dynflagsValue &= ~(UNIT_DYNFLAG_LOOTABLE | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-                        }
-                        else
-                        {
-                            // flag only for original loot recipent
-                            if (target->GetObjectGuid() != ((Creature*)this)->GetLootRecipientGuid())
-                            {
-                                dynflagsValue &= ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-                            }
-                        }
-                    }
-                    *data << dynflagsValue;
-                }
-                else                                        // Unhandled index, just send
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
-                }
+                *data << UnitValueForViewer(index, target, IsPerCasterAuraState);
             }
         }
     }
@@ -691,46 +642,7 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
         {
             if (updateMask->GetBit(index))
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYNAMIC)
-                {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
-
-                    if (IsActivateToQuest)
-                    {
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(-1);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(-1);
-                                break;
-                            default:
-                                // unknown, not happen.
-                                *data << uint16(0);
-                                *data << uint16(-1);
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        // disable quest object
-                        *data << uint16(0);
-                        *data << uint16(-1);
-                    }
-                }
-                else
-                {
-                    *data << m_uint32Values[index];          // other cases
-                }
+                *data << GameObjectValueForViewer(index, IsActivateToQuest);
             }
         }
     }
@@ -747,6 +659,173 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
     }
 }
 
+/**
+ * @brief A unit's field as it is sent to one viewer
+ * @param index Field index
+ * @param target Viewer
+ * @param perCasterAuraState True if the unit has an aura state that only some casters see
+ * @return The 32 bits to send
+ *
+ * Most fields go out as stored. Npc flags, aura state, unit flags and dynamic flags
+ * are trimmed to what @p target is allowed to see; GetValuesViewKey() depends on
+ * this being the complete list.
+ */
+uint32 Object::UnitValueForViewer(uint16 index, Player* target, bool perCasterAuraState) const
+{
+    if (index == UNIT_NPC_FLAGS)
+    {
+        uint32 appendValue = m_uint32Values[index];
+
+        if (GetTypeId() == TYPEID_UNIT)
+        {
+            if (!target->canSeeSpellClickOn((Creature*)this))
+            {
+                appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+            }
+
+            if (appendValue & UNIT_NPC_FLAG_TRAINER)
+            {
+                if (!((Creature*)this)->IsTrainerOf(target, false))
+                {
+                    appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
+                }
+            }
+
+            if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+            {
+                if (target->getClass() != CLASS_HUNTER)
+                {
+                    appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+                }
+            }
+        }
+
+        return appendValue;
+    }
+
+    if (index == UNIT_FIELD_AURASTATE)
+    {
+        // perCasterAuraState set if related pet caster aura state set already
+        if (perCasterAuraState && !((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+        {
+            return m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1));
+        }
+        return m_uint32Values[index];
+    }
+
+    // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+    if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+    {
+        // convert from float to uint32 and send
+        return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+    }
+
+    // there are some float values which may be negative or can't get negative due to other checks
+    if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+        (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+        (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+        (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+    {
+        return uint32(m_floatValues[index]);
+    }
+
+    // Gamemasters should be always able to select units - remove not selectable flag
+    if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+    {
+        return m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE;
+    }
+
+    // Hide special-info for non empathy-casters,
+    // Hide lootable animation for unallowed players
+    if (index == UNIT_DYNAMIC_FLAGS)
+    {
+        uint32 dynflagsValue = m_uint32Values[index];
+
+        // Checking SPELL_AURA_EMPATHY and caster
+        if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO && ((Unit*)this)->IsAlive())
+        {
+            bool bIsEmpathy = false;
+            bool bIsCaster = false;
+            Unit::AuraList const& mAuraEmpathy = ((Unit*)this)->GetAurasByType(SPELL_AURA_EMPATHY);
+            for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
+            {
+                bIsEmpathy = true;        // Empathy by aura set
+
+                if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
+                {
+                    bIsCaster = true;  // target is the caster of an empathy aura
+                }
+            }
+
+            if (bIsEmpathy && !bIsCaster) // Empathy by aura, but target is not the caster
+            {
+                dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
+            }
+        }
+
+        // Checking lootable
+        if (dynflagsValue & UNIT_DYNFLAG_LOOTABLE && GetTypeId() == TYPEID_UNIT)
+        {
+            if (!target->isAllowedToLoot((Creature*)this))
+            {
+                dynflagsValue &= ~(UNIT_DYNFLAG_LOOTABLE | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+            }
+            else
+            {
+                // flag only for original loot recipent
+                if (target->GetObjectGuid() != ((Creature*)this)->GetLootRecipientGuid())
+                {
+                    dynflagsValue &= ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+                }
+            }
+        }
+        return dynflagsValue;
+    }
+
+    // Unhandled index, just send in current format (float as float, uint32 as uint32)
+    return m_uint32Values[index];
+}
+
+/**
+ * @brief A game object's field as it is sent to a viewer
+ * @param index Field index
+ * @param activateToQuest True if the viewer can use the object for a quest
+ * @return The 32 bits to send
+ */
+uint32 Object::GameObjectValueForViewer(uint16 index, bool activateToQuest) const
+{
+    if (index != GAMEOBJECT_DYNAMIC)
+    {
+        return m_uint32Values[index];                       // other cases
+    }
+
+    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+    //      most likely related to "can enter map" and then should be 0 if can not enter
+    // The hi half is always sent as -1.
+    uint32 const hi = uint32(uint16(-1)) << 16;
+
+    if (!activateToQuest)
+    {
+        // disable quest object
+        return hi;
+    }
+
+    switch (((GameObject*)this)->GetGoType())
+    {
+        case GAMEOBJECT_TYPE_QUESTGIVER:
+            // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
+            return hi | GO_DYNFLAG_LO_ACTIVATE;
+        case GAMEOBJECT_TYPE_CHEST:
+        case GAMEOBJECT_TYPE_GENERIC:
+        case GAMEOBJECT_TYPE_SPELL_FOCUS:
+        case GAMEOBJECT_TYPE_GOOBER:
+            return hi | GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+        default:
+            // unknown, not happen.
+            return hi;
+    }
+}
+
 /**
  * @brief Clear update mask
  * @param remove If true, remove from client update list
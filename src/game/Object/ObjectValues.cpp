@@ -485,11 +485,12 @@ bool Object::PrintEntryError(char const* descr) const
  * @brief Build update data for player
  * @param pl Target player
  * @param update_players Map of players to their update data
+ * @param cache Blocks already built for other viewers this flush, or NULL
  *
  * Builds update data for the specified player, adding them
  * to the update map if not already present.
  */
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesBlockCache* cache)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -500,7 +501,14 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (cache)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *cache);
+    }
+    else
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    }
 }
 
 /**
@@ -503,6 +503,10 @@ Player::Player(WorldSession* session): Unit(), m_honorMgr(this), m_spellCooldown
 
     // Initialize mails updated flag to false
     m_mailsUpdated = false;
+    // Nothing written by this session yet; the first save rewrites these whole
+    m_savedAurasKnown = false;
+    m_savedStatsKnown = false;
+    memset(&m_savedStats, 0, sizeof(m_savedStats));
     // Initialize unread mails count to 0
     unReadMails = 0;
     // Initialize next mail delivery time to 0
@@ -2543,6 +2547,7 @@ void Player::SetLevel(uint32 level)
 
     SetUInt32Value(UNIT_FIELD_LEVEL, level);
     SetUInt32Value(PLAYER_XP, 0);
+    sPlayerRegistry.Directory().SetLevel(GetObjectGuid(), level);
     if (GetGroup())
     {
         SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
@@ -2662,6 +2667,27 @@ void Player::GiveLevel(uint32 level)
     return SetLevel(level);
 }
 
+/**
+ * @brief Sets the player's guild and refiles them under it for /who.
+ *
+ * A guild being founded adds its founder before GuildMgr knows it, so the guild
+ * passes its own name rather than have it looked up.
+ *
+ * @param GuildId The guild to join, or 0 to leave.
+ * @param guildName The guild's name; empty to look it up by @p GuildId.
+ */
+void Player::SetInGuild(uint32 GuildId, std::string const& guildName)
+{
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
+
+    std::string name;
+    if (GuildId)
+    {
+        name = guildName.empty() ? sGuildMgr.GetGuildNameById(GuildId) : guildName;
+    }
+    sPlayerRegistry.Directory().SetGuild(GetObjectGuid(), GuildId, name);
+}
+
 /**
  * @brief Recalculates the player's free talent points for the current level.
  *
@@ -85,6 +85,7 @@
 #include "WorldSession.h"
 #include "Pet.h"
 #include "MapReference.h"
+#include "ClientGuidSet.h"
 #include "Util.h"                                           // for Tokens typedef
 #include "AchievementMgr.h"
 #include "ReputationMgr.h"
@@ -1033,6 +1034,68 @@ struct BGData
     bool HasTaxiPath() const { return taxiPath[0] && taxiPath[1]; }
 };
 
+/// Key of a `character_aura` row: who cast it, from which item, and the spell.
+struct SavedAuraKey
+{
+    uint64 casterGuid;
+    uint32 itemGuid;
+    uint32 spellId;
+
+    bool operator<(SavedAuraKey const& other) const
+    {
+        if (casterGuid != other.casterGuid)
+        {
+            return casterGuid < other.casterGuid;
+        }
+        return itemGuid != other.itemGuid ? itemGuid < other.itemGuid : spellId < other.spellId;
+    }
+};
+
+/// The rest of a `character_aura` row, as the last save wrote it
+struct SavedAuraRow
+{
+    uint32 stackCount;
+    uint32 charges;
+    int32 damage[MAX_EFFECT_INDEX];
+    uint32 periodicTime[MAX_EFFECT_INDEX];
+    int32 maxDuration;
+    int32 duration;
+    uint32 effIndexMask;
+
+    bool operator==(SavedAuraRow const& other) const { return memcmp(this, &other, sizeof(*this)) == 0; }
+    bool operator!=(SavedAuraRow const& other) const { return !(*this == other); }
+};
+
+typedef std::map<SavedAuraKey, SavedAuraRow> SavedAuraRows;
+
+/// The `character_stats` row, as the last save wrote it. All 32-bit fields: no padding to compare.
+struct SavedStatsRow
+{
+    uint32 maxHealth;
+    uint32 maxPower[MAX_POWERS];
+    float stat[MAX_STATS];
+    uint32 resistance[MAX_SPELL_SCHOOL];
+    float blockPct;
+    float dodgePct;
+    float parryPct;
+    float critPct;
+    float rangedCritPct;
+    float spellCritPct;
+    uint32 attackPower;
+    uint32 rangedAttackPower;
+    uint32 spellPower;
+
+    bool operator==(SavedStatsRow const& other) const { return memcmp(this, &other, sizeof(*this)) == 0; }
+};
+
+/// Character saves since start (or the last reset), for `.debug dbqueues`
+struct PlayerSaveStats
+{
+    uint64 saves;                                           ///< Player::SaveToDB calls that wrote
+    uint64 statements;                                      ///< statements they issued, all told
+    uint32 maxStatements;                                   ///< most issued by one save
+};
+
 // Structure to hold trade status information
 struct TradeStatusInfo
 {
@@ -2140,6 +2203,9 @@ class Player : public Unit
         // Save the gold to the database
         void SaveGoldToDB();
 
+        // Character save counters, all players together
+        static void GetSaveStats(PlayerSaveStats& stats, bool resetPeak);
+
         // Set a uint32 value in an array
         static void SetUInt32ValueInArray(Tokens& data, uint16 index, uint32 value);
         static void SetFloatValueInArray(Tokens& data, uint16 index, float value);
@@ -2620,11 +2686,8 @@ class Player : public Unit
         void SetAllowLowLevelRaid(bool allow) { ApplyModFlag(PLAYER_FLAGS, PLAYER_FLAGS_ENABLE_LOW_LEVEL_RAID, allow); }
         bool GetAllowLowLevelRaid() const { return HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_ENABLE_LOW_LEVEL_RAID); }
 
-        // Set the player's guild ID
-        void SetInGuild(uint32 GuildId)
-        {
-            SetUInt32Value(PLAYER_GUILDID, GuildId);
-        }
+        // Set the player's guild ID; the guild's name is looked up if not given
+        void SetInGuild(uint32 GuildId, std::string const& guildName = std::string());
 
         // Set the player's guild rank
         void SetRank(uint32 rankId)
@@ -3634,10 +3697,10 @@ class Player : public Unit
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
         // Currently visible objects at the player's client
-        GuidSet m_clientGUIDs;
+        ClientGuidSet m_clientGUIDs;
 
         // Check if an object is visible to the client
-        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.Contains(u->GetObjectGuid()); }
 
         // Check if the player is visible in the grid for another player
         bool IsVisibleInGridForPlayer(Player* pl) const override;
@@ -3650,7 +3713,7 @@ class Player : public Unit
 
         // Template function to update the visibility of a target from a viewpoint
         template<class T>
-        void UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateData& data, std::set<WorldObject*>& visibleNow);
+        void UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateData& data, std::vector<WorldObject*>& visibleNow);
 
         // Handle detection of stealthed units
         void HandleStealthedUnitsDetection();
@@ -3866,6 +3929,14 @@ class Player : public Unit
 
         BgBattleGroundQueueID_Rec m_bgBattleGroundQueueID[PLAYER_MAX_BATTLEGROUND_QUEUES];
         BGData                    m_bgData;
+
+        // What the last save wrote for the tables that are not tracked row by row as they
+        // change; a save writes only where these differ. Unknown until the first save,
+        // which rewrites them whole.
+        SavedAuraRows             m_savedAuras;
+        bool                      m_savedAurasKnown;
+        SavedStatsRow             m_savedStats;
+        bool                      m_savedStatsKnown;
         bool m_IsBGRandomWinner;
 
         /*********************************************************/
@@ -3964,7 +4035,7 @@ class Player : public Unit
         void _SaveBGData();
         void _SaveGlyphs() { m_glyphMgr.Save(); }
         void _SaveTalents();
-        void _SaveStats();
+        bool _SaveStats();
 
         // Set create bits for the update mask
         void _SetCreateBits(UpdateMask* updateMask, Player* target) const override;
@@ -0,0 +1,234 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file PlayerDirectory.cpp
+ * @brief Implementation of the online-player directory.
+ */
+
+#include "PlayerDirectory.h"
+#include "Util.h"
+
+#include <cstring>
+
+std::wstring PlayerDirectory::Lowered(std::string const& utf8)
+{
+    std::wstring wide;
+    if (!Utf8toWStr(utf8, wide))
+    {
+        return std::wstring();
+    }
+    wstrToLower(wide);
+    return wide;
+}
+
+void PlayerDirectory::Unlink(std::vector<uint32>& bucket, uint32 row)
+{
+    std::vector<uint32>::iterator itr = std::find(bucket.begin(), bucket.end(), row);
+    if (itr != bucket.end())
+    {
+        *itr = bucket.back();
+        bucket.pop_back();
+    }
+}
+
+void PlayerDirectory::UnlinkName(uint32 row)
+{
+    std::pair<NameIndex::iterator, NameIndex::iterator> range = m_byName.equal_range(m_rows[row].lowerName);
+    for (NameIndex::iterator itr = range.first; itr != range.second; ++itr)
+    {
+        if (itr->second == row)
+        {
+            m_byName.erase(itr);
+            return;
+        }
+    }
+}
+
+int32 PlayerDirectory::RowOf(ObjectGuid guid) const
+{
+    std::unordered_map<ObjectGuid, uint32>::const_iterator itr = m_rowOf.find(guid);
+    return itr != m_rowOf.end() ? int32(itr->second) : -1;
+}
+
+void PlayerDirectory::Insert(Entry const& entry)
+{
+    // Lower the names before taking the lock: it is the one costly step.
+    std::wstring lowerName = Lowered(entry.name);
+    std::wstring lowerGuildName = Lowered(entry.guildName);
+
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+
+    int32 existing = RowOf(entry.guid);
+    if (existing >= 0)
+    {
+        // Filed again without being dropped: unlink the old row and reuse it.
+        Row& r = m_rows[existing];
+        UnlinkName(uint32(existing));
+        Unlink(m_byZone[r.entry.zone], uint32(existing));
+        Unlink(m_byLevel[LevelSlot(r.entry.level)], uint32(existing));
+    }
+
+    uint32 row;
+    if (existing >= 0)
+    {
+        row = uint32(existing);
+    }
+    else if (!m_freeRows.empty())
+    {
+        row = m_freeRows.back();
+        m_freeRows.pop_back();
+    }
+    else
+    {
+        row = uint32(m_rows.size());
+        m_rows.push_back(Row());
+    }
+
+    Row& r = m_rows[row];
+    r.entry = entry;
+    r.lowerName.swap(lowerName);
+    r.lowerGuildName.swap(lowerGuildName);
+
+    m_rowOf[entry.guid] = row;
+    m_byName.insert(NameIndex::value_type(r.lowerName, row));
+    m_byZone[entry.zone].push_back(row);
+    m_byLevel[LevelSlot(entry.level)].push_back(row);
+}
+
+void PlayerDirectory::Remove(ObjectGuid guid)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+
+    int32 found = RowOf(guid);
+    if (found < 0)
+    {
+        return;
+    }
+
+    uint32 row = uint32(found);
+    Row& r = m_rows[row];
+    UnlinkName(row);
+    Unlink(m_byZone[r.entry.zone], row);
+    Unlink(m_byLevel[LevelSlot(r.entry.level)], row);
+    m_rowOf.erase(guid);
+
+    r = Row();                                              // let go of the strings
+    m_freeRows.push_back(row);
+}
+
+void PlayerDirectory::SetZone(ObjectGuid guid, uint32 zone)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+
+    int32 found = RowOf(guid);
+    if (found < 0 || m_rows[found].entry.zone == zone)
+    {
+        return;
+    }
+
+    Unlink(m_byZone[m_rows[found].entry.zone], uint32(found));
+    m_byZone[zone].push_back(uint32(found));
+    m_rows[found].entry.zone = zone;
+}
+
+void PlayerDirectory::SetLevel(ObjectGuid guid, uint32 level)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+
+    int32 found = RowOf(guid);
+    if (found < 0 || m_rows[found].entry.level == level)
+    {
+        return;
+    }
+
+    Unlink(m_byLevel[LevelSlot(m_rows[found].entry.level)], uint32(found));
+    m_byLevel[LevelSlot(level)].push_back(uint32(found));
+    m_rows[found].entry.level = level;
+}
+
+void PlayerDirectory::SetGuild(ObjectGuid guid, uint32 guildId, std::string const& guildName)
+{
+    std::wstring lowerGuildName = Lowered(guildName);
+
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+
+    int32 found = RowOf(guid);
+    if (found < 0)
+    {
+        return;
+    }
+
+    Row& r = m_rows[found];
+    r.entry.guildId = guildId;
+    r.entry.guildName = guildName;
+    r.lowerGuildName.swap(lowerGuildName);
+}
+
+ObjectGuid PlayerDirectory::FindByName(const char* name) const
+{
+    if (!name)
+    {
+        return ObjectGuid();
+    }
+
+    // Lowering the one name asked for replaces comparing against every name online.
+    std::wstring lowerName = Lowered(name);
+    if (lowerName.empty())
+    {
+        return ObjectGuid();
+    }
+
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+
+    std::pair<NameIndex::const_iterator, NameIndex::const_iterator> range = m_byName.equal_range(lowerName);
+    for (NameIndex::const_iterator itr = range.first; itr != range.second; ++itr)
+    {
+        Row const& r = m_rows[itr->second];
+        if (std::strcmp(r.entry.name.c_str(), name) == 0)
+        {
+            return r.entry.guid;
+        }
+    }
+    return ObjectGuid();
+}
+
+bool PlayerDirectory::FindPresence(ObjectGuid guid, Presence& presence) const
+{
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+
+    int32 found = RowOf(guid);
+    if (found < 0)
+    {
+        return false;
+    }
+
+    Row const& r = m_rows[found];
+    presence.zone = r.entry.zone;
+    presence.level = r.entry.level;
+    presence.team = r.entry.team;
+    presence.classId = r.entry.classId;
+    return true;
+}
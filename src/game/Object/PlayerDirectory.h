@@ -0,0 +1,310 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file PlayerDirectory.h
+ * @brief What a /who or a friends list needs to know about everyone online.
+ *
+ * A /who used to visit every online player, work out the zone from the terrain at
+ * their feet, and convert their name and their guild's name to lower-case wide
+ * strings, all to compare against a filter that most of them fail. This keeps those
+ * answers ready: one row per player, with the names lowered once when the player
+ * logs in, and indexes by zone, by level and by name so a query starts from the
+ * players it can match and stops once it has listed enough.
+ *
+ * The rows are kept in step by the player, not read from it: PlayerRegistry files
+ * and drops them, and Player reports a new zone, level or guild as it happens. A row
+ * names its player by guid only; PlayerRegistry turns the guid back into a Player.
+ */
+
+#ifndef MANGOS_PLAYER_DIRECTORY_H
+#define MANGOS_PLAYER_DIRECTORY_H
+
+#include "Platform/Define.h"
+#include "ObjectGuid.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief An index of online players by name, zone and level.
+ *
+ * Lookups take the lock shared; filing, dropping and updating a row take it
+ * exclusively, and may come from any map thread.
+ */
+class PlayerDirectory
+{
+    public:
+
+        /// The filed state of one player.
+        struct Entry
+        {
+            Entry() : guildId(0), level(0), zone(0), team(0), race(0), classId(0), gender(0) {}
+
+            ObjectGuid guid;
+            std::string name;
+            uint32 guildId;
+            std::string guildName;
+            uint32 level;
+            uint32 zone;
+            uint32 team;
+            uint8 race;
+            uint8 classId;
+            uint8 gender;
+        };
+
+        /// The parts of an entry a friends list shows.
+        struct Presence
+        {
+            uint32 zone;
+            uint32 level;
+            uint32 team;
+            uint8 classId;
+        };
+
+        /// A /who, with every string already lowered.
+        struct WhoQuery
+        {
+            WhoQuery() : levelMin(0), levelMax(255), raceMask(0xFFFFFFFF), classMask(0xFFFFFFFF), team(0), limit(50) {}
+
+            uint32 levelMin;
+            uint32 levelMax;
+            uint32 raceMask;
+            uint32 classMask;
+            std::vector<uint32> zones;              ///< empty: any zone
+            std::wstring name;                      ///< a substring of the player's name; empty: any
+            std::wstring guild;                     ///< a substring of the guild's name; empty: any
+            std::vector<std::wstring> strings;      ///< each may match name, guild or zone name; empty ones are ignored
+            uint32 team;                            ///< 0: either team
+            uint32 limit;                           ///< stop after listing this many
+        };
+
+        PlayerDirectory() {}
+
+        PlayerDirectory(const PlayerDirectory&) = delete;
+        PlayerDirectory& operator=(const PlayerDirectory&) = delete;
+
+        /// File @p entry, replacing any row for the same guid.
+        void Insert(Entry const& entry);
+
+        void Remove(ObjectGuid guid);
+
+        /// Updates for a filed player; a guid that is not filed is ignored.
+        void SetZone(ObjectGuid guid, uint32 zone);
+        void SetLevel(ObjectGuid guid, uint32 level);
+        void SetGuild(ObjectGuid guid, uint32 guildId, std::string const& guildName);
+
+        /// The guid of the player named exactly @p name (case counts), or an empty guid. A lookup in the name index.
+        ObjectGuid FindByName(const char* name) const;
+
+        /// Fill @p presence for @p guid. False if the guid is not filed.
+        bool FindPresence(ObjectGuid guid, Presence& presence) const;
+
+        size_t Size() const
+        {
+            std::shared_lock<std::shared_mutex> guard(m_lock);
+            return m_rowOf.size();
+        }
+
+        /**
+         * @brief Run a /who.
+         *
+         * Offers every filed player matching @p query to visit(Entry const&), which
+         * makes the checks the directory cannot -- whether the player is in the world, is
+         * visible to the asker -- and returns true if it listed them. Stops once
+         * @p query.limit have been listed.
+         *
+         * The search starts from the zone index if the query names zones, from the name
+         * index if it names a player, and otherwise from the level index over the
+         * requested range. A name is matched anywhere in the player's name, as the client
+         * expects; the players whose names start with it are offered first.
+         *
+         * @param areaFits areaFits(zoneId, string) -- whether the name of the zone fits a
+         *                 free string. Only asked for a player whose name and guild do not.
+         * @return The number listed.
+         */
+        template <typename AreaFits, typename Visit>
+        uint32 Who(WhoQuery const& query, AreaFits&& areaFits, Visit&& visit) const
+        {
+            std::shared_lock<std::shared_mutex> guard(m_lock);
+
+            uint32 listed = 0;
+            auto offer = [&](uint32 row) -> bool
+            {
+                Row const& r = m_rows[row];
+                if (Matches(r, query, areaFits) && visit(r.entry))
+                {
+                    ++listed;
+                }
+                return listed >= query.limit;
+            };
+
+            if (query.limit == 0)
+            {
+                return 0;
+            }
+
+            if (!query.zones.empty())
+            {
+                for (size_t i = 0; i < query.zones.size(); ++i)
+                {
+                    if (std::find(query.zones.begin(), query.zones.begin() + i, query.zones[i]) != query.zones.begin() + i)
+                    {
+                        continue;                           // a zone asked for twice
+                    }
+
+                    ZoneIndex::const_iterator bucket = m_byZone.find(query.zones[i]);
+                    if (bucket == m_byZone.end())
+                    {
+                        continue;
+                    }
+                    for (uint32 row : bucket->second)
+                    {
+                        if (offer(row))
+                        {
+                            return listed;
+                        }
+                    }
+                }
+                return listed;
+            }
+
+            if (!query.name.empty())
+            {
+                for (NameIndex::const_iterator itr = m_byName.lower_bound(query.name);
+                     itr != m_byName.end() && itr->first.compare(0, query.name.size(), query.name) == 0; ++itr)
+                {
+                    if (offer(itr->second))
+                    {
+                        return listed;
+                    }
+                }
+            }
+
+            uint32 const top = query.levelMax < MAX_INDEXED_LEVEL ? query.levelMax : MAX_INDEXED_LEVEL;
+            for (uint32 level = query.levelMin; level <= top; ++level)
+            {
+                for (uint32 row : m_byLevel[level])
+                {
+                    if (!query.name.empty() && m_rows[row].lowerName.compare(0, query.name.size(), query.name) == 0)
+                    {
+                        continue;                           // offered from the name index already
+                    }
+                    if (offer(row))
+                    {
+                        return listed;
+                    }
+                }
+            }
+            return listed;
+        }
+
+    private:
+
+        static const uint32 MAX_INDEXED_LEVEL = 255;
+
+        struct Row
+        {
+            Entry entry;
+            std::wstring lowerName;
+            std::wstring lowerGuildName;
+        };
+
+        typedef std::multimap<std::wstring, uint32> NameIndex;
+        typedef std::unordered_map<uint32, std::vector<uint32> > ZoneIndex;
+
+        template <typename AreaFits>
+        static bool Matches(Row const& r, WhoQuery const& query, AreaFits& areaFits)
+        {
+            Entry const& e = r.entry;
+            if (e.level < query.levelMin || e.level > query.levelMax)
+            {
+                return false;
+            }
+            if (!(query.classMask & (1 << e.classId)) || !(query.raceMask & (1 << e.race)))
+            {
+                return false;
+            }
+            if (query.team && e.team != query.team)
+            {
+                return false;
+            }
+            if (!query.zones.empty() && std::find(query.zones.begin(), query.zones.end(), e.zone) == query.zones.end())
+            {
+                return false;
+            }
+            if (!query.name.empty() && r.lowerName.find(query.name) == std::wstring::npos)
+            {
+                return false;
+            }
+            if (!query.guild.empty() && r.lowerGuildName.find(query.guild) == std::wstring::npos)
+            {
+                return false;
+            }
+
+            bool anyString = false;
+            for (std::wstring const& s : query.strings)
+            {
+                if (s.empty())
+                {
+                    continue;
+                }
+                if (r.lowerName.find(s) != std::wstring::npos ||
+                    r.lowerGuildName.find(s) != std::wstring::npos ||
+                    areaFits(e.zone, s))
+                {
+                    return true;
+                }
+                anyString = true;
+            }
+            return !anyString;
+        }
+
+        static std::wstring Lowered(std::string const& utf8);
+
+        /// Take @p row out of @p bucket.
+        static void Unlink(std::vector<uint32>& bucket, uint32 row);
+
+        void UnlinkName(uint32 row);
+        static uint32 LevelSlot(uint32 level) { return level < MAX_INDEXED_LEVEL ? level : MAX_INDEXED_LEVEL; }
+
+        /// The row of @p guid, or -1. The lock must be held.
+        int32 RowOf(ObjectGuid guid) const;
+
+        mutable std::shared_mutex m_lock;
+        std::vector<Row> m_rows;
+        std::vector<uint32> m_freeRows;
+        std::unordered_map<ObjectGuid, uint32> m_rowOf;
+        NameIndex m_byName;                         ///< lowered name -> row
+        ZoneIndex m_byZone;                         ///< zone -> rows
+        std::vector<uint32> m_byLevel[MAX_INDEXED_LEVEL + 1];
+};
+
+#endif
@@ -2861,25 +2861,25 @@ bool Player::HasQuestForGO(int32 GOId) const
  */
 void Player::UpdateForQuestWorldObjects()
 {
-    if (m_clientGUIDs.empty())
+    if (m_clientGUIDs.Empty())
     {
         return;
     }
 
     UpdateData udata;
     WorldPacket packet;
-    for (GuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (ObjectGuid guid : m_clientGUIDs)
     {
-        if (itr->IsGameObject())
+        if (guid.IsGameObject())
         {
-            if (GameObject* obj = GetMap()->GetGameObject(*itr))
+            if (GameObject* obj = GetMap()->GetGameObject(guid))
             {
                 obj->BuildValuesUpdateBlockForPlayer(&udata, this);
             }
         }
-        else if (itr->IsCreatureOrVehicle())
+        else if (guid.IsCreatureOrVehicle())
         {
-            Creature* obj = GetMap()->GetAnyTypeCreature(*itr);
+            Creature* obj = GetMap()->GetAnyTypeCreature(guid);
             if (!obj)
             {
                 continue;
@@ -26,11 +26,10 @@
 #include "PlayerRegistry.h"
 
 #include "Player.h"
+#include "GuildMgr.h"
 #include "World.h"
 #include "WorldSession.h"
 
-#include <cstring>
-
 
 Player* PlayerRegistry::Find(ObjectGuid guid, bool inWorld /* = true */) const
 {
@@ -60,12 +59,8 @@ Player* PlayerRegistry::FindByName(const char* name) const
         return nullptr;
     }
 
-    // Genuinely linear: names are not indexed. Callers are commands, mail and
-    // trade, none of them hot.
-    return m_players.FindWith([name](const ObjectGuid&, Player* player) -> bool
-    {
-        return player->IsInWorld() && std::strcmp(name, player->GetName()) == 0;
-    });
+    ObjectGuid guid = m_directory.FindByName(name);
+    return guid.IsEmpty() ? nullptr : Find(guid);
 }
 
 void PlayerRegistry::Kick(ObjectGuid guid) const
@@ -99,9 +94,26 @@ void PlayerRegistry::SaveAll() const
 void PlayerRegistry::Add(Player* player)
 {
     m_players.Insert(player->GetObjectGuid(), player);
+
+    PlayerDirectory::Entry entry;
+    entry.guid = player->GetObjectGuid();
+    entry.name = player->GetName();
+    entry.guildId = player->GetGuildId();
+    if (entry.guildId)
+    {
+        entry.guildName = sGuildMgr.GetGuildNameById(entry.guildId);
+    }
+    entry.level = player->getLevel();
+    entry.zone = player->GetCachedZoneId();             // 0 until the first UpdateZone(), which refiles it
+    entry.team = player->GetTeam();
+    entry.race = player->getRace();
+    entry.classId = player->getClass();
+    entry.gender = player->getGender();
+    m_directory.Insert(entry);
 }
 
 void PlayerRegistry::Remove(Player* player)
 {
+    m_directory.Remove(player->GetObjectGuid());
     m_players.Remove(player->GetObjectGuid());
 }
@@ -28,6 +28,7 @@
 
 #include <utility>
 #include "ObjectGuid.h"
+#include "PlayerDirectory.h"
 #include "Policies/Singleton.h"
 #include "Utilities/ConcurrentRegistry.h"
 
@@ -44,6 +45,9 @@ class Player;
  * The index is held by composition rather than inheritance, which is what closes
  * the hazard in the old HashMapHolder/Player2Corpse pair: with no virtual
  * functions anywhere, the derived Insert/Remove only hid the base ones.
+ *
+ * Alongside the GUID index it keeps a PlayerDirectory, filed and dropped with
+ * it, for the lookups a GUID cannot answer: by name, and for /who.
  */
 class PlayerRegistry : public MaNGOS::Singleton<PlayerRegistry>
 {
@@ -60,7 +64,7 @@ class PlayerRegistry : public MaNGOS::Singleton<PlayerRegistry>
          */
         Player* Find(ObjectGuid guid, bool inWorld = true) const;
 
-        /// Find by exact name. Linear; callers are rare (commands, mail, trade).
+        /// Find by exact name, through the directory's name index.
         Player* FindByName(const char* name) const;
 
         /// Disconnect a player by GUID, if online.
@@ -81,12 +85,17 @@ class PlayerRegistry : public MaNGOS::Singleton<PlayerRegistry>
 
         size_t Count() const { return m_players.Size(); }
 
+        /// Names, zones and levels of everyone online. Player keeps its row current.
+        PlayerDirectory& Directory() { return m_directory; }
+        PlayerDirectory const& Directory() const { return m_directory; }
+
     private:
 
         PlayerRegistry() = default;
         ~PlayerRegistry() = default;
 
         MaNGOS::ConcurrentRegistry<ObjectGuid, Player> m_players;
+        PlayerDirectory m_directory;
 };
 
 #define sPlayerRegistry MaNGOS::Singleton<PlayerRegistry>::Instance()
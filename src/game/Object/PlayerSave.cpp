@@ -36,6 +36,7 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <atomic>
 #include "Utilities/PackedValues.h"
 #include "Common/TimeConstants.h"
 #include "Utilities/MathDefines.h"
@@ -113,6 +114,40 @@
 /***                   SAVE SYSTEM                     ***/
 /*********************************************************/
 
+// Saves run on every map thread at once, hence the atomics.
+static std::atomic<uint64> s_saveCount(0);
+static std::atomic<uint64> s_saveStatements(0);
+static std::atomic<uint32> s_saveMaxStatements(0);
+
+/// Add one save that issued @p statements writes to the counters.
+static void CountSave(uint32 statements)
+{
+    ++s_saveCount;
+    s_saveStatements += statements;
+
+    uint32 peak = s_saveMaxStatements.load(std::memory_order_relaxed);
+    while (statements > peak && !s_saveMaxStatements.compare_exchange_weak(peak, statements, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Character saves since start: how many, and how many statements they wrote.
+ *
+ * Statements are what Player::SaveToDB itself queues -- the characters row, the tables
+ * that changed, the stats row -- not the pet's save. Each one writes at most one row,
+ * except the whole-table deletes of a session's first save.
+ *
+ * @param stats filled with the counters
+ * @param resetPeak start a new window for maxStatements
+ */
+void Player::GetSaveStats(PlayerSaveStats& stats, bool resetPeak)
+{
+    stats.saves = s_saveCount;
+    stats.statements = s_saveStatements;
+    stats.maxStatements = resetPeak ? s_saveMaxStatements.exchange(0) : uint32(s_saveMaxStatements);
+}
+
 void Player::SaveToDB()
 {
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
@@ -126,6 +161,10 @@ void Player::SaveToDB()
         return;
     }
 
+    // Everything below writes only this character's rows, so it may run on this
+    // character's async connection, alongside other characters' saves.
+    Database::AsyncKeyScope asyncKey(CharacterDatabase, GetGUIDLow());
+
     // first save/honor gain after midnight will also update the player's honor fields
     UpdateHonorFields();
 
@@ -363,15 +402,18 @@ void Player::SaveToDB()
     _SaveGlyphs();
     _SaveTalents();
 
+    uint32 statements = CharacterDatabase.GetTransactionSize();
     CharacterDatabase.CommitTransaction();
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
-    if (m_session->isLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT))
+    if ((m_session->isLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT)) && _SaveStats())
     {
-        _SaveStats();
+        statements += 2;
     }
 
+    CountSave(statements);
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
     {
@@ -456,28 +498,44 @@ void Player::_SaveActions()
     }
 }
 
+/// Bind the non-key columns of a `character_aura` row, in table order.
+static void BindAuraRow(SqlStatement& stmt, SavedAuraRow const& row)
+{
+    stmt.addUInt32(row.stackCount);
+    stmt.addUInt8(uint8(row.charges));
+
+    for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+    {
+        stmt.addInt32(row.damage[i]);
+    }
+
+    for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+    {
+        stmt.addUInt32(row.periodicTime[i]);
+    }
+
+    stmt.addInt32(row.maxDuration);
+    stmt.addInt32(row.duration);
+    stmt.addUInt32(row.effIndexMask);
+}
+
 /**
  * @brief Saves eligible active aura state to the database.
+ *
+ * Writes only the rows that differ from what the last save wrote. Timed auras still
+ * change every save, as their remaining time runs down; permanent ones, and a player
+ * with nothing to save, cost nothing.
  */
 void Player::_SaveAuras()
 {
     static SqlStatementID deleteAuras ;
+    static SqlStatementID deleteAura ;
     static SqlStatementID insertAuras ;
+    static SqlStatementID updateAura ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
-    stmt.PExecute(GetGUIDLow());
-
+    SavedAuraRows rows;
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
 
-    if (auraHolders.empty())
-    {
-        return;
-    }
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
-            "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
     for (SpellAuraHolderMap::const_iterator itr = auraHolders.begin(); itr != auraHolders.end(); ++itr)
     {
         SpellAuraHolder* holder = itr->second;
@@ -488,15 +546,11 @@ void Player::_SaveAuras()
         if (!holder->IsPassive() && !IsChanneledSpell(holder->GetSpellProto()) &&
            (trackedType == TRACK_AURA_TYPE_NOT_TRACKED || (trackedType == TRACK_AURA_TYPE_SINGLE_TARGET && selfCastHolder)))
         {
-            int32  damage[MAX_EFFECT_INDEX];
-            uint32 periodicTime[MAX_EFFECT_INDEX];
-            uint32 effIndexMask = 0;
+            SavedAuraRow row;
+            memset(&row, 0, sizeof(row));
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                damage[i] = 0;
-                periodicTime[i] = 0;
-
                 if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
                 {
                     // don't save not own area auras
@@ -505,40 +559,89 @@ void Player::_SaveAuras()
                         continue;
                     }
 
-                    damage[i] = aur->GetModifier()->m_amount;
-                    periodicTime[i] = aur->GetModifier()->periodictime;
-                    effIndexMask |= (1 << i);
+                    row.damage[i] = aur->GetModifier()->m_amount;
+                    row.periodicTime[i] = aur->GetModifier()->periodictime;
+                    row.effIndexMask |= (1 << i);
                 }
             }
 
-            if (!effIndexMask)
+            if (!row.effIndexMask)
             {
                 continue;
             }
 
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
+            row.stackCount = holder->GetStackAmount();
+            row.charges = holder->GetAuraCharges();
+            row.maxDuration = holder->GetAuraMaxDuration();
+            row.duration = holder->GetAuraDuration();
 
-            for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                stmt.addInt32(damage[i]);
-            }
+            SavedAuraKey key;
+            key.casterGuid = holder->GetCasterGuid().GetRawValue();
+            key.itemGuid = holder->GetCastItemGuid().GetCounter();
+            key.spellId = holder->GetId();
+            rows[key] = row;
+        }
+    }
 
-            for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                stmt.addUInt32(periodicTime[i]);
-            }
+    // The table holds whatever the last session left until this session first writes it.
+    if (!m_savedAurasKnown)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
+        stmt.PExecute(GetGUIDLow());
+        m_savedAuras.clear();
+        m_savedAurasKnown = true;
+    }
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
+    for (SavedAuraRows::const_iterator itr = m_savedAuras.begin(); itr != m_savedAuras.end(); ++itr)
+    {
+        if (rows.find(itr->first) == rows.end())
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAura, "DELETE FROM `character_aura` WHERE `guid` = ? AND `caster_guid` = ? AND `item_guid` = ? AND `spell` = ?");
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt64(itr->first.casterGuid);
+            stmt.addUInt32(itr->first.itemGuid);
+            stmt.addUInt32(itr->first.spellId);
+            stmt.Execute();
+        }
+    }
+
+    for (SavedAuraRows::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+    {
+        SavedAuraRows::const_iterator saved = m_savedAuras.find(itr->first);
+        if (saved == m_savedAuras.end())
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
+                    "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) "
+                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt64(itr->first.casterGuid);
+            stmt.addUInt32(itr->first.itemGuid);
+            stmt.addUInt32(itr->first.spellId);
+            BindAuraRow(stmt, itr->second);
             stmt.Execute();
         }
     }
+
+    // updates after the inserts, so each is one run (see SqlStatementBatch)
+    for (SavedAuraRows::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+    {
+        SavedAuraRows::const_iterator saved = m_savedAuras.find(itr->first);
+        if (saved != m_savedAuras.end() && saved->second != itr->second)
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updateAura, "UPDATE `character_aura` SET `stackcount` = ?, `remaincharges` = ?, "
+                    "`basepoints0` = ?, `basepoints1` = ?, `basepoints2` = ?, `periodictime0` = ?, `periodictime1` = ?, `periodictime2` = ?, "
+                    "`maxduration` = ?, `remaintime` = ?, `effIndexMask` = ? "
+                    "WHERE `guid` = ? AND `caster_guid` = ? AND `item_guid` = ? AND `spell` = ?");
+            BindAuraRow(stmt, itr->second);
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt64(itr->first.casterGuid);
+            stmt.addUInt32(itr->first.itemGuid);
+            stmt.addUInt32(itr->first.spellId);
+            stmt.Execute();
+        }
+    }
+
+    m_savedAuras.swap(rows);
 }
 
 /**
@@ -752,58 +855,62 @@ void Player::_SaveQuestStatus()
     static SqlStatementID updateQuestStatus ;
 
     // we don't need transactions here.
+    // New rows first, as one run of inserts a transaction sends as one statement; then the updates.
     for (QuestStatusMap::iterator i = mQuestStatus.begin(); i != mQuestStatus.end(); ++i)
     {
         QuestStatusData &questStatus = i->second;
-        switch (questStatus.uState)
+        if (questStatus.uState != QUEST_NEW)
         {
-            case QUEST_NEW :
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(insertQuestStatus, "INSERT INTO `character_queststatus` (`guid`,`quest`,`status`,`rewarded`,`explored`,`timer`,`mobcount1`,`mobcount2`,`mobcount3`,`mobcount4`,`itemcount1`,`itemcount2`,`itemcount3`,`itemcount4`,`itemcount5`,`itemcount6`) "
-                                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+            continue;
+        }
 
-                stmt.addUInt32(GetGUIDLow());
-                stmt.addUInt32(i->first);
-                stmt.addUInt8(questStatus.m_status);
-                stmt.addUInt8(questStatus.m_rewarded);
-                stmt.addUInt8(questStatus.m_explored);
-                stmt.addUInt64(uint64(questStatus.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()));
-                for (int k = 0; k < QUEST_OBJECTIVES_COUNT; ++k)
-                {
-                    stmt.addUInt32(questStatus.m_creatureOrGOcount[k]);
-                }
-                for (int k = 0; k < QUEST_ITEM_OBJECTIVES_COUNT; ++k)
-                {
-                    stmt.addUInt32(questStatus.m_itemcount[k]);
-                }
-                stmt.Execute();
-            }
-            break;
-            case QUEST_CHANGED :
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(updateQuestStatus, "UPDATE `character_queststatus` SET `status` = ?,`rewarded` = ?,`explored` = ?,`timer` = ?,"
-                                    "`mobcount1` = ?,`mobcount2` = ?,`mobcount3` = ?,`mobcount4` = ?,`itemcount1` = ?,`itemcount2` = ?,`itemcount3` = ?,`itemcount4` = ?,`itemcount5` = ?,`itemcount6` = ? WHERE `guid` = ? AND `quest` = ?");
-
-                stmt.addUInt8(questStatus.m_status);
-                stmt.addUInt8(questStatus.m_rewarded);
-                stmt.addUInt8(questStatus.m_explored);
-                stmt.addUInt64(uint64(questStatus.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()));
-                for (int k = 0; k < QUEST_OBJECTIVES_COUNT; ++k)
-                {
-                    stmt.addUInt32(questStatus.m_creatureOrGOcount[k]);
-                }
-                for (int k = 0; k < QUEST_ITEM_OBJECTIVES_COUNT; ++k)
-                {
-                    stmt.addUInt32(questStatus.m_itemcount[k]);
-                }
-                stmt.addUInt32(GetGUIDLow());
-                stmt.addUInt32(i->first);
-                stmt.Execute();
-            }
-            break;
-            case QUEST_UNCHANGED:
-                break;
-        };
+        SqlStatement stmt = CharacterDatabase.CreateStatement(insertQuestStatus, "INSERT INTO `character_queststatus` (`guid`,`quest`,`status`,`rewarded`,`explored`,`timer`,`mobcount1`,`mobcount2`,`mobcount3`,`mobcount4`,`itemcount1`,`itemcount2`,`itemcount3`,`itemcount4`,`itemcount5`,`itemcount6`) "
+                            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(i->first);
+        stmt.addUInt8(questStatus.m_status);
+        stmt.addUInt8(questStatus.m_rewarded);
+        stmt.addUInt8(questStatus.m_explored);
+        stmt.addUInt64(uint64(questStatus.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()));
+        for (int k = 0; k < QUEST_OBJECTIVES_COUNT; ++k)
+        {
+            stmt.addUInt32(questStatus.m_creatureOrGOcount[k]);
+        }
+        for (int k = 0; k < QUEST_ITEM_OBJECTIVES_COUNT; ++k)
+        {
+            stmt.addUInt32(questStatus.m_itemcount[k]);
+        }
+        stmt.Execute();
+        questStatus.uState = QUEST_UNCHANGED;
+    }
+
+    for (QuestStatusMap::iterator i = mQuestStatus.begin(); i != mQuestStatus.end(); ++i)
+    {
+        QuestStatusData &questStatus = i->second;
+        if (questStatus.uState != QUEST_CHANGED)
+        {
+            continue;
+        }
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updateQuestStatus, "UPDATE `character_queststatus` SET `status` = ?,`rewarded` = ?,`explored` = ?,`timer` = ?,"
+                            "`mobcount1` = ?,`mobcount2` = ?,`mobcount3` = ?,`mobcount4` = ?,`itemcount1` = ?,`itemcount2` = ?,`itemcount3` = ?,`itemcount4` = ?,`itemcount5` = ?,`itemcount6` = ? WHERE `guid` = ? AND `quest` = ?");
+
+        stmt.addUInt8(questStatus.m_status);
+        stmt.addUInt8(questStatus.m_rewarded);
+        stmt.addUInt8(questStatus.m_explored);
+        stmt.addUInt64(uint64(questStatus.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()));
+        for (int k = 0; k < QUEST_OBJECTIVES_COUNT; ++k)
+        {
+            stmt.addUInt32(questStatus.m_creatureOrGOcount[k]);
+        }
+        for (int k = 0; k < QUEST_ITEM_OBJECTIVES_COUNT; ++k)
+        {
+            stmt.addUInt32(questStatus.m_itemcount[k]);
+        }
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(i->first);
+        stmt.Execute();
         questStatus.uState = QUEST_UNCHANGED;
     }
 }
@@ -951,22 +1058,24 @@ void Player::_SaveSpells()
     SqlStatement stmtDel = CharacterDatabase.CreateStatement(delSpells, "DELETE FROM `character_spell` WHERE `guid` = ? and `spell` = ?");
     SqlStatement stmtIns = CharacterDatabase.CreateStatement(insSpells, "INSERT INTO `character_spell` (`guid`,`spell`,`active`,`disabled`) VALUES (?, ?, ?, ?)");
 
-    for (PlayerSpellMap::iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end();)
+    // All the deletes, then all the inserts: each spell is its own row, so the order
+    // between spells does not matter, and two runs of one statement go out as two
+    // multi-row statements (see SqlStatementBatch).
+    for (PlayerSpellMap::const_iterator itr = m_spells.begin(); itr != m_spells.end(); ++itr)
     {
-        uint32 talentCosts = GetTalentSpellCost(itr->first);
-
-        if (!talentCosts)
+        if ((itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED) && !GetTalentSpellCost(itr->first))
         {
-            if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
-            {
-                stmtDel.PExecute(GetGUIDLow(), itr->first);
-            }
+            stmtDel.PExecute(GetGUIDLow(), itr->first);
+        }
+    }
 
-            // add only changed/new not dependent spells
-            if (!itr->second.dependent && (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED))
-            {
-                stmtIns.PExecute(GetGUIDLow(), itr->first, uint8(itr->second.active ? 1 : 0), uint8(itr->second.disabled ? 1 : 0));
-            }
+    for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
+    {
+        // add only changed/new not dependent spells
+        if (!itr->second.dependent && (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED) &&
+            !GetTalentSpellCost(itr->first))
+        {
+            stmtIns.PExecute(GetGUIDLow(), itr->first, uint8(itr->second.active ? 1 : 0), uint8(itr->second.disabled ? 1 : 0));
         }
 
         if (itr->second.state == PLAYERSPELL_REMOVED)
@@ -989,15 +1098,22 @@ void Player::_SaveTalents()
     SqlStatement stmtDel = CharacterDatabase.CreateStatement(delTalents, "DELETE FROM `character_talent` WHERE `guid` = ? and `talent_id` = ? and `spec` = ?");
     SqlStatement stmtIns = CharacterDatabase.CreateStatement(insTalents, "INSERT INTO `character_talent` (`guid`, `talent_id`, `current_rank`, `spec`) VALUES (?, ?, ?, ?)");
 
+    // deletes first, then inserts, as in _SaveSpells
     for (uint32 i = 0; i < MAX_TALENT_SPEC_COUNT; ++i)
     {
-        for (PlayerTalentMap::iterator itr = m_talents[i].begin(); itr != m_talents[i].end();)
+        for (PlayerTalentMap::const_iterator itr = m_talents[i].begin(); itr != m_talents[i].end(); ++itr)
         {
             if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
             {
                 stmtDel.PExecute(GetGUIDLow(), itr->first, i);
             }
+        }
+    }
 
+    for (uint32 i = 0; i < MAX_TALENT_SPEC_COUNT; ++i)
+    {
+        for (PlayerTalentMap::iterator itr = m_talents[i].begin(); itr != m_talents[i].end();)
+        {
             // add only changed/new talents
             if (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED)
             {
@@ -1019,12 +1135,44 @@ void Player::_SaveTalents()
 
 // save player stats -- only for external usage
 // real stats will be recalculated on player login
-void Player::_SaveStats()
+// the row moves with gear, talents and level, not with every save: unchanged, it is not written
+bool Player::_SaveStats()
 {
     // check if stat saving is enabled and if char level is high enough
     if (!sWorld.getConfig(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE) || getLevel() < sWorld.getConfig(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE))
     {
-        return;
+        return false;
+    }
+
+    SavedStatsRow row;
+    memset(&row, 0, sizeof(row));
+    row.maxHealth = GetMaxHealth();
+    for (int i = 0; i < MAX_POWERS; ++i)
+    {
+        row.maxPower[i] = GetMaxPower(Powers(i));
+    }
+    for (int i = 0; i < MAX_STATS; ++i)
+    {
+        row.stat[i] = GetStat(Stats(i));
+    }
+    // armor + school resistances
+    for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
+    {
+        row.resistance[i] = GetResistance(SpellSchools(i));
+    }
+    row.blockPct = GetFloatValue(PLAYER_BLOCK_PERCENTAGE);
+    row.dodgePct = GetFloatValue(PLAYER_DODGE_PERCENTAGE);
+    row.parryPct = GetFloatValue(PLAYER_PARRY_PERCENTAGE);
+    row.critPct = GetFloatValue(PLAYER_CRIT_PERCENTAGE);
+    row.rangedCritPct = GetFloatValue(PLAYER_RANGED_CRIT_PERCENTAGE);
+    row.spellCritPct = GetFloatValue(PLAYER_SPELL_CRIT_PERCENTAGE1);
+    row.attackPower = GetUInt32Value(UNIT_FIELD_ATTACK_POWER);
+    row.rangedAttackPower = GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER);
+    row.spellPower = GetBaseSpellPowerBonus();
+
+    if (m_savedStatsKnown && row == m_savedStats)
+    {
+        return false;
     }
 
     static SqlStatementID delStats ;
@@ -1039,31 +1187,34 @@ void Player::_SaveStats()
             "VALUES ( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
     stmt.addUInt32(GetGUIDLow());
-    stmt.addUInt32(GetMaxHealth());
+    stmt.addUInt32(row.maxHealth);
     for (int i = 0; i < MAX_POWERS; ++i)
     {
-        stmt.addUInt32(GetMaxPower(Powers(i)));
+        stmt.addUInt32(row.maxPower[i]);
     }
     for (int i = 0; i < MAX_STATS; ++i)
     {
-        stmt.addFloat(GetStat(Stats(i)));
+        stmt.addFloat(row.stat[i]);
     }
-    // armor + school resistances
     for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
     {
-        stmt.addUInt32(GetResistance(SpellSchools(i)));
+        stmt.addUInt32(row.resistance[i]);
     }
-    stmt.addFloat(GetFloatValue(PLAYER_BLOCK_PERCENTAGE));
-    stmt.addFloat(GetFloatValue(PLAYER_DODGE_PERCENTAGE));
-    stmt.addFloat(GetFloatValue(PLAYER_PARRY_PERCENTAGE));
-    stmt.addFloat(GetFloatValue(PLAYER_CRIT_PERCENTAGE));
-    stmt.addFloat(GetFloatValue(PLAYER_RANGED_CRIT_PERCENTAGE));
-    stmt.addFloat(GetFloatValue(PLAYER_SPELL_CRIT_PERCENTAGE1));
-    stmt.addUInt32(GetUInt32Value(UNIT_FIELD_ATTACK_POWER));
-    stmt.addUInt32(GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER));
-    stmt.addUInt32(GetBaseSpellPowerBonus());
+    stmt.addFloat(row.blockPct);
+    stmt.addFloat(row.dodgePct);
+    stmt.addFloat(row.parryPct);
+    stmt.addFloat(row.critPct);
+    stmt.addFloat(row.rangedCritPct);
+    stmt.addFloat(row.spellCritPct);
+    stmt.addUInt32(row.attackPower);
+    stmt.addUInt32(row.rangedAttackPower);
+    stmt.addUInt32(row.spellPower);
 
     stmt.Execute();
+
+    m_savedStats = row;
+    m_savedStatsKnown = true;
+    return true;
 }
 
 /**
@@ -2068,7 +2219,7 @@ void Player::HandleStealthedUnitsDetection()
             {
                 ObjectGuid i_guid = (*i)->GetObjectGuid();
                 (*i)->SendCreateUpdateToPlayer(this);
-                m_clientGUIDs.insert(i_guid);
+                m_clientGUIDs.Insert(i_guid);
 
                 DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is detected in stealth by player %u. Distance = %f", i_guid.GetString().c_str(), GetGUIDLow(), Where().DistanceTo((*i)->Where()));
 
@@ -2085,7 +2236,7 @@ void Player::HandleStealthedUnitsDetection()
             if (hasAtClient)
             {
                 (*i)->DestroyForPlayer(this);
-                m_clientGUIDs.erase((*i)->GetObjectGuid());
+                m_clientGUIDs.Erase((*i)->GetObjectGuid());
             }
         }
     }
@@ -58,6 +58,7 @@
 #include "Group.h"
 #include "Guild.h"
 #include "GuildMgr.h"
+#include "PlayerRegistry.h"
 #include "Pet.h"
 #include "Util.h"
 #include "Transports.h"
@@ -288,6 +289,7 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
         // handle outdoor pvp zones
         sOutdoorPvPMgr.HandlePlayerLeaveZone(this, m_zoneUpdateId);
         sOutdoorPvPMgr.HandlePlayerEnterZone(this, newZone);
+        sPlayerRegistry.Directory().SetZone(GetObjectGuid(), newZone);
 
         SendInitWorldStates(newZone, newArea);              // only if really enters to new zone, not just area change, works strange...
 
@@ -270,7 +270,15 @@ void SocialMgr::GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo&
         return;
     }
 
-    Player* pFriend = sPlayerRegistry.Find(ObjectGuid(HIGHGUID_PLAYER, friend_lowguid));
+    // The directory's row carries the zone, so a friends list no longer asks the
+    // terrain where each friend stands.
+    ObjectGuid friendGuid(HIGHGUID_PLAYER, friend_lowguid);
+    PlayerDirectory::Presence presence;
+    Player* pFriend = NULL;
+    if (sPlayerRegistry.Directory().FindPresence(friendGuid, presence))
+    {
+        pFriend = sPlayerRegistry.Find(friendGuid);
+    }
 
     Team team = player->GetTeam();
     AccountTypes security = player->GetSession()->GetSecurity();
@@ -287,7 +295,7 @@ void SocialMgr::GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo&
         // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
         if (pFriend && pFriend->GetName() &&
             (security > SEC_PLAYER ||
-             ((pFriend->GetTeam() == team || allowTwoSideWhoList) && (pFriend->GetSession()->GetSecurity() <= gmLevelInWhoList))) &&
+             ((Team(presence.team) == team || allowTwoSideWhoList) && (pFriend->GetSession()->GetSecurity() <= gmLevelInWhoList))) &&
             pFriend->IsVisibleGloballyFor(player))
         {
             friendInfo.Status = FRIEND_STATUS_ONLINE;
@@ -299,9 +307,9 @@ void SocialMgr::GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo&
             {
                 friendInfo.Status = FRIEND_STATUS_DND;
             }
-            friendInfo.Area = pFriend->GetTerrain()->GetZoneId(pFriend->Where().X(), pFriend->Where().Y(), pFriend->Where().Z());
-            friendInfo.Level = pFriend->getLevel();
-            friendInfo.Class = pFriend->getClass();
+            friendInfo.Area = presence.zone;
+            friendInfo.Level = presence.level;
+            friendInfo.Class = presence.classId;
         }
         else
         {
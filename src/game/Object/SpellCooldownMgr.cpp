@@ -274,33 +274,76 @@ void SpellCooldownMgr::LoadFromDB(QueryResult* result)
 
 void SpellCooldownMgr::SaveToDB()
 {
+    static SqlStatementID deleteSpellCooldowns ;
     static SqlStatementID deleteSpellCooldown ;
     static SqlStatementID insertSpellCooldown ;
+    static SqlStatementID updateSpellCooldown ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ?");
-    stmt.PExecute(m_owner->GetGUIDLow());
+    uint32 guid = m_owner->GetGUIDLow();
+
+    // The table holds whatever the last session left until this session first writes it.
+    if (!m_savedKnown)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldowns, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ?");
+        stmt.PExecute(guid);
+        m_saved.clear();
+        m_savedKnown = true;
+    }
 
     time_t curTime = time(NULL);
     time_t infTime = curTime + Player::infinityCooldownDelayCheck;
 
-    // remove outdated and save active
+    // remove outdated
     for (SpellCooldowns::iterator itr = m_cooldowns.begin(); itr != m_cooldowns.end();)
     {
         if (itr->second.end <= curTime)
         {
             m_cooldowns.erase(itr++);
         }
-        else if (itr->second.end <= infTime)                // not save locked cooldowns, it will be reset or set at reload
+        else
         {
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO `character_spell_cooldown` (`guid`,`spell`,`item`,`time`) VALUES( ?, ?, ?, ?)");
-            stmt.PExecute(m_owner->GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end));
             ++itr;
         }
+    }
+
+    // drop rows for cooldowns that ended, or became locked ones (not saved, reset or set at reload)
+    for (SpellCooldowns::iterator itr = m_saved.begin(); itr != m_saved.end();)
+    {
+        SpellCooldowns::const_iterator current = m_cooldowns.find(itr->first);
+        if (current == m_cooldowns.end() || current->second.end > infTime)
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ? AND `spell` = ?");
+            stmt.PExecute(guid, itr->first);
+            m_saved.erase(itr++);
+        }
         else
         {
             ++itr;
         }
     }
+
+    // and write the ones that started or restarted
+    for (SpellCooldowns::const_iterator itr = m_cooldowns.begin(); itr != m_cooldowns.end(); ++itr)
+    {
+        if (itr->second.end > infTime)
+        {
+            continue;
+        }
+
+        SpellCooldowns::iterator saved = m_saved.find(itr->first);
+        if (saved == m_saved.end())
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO `character_spell_cooldown` (`guid`,`spell`,`item`,`time`) VALUES( ?, ?, ?, ?)");
+            stmt.PExecute(guid, itr->first, uint32(itr->second.itemid), uint64(itr->second.end));
+            m_saved[itr->first] = itr->second;
+        }
+        else if (saved->second.end != itr->second.end || saved->second.itemid != itr->second.itemid)
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updateSpellCooldown, "UPDATE `character_spell_cooldown` SET `item` = ?, `time` = ? WHERE `guid` = ? AND `spell` = ?");
+            stmt.PExecute(uint32(itr->second.itemid), uint64(itr->second.end), guid, itr->first);
+            saved->second = itr->second;
+        }
+    }
 }
 
 void SpellCooldownMgr::UpdatePotionCooldown(Spell* spell)
@@ -50,12 +50,13 @@ typedef std::map<uint32, SpellCooldown> SpellCooldowns;
  * @brief Owns a player's active spell-cooldown map and the operations on it.
  *
  * Held by value on Player as m_spellCooldownMgr with a Player* back-pointer.
- * Persisted to character_spell_cooldown via LoadFromDB()/SaveToDB().
+ * Persisted to character_spell_cooldown via LoadFromDB()/SaveToDB(); a save writes only
+ * the cooldowns that started, changed or ended since the one before.
  */
 class SpellCooldownMgr
 {
     public:
-        explicit SpellCooldownMgr(Player* owner) : m_owner(owner) {}
+        explicit SpellCooldownMgr(Player* owner) : m_owner(owner), m_savedKnown(false) {}
 
         SpellCooldowns const& GetSpellCooldownMap() const { return m_cooldowns; }
 
@@ -86,6 +87,8 @@ class SpellCooldownMgr
     private:
         Player* m_owner;
         SpellCooldowns m_cooldowns;
+        SpellCooldowns m_saved;             ///< the rows the last SaveToDB() left in the table
+        bool m_savedKnown;                  ///< false until the first SaveToDB(), which rewrites them all
 };
 
 #endif
@@ -267,7 +267,7 @@ Unit::Unit() :
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
-    m_AINotifyScheduled = false;
+    m_AINotifyEvent = NULL;
 
     m_detectInvisibilityMask = 0;
     m_invisibilityMask = 0;
@@ -5663,6 +5663,10 @@ void Unit::InterruptMoving(bool forceSendStop /*=false*/)
         // written from the movement state -- so it follows the placement whenever the
         // server is the one that moved the unit.
         m_movementInfo.Report(loc.x, loc.y, loc.z, loc.orientation);
+        if (IsInWorld())
+        {
+            GetMap()->UpdateGridPosition(this);             // moved without the map
+        }
         isMoving = true;
     }
 
@@ -5897,19 +5901,7 @@ Unit* Unit::SelectRandomUnfriendlyTarget(Unit* except /*= NULL*/, float radius /
     }
 
     // remove not LoS targets
-    for (std::list<Unit*>::iterator tIter = targets.begin(); tIter != targets.end();)
-    {
-        if (!HasLineOfSight(*this, *(*tIter)))
-        {
-            std::list<Unit*>::iterator tIter2 = tIter;
-            ++tIter;
-            targets.erase(tIter2);
-        }
-        else
-        {
-            ++tIter;
-        }
-    }
+    KeepInLineOfSight(*this, targets);
 
     // no appropriate targets
     if (targets.empty())
@@ -5951,19 +5943,7 @@ Unit* Unit::SelectRandomFriendlyTarget(Unit* except /*= NULL*/, float radius /*=
     }
 
     // remove not LoS targets
-    for (std::list<Unit*>::iterator tIter = targets.begin(); tIter != targets.end();)
-    {
-        if (!HasLineOfSight(*this, *(*tIter)))
-        {
-            std::list<Unit*>::iterator tIter2 = tIter;
-            ++tIter;
-            targets.erase(tIter2);
-        }
-        else
-        {
-            ++tIter;
-        }
-    }
+    KeepInLineOfSight(*this, targets);
 
     // no appropriate targets
     if (targets.empty())
@@ -6642,7 +6622,7 @@ class RelocationNotifyEvent : public BasicEvent
     public:
         RelocationNotifyEvent(Unit& owner) : BasicEvent(), m_owner(owner)
         {
-            m_owner._SetAINotifyScheduled(true);
+            m_owner._SetAINotifyEvent(this);
         }
 
         bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
@@ -6658,13 +6638,13 @@ class RelocationNotifyEvent : public BasicEvent
                 MaNGOS::CreatureRelocationNotifier notify((Creature&)m_owner);
                 Cell::VisitAllObjects(&m_owner, notify, radius);
             }
-            m_owner._SetAINotifyScheduled(false);
+            m_owner._SetAINotifyEvent(NULL);
             return true;
         }
 
         void Abort(uint64)
         {
-            m_owner._SetAINotifyScheduled(false);
+            m_owner._SetAINotifyEvent(NULL);
         }
 
     private:
@@ -6674,18 +6654,31 @@ class RelocationNotifyEvent : public BasicEvent
 /**
  * @brief Schedules deferred AI relocation notifications.
  *
+ * A notify already pending at or before the requested time covers this one. One
+ * pending later -- the relocation delay, when the unit has just entered the world or
+ * changed visibility and asks for one now -- is cancelled and scheduled again sooner.
+ *
  * @param delay The delay before the notification event executes.
  */
 void Unit::ScheduleAINotify(uint32 delay)
 {
-    if (!IsAINotifyScheduled())
+    uint64 due = m_Events.CalculateTime(delay);
+    if (m_AINotifyEvent)
     {
-        m_Events.AddEvent(new RelocationNotifyEvent(*this), m_Events.CalculateTime(delay));
+        if (m_AINotifyEvent->m_execTime <= due)
+        {
+            return;
+        }
+        m_Events.CancelEvent(m_AINotifyEvent);              // its Abort clears m_AINotifyEvent
     }
+    m_Events.AddEvent(new RelocationNotifyEvent(*this), due);
 }
 
 /**
  * @brief Handles relocation updates after the unit position changes.
+ *
+ * Past the relocation limit the unit's visibility is redone: by the map's visibility
+ * pass at the end of its tick when Visibility.BatchedPass is on, here otherwise.
  */
 void Unit::OnRelocated()
 {
@@ -6700,8 +6693,15 @@ void Unit::OnRelocated()
         m_last_notified_position.y = Where().Y();
         m_last_notified_position.z = Where().Z();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
-        UpdateObjectVisibility();
+        if (World::GetVisibilityBatchedPass())
+        {
+            GetMap()->AddToVisibilityPass(this);
+        }
+        else
+        {
+            GetViewPoint().Call_UpdateVisibilityForOwner();
+            UpdateObjectVisibility();
+        }
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
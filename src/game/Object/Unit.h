@@ -4013,8 +4013,8 @@ uint32  GetPower(Powers power) const { return GetUInt32Value(UNIT_FIELD_POWER1 +
         Movement::MoveSpline* movespline;
 
         void ScheduleAINotify(uint32 delay);
-        bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
-        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
+        bool IsAINotifyScheduled() const { return m_AINotifyEvent != NULL;}
+        void _SetAINotifyEvent(BasicEvent* event) { m_AINotifyEvent = event;}  // only for call from RelocationNotifyEvent code
         void OnRelocated();
 
         bool IsLinkingEventTrigger() const { return m_isCreatureLinkingTrigger; }
@@ -4100,7 +4100,7 @@ uint32  GetPower(Powers power) const { return GetUInt32Value(UNIT_FIELD_POWER1 +
 
         UnitVisibility m_Visibility;
         Position m_last_notified_position;
-        bool m_AINotifyScheduled;
+        BasicEvent* m_AINotifyEvent;                        // the pending RelocationNotifyEvent, if any
         TimeTracker m_movesplineTimer;
 
         Diminishing m_Diminishing;
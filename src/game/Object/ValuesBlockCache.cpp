@@ -0,0 +1,68 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file ValuesBlockCache.cpp
+ * @brief Implementation of the per-key values block store.
+ */
+
+#include "ValuesBlockCache.h"
+
+bool ValuesViewKey::operator==(ValuesViewKey const& other) const
+{
+    if (self != other.self || count != other.count)
+    {
+        return false;
+    }
+
+    for (uint8 i = 0; i < count; ++i)
+    {
+        if (values[i] != other.values[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8> const* ValuesBlockCache::Find(ValuesViewKey const& key) const
+{
+    for (Entry const& entry : m_entries)
+    {
+        if (entry.key == key)
+        {
+            return &entry.bytes;
+        }
+    }
+    return NULL;
+}
+
+void ValuesBlockCache::Store(ValuesViewKey const& key, uint8 const* bytes, size_t size)
+{
+    m_entries.push_back(Entry());
+    Entry& entry = m_entries.back();
+    entry.key = key;
+    entry.bytes.assign(bytes, bytes + size);
+}
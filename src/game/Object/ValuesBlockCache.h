@@ -0,0 +1,93 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file ValuesBlockCache.h
+ * @brief One object's values block, serialised once per kind of viewer.
+ *
+ * Kept apart from Object.h so that it depends on nothing but bytes: the flush builds
+ * through it, and mangos_bench times it against building per viewer without a map.
+ */
+
+#ifndef MANGOS_VALUES_BLOCK_CACHE_H
+#define MANGOS_VALUES_BLOCK_CACHE_H
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Everything one viewer's values block depends on besides the object itself.
+ *
+ * Two viewers with equal keys are sent byte-identical blocks. The viewer-dependent
+ * fields are few -- npc flags, aura state, unit flags and dynamic flags for a unit,
+ * the dynamic field for a game object -- and what they come out as is what tells the
+ * owner, the loot recipient's group, a GM and everybody else apart.
+ */
+struct ValuesViewKey
+{
+    static const uint32 MAX_FIELDS = 4;
+
+    bool self;                      ///< the viewer is the object: a player's own fields
+    uint8 count;                    ///< viewer-dependent fields in this delta
+    uint32 values[MAX_FIELDS];      ///< what each of them is sent as to this viewer
+
+    bool operator==(ValuesViewKey const& other) const;
+};
+
+/**
+ * @brief The blocks built so far for one object's pending delta, by key.
+ *
+ * Lives for one WorldObject::BuildUpdateData: the delta it serialises is the one
+ * pending at that moment, so it must not outlive ClearUpdateMask(). Building is the
+ * caller's business (Object::BuildValuesUpdateBlockForPlayer); this only remembers
+ * the bytes.
+ */
+class ValuesBlockCache
+{
+    public:
+
+        /// The bytes built for an earlier viewer with @p key, or NULL if there was none.
+        std::vector<uint8> const* Find(ValuesViewKey const& key) const;
+
+        /// Keep @p size bytes at @p bytes as the block for @p key.
+        void Store(ValuesViewKey const& key, uint8 const* bytes, size_t size);
+
+        /// Distinct blocks serialised so far.
+        uint32 Classes() const { return uint32(m_entries.size()); }
+
+    private:
+
+        struct Entry
+        {
+            ValuesViewKey key;
+            std::vector<uint8> bytes;
+        };
+
+        std::vector<Entry> m_entries;
+};
+
+#endif
@@ -30,6 +30,7 @@
  */
 
 #include <cmath>
+#include <memory>
 #include "Utilities/MathDefines.h"
 #include "Object.h"
 #include "SharedDefines.h"
@@ -106,6 +107,22 @@ void WorldObject::_Create(uint32 guidlow, HighGuid guidhigh, uint32 phaseMask)
     m_phaseMask = phaseMask;
 }
 
+/**
+ * @brief Push a freshly computed extent into the placement.
+ *
+ * An object in the world is also a row in its cell's position index, which pads
+ * every search by the extent it was filed with; the row follows.
+ */
+void WorldObject::RefreshBoundingRadius()
+{
+    m_placement.Resize(ComputeBoundingRadius());
+
+    if (IsInWorld())
+    {
+        GetMap()->UpdateGridPosition(this);
+    }
+}
+
 /**
  * @brief Get instance data
  * @return Instance data pointer
@@ -445,6 +462,63 @@ bool HasLineOfSight(WorldObject const& a, WorldObject const& b)
     return HasLineOfSight(a, b.Where().Pos());
 }
 
+void KeepInLineOfSight(WorldObject const& a, std::list<Unit*>& targets)
+{
+    // Aboard, every line goes through the hull's own geometry, one at a time; and a single
+    // target has nothing to be traced with.
+    Map* map = a.GetMap();
+    if (!map || map->AsTransport() || targets.size() < 2)
+    {
+        for (std::list<Unit*>::iterator itr = targets.begin(); itr != targets.end();)
+        {
+            if (HasLineOfSight(a, **itr))
+            {
+                ++itr;
+            }
+            else
+            {
+                itr = targets.erase(itr);
+            }
+        }
+        return;
+    }
+
+    // The batch asks exactly what HasLineOfSight(a, b) would have: the interaction
+    // check first, then the sight line between the two heads.
+    const Geometry::Vector3 eye(a.Where().X(), a.Where().Y(), a.Where().Z() + 2.0f);
+    std::vector<Unit*> batched;
+    std::vector<Geometry::Vector3> from, to;
+    batched.reserve(targets.size());
+    from.reserve(targets.size());
+    to.reserve(targets.size());
+    for (std::list<Unit*>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
+    {
+        if (!CanInteract(a, **itr))
+        {
+            continue;
+        }
+        batched.push_back(*itr);
+        from.push_back(eye);
+        to.push_back(Geometry::Vector3((*itr)->Where().X(), (*itr)->Where().Y(), (*itr)->Where().Z() + 2.0f));
+    }
+
+    targets.clear();
+    if (batched.empty())
+    {
+        return;
+    }
+
+    std::unique_ptr<bool[]> visible(new bool[batched.size()]);
+    map->IsInLineOfSight(&from[0], &to[0], uint32(batched.size()), a.GetPhaseMask(), visible.get());
+    for (size_t i = 0; i < batched.size(); ++i)
+    {
+        if (visible[i])
+        {
+            targets.push_back(batched[i]);
+        }
+    }
+}
+
 bool IsPlaceable(WorldObject const& obj)
 {
     return obj.Where().IsFinite() &&
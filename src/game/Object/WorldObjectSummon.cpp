@@ -580,6 +580,11 @@ void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
 
+    if (IsInWorld())
+    {
+        GetMap()->UpdateGridPosition(this);
+    }
+
     if (update && IsInWorld())
     {
         UpdateVisibilityAndView();
@@ -695,6 +700,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas; ///< Update data map
     WorldObject& i_object; ///< World object
+    ValuesBlockCache i_blocks; ///< The object's delta, serialised once per kind of viewer
 
     /**
      * @brief Constructor
@@ -707,7 +713,7 @@ struct WorldObjectChangeAccumulator
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
         if (i_object.isType(TYPEMASK_PLAYER))
         {
-            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
+            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas, &i_blocks);
         }
     }
 
@@ -724,7 +730,7 @@ struct WorldObjectChangeAccumulator
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
             {
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_blocks);
             }
         }
     }
@@ -0,0 +1,154 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "AccountLookupStage.h"
+
+#include <algorithm>
+#include <utility>
+
+AccountLookupStage::AccountLookupStage(Resolver resolver, BatchLimit batchLimit)
+    : m_resolver(std::move(resolver)), m_batchLimit(std::move(batchLimit)),
+      m_stopping(false), m_stats()
+{
+}
+
+AccountLookupStage::~AccountLookupStage()
+{
+    Stop();
+}
+
+void AccountLookupStage::Enqueue(proto::AuthRequest const& request,
+                                 proto::IWorldGateway::AuthLookupHandler handler)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!m_stopping)
+        {
+            if (!m_thread.joinable())
+            {
+                m_thread = std::thread(&AccountLookupStage::Run, this);
+            }
+
+            Job job;
+            job.request  = request;
+            job.handler  = std::move(handler);
+            job.queuedAt = std::chrono::steady_clock::now();
+            m_queue.push_back(std::move(job));
+
+            m_stats.queued = uint32(m_queue.size());
+            m_stats.peakQueued = std::max(m_stats.peakQueued, m_stats.queued);
+            m_wake.notify_one();
+            return;
+        }
+    }
+
+    // Shutting down: nothing will answer later, so answer now.
+    proto::AuthLookup refused;
+    refused.status = proto::AuthStatus::SystemError;
+    handler(refused);
+}
+
+void AccountLookupStage::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stopping = true;
+        m_wake.notify_one();
+    }
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void AccountLookupStage::GetStats(Stats& stats) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    stats = m_stats;
+}
+
+void AccountLookupStage::Run()
+{
+    std::vector<Job> batch;
+    std::vector<const proto::AuthRequest*> requests;
+    std::vector<proto::AuthLookup> results;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_wake.wait(guard, [this] { return m_stopping || !m_queue.empty(); });
+
+            // Stopping still drains: every queued login gets its answer.
+            if (m_queue.empty())
+            {
+                return;
+            }
+
+            size_t const limit = std::max<uint32>(1, m_batchLimit());
+            size_t const take = std::min(limit, m_queue.size());
+            for (size_t i = 0; i < take; ++i)
+            {
+                batch.push_back(std::move(m_queue.front()));
+                m_queue.pop_front();
+            }
+            m_stats.queued = uint32(m_queue.size());
+        }
+
+        requests.clear();
+        for (Job const& job : batch)
+        {
+            requests.push_back(&job.request);
+        }
+        results.assign(batch.size(), proto::AuthLookup());
+
+        m_resolver(requests, results);
+
+        std::chrono::steady_clock::time_point const now = std::chrono::steady_clock::now();
+        uint64 waitUs = 0;
+        uint64 maxWaitUs = 0;
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            uint64 const us = uint64(std::chrono::duration_cast<std::chrono::microseconds>(
+                                         now - batch[i].queuedAt).count());
+            waitUs += us;
+            maxWaitUs = std::max(maxWaitUs, us);
+
+            batch[i].handler(results[i]);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stats.lookups += batch.size();
+            m_stats.batches += 1;
+            m_stats.largestBatch = std::max(m_stats.largestBatch, uint32(batch.size()));
+            m_stats.totalWaitUs += waitUs;
+            m_stats.maxWaitUs = std::max(m_stats.maxWaitUs, maxWaitUs);
+        }
+
+        batch.clear();
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_ACCOUNTLOOKUPSTAGE
+#define MANGOS_H_ACCOUNTLOOKUPSTAGE
+
+#include "IWorldGateway.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Answers account lookups off the network threads, several per query.
+ *
+ * A CMSG_AUTH_SESSION used to be resolved by a blocking login database query on
+ * the network worker that received it, and every other connection that worker
+ * owns waited with it. After a restart, when the whole population reconnects at
+ * once, that is every connection on the server waiting on MySQL one login at a
+ * time.
+ *
+ * Lookups are queued here instead and answered by one thread of its own. It takes
+ * whatever has accumulated -- up to the configured batch -- and hands it to the
+ * resolver as one batch, so under a storm the queue empties in a handful of
+ * multi-row queries rather than one round trip per login. Nothing waits to fill a
+ * batch: a lone login is answered as soon as the thread is free.
+ */
+class AccountLookupStage
+{
+    public:
+
+        /// Resolves a batch: fills results[i] with the verdict for *requests[i].
+        typedef std::function<void(std::vector<const proto::AuthRequest*> const& requests,
+                                   std::vector<proto::AuthLookup>& results)> Resolver;
+
+        /// The most lookups one resolver call may take. Asked per batch, so a config
+        /// reload applies to the next one; zero is read as one.
+        typedef std::function<uint32()> BatchLimit;
+
+        /// A snapshot of the stage's counters, for `.debug authlookups`.
+        struct Stats
+        {
+            uint32 queued;          ///< lookups waiting right now
+            uint32 peakQueued;      ///< deepest the queue has been
+            uint64 lookups;         ///< lookups answered
+            uint64 batches;         ///< resolver calls made for them
+            uint32 largestBatch;    ///< most lookups answered by one call
+            uint64 totalWaitUs;     ///< summed queue-to-answer time
+            uint64 maxWaitUs;       ///< slowest queue-to-answer time
+        };
+
+        AccountLookupStage(Resolver resolver, BatchLimit batchLimit);
+        ~AccountLookupStage();
+
+        /// Queue a lookup. @p handler is called exactly once, on the stage's thread.
+        void Enqueue(proto::AuthRequest const& request,
+                     proto::IWorldGateway::AuthLookupHandler handler);
+
+        /// Answer everything still queued, then stop the thread. Idempotent.
+        void Stop();
+
+        void GetStats(Stats& stats) const;
+
+    private:
+
+        struct Job
+        {
+            proto::AuthRequest request;
+            proto::IWorldGateway::AuthLookupHandler handler;
+            std::chrono::steady_clock::time_point queuedAt;
+        };
+
+        void Run();
+
+        Resolver m_resolver;
+        BatchLimit m_batchLimit;
+
+        mutable std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::deque<Job> m_queue;
+        bool m_stopping;
+        std::thread m_thread;       ///< started by the first Enqueue()
+
+        Stats m_stats;              ///< guarded by m_lock
+};
+
+#endif
@@ -0,0 +1,323 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file OpcodeProfiler.cpp
+ * @brief Per-thread opcode timing slabs and their merge.
+ */
+
+#include "OpcodeProfiler.h"
+#include "OpcodeTable.h"
+#include "Log.h"
+#include "Common/TimeConstants.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+std::atomic<bool> OpcodeProfiler::s_enabled(false);
+
+namespace
+{
+    /// Bucket 0 and 1 are single 64 ns steps; above that, two buckets per power of two.
+    const uint32 BUCKET_SHIFT = 6;
+    const uint32 BUCKET_COUNT = 48;
+
+    /// One opcode's figures on one thread. Only the owning thread writes.
+    struct OpcodeCell
+    {
+        std::atomic<uint64> count;
+        std::atomic<uint64> totalNs;
+        std::atomic<uint64> maxNs;
+        std::atomic<uint32> buckets[BUCKET_COUNT];
+    };
+
+    /// One thread's table. Never freed: the threads that run handlers live as long as the server.
+    struct Slab
+    {
+        /// Reset() generation the cells belong to; a stale slab reads as empty.
+        std::atomic<uint32> generation;
+        OpcodeCell cells[NUM_MSG_TYPES];
+    };
+
+    std::mutex s_slabLock;
+    std::vector<Slab*> s_slabs;                             ///< guarded by s_slabLock
+    std::chrono::steady_clock::time_point s_windowStart;    ///< guarded by s_slabLock
+    std::atomic<uint32> s_generation(1);
+
+    thread_local Slab* t_slab = NULL;
+
+    // Dump file; world thread only.
+    uint32 s_dumpIntervalMs = 0;
+    uint32 s_sinceDumpMs = 0;
+    std::string s_dumpFile;
+
+    uint32 BucketOf(uint64 ns)
+    {
+        uint64 v = ns >> BUCKET_SHIFT;
+        if (v < 2)
+        {
+            return uint32(v);
+        }
+
+        uint32 msb = 63;
+        while (!(v >> msb))
+        {
+            --msb;
+        }
+
+        uint32 bucket = msb * 2 + uint32((v >> (msb - 1)) & 1);
+        return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+    }
+
+    /// Smallest time, in ns, that lands in @p bucket.
+    uint64 BucketFloor(uint32 bucket)
+    {
+        if (bucket < 2)
+        {
+            return uint64(bucket) << BUCKET_SHIFT;
+        }
+
+        uint32 msb = bucket / 2;
+        uint64 v = (uint64(1) << msb) | (uint64(bucket & 1) << (msb - 1));
+        return v << BUCKET_SHIFT;
+    }
+
+    uint64 Percentile(uint64 const* buckets, uint64 samples, uint64 maxNs, uint32 percent)
+    {
+        if (!samples)
+        {
+            return 0;
+        }
+
+        uint64 rank = (samples * percent + 99) / 100;
+        uint64 seen = 0;
+        for (uint32 b = 0; b < BUCKET_COUNT; ++b)
+        {
+            seen += buckets[b];
+            if (seen >= rank)
+            {
+                uint64 mid = (BucketFloor(b) + BucketFloor(b + 1)) / 2;
+                return std::min(mid, maxNs);
+            }
+        }
+        return maxNs;
+    }
+
+    Slab* ThreadSlab()
+    {
+        if (!t_slab)
+        {
+            Slab* slab = new Slab();
+            slab->generation.store(s_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> guard(s_slabLock);
+            s_slabs.push_back(slab);
+            t_slab = slab;
+        }
+        return t_slab;
+    }
+}
+
+void OpcodeProfiler::SetEnabled(bool enabled)
+{
+    if (enabled && !s_enabled.load(std::memory_order_relaxed))
+    {
+        Reset();
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void OpcodeProfiler::Reset()
+{
+    // Other threads' slabs are theirs to write; each one clears itself the next time it
+    // records and sees the generation has moved on.
+    std::lock_guard<std::mutex> guard(s_slabLock);
+    s_generation.fetch_add(1, std::memory_order_relaxed);
+    s_windowStart = std::chrono::steady_clock::now();
+}
+
+void OpcodeProfiler::Record(uint16 opcode, int64 ns)
+{
+    if (opcode >= NUM_MSG_TYPES)
+    {
+        return;
+    }
+
+    Slab* slab = ThreadSlab();
+
+    uint32 generation = s_generation.load(std::memory_order_relaxed);
+    if (slab->generation.load(std::memory_order_relaxed) != generation)
+    {
+        for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+        {
+            OpcodeCell& cell = slab->cells[i];
+            cell.count.store(0, std::memory_order_relaxed);
+            cell.totalNs.store(0, std::memory_order_relaxed);
+            cell.maxNs.store(0, std::memory_order_relaxed);
+            for (uint32 b = 0; b < BUCKET_COUNT; ++b)
+            {
+                cell.buckets[b].store(0, std::memory_order_relaxed);
+            }
+        }
+        slab->generation.store(generation, std::memory_order_release);
+    }
+
+    uint64 value = ns > 0 ? uint64(ns) : 0;
+    OpcodeCell& cell = slab->cells[opcode];
+    cell.count.store(cell.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    cell.totalNs.store(cell.totalNs.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value > cell.maxNs.load(std::memory_order_relaxed))
+    {
+        cell.maxNs.store(value, std::memory_order_relaxed);
+    }
+    std::atomic<uint32>& bucket = cell.buckets[BucketOf(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+double OpcodeProfiler::Collect(std::vector<Row>& rows)
+{
+    std::vector<Slab*> slabs;
+    std::chrono::steady_clock::time_point windowStart;
+    {
+        std::lock_guard<std::mutex> guard(s_slabLock);
+        slabs = s_slabs;
+        windowStart = s_windowStart;
+    }
+
+    uint32 generation = s_generation.load(std::memory_order_relaxed);
+
+    rows.clear();
+    uint64 buckets[BUCKET_COUNT];
+    for (uint32 op = 0; op < NUM_MSG_TYPES; ++op)
+    {
+        Row row;
+        row.opcode = uint16(op);
+        row.count = 0;
+        row.totalNs = 0;
+        row.maxNs = 0;
+        std::fill(buckets, buckets + BUCKET_COUNT, uint64(0));
+        uint64 samples = 0;
+
+        for (Slab* slab : slabs)
+        {
+            if (slab->generation.load(std::memory_order_acquire) != generation)
+            {
+                continue;
+            }
+
+            OpcodeCell const& cell = slab->cells[op];
+            uint64 count = cell.count.load(std::memory_order_relaxed);
+            if (!count)
+            {
+                continue;
+            }
+
+            row.count += count;
+            row.totalNs += cell.totalNs.load(std::memory_order_relaxed);
+            row.maxNs = std::max(row.maxNs, cell.maxNs.load(std::memory_order_relaxed));
+            for (uint32 b = 0; b < BUCKET_COUNT; ++b)
+            {
+                uint32 n = cell.buckets[b].load(std::memory_order_relaxed);
+                buckets[b] += n;
+                samples += n;
+            }
+        }
+
+        if (!row.count)
+        {
+            continue;
+        }
+
+        row.p50Ns = Percentile(buckets, samples, row.maxNs, 50);
+        row.p99Ns = Percentile(buckets, samples, row.maxNs, 99);
+        rows.push_back(row);
+    }
+
+    std::sort(rows.begin(), rows.end(), [](Row const& a, Row const& b)
+    {
+        return a.totalNs > b.totalNs;
+    });
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - windowStart).count();
+}
+
+void OpcodeProfiler::Configure(uint32 intervalSecs, std::string const& file)
+{
+    s_dumpIntervalMs = intervalSecs * IN_MILLISECONDS;
+    s_sinceDumpMs = 0;
+    s_dumpFile = file;
+}
+
+void OpcodeProfiler::Update(uint32 diff)
+{
+    if (!s_dumpIntervalMs || s_dumpFile.empty() || !IsEnabled())
+    {
+        return;
+    }
+
+    s_sinceDumpMs += diff;
+    if (s_sinceDumpMs < s_dumpIntervalMs)
+    {
+        return;
+    }
+    s_sinceDumpMs = 0;
+
+    if (!WriteDump())
+    {
+        sLog.outError("OpcodeProfiler: cannot write '%s', dump file disabled until the next config reload", s_dumpFile.c_str());
+        s_dumpIntervalMs = 0;
+    }
+}
+
+bool OpcodeProfiler::WriteDump()
+{
+    if (s_dumpFile.empty())
+    {
+        return false;
+    }
+
+    std::vector<Row> rows;
+    double seconds = Collect(rows);
+
+    FILE* file = fopen(s_dumpFile.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    fprintf(file, "opcode,name,count,per_sec,total_us,avg_us,p50_us,p99_us,max_us\n");
+    for (Row const& row : rows)
+    {
+        fprintf(file, "%u,%s,%llu,%.2f,%llu,%.2f,%.2f,%.2f,%.2f\n",
+                uint32(row.opcode), LookupOpcodeName(row.opcode),
+                (unsigned long long)row.count, seconds > 0.0 ? row.count / seconds : 0.0,
+                (unsigned long long)(row.totalNs / 1000), row.totalNs / 1000.0 / row.count,
+                row.p50Ns / 1000.0, row.p99Ns / 1000.0, row.maxNs / 1000.0);
+    }
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,143 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file OpcodeProfiler.h
+ * @brief Per-opcode handler latency and throughput, for finding the handlers that cost.
+ */
+
+#ifndef MANGOS_H_OPCODEPROFILER
+#define MANGOS_H_OPCODEPROFILER
+
+#include "Platform/Define.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Times every client packet handler that WorldSession::ExecuteOpcode runs.
+ *
+ * Handlers run on the world thread and, for map-bound opcodes, on the map update
+ * threads, so a shared table would have every worker contending on the same cache
+ * lines for the hottest opcodes. Each thread records into a slab of its own
+ * instead -- plain loads and stores, no read-modify-write -- and the slabs are only
+ * summed when somebody asks: `.debug opcodes` or the periodic dump file.
+ *
+ * Latency goes into a log-linear histogram (two buckets per power of two, 64 ns
+ * resolution at the bottom), so p50 and p99 are read back to within a quarter of
+ * their value without keeping samples.
+ *
+ * Off by default. When off, ExecuteOpcode pays one relaxed load per packet.
+ */
+class OpcodeProfiler
+{
+    public:
+
+        /// Merged figures for one opcode.
+        struct Row
+        {
+            uint16 opcode;
+            uint64 count;           ///< handler calls since the last reset
+            uint64 totalNs;         ///< summed handler time
+            uint64 p50Ns;           ///< median handler time, bucket midpoint
+            uint64 p99Ns;           ///< 99th percentile handler time, bucket midpoint
+            uint64 maxNs;           ///< slowest single call
+        };
+
+        /**
+         * @brief Times one handler call; does nothing unless the profiler is on.
+         */
+        class Scope
+        {
+            public:
+                explicit Scope(uint16 opcode)
+                    : m_opcode(opcode), m_active(IsEnabled())
+                {
+                    if (m_active)
+                    {
+                        m_start = std::chrono::steady_clock::now();
+                    }
+                }
+
+                ~Scope()
+                {
+                    if (m_active)
+                    {
+                        Record(m_opcode, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - m_start).count());
+                    }
+                }
+
+            private:
+                Scope(Scope const&);
+                Scope& operator=(Scope const&);
+
+                uint16 m_opcode;
+                bool m_active;
+                std::chrono::steady_clock::time_point m_start;
+        };
+
+        static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+        /// Turn recording on or off. Turning it on from off starts a fresh window.
+        static void SetEnabled(bool enabled);
+
+        /// Forget everything recorded so far; the rate window restarts now.
+        static void Reset();
+
+        /// Add one handler call of @p ns nanoseconds to the calling thread's slab.
+        static void Record(uint16 opcode, int64 ns);
+
+        /**
+         * @brief Sum every thread's slab.
+         *
+         * @param rows Receives one row per opcode seen since the last reset, slowest
+         *             total first.
+         * @return Seconds covered by the figures, for turning counts into rates.
+         */
+        static double Collect(std::vector<Row>& rows);
+
+        /**
+         * @brief Dump file settings, from the config.
+         *
+         * @param intervalSecs Seconds between dumps; 0 turns the file off.
+         * @param file Path of the dump, rewritten whole each time.
+         */
+        static void Configure(uint32 intervalSecs, std::string const& file);
+
+        /// Called from World::Update; writes the dump file when its interval has passed.
+        static void Update(uint32 diff);
+
+        /// Write the current figures to the dump file now. False if it cannot be opened.
+        static bool WriteDump();
+
+    private:
+
+        static std::atomic<bool> s_enabled;
+};
+
+#endif
@@ -41,12 +41,15 @@
 #include "World.h"
 #include "WorldSession.h"
 #include "WorldGatewayAuth.h"
+#include "Util.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif
 
+#include <set>
 #include <string>
+#include <unordered_map>
 
 namespace
 {
@@ -95,7 +98,13 @@ namespace
 }
 
 WorldGateway::WorldGateway()
-    : m_nextId(1)
+    : m_nextId(1),
+      m_lookups([this](std::vector<const proto::AuthRequest*> const& requests,
+                       std::vector<proto::AuthLookup>& results)
+                {
+                    ResolveAccounts(requests, results);
+                },
+                []() { return sWorld.getConfig(CONFIG_UINT32_AUTH_LOOKUP_BATCH); })
 {
 }
 
@@ -105,20 +114,96 @@ WorldGateway::~WorldGateway()
 
 proto::AuthLookup WorldGateway::LookupAccount(const proto::AuthRequest& request)
 {
-    EnsureDbThreadRegistered();
+    std::vector<const proto::AuthRequest*> requests(1, &request);
+    std::vector<proto::AuthLookup> results(1);
+    ResolveAccounts(requests, results);
+    return results[0];
+}
 
-    proto::AuthLookup result;
+void WorldGateway::LookupAccountAsync(const proto::AuthRequest& request,
+                                      AuthLookupHandler handler)
+{
+    m_lookups.Enqueue(request, std::move(handler));
+}
+
+void WorldGateway::StopLookups()
+{
+    m_lookups.Stop();
+}
+
+void WorldGateway::GetLookupStats(AccountLookupStage::Stats& stats) const
+{
+    m_lookups.GetStats(stats);
+}
+
+namespace
+{
+    /// What one account row says, beyond what Attach() needs.
+    struct FetchedAccount
+    {
+        std::shared_ptr<AccountRow> row;
+        std::string lastIp;
+        bool        locked = false;
+        std::string clientOS;
+    };
+
+    /// `'a', 'b', ...` for an IN list; every entry escaped.
+    std::string QuotedList(std::set<std::string> const& values)
+    {
+        std::string list;
+        for (std::string value : values)
+        {
+            LoginDatabase.escape_string(value);
+            if (!list.empty())
+            {
+                list += ", ";
+            }
+            list += "'" + value + "'";
+        }
+        return list;
+    }
+
+    /// `1, 2, ...` for an IN list of integer ids.
+    std::string IdList(std::set<uint32> const& values)
+    {
+        std::string list;
+        for (uint32 value : values)
+        {
+            if (!list.empty())
+            {
+                list += ", ";
+            }
+            list += std::to_string(value);
+        }
+        return list;
+    }
+}
+
+void WorldGateway::ResolveAccounts(std::vector<const proto::AuthRequest*> const& requests,
+                                   std::vector<proto::AuthLookup>& results)
+{
+    EnsureDbThreadRegistered();
 
     // ---- Client build ----------------------------------------------------
-    if (!IsAcceptableClientBuild(request.build))
+    // Settled before any query, so a wrong build never costs a round trip.
+    std::set<std::string> names;
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        if (!IsAcceptableClientBuild(requests[i]->build))
+        {
+            results[i].status = proto::AuthStatus::VersionMismatch;
+            continue;
+        }
+        names.insert(requests[i]->account);
+    }
+
+    if (names.empty())
     {
-        result.status = proto::AuthStatus::VersionMismatch;
-        return result;
+        return;
     }
 
-    // ---- Account row -----------------------------------------------------
-    std::string safeAccount = request.account;
-    LoginDatabase.escape_string(safeAccount);
+    // ---- Account rows, one query for the whole batch ---------------------
+    std::unordered_map<std::string, FetchedAccount> accounts;
 
     QueryResult* queryResult =
         LoginDatabase.PQuery("SELECT "
@@ -130,95 +215,168 @@ proto::AuthLookup WorldGateway::LookupAccount(const proto::AuthRequest& request)
                              "`expansion`, "   // 5
                              "`mutetime`, "    // 6
                              "`locale`, "      // 7
-                             "`os` "           // 8
-                             "FROM `account` WHERE `username` = '%s'",
-                             safeAccount.c_str());
+                             "`os`, "          // 8
+                             "`username` "     // 9
+                             "FROM `account` WHERE `username` IN (%s)",
+                             QuotedList(names).c_str());
 
-    if (!queryResult)
+    if (queryResult)
     {
-        result.status = proto::AuthStatus::UnknownAccount;
-        return result;
-    }
+        do
+        {
+            const Field* fields = queryResult->Fetch();
 
-    const Field* fields = queryResult->Fetch();
+            FetchedAccount account;
+            account.row = std::make_shared<AccountRow>();
+            AccountRow& row = *account.row;
 
-    std::shared_ptr<AccountRow> row = std::make_shared<AccountRow>();
+            row.id = fields[0].GetUInt32();
 
-    row->id = fields[0].GetUInt32();
+            // Clamp rather than trust: a bad gmlevel in the database must not hand out
+            // more authority than the server has levels for.
+            uint32 security = fields[1].GetUInt16();
+            if (security > SEC_ADMINISTRATOR)
+            {
+                security = SEC_ADMINISTRATOR;
+            }
+            row.security = AccountTypes(security);
 
-    // Clamp rather than trust: a bad gmlevel in the database must not hand out
-    // more authority than the server has levels for.
-    uint32 security = fields[1].GetUInt16();
-    if (security > SEC_ADMINISTRATOR)
-    {
-        security = SEC_ADMINISTRATOR;
-    }
-    row->security = AccountTypes(security);
+            row.sessionKey.SetHexStr(fields[2].GetString());
 
-    row->sessionKey.SetHexStr(fields[2].GetString());
+            account.lastIp = fields[3].GetString();
+            account.locked = fields[4].GetUInt8() == 1;
 
-    const std::string lastIp = fields[3].GetString();
-    const bool        locked = fields[4].GetUInt8() == 1;
+            row.expansion = uint8(std::min<uint32>(sWorld.getConfig(CONFIG_UINT32_EXPANSION),
+                                                   fields[5].GetUInt8()));
+            row.muteTime  = time_t(fields[6].GetUInt64());
 
-    row->expansion = uint8(std::min<uint32>(sWorld.getConfig(CONFIG_UINT32_EXPANSION),
-                                            fields[5].GetUInt8()));
-    row->muteTime  = time_t(fields[6].GetUInt64());
+            const uint8 rawLocale = fields[7].GetUInt8();
+            row.locale = rawLocale >= MAX_LOCALE ? LOCALE_enUS : LocaleConstant(rawLocale);
+            account.clientOS = fields[8].GetCppString();
 
-    const uint8 rawLocale = fields[7].GetUInt8();
-    row->locale = rawLocale >= MAX_LOCALE ? LOCALE_enUS : LocaleConstant(rawLocale);
-    const std::string clientOS = fields[8].GetCppString();
+            accounts[AccountKey(fields[9].GetCppString())] = account;
+        }
+        while (queryResult->NextRow());
 
-    delete queryResult;
+        delete queryResult;
+    }
 
-    // ---- IP lock ---------------------------------------------------------
-    if (locked && lastIp != request.peerAddress)
+    // ---- Bans, one query for every account and address -------------------
+    std::set<uint32> ids;
+    std::set<std::string> addresses;
+    for (size_t i = 0; i < requests.size(); ++i)
     {
-        sLog.outBasic("WorldGateway: account '%s' is IP locked to %s but connected from %s",
-                      request.account.c_str(), lastIp.c_str(),
-                      request.peerAddress.c_str());
-        result.status = proto::AuthStatus::Failed;
-        return result;
-    }
+        if (results[i].status == proto::AuthStatus::VersionMismatch)
+        {
+            continue;
+        }
 
-    // ---- Bans ------------------------------------------------------------
-    QueryResult* banResult =
-        LoginDatabase.PQuery("SELECT 1 FROM `account_banned` WHERE `id` = %u AND `active` = 1 "
-                             "AND (`unbandate` > UNIX_TIMESTAMP() OR `unbandate` = `bandate`) "
-                             "UNION "
-                             "SELECT 1 FROM `ip_banned` WHERE (`unbandate` = `bandate` OR "
-                             "`unbandate` > UNIX_TIMESTAMP()) AND `ip` = '%s'",
-                             row->id, request.peerAddress.c_str());
+        std::unordered_map<std::string, FetchedAccount>::const_iterator found =
+            accounts.find(AccountKey(requests[i]->account));
+        if (found != accounts.end())
+        {
+            ids.insert(found->second.row->id);
+            addresses.insert(requests[i]->peerAddress);
+        }
+    }
 
-    if (banResult)
+    std::set<uint32> bannedIds;
+    std::set<std::string> bannedAddresses;
+    if (!ids.empty())
     {
-        delete banResult;
-        sLog.outBasic("WorldGateway: banned account '%s' tried to connect from %s",
-                      request.account.c_str(), request.peerAddress.c_str());
-        result.status = proto::AuthStatus::Banned;
-        return result;
+        QueryResult* banResult =
+            LoginDatabase.PQuery("SELECT 0, `id`, '' FROM `account_banned` "
+                                 "WHERE `id` IN (%s) AND `active` = 1 "
+                                 "AND (`unbandate` > UNIX_TIMESTAMP() OR `unbandate` = `bandate`) "
+                                 "UNION ALL "
+                                 "SELECT 1, 0, `ip` FROM `ip_banned` WHERE (`unbandate` = `bandate` OR "
+                                 "`unbandate` > UNIX_TIMESTAMP()) AND `ip` IN (%s)",
+                                 IdList(ids).c_str(), QuotedList(addresses).c_str());
+
+        if (banResult)
+        {
+            do
+            {
+                const Field* fields = banResult->Fetch();
+                if (fields[0].GetUInt32() == 0)
+                {
+                    bannedIds.insert(fields[1].GetUInt32());
+                }
+                else
+                {
+                    bannedAddresses.insert(fields[2].GetCppString());
+                }
+            }
+            while (banResult->NextRow());
+
+            delete banResult;
+        }
     }
 
-    // ---- Security floor (server closed to ordinary players) --------------
+    // ---- Per login policy --------------------------------------------------
     const AccountTypes allowed = sWorld.GetPlayerSecurityLimit();
-    if (allowed > SEC_PLAYER && row->security < allowed)
-    {
-        result.status = proto::AuthStatus::Unavailable;
-        return result;
-    }
 
-    // ---- Client platform -------------------------------------------------
-    if (!IsSupportedAccountClientOS(clientOS))
+    for (size_t i = 0; i < requests.size(); ++i)
     {
-        sLog.outError("WorldGateway: client %s reported invalid OS '%s'",
-                      request.peerAddress.c_str(), clientOS.c_str());
-        result.status = proto::AuthStatus::Reject;
-        return result;
-    }
+        const proto::AuthRequest& request = *requests[i];
+        proto::AuthLookup& result = results[i];
 
-    result.status     = proto::AuthStatus::Ok;
-    result.sessionKey = row->sessionKey;
-    result.context    = row;
-    return result;
+        if (result.status == proto::AuthStatus::VersionMismatch)
+        {
+            continue;
+        }
+
+        std::unordered_map<std::string, FetchedAccount>::const_iterator found =
+            accounts.find(AccountKey(request.account));
+        if (found == accounts.end())
+        {
+            result.status = proto::AuthStatus::UnknownAccount;
+            continue;
+        }
+        const FetchedAccount& account = found->second;
+
+        // ---- IP lock -----------------------------------------------------
+        if (account.locked && account.lastIp != request.peerAddress)
+        {
+            sLog.outBasic("WorldGateway: account '%s' is IP locked to %s but connected from %s",
+                          request.account.c_str(), account.lastIp.c_str(),
+                          request.peerAddress.c_str());
+            result.status = proto::AuthStatus::Failed;
+            continue;
+        }
+
+        // ---- Bans --------------------------------------------------------
+        if (bannedIds.count(account.row->id) || bannedAddresses.count(request.peerAddress))
+        {
+            sLog.outBasic("WorldGateway: banned account '%s' tried to connect from %s",
+                          request.account.c_str(), request.peerAddress.c_str());
+            result.status = proto::AuthStatus::Banned;
+            continue;
+        }
+
+        // ---- Security floor (server closed to ordinary players) ----------
+        if (allowed > SEC_PLAYER && account.row->security < allowed)
+        {
+            result.status = proto::AuthStatus::Unavailable;
+            continue;
+        }
+
+        // ---- Client platform ---------------------------------------------
+        if (!IsSupportedAccountClientOS(account.clientOS))
+        {
+            sLog.outError("WorldGateway: client %s reported invalid OS '%s'",
+                          request.peerAddress.c_str(), account.clientOS.c_str());
+            result.status = proto::AuthStatus::Reject;
+            continue;
+        }
+
+        // Each login gets its own row: Attach() hands it to a session for keeps.
+        std::shared_ptr<AccountRow> row = std::make_shared<AccountRow>(*account.row);
+
+        result.status     = proto::AuthStatus::Ok;
+        result.sessionKey = row->sessionKey;
+        result.context    = row;
+    }
 }
 
 proto::SessionId WorldGateway::Attach(const proto::AuthRequest& request,
@@ -26,11 +26,13 @@
 #ifndef MANGOS_H_WORLDGATEWAY
 #define MANGOS_H_WORLDGATEWAY
 
+#include "AccountLookupStage.h"
 #include "IWorldGateway.h"
 
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 class SessionMailbox;
 
@@ -58,6 +60,10 @@ class WorldGateway : public proto::IWorldGateway
 
         proto::AuthLookup LookupAccount(const proto::AuthRequest& request) override;
 
+        /// Queued on the account lookup stage, so no network worker waits on MySQL.
+        void LookupAccountAsync(const proto::AuthRequest& request,
+                                AuthLookupHandler handler) override;
+
         proto::SessionId Attach(const proto::AuthRequest& request,
                                 const std::shared_ptr<proto::IClientLink>& link,
                                 const std::shared_ptr<proto::AuthContext>& context) override;
@@ -69,8 +75,20 @@ class WorldGateway : public proto::IWorldGateway
 
         void Detach(proto::SessionId session) override;
 
+        /// Answer every queued lookup and stop the lookup thread. Called at shutdown,
+        /// once the listener has stopped producing new ones.
+        void StopLookups();
+
+        void GetLookupStats(AccountLookupStage::Stats& stats) const;
+
     private:
 
+        /// The account policy, for any number of logins at once: one query for the
+        /// rows, one for the bans, then the per-login checks. LookupAccount() is a
+        /// batch of one.
+        void ResolveAccounts(std::vector<const proto::AuthRequest*> const& requests,
+                             std::vector<proto::AuthLookup>& results);
+
         mutable std::mutex m_lock;
 
         /// Handles are drawn from a counter rather than reusing account ids, so a
@@ -79,6 +97,8 @@ class WorldGateway : public proto::IWorldGateway
         proto::SessionId m_nextId;
 
         std::unordered_map<proto::SessionId, std::shared_ptr<SessionMailbox>> m_routes;
+
+        AccountLookupStage m_lookups;
 };
 
 #endif
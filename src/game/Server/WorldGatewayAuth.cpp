@@ -25,7 +25,15 @@
 
 #include "WorldGatewayAuth.h"
 
+#include "Util.h"
+
 bool IsSupportedAccountClientOS(const std::string& os)
 {
     return os == "Win" || os == "OSX";
 }
+
+std::string AccountKey(std::string name)
+{
+    Utf8ToUpperOnlyLatin(name);
+    return name;
+}
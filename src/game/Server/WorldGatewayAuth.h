@@ -30,4 +30,8 @@
 
 bool IsSupportedAccountClientOS(const std::string& os);
 
+/// Usernames compare the way the login database compares them: Latin case folded.
+/// A batched lookup matches the rows it got back to the logins that asked by this.
+std::string AccountKey(std::string name);
+
 #endif
@@ -68,6 +68,10 @@ bool WorldNetwork::Start(uint16 port, const std::string& bindIp)
 void WorldNetwork::Stop()
 {
     m_listener.Stop();
+
+    // Only once nothing can queue another: every lookup still waiting is answered
+    // (into connections that are gone) and the lookup thread joins.
+    m_gateway.StopLookups();
 }
 
 uint32 WorldNetwork::GetOpenConnectionCount() const
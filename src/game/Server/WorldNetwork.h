@@ -66,6 +66,12 @@ class WorldNetwork : public MaNGOS::Singleton<WorldNetwork>
         /// Sockets currently open, for the mangosd console/window title.
         uint32 GetOpenConnectionCount() const;
 
+        /// Counters of the login lookup stage, for `.debug authlookups`.
+        void GetAuthLookupStats(AccountLookupStage::Stats& stats) const
+        {
+            m_gateway.GetLookupStats(stats);
+        }
+
     private:
 
         WorldNetwork();
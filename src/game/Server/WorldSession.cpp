@@ -66,6 +66,7 @@
 #endif
 #include "Log.h"
 #include "OpcodeTable.h"
+#include "OpcodeProfiler.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "SessionMailbox.h"
@@ -278,6 +279,23 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     m_link->SendPacket(*packet);
 }
 
+/// Send this session's share of a broadcast: only the header is encoded per connection
+void WorldSession::SendSharedPacket(proto::SharedPacket const& packet)
+{
+    if (!m_link)
+    {
+        return;
+    }
+
+    if (opcodeTable[packet.Packet().GetOpcode()].status == STATUS_UNHANDLED)
+    {
+        sLog.outError("SESSION: tried to send an unhandled opcode 0x%.4X", packet.Packet().GetOpcode());
+        return;
+    }
+
+    m_link->SendShared(packet);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -1285,7 +1303,10 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* pac
         _player->SetCanDelayTeleport(true);
     }
 
-    (this->*opHandle.handler)(*packet);
+    {
+        OpcodeProfiler::Scope profile(packet->GetOpcode());
+        (this->*opHandle.handler)(*packet);
+    }
 
     if (_player)
     {
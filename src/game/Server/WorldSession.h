@@ -63,6 +63,7 @@ class SessionMailbox;
 namespace proto
 {
     class IClientLink;
+    class SharedPacket;
 }
 class QueryResult;
 class LoginQueryHolder;
@@ -354,6 +355,8 @@ class WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const* packet);
+        /// Send this session's share of a packet being broadcast to many.
+        void SendSharedPacket(proto::SharedPacket const& packet);
         void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(int32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName* declinedName);
@@ -0,0 +1,275 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file TickProfiler.cpp
+ * @brief Tick and zone scopes, per-owner histograms and the slow tick report.
+ */
+
+#include "TickProfiler.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+std::atomic<bool> TickProfiler::s_enabled(false);
+std::atomic<uint32> TickProfiler::s_slowTickMs(0);
+
+namespace
+{
+    thread_local TickProfiler::Tick* t_openTick = NULL;
+
+    char const* const s_zoneNames[TICK_ZONE_COUNT] =
+    {
+        "tick",
+        "sessions",
+        "maps",
+        "query callbacks",
+        "auctions",
+        "lfg",
+        "corpses",
+        "sessions",
+        "players",
+        "cells",
+        "visibility",
+        "object updates",
+        "grid state",
+        "scripts",
+        "transports",
+    };
+
+    uint64 ElapsedUs(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - since).count();
+    }
+
+    uint32 BucketOf(uint64 us)
+    {
+        uint32 bucket = 0;
+        while (us && bucket < TickProfiler::BUCKET_COUNT - 1)
+        {
+            us >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    uint64 Percentile(uint32 const* buckets, uint64 ticks, uint64 maxUs, uint32 percent)
+    {
+        if (!ticks)
+        {
+            return 0;
+        }
+
+        uint64 rank = (ticks * percent + 99) / 100;
+        uint64 seen = 0;
+        for (uint32 b = 0; b < TickProfiler::BUCKET_COUNT; ++b)
+        {
+            seen += buckets[b];
+            if (seen >= rank)
+            {
+                // bucket b spans [2^(b-1), 2^b); report three quarters of the way up
+                uint64 mid = b ? (uint64(3) << b) / 4 : 0;
+                return std::min(mid, maxUs);
+            }
+        }
+        return maxUs;
+    }
+}
+
+TickProfiler::History::History()
+{
+    memset(m_zones, 0, sizeof(m_zones));
+}
+
+void TickProfiler::History::Snapshot(ZoneStats (&stats)[TICK_ZONE_COUNT]) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (uint32 z = 0; z < TICK_ZONE_COUNT; ++z)
+    {
+        Histogram const& h = m_zones[z];
+        stats[z].ticks = h.ticks;
+        stats[z].totalUs = h.totalUs;
+        stats[z].maxUs = h.maxUs;
+        stats[z].p50Us = Percentile(h.buckets, h.ticks, h.maxUs, 50);
+        stats[z].p99Us = Percentile(h.buckets, h.ticks, h.maxUs, 99);
+    }
+}
+
+void TickProfiler::History::Reset()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    memset(m_zones, 0, sizeof(m_zones));
+}
+
+TickProfiler::Tick::Tick(History& history, uint32 mapId, uint32 instanceId, bool world)
+    : m_history(history), m_mapId(mapId), m_instanceId(instanceId), m_world(world),
+      m_active(IsEnabled()), m_outer(NULL), m_open(TICK_ZONE_TOTAL)
+{
+    if (!m_active)
+    {
+        return;
+    }
+
+    memset(m_zoneUs, 0, sizeof(m_zoneUs));
+    memset(m_zoneCalls, 0, sizeof(m_zoneCalls));
+    std::fill(m_parent, m_parent + TICK_ZONE_COUNT, TICK_ZONE_TOTAL);
+
+    m_outer = t_openTick;
+    t_openTick = this;
+    m_start = std::chrono::steady_clock::now();
+}
+
+TickProfiler::Tick::~Tick()
+{
+    if (!m_active)
+    {
+        return;
+    }
+
+    t_openTick = m_outer;
+
+    uint64 totalUs = ElapsedUs(m_start);
+    m_zoneUs[TICK_ZONE_TOTAL] = totalUs;
+    m_zoneCalls[TICK_ZONE_TOTAL] = 1;
+
+    {
+        std::lock_guard<std::mutex> guard(m_history.m_lock);
+        for (uint32 z = 0; z < TICK_ZONE_COUNT; ++z)
+        {
+            if (!m_zoneCalls[z])
+            {
+                continue;
+            }
+
+            History::Histogram& h = m_history.m_zones[z];
+            ++h.ticks;
+            h.totalUs += m_zoneUs[z];
+            h.maxUs = std::max(h.maxUs, m_zoneUs[z]);
+            ++h.buckets[BucketOf(m_zoneUs[z])];
+        }
+    }
+
+    uint32 slowMs = s_slowTickMs.load(std::memory_order_relaxed);
+    if (slowMs && totalUs >= uint64(slowMs) * 1000)
+    {
+        Report(totalUs);
+    }
+}
+
+void TickProfiler::Tick::Report(uint64 totalUs) const
+{
+    if (m_world)
+    {
+        sLog.outString("Slow tick: world, %.1f ms", totalUs / 1000.0);
+    }
+    else
+    {
+        sLog.outString("Slow tick: map %u instance %u, %.1f ms", m_mapId, m_instanceId, totalUs / 1000.0);
+    }
+
+    ReportChildren(TICK_ZONE_TOTAL, 1);
+}
+
+void TickProfiler::Tick::ReportChildren(TickZone parent, uint32 depth) const
+{
+    uint64 childrenUs = 0;
+    for (uint32 z = TICK_ZONE_TOTAL + 1; z < TICK_ZONE_COUNT; ++z)
+    {
+        if (!m_zoneCalls[z] || m_parent[z] != parent)
+        {
+            continue;
+        }
+
+        if (m_zoneCalls[z] > 1)
+        {
+            sLog.outString("%*s%-16s %8.1f ms  (%u times)", int(depth * 2), "", s_zoneNames[z],
+                           m_zoneUs[z] / 1000.0, m_zoneCalls[z]);
+        }
+        else
+        {
+            sLog.outString("%*s%-16s %8.1f ms", int(depth * 2), "", s_zoneNames[z], m_zoneUs[z] / 1000.0);
+        }
+
+        childrenUs += m_zoneUs[z];
+        ReportChildren(TickZone(z), depth + 1);
+    }
+
+    // Time in the parent that no zone claimed; only worth a line under a zone that has children.
+    uint64 parentUs = m_zoneUs[parent];
+    if (childrenUs && parentUs > childrenUs)
+    {
+        sLog.outString("%*s%-16s %8.1f ms", int(depth * 2), "", "(other)", (parentUs - childrenUs) / 1000.0);
+    }
+}
+
+TickProfiler::Zone::Zone(TickZone zone)
+    : m_tick(t_openTick), m_open(false), m_zone(zone), m_outer(TICK_ZONE_TOTAL)
+{
+    Start(zone);
+}
+
+void TickProfiler::Zone::Next(TickZone zone)
+{
+    Stop();
+    Start(zone);
+}
+
+void TickProfiler::Zone::Start(TickZone zone)
+{
+    if (!m_tick)
+    {
+        return;
+    }
+
+    m_zone = zone;
+    m_outer = m_tick->m_open;
+    m_tick->m_open = zone;
+    if (!m_tick->m_zoneCalls[zone])
+    {
+        m_tick->m_parent[zone] = m_outer;
+    }
+    m_open = true;
+    m_start = std::chrono::steady_clock::now();
+}
+
+void TickProfiler::Zone::Stop()
+{
+    if (!m_open)
+    {
+        return;
+    }
+
+    m_tick->m_zoneUs[m_zone] += ElapsedUs(m_start);
+    ++m_tick->m_zoneCalls[m_zone];
+    m_tick->m_open = m_outer;
+    m_open = false;
+}
+
+char const* TickProfiler::ZoneName(TickZone zone)
+{
+    return zone < TICK_ZONE_COUNT ? s_zoneNames[zone] : "?";
+}
@@ -0,0 +1,218 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file TickProfiler.h
+ * @brief Phase-by-phase timing of World::Update and Map::Update.
+ */
+
+#ifndef MANGOS_H_TICKPROFILER
+#define MANGOS_H_TICKPROFILER
+
+#include "Platform/Define.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+/**
+ * @brief The phases a tick is broken into.
+ *
+ * Which zone a phase is nested under is not fixed here: it is whatever zone was open
+ * on the thread when the phase started, so the same phase can show up under a
+ * different parent when one tick runs inside another (a ship's deck map, ticked from
+ * its continent's transport phase).
+ */
+enum TickZone
+{
+    TICK_ZONE_TOTAL = 0,            ///< the whole tick; the root every other zone hangs off
+
+    TICK_ZONE_WORLD_SESSIONS,       ///< World::UpdateSessions
+    TICK_ZONE_WORLD_MAPS,           ///< sMapMgr.Update, waiting on the map pool included
+    TICK_ZONE_WORLD_RESULTS,        ///< World::UpdateResultQueue
+    TICK_ZONE_WORLD_AUCTIONS,       ///< mail expiry and sAuctionMgr.Update
+    TICK_ZONE_WORLD_LFG,            ///< sLFGMgr.Update
+    TICK_ZONE_WORLD_CORPSES,        ///< sCorpseManager.RemoveOldCorpses
+
+    TICK_ZONE_MAP_SESSIONS,         ///< map-bound packets of the map's players
+    TICK_ZONE_MAP_PLAYERS,          ///< Player::Update of each player
+    TICK_ZONE_MAP_CELLS,            ///< the cell pass around players and active objects
+    TICK_ZONE_MAP_VISIBILITY,       ///< Map::UpdateVisibilityPass
+    TICK_ZONE_MAP_OBJECT_UPDATES,   ///< Map::SendObjectUpdates
+    TICK_ZONE_MAP_GRID_STATE,       ///< grid state machine and pending cell unloads
+    TICK_ZONE_MAP_SCRIPTS,          ///< map scripts, Eluna and the instance script
+    TICK_ZONE_MAP_TRANSPORTS,       ///< vessels sailing the map, their deck maps included
+
+    TICK_ZONE_COUNT
+};
+
+/**
+ * @brief Scoped-zone profiler for server ticks.
+ *
+ * UpdateTime keeps whole-tick diffs, which say that a tick was slow but not what
+ * made it slow. A TickProfiler::Tick opened around a tick collects the time spent
+ * in every TickProfiler::Zone opened on the same thread while it runs. When the
+ * tick closes, each zone's share goes into the owner's History -- the world, or one
+ * map -- as a latency histogram per zone; a tick slower than the configured
+ * threshold also has its whole breakdown written to the server log.
+ *
+ * Off by default. When off, a zone costs one thread-local load.
+ */
+class TickProfiler
+{
+    public:
+
+        /// Log2 buckets of microseconds: bucket b holds [2^(b-1), 2^b) us.
+        static const uint32 BUCKET_COUNT = 25;
+
+        /// Read-back figures for one zone of one owner.
+        struct ZoneStats
+        {
+            uint64 ticks;       ///< ticks the zone ran in
+            uint64 totalUs;     ///< summed time
+            uint64 p50Us;       ///< median per-tick time, bucket midpoint
+            uint64 p99Us;       ///< 99th percentile per-tick time, bucket midpoint
+            uint64 maxUs;       ///< slowest single tick
+        };
+
+        /**
+         * @brief Per-zone histograms of one tick owner.
+         *
+         * Written once per tick by whichever thread ran it, read by `.debug ticks`.
+         */
+        class History
+        {
+            public:
+                History();
+
+                /// Copy out every zone's figures.
+                void Snapshot(ZoneStats (&stats)[TICK_ZONE_COUNT]) const;
+
+                void Reset();
+
+            private:
+                friend class TickProfiler;
+
+                struct Histogram
+                {
+                    uint64 ticks;
+                    uint64 totalUs;
+                    uint64 maxUs;
+                    uint32 buckets[BUCKET_COUNT];
+                };
+
+                mutable std::mutex m_lock;
+                Histogram m_zones[TICK_ZONE_COUNT];
+        };
+
+        /**
+         * @brief Times one tick of @p history's owner on the calling thread.
+         *
+         * Ticks nest: a tick opened inside another is its own tick for its zones, and
+         * the outer tick sees it only as time spent in whichever zone it was opened in.
+         */
+        class Tick
+        {
+            public:
+                /**
+                 * @param history Where the tick's figures go.
+                 * @param mapId Map the tick belongs to, for the slow tick report;
+                 *              ignored when @p world is set.
+                 * @param instanceId Instance the tick belongs to, likewise.
+                 * @param world True for the world tick.
+                 */
+                Tick(History& history, uint32 mapId, uint32 instanceId, bool world);
+                ~Tick();
+
+            private:
+                friend class TickProfiler;
+
+                Tick(Tick const&);
+                Tick& operator=(Tick const&);
+
+                void Report(uint64 totalUs) const;
+                void ReportChildren(TickZone parent, uint32 depth) const;
+
+                History& m_history;
+                uint32 m_mapId;
+                uint32 m_instanceId;
+                bool m_world;
+                bool m_active;
+                Tick* m_outer;
+                TickZone m_open;            ///< innermost zone open right now
+                std::chrono::steady_clock::time_point m_start;
+
+                uint64 m_zoneUs[TICK_ZONE_COUNT];
+                uint32 m_zoneCalls[TICK_ZONE_COUNT];
+                TickZone m_parent[TICK_ZONE_COUNT];
+        };
+
+        /**
+         * @brief Charges its lifetime to @p zone of the thread's open tick, if any.
+         *
+         * A run of phases that follow one another can share one Zone and move it along
+         * with Next(), rather than each being put in a block of its own.
+         */
+        class Zone
+        {
+            public:
+                explicit Zone(TickZone zone);
+                ~Zone() { Stop(); }
+
+                /// Close the current zone and open @p zone in its place.
+                void Next(TickZone zone);
+
+                /// Close the current zone early. Idempotent.
+                void Stop();
+
+            private:
+                Zone(Zone const&);
+                Zone& operator=(Zone const&);
+
+                void Start(TickZone zone);
+
+                Tick* m_tick;
+                bool m_open;
+                TickZone m_zone;
+                TickZone m_outer;
+                std::chrono::steady_clock::time_point m_start;
+        };
+
+        static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+        static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+        /// Ticks at least this long (ms) are written to the log in full; 0 never.
+        static void SetSlowTickThreshold(uint32 ms) { s_slowTickMs.store(ms, std::memory_order_relaxed); }
+
+        /// Display name of @p zone.
+        static char const* ZoneName(TickZone zone);
+
+    private:
+
+        static std::atomic<bool> s_enabled;
+        static std::atomic<uint32> s_slowTickMs;
+};
+
+#endif
@@ -112,7 +112,7 @@ void CharacterDatabaseCleaner::CleanDatabase()
  * Generic cleanup helper that:
  * 1. Queries all distinct values in the specified column
  * 2. Validates each value using the provided check function
- * 3. Deletes rows with invalid IDs in a single DELETE statement
+ * 3. Deletes rows with invalid IDs, in as few DELETE statements as the batch byte budget allows
  *
  * Uses a progress bar for visual feedback during long operations.
  */
@@ -138,6 +138,16 @@ void CharacterDatabaseCleaner::CheckUnique(const char* column, const char* table
 
         if (!check(id))
         {
+            // one statement per SqlStatementBatch::DEFAULT_BUDGET bytes of ids, not one for
+            // the whole table: a list past max_allowed_packet is refused outright
+            if (found && size_t(ss.tellp()) > SqlStatementBatch::DEFAULT_BUDGET)
+            {
+                ss << ")";
+                CharacterDatabase.Execute(ss.str().c_str());
+                ss.str("");
+                found = false;
+            }
+
             if (!found)
             {
                 ss << "DELETE FROM `" << table << "` WHERE `" << column << "` IN (";
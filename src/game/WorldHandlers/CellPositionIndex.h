@@ -0,0 +1,149 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file CellPositionIndex.h
+ * @brief Where everything in one cell stands, kept as columns rather than objects.
+ *
+ * A radius search over the grid walks each cell's type containers: an intrusive list
+ * per type, one heap object per link, and a distance check through the object's
+ * placement for every one of them -- most of which are out of range, out of phase or
+ * of a type the search does not want. This keeps the handful of values those checks
+ * read in flat arrays per cell, so a search filters a cell with a few tight loops
+ * over contiguous floats and masks, which the compiler turns into vector code, and
+ * touches an object only once it has passed.
+ *
+ * The index is a mirror. The grid containers stay the authority on what is in a cell;
+ * Map keeps the rows in step with them (see Map::IndexGridPosition()). Each object
+ * carries a Slot naming its cell and row, so a move refreshes its row, and a removal
+ * drops it, without searching for it.
+ *
+ * The index is a template over what a row points at only so the unit tests can file
+ * stand-ins of their own type; the server files WorldObjects, through CellPositionIndex.
+ * The definitions are in CellPositionIndexImpl.h, instantiated for WorldObject in
+ * CellPositionIndex.cpp.
+ */
+
+#ifndef MANGOS_CELL_POSITION_INDEX_H
+#define MANGOS_CELL_POSITION_INDEX_H
+
+#include "Platform/Define.h"
+
+#include <vector>
+
+class WorldObject;
+
+/**
+ * @brief The position, extent, type mask and phase mask of every object in a cell.
+ *
+ * One row per object, one array per field. Rows are unordered: removal moves the last
+ * row into the hole, and re-points the moved row's slot.
+ *
+ * @tparam T What a row points at. Only ever pointed at: the index never calls into it.
+ */
+template <class T>
+class CellPositionIndexOf
+{
+    public:
+
+        /// Where an object is filed. Kept by the object; only the index writes it.
+        struct Slot
+        {
+            Slot() : index(NULL), row(0) {}
+
+            CellPositionIndexOf* index;             ///< NULL: not filed
+            uint32 row;
+        };
+
+        CellPositionIndexOf() {}
+        ~CellPositionIndexOf() { Clear(); }
+
+        CellPositionIndexOf(const CellPositionIndexOf&) = delete;
+        CellPositionIndexOf& operator=(const CellPositionIndexOf&) = delete;
+
+        /// File @p obj, and point @p slot at its row. The caller guarantees @p slot is not filed.
+        void Insert(Slot& slot, T* obj, float x, float y, float extent, uint16 typeMask, uint32 phaseMask);
+
+        /// Drop the row @p slot points at, which must be in this index, and clear @p slot.
+        void Remove(Slot& slot);
+
+        /// Refresh the row @p slot points at after a move, a resize or a phase change.
+        void Update(Slot const& slot, float x, float y, float extent, uint32 phaseMask)
+        {
+            m_x[slot.row] = x;
+            m_y[slot.row] = y;
+            m_extent[slot.row] = extent;
+            m_phaseMask[slot.row] = phaseMask;
+        }
+
+        /// Drop every row, clearing the slots that pointed at them.
+        void Clear();
+
+        uint32 Size() const { return uint32(m_object.size()); }
+
+        /**
+         * @brief Appends every object of @p typeMask sharing a phase with @p phaseMask whose
+         *        extent reaches within @p radius of (@p x, @p y).
+         *
+         * A 2D test, padded by each row's extent: a superset of what Placement::WithinDist()
+         * accepts for the same radius, so the caller's exact check still decides.
+         *
+         * @return The number of objects appended.
+         */
+        uint32 CollectInCircle(float x, float y, float radius, uint16 typeMask, uint32 phaseMask,
+                               std::vector<T*>& out) const;
+
+        /// As CollectInCircle(), for an axis-aligned box.
+        uint32 CollectInBox(float minX, float minY, float maxX, float maxY, uint16 typeMask, uint32 phaseMask,
+                            std::vector<T*>& out) const;
+
+    private:
+
+        /// Rows filtered per pass. The keep flags of one block live on the stack, so two
+        /// searches of the same cell from different threads share nothing.
+        static constexpr uint32 FILTER_BLOCK = 64;
+
+        /// Rows up to which a plain loop beats filling the keep flags: too few for the
+        /// vector code to pay for its setup.
+        static constexpr uint32 SMALL_CELL = 16;
+
+        /// Appends the objects of rows [@p first, @p first + @p count) whose @p keep flag is set.
+        uint32 Compact(uint32 const* keep, uint32 first, uint32 count, std::vector<T*>& out) const;
+
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_extent;
+        std::vector<uint32> m_typeMask;           ///< widened to the floats' lane width
+        std::vector<uint32> m_phaseMask;
+        std::vector<T*> m_object;
+        std::vector<Slot*> m_slot;
+};
+
+/// The index the map keeps for every cell.
+typedef CellPositionIndexOf<WorldObject> CellPositionIndex;
+
+extern template class CellPositionIndexOf<WorldObject>;
+
+#endif
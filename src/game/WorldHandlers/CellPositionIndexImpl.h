@@ -0,0 +1,199 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file CellPositionIndexImpl.h
+ * @brief The definitions of CellPositionIndexOf, for the translation units that instantiate it.
+ */
+
+#ifndef MANGOS_CELL_POSITION_INDEX_IMPL_H
+#define MANGOS_CELL_POSITION_INDEX_IMPL_H
+
+#include "CellPositionIndex.h"
+
+template <class T>
+void CellPositionIndexOf<T>::Insert(Slot& slot, T* obj, float x, float y, float extent, uint16 typeMask, uint32 phaseMask)
+{
+    slot.index = this;
+    slot.row = Size();
+
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_extent.push_back(extent);
+    m_typeMask.push_back(typeMask);
+    m_phaseMask.push_back(phaseMask);
+    m_object.push_back(obj);
+    m_slot.push_back(&slot);
+}
+
+template <class T>
+void CellPositionIndexOf<T>::Remove(Slot& slot)
+{
+    uint32 const row = slot.row;
+    uint32 const last = Size() - 1;
+    if (row != last)
+    {
+        m_x[row] = m_x[last];
+        m_y[row] = m_y[last];
+        m_extent[row] = m_extent[last];
+        m_typeMask[row] = m_typeMask[last];
+        m_phaseMask[row] = m_phaseMask[last];
+        m_object[row] = m_object[last];
+        m_slot[row] = m_slot[last];
+        m_slot[row]->row = row;
+    }
+
+    m_x.pop_back();
+    m_y.pop_back();
+    m_extent.pop_back();
+    m_typeMask.pop_back();
+    m_phaseMask.pop_back();
+    m_object.pop_back();
+    m_slot.pop_back();
+
+    slot.index = NULL;
+    slot.row = 0;
+}
+
+template <class T>
+void CellPositionIndexOf<T>::Clear()
+{
+    for (Slot* slot : m_slot)
+    {
+        slot->index = NULL;
+        slot->row = 0;
+    }
+
+    m_x.clear();
+    m_y.clear();
+    m_extent.clear();
+    m_typeMask.clear();
+    m_phaseMask.clear();
+    m_object.clear();
+    m_slot.clear();
+}
+
+template <class T>
+uint32 CellPositionIndexOf<T>::CollectInCircle(float x, float y, float radius, uint16 typeMask, uint32 phaseMask,
+                                                std::vector<T*>& out) const
+{
+    float const* xs = m_x.data();
+    float const* ys = m_y.data();
+    float const* extents = m_extent.data();
+    uint32 const* types = m_typeMask.data();
+    uint32 const* phases = m_phaseMask.data();
+
+    uint32 found = 0;
+    uint32 const size = Size();
+    if (size <= SMALL_CELL)
+    {
+        T* const* objects = m_object.data();
+        for (uint32 row = 0; row < size; ++row)
+        {
+            if ((types[row] & typeMask) && (phases[row] & phaseMask))
+            {
+                float const dx = xs[row] - x;
+                float const dy = ys[row] - y;
+                float const reach = radius + extents[row];
+                if (dx * dx + dy * dy <= reach * reach)
+                {
+                    out.push_back(objects[row]);
+                    ++found;
+                }
+            }
+        }
+        return found;
+    }
+
+    uint32 keep[FILTER_BLOCK];
+    for (uint32 first = 0; first < Size(); first += FILTER_BLOCK)
+    {
+        uint32 const count = Size() - first < FILTER_BLOCK ? Size() - first : FILTER_BLOCK;
+
+        // No branches and no early outs: every row of the block is tested the same way,
+        // so this loop is vectorised.
+        for (uint32 i = 0; i < count; ++i)
+        {
+            uint32 const row = first + i;
+            float const dx = xs[row] - x;
+            float const dy = ys[row] - y;
+            float const reach = radius + extents[row];
+            keep[i] = uint32(dx * dx + dy * dy <= reach * reach) &
+                      uint32((types[row] & typeMask) != 0) &
+                      uint32((phases[row] & phaseMask) != 0);
+        }
+
+        found += Compact(keep, first, count, out);
+    }
+    return found;
+}
+
+template <class T>
+uint32 CellPositionIndexOf<T>::CollectInBox(float minX, float minY, float maxX, float maxY, uint16 typeMask, uint32 phaseMask,
+                                          std::vector<T*>& out) const
+{
+    float const* xs = m_x.data();
+    float const* ys = m_y.data();
+    float const* extents = m_extent.data();
+    uint32 const* types = m_typeMask.data();
+    uint32 const* phases = m_phaseMask.data();
+
+    uint32 found = 0;
+    uint32 keep[FILTER_BLOCK];
+    for (uint32 first = 0; first < Size(); first += FILTER_BLOCK)
+    {
+        uint32 const count = Size() - first < FILTER_BLOCK ? Size() - first : FILTER_BLOCK;
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            uint32 const row = first + i;
+            float const e = extents[row];
+            keep[i] = uint32(xs[row] + e >= minX) & uint32(xs[row] - e <= maxX) &
+                      uint32(ys[row] + e >= minY) & uint32(ys[row] - e <= maxY) &
+                      uint32((types[row] & typeMask) != 0) &
+                      uint32((phases[row] & phaseMask) != 0);
+        }
+
+        found += Compact(keep, first, count, out);
+    }
+    return found;
+}
+
+template <class T>
+uint32 CellPositionIndexOf<T>::Compact(uint32 const* keep, uint32 first, uint32 count, std::vector<T*>& out) const
+{
+    uint32 kept = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (keep[i])
+        {
+            out.push_back(m_object[first + i]);
+            ++kept;
+        }
+    }
+    return kept;
+}
+
+#endif
@@ -474,6 +474,24 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
         return;
     }
 
+    // Linked creatures may be in any region of the map: a region hands the event to its barrier
+    Map* map = pSource->GetMap();
+    if (map->InRegionJob())
+    {
+        ObjectGuid sourceGuid = pSource->GetObjectGuid();
+        ObjectGuid enemyGuid = pEnemy ? pEnemy->GetObjectGuid() : ObjectGuid();
+        map->RunAtColourBarrier([map, eventType, sourceGuid, enemyGuid]()
+        {
+            Creature* source = map->GetAnyTypeCreature(sourceGuid);
+            Unit* enemy = enemyGuid.IsEmpty() ? NULL : map->GetUnit(enemyGuid);
+            if (source && (enemy || enemyGuid.IsEmpty()))
+            {
+                map->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(eventType, source, enemy);
+            }
+        });
+        return;
+    }
+
     uint32 eventFlagFilter = 0;
     uint32 reverseEventFlagFilter = 0;
 
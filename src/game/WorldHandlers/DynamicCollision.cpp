@@ -26,11 +26,14 @@
 #include "DynamicCollision.h"
 
 #include "GameObjectModel.h"
+#include "terrain/Accelerators.hpp"
 #include "terrain/Terrain.hpp"
 
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <functional>
+#include <utility>
 
 using Geometry::Vector3;
 
@@ -187,6 +190,74 @@ float DynamicCollision::NearestHitFraction(float x1, float y1, float z1, float x
     return best;
 }
 
+void DynamicCollision::NearestHitFractions(const Vector3* a, const Vector3* b,
+                                           uint32_t count, uint32_t phasemask,
+                                           float* out) const
+{
+    typedef std::pair<const GameObjectModel*, uint32_t> Pair;
+    thread_local std::vector<Pair> pairs;
+    pairs.clear();
+
+    auto inv = [](float d) { return std::fabs(d) > 1e-9f ? 1.0f / d : 1e30f; };
+
+    // The same candidates and the same box test NearestHitFraction applies, one segment
+    // at a time...
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        out[i] = 2.0f;
+        const Vector3 seg = b[i] - a[i];
+        if (Geometry::dot(seg, seg) < 1e-6f)
+        {
+            continue;
+        }
+        const Vector3 invDir{inv(seg.x), inv(seg.y), inv(seg.z)};
+
+        ForEachCandidate(std::min(a[i].x, b[i].x), std::min(a[i].y, b[i].y),
+                         std::max(a[i].x, b[i].x), std::max(a[i].y, b[i].y),
+                         [&](const GameObjectModel& model)
+        {
+            if (model.IsCollidable() && (model.GetPhaseMask() & phasemask) &&
+                model.GetBounds().intersectsRay(a[i], invDir, 1.0f))
+            {
+                pairs.push_back(Pair(&model, i));
+            }
+        });
+    }
+
+    // ...then each body walks all of the segments that reached it at once.
+    std::sort(pairs.begin(), pairs.end(), [](const Pair& l, const Pair& r)
+    {
+        return std::less<const GameObjectModel*>()(l.first, r.first) ||
+               (l.first == r.first && l.second < r.second);
+    });
+
+    constexpr int WIDTH = world::terrain::Bvh::PACKET_WIDTH;
+    for (size_t run = 0; run < pairs.size();)
+    {
+        const GameObjectModel* model = pairs[run].first;
+        int n = 0;
+        Vector3 from[WIDTH], to[WIDTH];
+        float fracs[WIDTH];
+        while (n < WIDTH && run + n < pairs.size() && pairs[run + n].first == model)
+        {
+            from[n] = a[pairs[run + n].second];
+            to[n] = b[pairs[run + n].second];
+            ++n;
+        }
+
+        model->SegmentHitFractions(from, to, n, fracs);
+        for (int k = 0; k < n; ++k)
+        {
+            float& frac = out[pairs[run + k].second];
+            if (fracs[k] < frac)
+            {
+                frac = fracs[k];
+            }
+        }
+        run += size_t(n);
+    }
+}
+
 bool DynamicCollision::IsInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                                        float z2, uint32_t phasemask) const
 {
@@ -83,6 +83,12 @@ class DynamicCollision : public world::terrain::ILiveGeometry
         float NearestHitFraction(float x1, float y1, float z1, float x2, float y2,
                                  float z2, uint32_t phasemask) const;
 
+        // NearestHitFraction for `count` segments a[i]->b[i]; out[i] is segment i's.
+        // Each body is offered every segment that reaches its box, and walks them
+        // together, four at a time.
+        void NearestHitFractions(const Geometry::Vector3* a, const Geometry::Vector3* b,
+                                 uint32_t count, uint32_t phasemask, float* out) const;
+
         // Every collidable surface crossing the window over (x,y), appended to the
         // terrain engine's column. `filter` is the phase mask: this is the ILiveGeometry
         // side of the seam, so the engine hands it back without having looked at it.
@@ -26,8 +26,10 @@
 #include <memory>
 #include <vector>
 #include "GameObjectModel.h"
+#include "terrain/Accelerators.hpp"
 
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
@@ -101,6 +103,43 @@ float GameObjectModel::SegmentHitFraction(const Vector3& a, const Vector3& b) co
     return 2.0f;
 }
 
+void GameObjectModel::SegmentHitFractions(const Vector3* a, const Vector3* b, int count,
+                                          float* out) const
+{
+    constexpr int WIDTH = world::terrain::Bvh::PACKET_WIDTH;
+
+    for (int i = 0; i < count; ++i)
+    {
+        out[i] = 2.0f;
+    }
+    if (!m_collidable || !m_model)
+    {
+        return;
+    }
+
+    for (int base = 0; base < count; base += WIDTH)
+    {
+        const int n = std::min(WIDTH, count - base);
+        Vector3 origins[WIDTH], dirs[WIDTH];
+        float best[WIDTH];
+        for (int i = 0; i < n; ++i)
+        {
+            origins[i] = m_xf.worldToLocal(a[base + i]);
+            dirs[i] = m_xf.worldToLocal(b[base + i]) - origins[i];
+            best[i] = 1.0f;
+        }
+
+        m_model->RaycastNearestPacket(origins, dirs, n, best);
+        for (int i = 0; i < n; ++i)
+        {
+            if (best[i] < 1.0f)
+            {
+                out[base + i] = best[i];
+            }
+        }
+    }
+}
+
 void GameObjectModel::AddSurfaces(float x, float y, float zTop, float zBottom,
                                   world::terrain::Column& out) const
 {
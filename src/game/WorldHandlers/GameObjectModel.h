@@ -80,6 +80,11 @@ class GameObjectModel
         // the geometry pushed into world space.
         float SegmentHitFraction(const Geometry::Vector3& a, const Geometry::Vector3& b) const;
 
+        // SegmentHitFraction for `count` segments a[i]->b[i]; out[i] is segment i's. They
+        // are walked through the model Bvh::PACKET_WIDTH at a time.
+        void SegmentHitFractions(const Geometry::Vector3* a, const Geometry::Vector3* b,
+                                 int count, float* out) const;
+
         // Appends every surface of this body crossing the window over (x,y).
         void AddSurfaces(float x, float y, float zTop, float zBottom,
                          world::terrain::Column& out) const;
@@ -25,6 +25,7 @@
 
 #include <string>
 #include <mutex>
+#include <algorithm>
 #include "Utilities/Errors.h"
 #include "MapManager.h"
 
@@ -233,6 +234,7 @@ bool TerrainInfo::Load(const uint32 x, const uint32 y)
     // The tile data itself still loads lazily, on the first query that reaches it.
     if (firstReference)
     {
+        sTerrainMgr.Prefetcher().NoteGridLoad(m_terrain.IsResident(int(x), int(y)));
         m_terrain.PinCell(int(x), int(y));
 
         // The navmesh tile is loaded by the FIRST referent only -- the refcount above is
@@ -265,6 +267,28 @@ void TerrainInfo::Unload(const uint32 x, const uint32 y)
     }
 }
 
+bool TerrainInfo::Prefetch(const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    // The navmesh tile is only read here and staged; adding it to the mesh changes what
+    // every path query on this map walks, and stays with Load() on the map's thread. A
+    // grid some map already holds has its tile in the mesh, and a staged copy would only
+    // sit unused until it was pushed out.
+    if (!IsGridReferenced(x, y))
+    {
+        MMAP::MMapFactory::createOrGetMMapManager()->prefetchTile(m_mapId, x, y);
+    }
+    return m_terrain.Prefetch(int(x), int(y));
+}
+
+bool TerrainInfo::IsGridReferenced(const uint32 x, const uint32 y) const
+{
+    std::lock_guard<LOCK_TYPE> lock(m_refMutex);
+    return m_GridRef[x][y] > 0;
+}
+
 void TerrainInfo::CleanUpGrids(const uint32 diff)
 {
     m_terrain.Update(diff);
@@ -591,6 +615,19 @@ float TerrainInfo::NearestHitFraction(float x1, float y1, float z1, float x2, fl
     return m_terrain.NearestHitFraction(x1, y1, z1, x2, y2, z2);
 }
 
+void TerrainInfo::NearestHitFractions(Geometry::Vector3 const* a, Geometry::Vector3 const* b,
+                                      uint32 count, float* out) const
+{
+    if (m_collisionDisables.load(std::memory_order_relaxed) &
+        DisableMgr::COLLISION_DISABLE_LOS)
+    {
+        std::fill(out, out + count, 2.0f);
+        return;
+    }
+
+    m_terrain.NearestHitFractions(a, b, count, out);
+}
+
 TerrainManager::TerrainManager() : m_mutex()
 {
 }
@@ -664,6 +701,7 @@ void TerrainManager::UnloadTerrain(const uint32 mapId)
         if (ptr->IsReferenced() == false)
         {
             i_TerrainMap.erase(iter);
+            m_prefetcher.Forget(ptr);
             delete ptr;
         }
     }
@@ -688,6 +726,8 @@ void TerrainManager::Update(const uint32 diff)
  */
 void TerrainManager::UnloadAll()
 {
+    m_prefetcher.Stop();
+
     for (TerrainDataMap::iterator it = i_TerrainMap.begin(); it != i_TerrainMap.end(); ++it)
     {
         delete it->second;
@@ -35,6 +35,7 @@
 #include "GridDefines.h"
 #include "Object.h"
 #include "SharedDefines.h"
+#include "GridPrefetcher.h"
 #include "terrain/FusedTerrain.hpp"
 
 #include <bitset>
@@ -228,9 +229,21 @@ class TerrainInfo : public Referencable<AtomicLong>
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const;
         float NearestHitFraction(float x1, float y1, float z1, float x2, float y2, float z2) const;
 
+        /// NearestHitFraction for `count` segments a[i] -> b[i], traced together; out[i]
+        /// is segment i's.
+        void NearestHitFractions(Geometry::Vector3 const* a, Geometry::Vector3 const* b, uint32 count, float* out) const;
+
         // Ages the tile cache and reclaims what no active grid holds.
         void CleanUpGrids(const uint32 diff);
 
+        /// Reads grid (x, y)'s terrain and navmesh tiles ahead of Load(), on the calling
+        /// thread, which is meant to be the grid prefetcher's and never a map's. True when
+        /// the terrain tile was read by this call.
+        bool Prefetch(const uint32 x, const uint32 y);
+
+        /// True when grid (x, y) is held by a map, so a prefetch of it would read nothing.
+        bool IsGridReferenced(const uint32 x, const uint32 y) const;
+
         /// Re-reads this map's row from `disables`. Called once when the terrain is
         /// created and again after `.reload disables`, because the answer is cached:
         /// asking DisableMgr inside every height and sight query would put a container
@@ -266,7 +279,7 @@ class TerrainInfo : public Referencable<AtomicLong>
         IntervalTimer i_timer;
 
         typedef std::mutex LOCK_TYPE;
-        LOCK_TYPE m_refMutex;
+        mutable LOCK_TYPE m_refMutex;
 };
 
 // class for managing TerrainData object and all sort of geometry querying operations
@@ -282,6 +295,10 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager>
         void Update(const uint32 diff);
         void UnloadAll();
 
+        /// The thread reading grids ahead of the players heading for them. Owned here
+        /// because a terrain must be forgotten by it before it is deleted.
+        GridPrefetcher& Prefetcher() { return m_prefetcher; }
+
         /// Pushes the `disables` table into every terrain already built. The rows are
         /// read once per map and cached there, so a reload that does not do this leaves
         /// the old answer in place for the life of the process.
@@ -319,6 +336,7 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager>
         typedef std::mutex LOCK_TYPE;
         LOCK_TYPE m_mutex;
         TerrainDataMap i_TerrainMap;
+        GridPrefetcher m_prefetcher;
 };
 
 #define sTerrainMgr TerrainManager::Instance()
@@ -77,7 +77,7 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment the unseen guids are those not found at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (player.GetMap()->AsTransport())
     {
@@ -85,12 +85,12 @@ void VisibleNotifier::Notify()
         for (Map::PlayerList::const_iterator itr = aboard.begin(); itr != aboard.end(); ++itr)
         {
             Player* mate = itr->getSource();
-            if (mate && i_clientGUIDs.find(mate->GetObjectGuid()) != i_clientGUIDs.end())
+            if (mate && i_clientGUIDs.IsUnseen(mate->GetObjectGuid()))
             {
                 // ignore far sight case
                 mate->UpdateVisibilityOf(mate, &player);
                 player.UpdateVisibilityOf(&player, mate, i_data, i_visibleNow);
-                i_clientGUIDs.erase(mate->GetObjectGuid());
+                i_clientGUIDs.MarkSeen(mate->GetObjectGuid());
             }
         }
     }
@@ -101,10 +101,11 @@ void VisibleNotifier::Notify()
     // correct without anybody keeping a list.
 
     // generate outOfRange for not iterate objects
-    i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    std::vector<ObjectGuid> left;
+    i_clientGUIDs.TakeUnseen(left);
+    for (std::vector<ObjectGuid>::const_iterator itr = left.begin(); itr != left.end(); ++itr)
     {
-        player.m_clientGUIDs.erase(*itr);
+        i_data.AddOutOfRangeGUID(*itr);
 
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
                          itr->GetString().c_str(), player.GetGuidStr().c_str());
@@ -136,7 +137,7 @@ void VisibleNotifier::Notify()
     // Now do operations that required done at object visibility change to visible
 
     // send data at target visibility change (adding to client)
-    for (std::set<WorldObject*>::const_iterator vItr = i_visibleNow.begin(); vItr != i_visibleNow.end(); ++vItr)
+    for (std::vector<WorldObject*>::const_iterator vItr = i_visibleNow.begin(); vItr != i_visibleNow.end(); ++vItr)
     {
         // target aura duration for caster show only if target exist at caster client
         if ((*vItr) != &player && (*vItr)->isType(TYPEMASK_UNIT))
@@ -166,7 +167,7 @@ void MessageDeliverer::Visit(CameraMapType& m)
 
             if (WorldSession* session = owner->GetSession())
             {
-                session->SendPacket(i_message);
+                session->SendSharedPacket(i_message);
             }
         }
     }
@@ -190,7 +191,7 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
 
         if (WorldSession* session = owner->GetSession())
         {
-            session->SendPacket(i_message);
+            session->SendSharedPacket(i_message);
         }
     }
 }
@@ -211,7 +212,7 @@ void ObjectMessageDeliverer::Visit(CameraMapType& m)
 
         if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
         {
-            session->SendPacket(i_message);
+            session->SendSharedPacket(i_message);
         }
     }
 }
@@ -238,7 +239,7 @@ void MessageDistDeliverer::Visit(CameraMapType& m)
 
             if (WorldSession* session = owner->GetSession())
             {
-                session->SendPacket(i_message);
+                session->SendSharedPacket(i_message);
             }
         }
     }
@@ -262,7 +263,7 @@ void ObjectMessageDistDeliverer::Visit(CameraMapType& m)
 
             if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
             {
-                session->SendPacket(i_message);
+                session->SendSharedPacket(i_message);
             }
         }
     }
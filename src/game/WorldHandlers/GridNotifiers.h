@@ -31,6 +31,7 @@
 #include <vector>
 #include "ObjectGridLoader.h"
 #include "UpdateData.h"
+#include "SharedPacket.h"
 #include <iostream>
 
 #include "Corpse.h"
@@ -42,14 +43,19 @@
 
 namespace MaNGOS
 {
+    /// One visibility sweep of a camera's owner: every object found in reach is marked
+    /// seen in the owner's client set, and Notify() destroys what was not.
     struct VisibleNotifier
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
-        std::set<WorldObject*> i_visibleNow;
+        ClientGuidSet& i_clientGUIDs;
+        std::vector<WorldObject*> i_visibleNow;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
+        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs)
+        {
+            i_clientGUIDs.BeginSweep();
+        }
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
@@ -64,24 +70,28 @@ namespace MaNGOS
         void Visit(CameraMapType&);
     };
 
+    // The Message*Deliverer family fans one packet out to everyone in range. Each
+    // wraps it in a SharedPacket for the whole visit, so a large payload is copied
+    // once and referenced by every recipient's send queue; only the header, under
+    // each connection's own cipher, is written per recipient.
     struct MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        proto::SharedPacket i_message;
         bool i_toSelf;
-        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
+        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(*msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
     struct MessageDelivererExcept
     {
-        uint32        i_phaseMask;
-        WorldPacket*  i_message;
-        Player const* i_skipped_receiver;
+        uint32              i_phaseMask;
+        proto::SharedPacket i_message;
+        Player const*       i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket* msg, Player const* skipped)
-            : i_phaseMask(obj->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped) {}
+            : i_phaseMask(obj->GetPhaseMask()), i_message(*msg), i_skipped_receiver(skipped) {}
 
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
@@ -90,9 +100,9 @@ namespace MaNGOS
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket* i_message;
+        proto::SharedPacket i_message;
         explicit ObjectMessageDeliverer(WorldObject const& obj, WorldPacket* msg)
-            : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
+            : i_phaseMask(obj.GetPhaseMask()), i_message(*msg) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -100,13 +110,13 @@ namespace MaNGOS
     struct MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        proto::SharedPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
 
         MessageDistDeliverer(Player const& pl, WorldPacket* msg, float dist, bool to_self, bool ownTeamOnly)
-            : i_player(pl), i_message(msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
+            : i_player(pl), i_message(*msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -114,9 +124,9 @@ namespace MaNGOS
     struct ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket* i_message;
+        proto::SharedPacket i_message;
         float i_dist;
-        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
+        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(*msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -43,7 +43,9 @@
  */
 
 #include <vector>
+#include <chrono>
 #include <cmath>
+#include <functional>
 #include <set>
 #include "Utilities/Util.h"
 #include "Utilities/MathDefines.h"
@@ -52,6 +54,7 @@
 #include "Map.h"
 #include "GameObjectModel.h"
 #include "MapManager.h"
+#include "MapRegions.h"
 #include "Player.h"
 #include "GridNotifiers.h"
 #include "Log.h"
@@ -66,11 +69,14 @@
 #include "ObjectMgr.h"
 #include "World.h"
 #include "ScriptMgr.h"
+#include "PoolManager.h"
+#include "CreatureLinkingMgr.h"
 #include "Group.h"
 #include "MapRefManager.h"
 #include "DBCEnums.h"
 #include "MapPersistentStateMgr.h"
 #include "MoveMap.h"
+#include "WaypointMovementGenerator.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "Calendar.h"
 #include "Chat.h"
@@ -121,6 +127,14 @@ Map::~Map()
 
     UnloadAll(true);
 
+    for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+    {
+        for (uint32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+        {
+            delete m_positionIndex[x][y];
+        }
+    }
+
     if (!m_scriptSchedule.empty())
     {
         sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
@@ -145,6 +159,9 @@ Map::~Map()
 
     delete m_weatherSystem;
     m_weatherSystem = NULL;
+
+    delete m_regionPlan;
+    m_regionPlan = NULL;
 }
 
 /**
@@ -189,13 +206,15 @@ void Map::LoadMapAndVMap(int gx, int gy)
  */
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
-      i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
+      i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), m_updateCostHint(0),
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
       m_cinematicViewerRadius(0.0f), m_cinematicVisibilityRadius(0.0f),
       m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(NULL), i_script_id(0)
+      i_data(NULL), i_script_id(0),
+      m_prefetchTimer(0), m_prefetchPass(0),
+      m_regionPlan(NULL), m_regionPassActive(false)
 {
 #ifdef ENABLE_ELUNA
     // lua state begins uninitialized
@@ -217,6 +236,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
             // z code
             m_bLoadedGrids[idx][j] = false;
             setNGrid(NULL, idx, j);
+            m_positionIndex[idx][j] = NULL;
         }
     }
 
@@ -350,6 +370,7 @@ template<class T>
 void Map::AddToGrid(T* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).template AddGridObject<T>(obj);
+    IndexGridPosition(obj, cell);
 }
 
 /**
@@ -372,6 +393,7 @@ void Map::AddToGrid(Player* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).AddWorldObject(obj);
     grid->incPlayerCount();
+    IndexGridPosition(obj, cell);
 }
 
 /**
@@ -402,6 +424,7 @@ void Map::AddToGrid(Corpse* obj, NGridType* grid, Cell const& cell)
     {
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject(obj);
     }
+    IndexGridPosition(obj, cell);
 }
 
 /**
@@ -434,6 +457,7 @@ void Map::AddToGrid(Creature* obj, NGridType* grid, Cell const& cell)
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject<Creature>(obj);
         obj->SetCurrentCell(cell);
     }
+    IndexGridPosition(obj, cell);
 }
 
 /**
@@ -457,6 +481,7 @@ template<class T>
 void Map::RemoveFromGrid(T* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).template RemoveGridObject<T>(obj);
+    UnindexGridPosition(obj);
 }
 
 /**
@@ -478,6 +503,7 @@ template<>
 void Map::RemoveFromGrid(Player* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject(obj);
+    UnindexGridPosition(obj);
     grid->decPlayerCount();
     if (grid->getPlayerCount() == 0)
     {
@@ -513,6 +539,7 @@ void Map::RemoveFromGrid(Corpse* obj, NGridType* grid, Cell const& cell)
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject(obj);
     }
+    UnindexGridPosition(obj);
 }
 
 /**
@@ -543,6 +570,120 @@ void Map::RemoveFromGrid(Creature* obj, NGridType* grid, Cell const& cell)
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject<Creature>(obj);
     }
+    UnindexGridPosition(obj);
+}
+
+/**
+ * @brief Files a row for an object just added to a cell's containers.
+ *
+ * @param obj The object added.
+ * @param cell The cell it was added to.
+ */
+void Map::IndexGridPosition(WorldObject* obj, Cell const& cell)
+{
+    GridPositionIndex*& block = m_positionIndex[cell.GridX()][cell.GridY()];
+    if (!block)
+    {
+        block = new GridPositionIndex();
+    }
+
+    // Filed twice without being dropped: the old row goes, or it would outlive the slot.
+    CellPositionIndex::Slot& slot = obj->GetPositionSlot();
+    if (slot.index)
+    {
+        slot.index->Remove(slot);
+    }
+
+    Geometry::Placement const& where = obj->Where();
+    block->cells[cell.CellX()][cell.CellY()].Insert(slot, obj, where.X(), where.Y(), where.Extent(),
+                                                    obj->GetTypeMask(), obj->GetPhaseMask());
+}
+
+/**
+ * @brief Drops the row of an object just removed from a cell's containers.
+ *
+ * The object's slot names the row, wherever the object has wandered since it was
+ * filed. An object with no row is left alone.
+ *
+ * @param obj The object removed.
+ */
+void Map::UnindexGridPosition(WorldObject* obj)
+{
+    CellPositionIndex::Slot& slot = obj->GetPositionSlot();
+    if (slot.index)
+    {
+        slot.index->Remove(slot);
+    }
+}
+
+/**
+ * @brief Refreshes the row of an object that moved, resized or changed phase in place.
+ *
+ * An object with no row -- one not in any grid container, such as a transport -- is
+ * left alone.
+ *
+ * @param obj The object that changed.
+ */
+void Map::UpdateGridPosition(WorldObject* obj)
+{
+    CellPositionIndex::Slot const& slot = obj->GetPositionSlot();
+    if (slot.index)
+    {
+        Geometry::Placement const& where = obj->Where();
+        slot.index->Update(slot, where.X(), where.Y(), where.Extent(), obj->GetPhaseMask());
+    }
+}
+
+/**
+ * @brief Collects the objects near a point from the position index of each cell in range.
+ *
+ * @param x The centre X coordinate.
+ * @param y The centre Y coordinate.
+ * @param radius The search radius, capped as Cell::Visit() caps it.
+ * @param typeMask The object types wanted.
+ * @param phaseMask The phases wanted.
+ * @param out Receives the objects found, cell by cell.
+ */
+void Map::CollectInCircle(float x, float y, float radius, uint16 typeMask, uint32 phaseMask,
+                          std::vector<WorldObject*>& out) const
+{
+    if (radius > 333.0f)
+    {
+        radius = 333.0f;
+    }
+
+    CellArea area = Cell::CalculateCellArea(x, y, radius);
+    for (uint32 cx = area.low_bound.x_coord; cx <= area.high_bound.x_coord; ++cx)
+    {
+        for (uint32 cy = area.low_bound.y_coord; cy <= area.high_bound.y_coord; ++cy)
+        {
+            Cell cell(CellPair(cx, cy));
+
+            // The cells Map::Visit() would walk without loading anything: those of a
+            // loaded grid, and the resident cells of an envelope grid.
+            NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
+            if (!grid || (!loaded(cell.gridPair()) && !grid->isCellObjectDataLoaded(cell.CellX(), cell.CellY())))
+            {
+                continue;
+            }
+
+            if (CellPositionIndex const* index = FindPositionIndex(cell.cellPair()))
+            {
+                index->CollectInCircle(x, y, radius, typeMask, phaseMask, out);
+            }
+        }
+    }
+}
+
+CellPositionIndex* Map::FindPositionIndex(CellPair const& cell) const
+{
+    if (cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+    {
+        return NULL;
+    }
+
+    GridPositionIndex* block = m_positionIndex[cell.x_coord / MAX_NUMBER_OF_CELLS][cell.y_coord / MAX_NUMBER_OF_CELLS];
+    return block ? &block->cells[cell.x_coord % MAX_NUMBER_OF_CELLS][cell.y_coord % MAX_NUMBER_OF_CELLS] : NULL;
 }
 
 /**
@@ -559,6 +700,7 @@ void Map::DeleteFromWorld(Player* pl)
 void
 Map::EnsureGridCreated(const GridPair& p)
 {
+    RegionSerialGuard guard(this);
     if (!getNGrid(p.x_coord, p.y_coord))
     {
         setNGrid(new NGridType(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD)),
@@ -583,6 +725,7 @@ Map::EnsureGridCreated(const GridPair& p)
 void
 Map::EnsureGridLoadedAtEnter(const Cell& cell, Player* player)
 {
+    RegionSerialGuard guard(this);
     NGridType* grid;
 
     bool useEnvelope = (player == NULL) && sWorld.getConfig(CONFIG_BOOL_LIVINGWORLD_CELL_ENVELOPE_LOAD) && IsContinent();
@@ -794,6 +937,7 @@ template<class T>
 void
 Map::Add(T* obj)
 {
+    RegionSerialGuard guard(this);
     MANGOS_ASSERT(obj);
 
     CellPair p = MaNGOS::ComputeCellPair(obj->Where().X(), obj->Where().Y());
@@ -973,6 +1117,8 @@ bool Map::loaded(const GridPair& p) const
  */
 void Map::Update(const uint32& t_diff)
 {
+    TickProfiler::Tick tick(m_tickHistory, GetId(), GetInstanceId(), false);
+    TickProfiler::Zone zone(TICK_ZONE_MAP_SESSIONS);
 
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -988,6 +1134,7 @@ void Map::Update(const uint32& t_diff)
     }
 
     /// update players at tick
+    zone.Next(TICK_ZONE_MAP_PLAYERS);
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* plr = m_mapRefIter->getSource();
@@ -998,7 +1145,14 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    // After the players have moved, so the pass sees where this tick left them.
+    if (sWorld.getConfig(CONFIG_BOOL_TERRAIN_PREFETCH) && IsContinent())
+    {
+        PredictGridPrefetch(t_diff);
+    }
+
     /// update active cells around players and active objects
+    zone.Next(TICK_ZONE_MAP_CELLS);
     resetMarkedCells();
 
     MaNGOS::ObjectUpdater updater(t_diff);
@@ -1007,6 +1161,20 @@ void Map::Update(const uint32& t_diff)
     // for pets
     TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
+    // A continent may split this pass into regions ticked on the map pool. The cells are
+    // then only marked and filed here, and visited by UpdateCellsInRegions() below.
+    bool const regionPass = UseRegionPass();
+    if (regionPass)
+    {
+        if (!m_regionPlan)
+        {
+            m_regionPlan = new MapRegionPlan(sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_REGION_GRIDS));
+        }
+        m_regionPlan->Reset();
+    }
+
+    std::chrono::steady_clock::time_point const cellPassStart = std::chrono::steady_clock::now();
+
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -1032,6 +1200,11 @@ void Map::Update(const uint32& t_diff)
                 {
                     markCell(cell_id);
                     CellPair pair(x, y);
+                    if (regionPass)
+                    {
+                        m_regionPlan->AddCell(pair);
+                        continue;
+                    }
                     Cell cell(pair);
                     cell.SetNoCreate();
                     Visit(cell, grid_object_update);
@@ -1072,6 +1245,11 @@ void Map::Update(const uint32& t_diff)
                     {
                         markCell(cell_id);
                         CellPair pair(x, y);
+                        if (regionPass)
+                        {
+                            m_regionPlan->AddCell(pair);
+                            continue;
+                        }
                         Cell cell(pair);
                         cell.SetNoCreate();
                         Visit(cell, grid_object_update);
@@ -1082,9 +1260,31 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    bool const splitPass = regionPass && UpdateCellsInRegions(t_diff);
+    uint64 const cellPassUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - cellPassStart).count();
+    if (splitPass)
+    {
+        ++m_regionStats.regionPasses;
+        m_regionStats.regionPassUs += cellPassUs;
+    }
+    else
+    {
+        ++m_regionStats.serialPasses;
+        m_regionStats.serialPassUs += cellPassUs;
+    }
+
+    // Everything has moved that is going to this tick: see it all in one go, before the
+    // field updates that assume the client already knows the object.
+    zone.Next(TICK_ZONE_MAP_VISIBILITY);
+    UpdateVisibilityPass();
+
     // Send world objects and item update field changes
+    zone.Next(TICK_ZONE_MAP_OBJECT_UPDATES);
     SendObjectUpdates();
 
+    zone.Next(TICK_ZONE_MAP_GRID_STATE);
+
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
@@ -1102,6 +1302,7 @@ void Map::Update(const uint32& t_diff)
     ProcessPendingCellUnloads();
 
     ///- Process necessary scripts
+    zone.Next(TICK_ZONE_MAP_SCRIPTS);
     if (!m_scriptSchedule.empty())
     {
         ScriptsProcess();
@@ -1124,6 +1325,7 @@ void Map::Update(const uint32& t_diff)
         i_data->Update(t_diff);
     }
 
+    zone.Stop();
     m_weatherSystem->UpdateWeathers(t_diff);
 
     // LAST ACT, and it must stay last: every vessel sailing this map takes its tick here,
@@ -1139,6 +1341,7 @@ void Map::Update(const uint32& t_diff)
         sMapMgr.m_TransportsByMap.find(GetId());
     if (sailing != sMapMgr.m_TransportsByMap.end())
     {
+        zone.Next(TICK_ZONE_MAP_TRANSPORTS);
         for (Transport* vessel : sailing->second)
         {
             if (vessel->GetMap() == this)
@@ -1150,6 +1353,620 @@ void Map::Update(const uint32& t_diff)
     }
 }
 
+/// How often the movers of a map are looked at for grids to read ahead.
+static const uint32 PREFETCH_PASS_MS = 500;
+/// Slower than this is someone standing about: the grids they need are already loaded.
+static const float PREFETCH_MIN_SPEED = 2.0f;
+/// Faster than this is no flight there is; it was a teleport, and no guess would have
+/// seen it coming.
+static const float PREFETCH_MAX_SPEED = 200.0f;
+
+/**
+ * @brief Asks the grid prefetcher for the grids this map's movers are heading into.
+ *
+ * A mover's velocity is how far it went since the last pass, and the grids it reaches
+ * within the configured lookahead, widened by the visibility distance, are read ahead.
+ * A player on a taxi follows the flight path instead: it turns where a straight line
+ * would not, and a flight is the fastest thing there is. Vessels need nothing here --
+ * every grid on a route is pinned when the vessel is created.
+ */
+void Map::PredictGridPrefetch(uint32 diff)
+{
+    m_prefetchTimer += diff;
+    if (m_prefetchTimer < PREFETCH_PASS_MS)
+    {
+        return;
+    }
+
+    float const seconds = m_prefetchTimer / 1000.0f;
+    float const lookahead = float(sWorld.getConfig(CONFIG_UINT32_TERRAIN_PREFETCH_LOOKAHEAD));
+    m_prefetchTimer = 0;
+    ++m_prefetchPass;
+
+    std::vector<uint32> wanted;
+
+    auto predict = [&](WorldObject* obj)
+    {
+        float const x = obj->Where().X();
+        float const y = obj->Where().Y();
+
+        PrefetchTrack& track = m_prefetchTracks[obj->GetObjectGuid()];
+        bool const seen = track.pass != 0;
+        float const dx = x - track.x;
+        float const dy = y - track.y;
+        track.x = x;
+        track.y = y;
+        track.pass = m_prefetchPass;
+
+        float const speed = std::sqrt(dx * dx + dy * dy) / seconds;
+        if (!seen || speed < PREFETCH_MIN_SPEED || speed > PREFETCH_MAX_SPEED)
+        {
+            return;
+        }
+
+        Player* player = obj->GetTypeId() == TYPEID_PLAYER ? static_cast<Player*>(obj) : NULL;
+        if (player && player->IsTaxiFlying() &&
+            player->GetMotionMaster()->GetCurrentMovementGeneratorType() == FLIGHT_MOTION_TYPE)
+        {
+            FlightPathMovementGenerator* flight = static_cast<FlightPathMovementGenerator*>(player->GetMotionMaster()->top());
+            TaxiPathNodeList const& path = flight->GetPath();
+
+            float budget = speed * lookahead;
+            float fromX = x;
+            float fromY = y;
+            for (uint32 i = flight->GetCurrentNode(); i < path.size() && budget > 0.0f; ++i)
+            {
+                TaxiPathNodeEntry const& node = path[i];
+                if (node.ContinentID != GetId())
+                {
+                    break;                                  // the rest is another map's
+                }
+
+                float const legX = node.LocX - fromX;
+                float const legY = node.LocY - fromY;
+                float const leg = std::sqrt(legX * legX + legY * legY);
+                float const part = leg > budget ? budget / leg : 1.0f;
+                PrefetchGridsAlong(fromX, fromY, fromX + legX * part, fromY + legY * part, wanted);
+
+                budget -= leg;
+                fromX = node.LocX;
+                fromY = node.LocY;
+            }
+            return;
+        }
+
+        float const scale = lookahead / seconds;
+        PrefetchGridsAlong(x, y, x + dx * scale, y + dy * scale, wanted);
+    };
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (plr && plr->IsInWorld())
+        {
+            predict(plr);
+        }
+    }
+    for (ActiveNonPlayers::const_iterator itr = m_activeNonPlayers.begin(); itr != m_activeNonPlayers.end(); ++itr)
+    {
+        if ((*itr)->IsInWorld())
+        {
+            predict(*itr);
+        }
+    }
+
+    // Whoever the pass did not see has left the map.
+    for (std::unordered_map<ObjectGuid, PrefetchTrack>::iterator itr = m_prefetchTracks.begin(); itr != m_prefetchTracks.end();)
+    {
+        if (itr->second.pass != m_prefetchPass)
+        {
+            itr = m_prefetchTracks.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+
+    std::sort(wanted.begin(), wanted.end());
+    wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+    for (uint32 packed : wanted)
+    {
+        sTerrainMgr.Prefetcher().Request(m_TerrainData, packed / MAX_NUMBER_OF_GRIDS, packed % MAX_NUMBER_OF_GRIDS);
+    }
+}
+
+/**
+ * @brief Collects the grids within visibility distance of the segment (x1,y1)-(x2,y2)
+ *        that this map has not loaded, as terrain coordinates packed gx * 64 + gy.
+ */
+void Map::PrefetchGridsAlong(float x1, float y1, float x2, float y2, std::vector<uint32>& wanted) const
+{
+    float const radius = GetVisibilityDistance();
+    float const length = std::sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1));
+
+    // Samples half a grid apart, each widened by the visibility distance, leave no grid
+    // the segment passes through unvisited.
+    uint32 const steps = uint32(length / (SIZE_OF_GRIDS / 2)) + 1;
+    for (uint32 s = 1; s <= steps; ++s)
+    {
+        float const px = x1 + (x2 - x1) * s / steps;
+        float const py = y1 + (y2 - y1) * s / steps;
+
+        float loX = px - radius, hiX = px + radius;
+        float loY = py - radius, hiY = py + radius;
+        MaNGOS::NormalizeMapCoord(loX);
+        MaNGOS::NormalizeMapCoord(hiX);
+        MaNGOS::NormalizeMapCoord(loY);
+        MaNGOS::NormalizeMapCoord(hiY);
+
+        GridPair const lo = MaNGOS::ComputeGridPair(loX, loY);
+        GridPair const hi = MaNGOS::ComputeGridPair(hiX, hiY);
+        for (uint32 gridX = lo.x_coord; gridX <= hi.x_coord && gridX < MAX_NUMBER_OF_GRIDS; ++gridX)
+        {
+            for (uint32 gridY = lo.y_coord; gridY <= hi.y_coord && gridY < MAX_NUMBER_OF_GRIDS; ++gridY)
+            {
+                // The terrain counts its grids from the other corner; see EnsureGridCreated.
+                uint32 const gx = (MAX_NUMBER_OF_GRIDS - 1) - gridX;
+                uint32 const gy = (MAX_NUMBER_OF_GRIDS - 1) - gridY;
+                if (!m_bLoadedGrids[gx][gy])
+                {
+                    wanted.push_back(gx * MAX_NUMBER_OF_GRIDS + gy);
+                }
+            }
+        }
+    }
+}
+
+namespace
+{
+    /// MaNGOS::ObjectUpdater for a region job: ticks what may run in a region, and
+    /// leaves the rest to the colour barrier.
+    struct RegionObjectUpdater
+    {
+        Map& i_map;
+        uint32 i_timeDiff;
+        RegionObjectUpdater(Map& map, uint32 diff) : i_map(map), i_timeDiff(diff) {}
+
+        template<class T> void Visit(GridRefManager<T>& m)
+        {
+            for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+            {
+                if (i_map.DeferRegionTick(iter->getSource()))
+                {
+                    continue;
+                }
+
+                WorldObject::UpdateHelper helper(iter->getSource());
+                helper.Update(i_timeDiff);
+            }
+        }
+        void Visit(PlayerMapType&) {}
+        void Visit(CorpseMapType&) {}
+        void Visit(CameraMapType&) {}
+    };
+}
+
+/**
+ * @brief Decides whether this tick's cell pass is split into regions.
+ *
+ * Only continents qualify: an instance is small enough that its whole pass is one
+ * region anyway. The pool must have a worker to spare besides the one running this
+ * map. A region must be more than twice as wide as the visibility distance: two
+ * regions of one colour are a single region apart, and objects on both sides of that
+ * region reach into it, so anything nearer than that could be read and changed by two
+ * workers at once. And moves must go through the batched visibility pass: a move
+ * redone at once writes the client sets of every player who sees it.
+ *
+ * @return true if the pass should be filed into m_regionPlan.
+ */
+bool Map::UseRegionPass() const
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_MAPUPDATE_REGIONS) || !IsContinent())
+    {
+        return false;
+    }
+
+#ifdef ENABLE_ELUNA
+    // A per-map Lua state is one interpreter; creature hooks from two regions would
+    // enter it at once.
+    if (GetEluna())
+    {
+        return false;
+    }
+#endif /* ENABLE_ELUNA */
+
+    if (sMapMgr.GetMapUpdater().worker_count() < 2)
+    {
+        return false;
+    }
+
+    if (!World::GetVisibilityBatchedPass())
+    {
+        return false;
+    }
+
+    return 2.0f * GetVisibilityDistance() < sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_REGION_GRIDS) * SIZE_OF_GRIDS;
+}
+
+/**
+ * @brief Ticks the cells filed into the region plan.
+ *
+ * Each colour's regions run together on the map pool, the calling thread included;
+ * the colours run one after another. Between two colours nothing is running: the seam
+ * relocations the finished colour deferred are replayed, and the objects it held back
+ * (see DeferRegionTick()) are ticked, here. A creature replayed into a region of a
+ * later colour may be ticked a second time this tick -- the same thing the serial pass
+ * does to a creature that walks into a cell it has not reached.
+ *
+ * @param t_diff The elapsed update time in milliseconds.
+ * @return false if the pass was too small to be worth splitting and ran serially.
+ */
+bool Map::UpdateCellsInRegions(uint32 t_diff)
+{
+    MapRegionPlan& plan = *m_regionPlan;
+
+    if (plan.RegionCount() < 2 || plan.CellCount() < sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_REGION_MIN_CELLS))
+    {
+        MaNGOS::ObjectUpdater updater(t_diff);
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+        for (uint32 colour = 0; colour < MapRegionPlan::COLOUR_COUNT; ++colour)
+        {
+            for (MapRegionPlan::Region const* region : plan.RegionsOf(colour))
+            {
+                for (CellPair const& pair : region->cells)
+                {
+                    Cell cell(pair);
+                    cell.SetNoCreate();
+                    Visit(cell, grid_object_update);
+                    Visit(cell, world_object_update);
+                }
+            }
+        }
+        return false;
+    }
+
+    MapUpdater& pool = sMapMgr.GetMapUpdater();
+    std::vector<std::function<void()> > jobs;
+
+    m_regionPassActive = true;
+
+    for (uint32 colour = 0; colour < MapRegionPlan::COLOUR_COUNT; ++colour)
+    {
+        std::vector<MapRegionPlan::Region*> const& regions = plan.RegionsOf(colour);
+        if (regions.empty())
+        {
+            continue;
+        }
+
+        jobs.clear();
+        for (MapRegionPlan::Region const* region : regions)
+        {
+            jobs.push_back([this, &plan, region, t_diff]()
+            {
+                MapRegionPlan::RegionScope scope(plan, *region);
+
+                RegionObjectUpdater updater(*this, t_diff);
+                TypeContainerVisitor<RegionObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+                TypeContainerVisitor<RegionObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+                for (CellPair const& pair : region->cells)
+                {
+                    Cell cell(pair);
+                    cell.SetNoCreate();
+                    Visit(cell, grid_object_update);
+                    Visit(cell, world_object_update);
+                }
+            });
+        }
+
+        pool.run_parallel(jobs);
+
+        // The colour barrier: every region of this colour has stopped.
+        ApplySeamHandoffs();
+        TickDeferredObjects(t_diff);
+    }
+
+    m_regionPassActive = false;
+
+    m_regionStats.regionsTicked += plan.RegionCount();
+    m_regionStats.cellsTicked += plan.CellCount();
+    m_regionStats.lastRegionCount = plan.RegionCount();
+    return true;
+}
+
+/**
+ * @brief Records a creature move that would cross out of the region being ticked.
+ *
+ * @param creature The creature moving.
+ * @param x Destination X coordinate.
+ * @param y Destination Y coordinate.
+ * @param z Destination Z coordinate.
+ * @param orientation Destination orientation.
+ * @return true if the move was deferred to the colour barrier.
+ */
+bool Map::DeferSeamRelocation(Creature* creature, float x, float y, float z, float orientation)
+{
+    MapRegionPlan::Region const* region = MapRegionPlan::CurrentRegion();
+    if (!region || MapRegionPlan::CurrentPlan() != m_regionPlan)
+    {
+        return false;
+    }
+
+    if (m_regionPlan->Contains(*region, MaNGOS::ComputeCellPair(x, y)))
+    {
+        return false;
+    }
+
+    SeamHandoff handoff;
+    handoff.guid = creature->GetObjectGuid();
+    handoff.x = x;
+    handoff.y = y;
+    handoff.z = z;
+    handoff.orientation = orientation;
+
+    std::lock_guard<std::mutex> guard(m_seamLock);
+    m_seamHandoffs.push_back(handoff);
+    return true;
+}
+
+/**
+ * @brief Holds back every creature not known to keep to its region.
+ *
+ * An allowlist, not a list of what is known to be unsafe: a creature ticks in the
+ * region only if nothing its tick can run reaches past what is near it. That rules
+ * out a script or EventAI (script state is shared, and scripts find others by GUID),
+ * a link or a pool (both reach spawns anywhere on the map), and anything dead, fighting,
+ * casting, owned or following. What is left -- a plain spawn idling, wandering or
+ * walking its waypoints -- reads and writes only itself and what stands near it.
+ *
+ * @param creature The creature about to be ticked by a region job.
+ * @return true if it was recorded for the barrier.
+ */
+bool Map::DeferRegionTick(Creature* creature)
+{
+    char const* aiName = creature->GetCreatureInfo()->AIName;
+    bool const regionLocal =
+        creature->IsAlive() && !creature->IsDeadByDefault() && !creature->IsInCombat() && !creature->getVictim() &&
+        !creature->IsNonMeleeSpellCasted(false) && creature->GetCharmerOrOwnerGuid().IsEmpty() &&
+        creature->GetMotionMaster()->GetCurrentMovementGeneratorType() != FOLLOW_MOTION_TYPE &&
+        (!aiName || !aiName[0]) && !creature->GetScriptId() &&
+        !sPoolMgr.IsPartOfAPool<Creature>(creature->GetGUIDLow()) &&
+        !sCreatureLinkingMgr.GetLinkedTriggerInformation(creature) && !sCreatureLinkingMgr.IsLinkedMaster(creature);
+
+    if (regionLocal)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_seamLock);
+    m_deferredTicks.push_back(creature->GetObjectGuid());
+    return true;
+}
+
+/**
+ * @brief Holds back every game object: traps, doors, chests and their scripts are not
+ *        shown to keep to a region.
+ *
+ * @param go The game object about to be ticked by a region job.
+ * @return true, always.
+ */
+bool Map::DeferRegionTick(GameObject* go)
+{
+    std::lock_guard<std::mutex> guard(m_seamLock);
+    m_deferredTicks.push_back(go->GetObjectGuid());
+    return true;
+}
+
+/**
+ * @brief Holds back every dynamic object: each acts for its caster, wherever that is.
+ *
+ * @param dynObj The dynamic object about to be ticked by a region job.
+ * @return true, always.
+ */
+bool Map::DeferRegionTick(DynamicObject* dynObj)
+{
+    std::lock_guard<std::mutex> guard(m_seamLock);
+    m_deferredTicks.push_back(dynObj->GetObjectGuid());
+    return true;
+}
+
+/**
+ * @brief Whether the calling thread is ticking one of this map's regions.
+ */
+bool Map::InRegionJob() const
+{
+    return MapRegionPlan::CurrentRegion() && MapRegionPlan::CurrentPlan() == m_regionPlan;
+}
+
+/**
+ * @brief Queues map-wide work started inside a region for the next colour barrier.
+ *
+ * @param task The work; it runs on the map's own thread with no region running.
+ */
+void Map::RunAtColourBarrier(std::function<void()> task)
+{
+    std::lock_guard<std::mutex> guard(m_seamLock);
+    m_barrierTasks.push_back(std::move(task));
+}
+
+/**
+ * @brief Ticks the objects the colour that just finished held back.
+ *
+ * Runs on the map's own thread with no region running, in the order the objects were
+ * held back per region; one removed in the meantime is skipped. The tasks the colour
+ * queued through RunAtColourBarrier() run first.
+ *
+ * @param t_diff The elapsed update time in milliseconds.
+ */
+void Map::TickDeferredObjects(uint32 t_diff)
+{
+    std::vector<ObjectGuid> deferred;
+    std::vector<std::function<void()> > tasks;
+    {
+        std::lock_guard<std::mutex> guard(m_seamLock);
+        deferred.swap(m_deferredTicks);
+        tasks.swap(m_barrierTasks);
+    }
+
+    for (std::function<void()>& task : tasks)
+    {
+        task();
+    }
+
+    for (ObjectGuid const& guid : deferred)
+    {
+        WorldObject* obj = GetWorldObject(guid);
+        if (!obj || !obj->IsInWorld())
+        {
+            continue;
+        }
+
+        WorldObject::UpdateHelper helper(obj);
+        helper.Update(t_diff);
+        ++m_regionStats.deferredTicks;
+    }
+}
+
+/**
+ * @brief Replays the seam relocations deferred by the colour that just finished.
+ *
+ * Runs on the map's own thread with no region running. Moves are applied in the order
+ * they were recorded per region; a creature removed in the meantime is skipped.
+ */
+void Map::ApplySeamHandoffs()
+{
+    std::vector<SeamHandoff> handoffs;
+    {
+        std::lock_guard<std::mutex> guard(m_seamLock);
+        handoffs.swap(m_seamHandoffs);
+    }
+
+    for (SeamHandoff const& handoff : handoffs)
+    {
+        Creature* creature = GetAnyTypeCreature(handoff.guid);
+        if (!creature || !creature->IsInWorld())
+        {
+            continue;
+        }
+
+        CreatureRelocation(creature, handoff.x, handoff.y, handoff.z, handoff.orientation);
+        ++m_regionStats.seamHandoffs;
+    }
+}
+
+/**
+ * @brief Records a unit whose visibility must be redone at the next pass.
+ *
+ * @param unit The unit that moved past the relocation limit.
+ */
+void Map::AddToVisibilityPass(Unit* unit)
+{
+    // What the move would have cost at once: a sweep for the unit's viewers (counted as
+    // one, however many there are) and a visit for the cameras that may see it.
+    uint32 immediate = unit->GetViewPoint().hasViewers() ? 2 : 1;
+
+    RegionSerialGuard guard(this);
+    m_visibilityPending.insert(unit->GetObjectGuid());
+    ++m_visibilityStats.relocations;
+    m_visibilityStats.immediateVisits += immediate;
+}
+
+/**
+ * @brief Redoes the visibility of every unit that moved since the last pass.
+ *
+ * Two halves, as at each move before. The moved unit's own viewers sweep their
+ * surroundings -- one grid visit each, and one per tick however often the unit moved.
+ * Then every camera near a moved unit is told of it. Those cameras come from a hash of
+ * this map's cameras built once per pass, not from a grid visit per unit, and a camera
+ * that has just swept is skipped: its sweep saw every moved unit where it stands now.
+ */
+void Map::UpdateVisibilityPass()
+{
+    if (m_visibilityPending.empty())
+    {
+        return;
+    }
+
+    // A sweep can move nothing, but a script reacting to one could; anything recorded
+    // from here on waits for the next pass.
+    GuidSet pending;
+    pending.swap(m_visibilityPending);
+
+    m_visibilityMoved.clear();
+    for (GuidSet::const_iterator itr = pending.begin(); itr != pending.end(); ++itr)
+    {
+        WorldObject* obj = GetWorldObject(*itr);
+        if (obj && obj->IsInWorld())
+        {
+            m_visibilityMoved.push_back(obj);
+        }
+    }
+
+    ++m_visibilityStats.passes;
+    m_visibilityStats.objects += m_visibilityMoved.size();
+
+    for (WorldObject* obj : m_visibilityMoved)
+    {
+        if (obj->GetViewPoint().hasViewers())
+        {
+            obj->GetViewPoint().Call_UpdateVisibilityForOwner();
+            ++m_visibilityStats.sweeps;
+        }
+    }
+
+    // As far as the cell visit it replaces reached: the visibility distance, and up to a
+    // cell beyond it where the cell it ends in sticks out.
+    float const reach = GetVisibilityDistance() + SIZE_OF_GRID_CELL;
+    float const reachSq = reach * reach;
+
+    m_viewerHash.Reset(reach);
+    m_visibilityCameras.clear();
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (!plr || !plr->IsInWorld())
+        {
+            continue;
+        }
+
+        Camera& camera = plr->GetCamera();
+        WorldObject* body = camera.GetBody();
+        if (!body || !body->IsInWorld() || body->GetMap() != this || pending.find(body->GetObjectGuid()) != pending.end())
+        {
+            continue;
+        }
+
+        m_viewerHash.Add(body->Where().X(), body->Where().Y(), uint32(m_visibilityCameras.size()));
+        m_visibilityCameras.push_back(&camera);
+    }
+
+    if (m_visibilityCameras.empty())
+    {
+        return;
+    }
+    m_viewerHash.Build();
+
+    for (WorldObject* obj : m_visibilityMoved)
+    {
+        float const x = obj->Where().X();
+        float const y = obj->Where().Y();
+        m_visibilityStats.cameraChecks += m_viewerHash.ForEachNear(x, y, [&](uint32 index)
+        {
+            Camera* camera = m_visibilityCameras[index];
+            WorldObject* body = camera->GetBody();
+            float const dx = body->Where().X() - x;
+            float const dy = body->Where().Y() - y;
+            if (dx * dx + dy * dy <= reachSq)
+            {
+                camera->UpdateVisibilityOf(obj);
+            }
+        });
+    }
+}
+
 /**
  * @brief Removes a player from the map and optionally deletes it.
  *
@@ -1231,6 +2048,7 @@ template<class T>
 void
 Map::Remove(T* obj, bool remove)
 {
+    RegionSerialGuard guard(this);
     CellPair p = MaNGOS::ComputeCellPair(obj->Where().X(), obj->Where().Y());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -1376,6 +2194,10 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         NGridType* newGrid = getNGrid(new_cell.GridX(), new_cell.GridY());
         player->GetViewPoint().Event_GridChanged(&(*newGrid)(new_cell.CellX(), new_cell.CellY()));
     }
+    else
+    {
+        UpdateGridPosition(player);
+    }
 
     player->OnRelocated();
 
@@ -1398,6 +2220,13 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
  */
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang)
 {
+    // Leaving the region being ticked: the destination belongs to a region that may not
+    // be ours to touch yet. The move is replayed at the colour barrier.
+    if (DeferSeamRelocation(creature, x, y, z, ang))
+    {
+        return;
+    }
+
     MANGOS_ASSERT(CheckGridIntegrity(creature, false));
 
     Cell old_cell = creature->GetCurrentCell();
@@ -1409,6 +2238,7 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
         // update pos
         creature->Place().MoveTo(x, y, z, ang);
         creature->m_movementInfo.Report(x, y, z, ang);
+        UpdateGridPosition(creature);                       // re-filed above at the old position
         creature->OnRelocated();
     }
     // if creature can't be move in new cell/grid (not loaded) move it to repawn cell/grid
@@ -1583,6 +2413,7 @@ bool Map::CreatureRespawnRelocation(Creature* c)
     if (CreatureCellRelocation(c, resp_cell))
     {
         c->Place().MoveTo(resp_x, resp_y, resp_z, resp_o);
+        UpdateGridPosition(c);
         c->GetMotionMaster()->Initialize();                 // prevent possible problems with default move generators
         c->OnRelocated();
         return true;
@@ -1808,6 +2639,11 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
         unloader.UnloadN();
         delete getNGrid(x, y);
         setNGrid(NULL, x, y);
+
+        // What the unloader left is the world container -- corpses, which outlive the
+        // grid. Their rows go with it; a reload files them again.
+        delete m_positionIndex[x][y];
+        m_positionIndex[x][y] = NULL;
     }
 
     int gx = (MAX_NUMBER_OF_GRIDS - 1) - x;
@@ -2050,6 +2886,7 @@ inline void Map::setNGrid(NGridType* grid, uint32 x, uint32 y)
  */
 void Map::AddObjectToRemoveList(WorldObject* obj)
 {
+    RegionSerialGuard guard(this);
     MANGOS_ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
 #ifdef ENABLE_ELUNA
@@ -2231,6 +3068,7 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
  */
 void Map::AddToActive(WorldObject* obj)
 {
+    RegionSerialGuard guard(this);
     m_activeNonPlayers.insert(obj);
     Cell cell = Cell(MaNGOS::ComputeCellPair(obj->Where().X(), obj->Where().Y()));
     EnsureGridLoadedAtEnter(cell); // player==null → envelope when CellEnvelopeLoad is on
@@ -2270,6 +3108,7 @@ void Map::AddToActive(WorldObject* obj)
  */
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    RegionSerialGuard guard(this);
     // Map::Update for active object in proccess
     if (m_activeNonPlayersIter != m_activeNonPlayers.end())
     {
@@ -2926,6 +3765,7 @@ bool Map::CanEnter(Player* player)
  */
 bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* target, ScriptExecutionParam execParams /*=SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE_TARGET*/)
 {
+    RegionSerialGuard guard(this);
     MANGOS_ASSERT(source);
 
     ///- Find the script chain map
@@ -2984,6 +3824,7 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
  */
 void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target)
 {
+    RegionSerialGuard guard(this);
     // NOTE: script record _must_ exist until command executed
 
     // prepare static data
@@ -3208,6 +4049,7 @@ void Map::SendObjectUpdates()
  */
 uint32 Map::GenerateLocalLowGuid(HighGuid guidhigh)
 {
+    RegionSerialGuard guard(this);
     // TODO: for map local guid counters possible force reload map instead shutdown server at guid counter overflow
     switch (guidhigh)
     {
@@ -3340,6 +4182,20 @@ bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float
            && m_dyn_tree.IsInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
 }
 
+void Map::IsInLineOfSight(Geometry::Vector3 const* from, Geometry::Vector3 const* to, uint32 count, uint32 phasemask, bool* visible) const
+{
+    thread_local std::vector<float> staticFrac, dynFrac;
+    staticFrac.resize(count);
+    dynFrac.resize(count);
+
+    m_TerrainData->NearestHitFractions(from, to, count, staticFrac.data());
+    m_dyn_tree.NearestHitFractions(from, to, count, phasemask, dynFrac.data());
+    for (uint32 i = 0; i < count; ++i)
+    {
+        visible[i] = staticFrac[i] > 1.0f && dynFrac[i] > 1.0f;
+    }
+}
+
 /**
  * get the hit position and return true if we hit something (in this case the dest position will hold the hit-position)
  * otherwise the result pos will be the dest pos
@@ -54,9 +54,11 @@
 
 #include "Utilities/Errors.h"
 #include <ctime>
+#include <functional>
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include "Platform/Define.h"
 #include <mutex>
 #include <shared_mutex>
@@ -74,6 +76,9 @@
 #include "ScriptMgr.h"
 #include "CreatureLinkingMgr.h"
 #include "DynamicCollision.h"
+#include "TickProfiler.h"
+#include "ViewerHash.h"
+#include "CellPositionIndex.h"
 #ifdef ENABLE_ELUNA
 #include "LuaValue.h"
 #endif /* ENABLE_ELUNA */
@@ -87,6 +92,7 @@ class Creature;
 class Eluna;
 #endif /* ENABLE_ELUNA */
 class Unit;
+class Camera;
 class WorldPacket;
 class InstanceData;
 class Group;
@@ -101,6 +107,7 @@ class TransportMap;
 class TerrainInfo;
 class GameObjectModel;
 class WeatherSystem;
+class MapRegionPlan;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -183,6 +190,11 @@ class Map : public GridRefManager<NGridType>
 
         virtual void Update(const uint32&);
 
+        /// This map's last tick on the map pool, in microseconds. MapUpdater starts the
+        /// costliest maps first; 0 until the map has been ticked there once.
+        uint32 GetUpdateCostHint() const { return m_updateCostHint; }
+        void SetUpdateCostHint(uint32 us) { m_updateCostHint = us; }
+
         void MessageBroadcast(Player const*, WorldPacket*, bool to_self);
         void MessageBroadcast(WorldObject const*, WorldPacket*);
         void MessageDistBroadcast(Player const*, WorldPacket*, float dist, bool to_self, bool own_team_only = false);
@@ -352,11 +364,13 @@ class Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
+            RegionSerialGuard guard(this);
             i_objectsToClientUpdate.insert(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
+            RegionSerialGuard guard(this);
             i_objectsToClientUpdate.erase(obj);
         }
 
@@ -408,6 +422,17 @@ class Map : public GridRefManager<NGridType>
         /// core code uses Floor().
         float GetHeight(uint32 phasemask, float x, float y, float z) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+
+        /**
+         * @brief IsInLineOfSight for `count` sight lines from[i] -> to[i] at once.
+         *
+         * Each baked model and each game object is walked once for every four lines
+         * that reach it, rather than once per line, so a caster checking the units
+         * around it pays for the walls between them about once.
+         *
+         * @param visible visible[i] is set to whether line i is clear.
+         */
+        void IsInLineOfSight(Geometry::Vector3 const* from, Geometry::Vector3 const* to, uint32 count, uint32 phasemask, bool* visible) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
@@ -465,6 +490,111 @@ class Map : public GridRefManager<NGridType>
             return grid ? grid->loadedCellCount() : 0;
         }
 
+        /// What the region pass (MapUpdate.Regions) has done on this map since start-up,
+        /// next to what the serial cell pass cost, so the two can be compared in place.
+        struct RegionTickStats
+        {
+            uint32 serialPasses = 0;      // cell passes run on the map's own thread
+            uint64 serialPassUs = 0;      // ... and their total wall time
+            uint32 regionPasses = 0;      // cell passes split into regions
+            uint64 regionPassUs = 0;      // ... and their total wall time
+            uint32 regionsTicked = 0;     // regions run, summed over all region passes
+            uint32 cellsTicked = 0;       // cells visited by region passes
+            uint32 seamHandoffs = 0;      // relocations deferred to a colour barrier
+            uint32 deferredTicks = 0;     // object ticks deferred to a colour barrier
+            uint32 lastRegionCount = 0;   // regions in the most recent region pass
+        };
+        RegionTickStats const& GetRegionTickStats() const { return m_regionStats; }
+
+        /// What the batched visibility pass (Visibility.BatchedPass) has done on this map
+        /// since start-up, next to the grid visits the same relocations would have cost
+        /// one at a time.
+        struct VisibilityPassStats
+        {
+            uint32 passes = 0;            // passes that had anything to do
+            uint64 relocations = 0;       // moves past the relocation limit, as recorded
+            uint64 objects = 0;           // distinct objects the passes looked at
+            uint64 sweeps = 0;            // viewer sweeps run, one grid visit each
+            uint64 cameraChecks = 0;      // cameras the viewer hash offered for a moved object
+            uint64 immediateVisits = 0;   // grid visits the relocations would have made at once
+        };
+        VisibilityPassStats const& GetVisibilityPassStats() const { return m_visibilityStats; }
+
+        /**
+         * @brief Records that @p unit moved far enough for its visibility to be redone.
+         *
+         * The work is left to the next UpdateVisibilityPass(), however often the unit
+         * moves before it. Safe from a region worker.
+         */
+        void AddToVisibilityPass(Unit* unit);
+
+        /**
+         * @brief Appends every object of @p typeMask in @p phaseMask whose extent reaches
+         *        within @p radius of (@p x, @p y), from the position index of each cell in range.
+         *
+         * Covers the cells Cell::VisitAllObjects() would with dont_load set, and never
+         * loads one. The test is 2D and padded by each object's extent: the caller still
+         * makes its own exact check, but only on what this returns.
+         */
+        void CollectInCircle(float x, float y, float radius, uint16 typeMask, uint32 phaseMask,
+                             std::vector<WorldObject*>& out) const;
+
+        /**
+         * @brief Keep the position index in step with the grid containers.
+         *
+         * AddToGrid() and RemoveFromGrid() file and drop rows themselves; these are for
+         * the loaders and unloaders that fill and empty cells directly, and for anything
+         * that moves, resizes or rephases an object without moving it between cells.
+         */
+        void IndexGridPosition(WorldObject* obj, Cell const& cell);
+        /// Drop the row of @p obj, from whichever cell it was filed in.
+        void UnindexGridPosition(WorldObject* obj);
+        /// Refresh the row of @p obj after a move inside its cell, a resize or a phase change.
+        void UpdateGridPosition(WorldObject* obj);
+
+        /// Per-phase timing of this map's ticks, for `.debug ticks`.
+        TickProfiler::History& GetTickHistory() { return m_tickHistory; }
+
+        /**
+         * @brief A creature relocation that would leave the region being ticked.
+         *
+         * During a region pass only the region's own cells may change. A move across the
+         * seam is recorded here instead of being applied, and replayed through
+         * CreatureRelocation() by the map's own thread once the colour has finished.
+         *
+         * @return true if the move was deferred and the caller must not apply it.
+         */
+        bool DeferSeamRelocation(Creature* creature, float x, float y, float z, float orientation);
+
+        /**
+         * @brief Holds back, to the colour barrier, the tick of any object not known to keep to its region.
+         *
+         * Region workers only keep apart what is near: anything an object finds by GUID
+         * rather than by distance -- a victim, a threat list, a spell target, an owner, a
+         * pool or linked spawn, script state -- may be in, or shared with, another region
+         * of the same colour. So only creatures on an allowlist tick in the region: plain
+         * spawns, alive and out of combat, with no script, EventAI, pool or link. Every
+         * other object is recorded here and ticked by the map's own thread once the
+         * colour has stopped.
+         *
+         * @return true if the tick was deferred and the region must skip the object.
+         */
+        bool DeferRegionTick(Creature* creature);
+        bool DeferRegionTick(GameObject* go);
+        bool DeferRegionTick(DynamicObject* dynObj);
+
+        /// True on a thread ticking one of this map's regions.
+        bool InRegionJob() const;
+
+        /**
+         * @brief Runs @p task on the map's own thread at the next colour barrier.
+         *
+         * For the map-wide work an object ticked inside a region may still start -- a
+         * pool choosing a replacement spawn, a linking event waking creatures elsewhere.
+         * The task must look up by GUID whatever it needs; only the map is sure to exist.
+         */
+        void RunAtColourBarrier(std::function<void()> task);
+
         bool IsCellAnchorProtected(uint32 gridX, uint32 gridY, uint32 cellX, uint32 cellY) const;
         bool HasPlayerInOrAroundGrid(uint32 gridX, uint32 gridY) const;
         bool IsCellLoaded(float x, float y) const;
@@ -476,9 +606,56 @@ class Map : public GridRefManager<NGridType>
         LuaVal lua_data = LuaVal({});
 #endif /* ENABLE_ELUNA */
 
+        /**
+         * @brief Serialises map-wide containers while a region pass is running.
+         *
+         * The region pass only partitions cells. Everything the map keeps for the whole
+         * map -- the client update set, the remove list, the object store, the script
+         * schedule, the guid counters, grid creation, the persistent state's respawn
+         * times -- is still one structure, and any region may reach it. Outside a region
+         * pass the guard takes no lock at all.
+         */
+        class RegionSerialGuard
+        {
+            public:
+                explicit RegionSerialGuard(Map const* map)
+                    : m_lock(map && map->m_regionPassActive ? &map->m_regionLock : NULL)
+                {
+                    if (m_lock)
+                    {
+                        m_lock->lock();
+                    }
+                }
+                ~RegionSerialGuard()
+                {
+                    if (m_lock)
+                    {
+                        m_lock->unlock();
+                    }
+                }
+
+            private:
+                RegionSerialGuard(RegionSerialGuard const&);
+                RegionSerialGuard& operator=(RegionSerialGuard const&);
+
+                std::recursive_mutex* m_lock;
+        };
+
     private:
         void LoadMapAndVMap(int gx, int gy);
 
+        /// True if this tick's cell pass should be split into regions.
+        bool UseRegionPass() const;
+        /// Tick the cells filed into m_regionPlan, region by region, colour by colour.
+        /// @return false if the pass was too small to split and ran on this thread.
+        bool UpdateCellsInRegions(uint32 t_diff);
+        /// Replay the seam relocations deferred during the colour that just finished.
+        void ApplySeamHandoffs();
+        /// Tick the objects DeferRegionTick() held back during the colour that just finished.
+        void TickDeferredObjects(uint32 t_diff);
+        /// Redo the visibility of everything AddToVisibilityPass() recorded since the last pass.
+        void UpdateVisibilityPass();
+
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
         void SendInitSelf(Player* player);
@@ -496,6 +673,10 @@ class Map : public GridRefManager<NGridType>
         void UnloadCell(NGridType* grid, uint32 cellX, uint32 cellY);
         void ProcessPendingCellUnloads();
 
+        /// Asks the grid prefetcher for the grids this map's movers are heading into.
+        void PredictGridPrefetch(uint32 diff);
+        void PrefetchGridsAlong(float x1, float y1, float x2, float y2, std::vector<uint32>& wanted) const;
+
         void buildNGridLinkage(NGridType* pNGridType) { pNGridType->link(this); }
 
         template<class T> void AddType(T* obj);
@@ -531,6 +712,7 @@ class Map : public GridRefManager<NGridType>
         uint32 i_id;
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
+        uint32 m_updateCostHint;
         float m_VisibleDistance;
         std::multiset<float> m_cinematicViewerRadii;  ///< radii of active cinematic flyover viewers on this map
         float m_cinematicViewerRadius;                ///< cached largest of m_cinematicViewerRadii (0 when none)
@@ -591,6 +773,17 @@ class Map : public GridRefManager<NGridType>
         template<class T>
         void RemoveFromGrid(T*, NGridType*, Cell const&);
 
+        /// The position index of every cell of one grid, allocated with the first row
+        /// filed in the grid and freed when the grid unloads.
+        struct GridPositionIndex
+        {
+            CellPositionIndex cells[MAX_NUMBER_OF_CELLS][MAX_NUMBER_OF_CELLS];
+        };
+        GridPositionIndex* m_positionIndex[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+
+        /// The position index of @p cell, or NULL if nothing was ever filed in its grid.
+        CellPositionIndex* FindPositionIndex(CellPair const& cell) const;
+
         // Holder for information about linked mobs
         CreatureLinkingHolder m_creatureLinkingHolder;
 
@@ -600,6 +793,44 @@ class Map : public GridRefManager<NGridType>
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 
+        /// Where a mover stood at the last prediction pass; its velocity is the difference.
+        struct PrefetchTrack
+        {
+            float x, y;
+            uint32 pass;    ///< the last pass that saw it, so the departed can be dropped
+        };
+        std::unordered_map<ObjectGuid, PrefetchTrack> m_prefetchTracks;
+        uint32 m_prefetchTimer;
+        uint32 m_prefetchPass;
+
+        /// A creature move held back at a region seam; see DeferSeamRelocation().
+        struct SeamHandoff
+        {
+            ObjectGuid guid;
+            float x, y, z, orientation;
+        };
+
+        // Region pass state. The plan is created on the first region pass and reused.
+        MapRegionPlan* m_regionPlan;
+        /// Written only by the map's own thread, before it queues region jobs and after it
+        /// has collected them; the pool's queue mutex orders it for the workers.
+        bool m_regionPassActive;
+        mutable std::recursive_mutex m_regionLock;
+        std::mutex m_seamLock;
+        std::vector<SeamHandoff> m_seamHandoffs;
+        std::vector<ObjectGuid> m_deferredTicks;
+        std::vector<std::function<void()> > m_barrierTasks;
+        RegionTickStats m_regionStats;
+
+        // Batched visibility pass state; see UpdateVisibilityPass(). The containers are
+        // kept between passes for their storage.
+        GuidSet m_visibilityPending;
+        std::vector<WorldObject*> m_visibilityMoved;
+        std::vector<Camera*> m_visibilityCameras;
+        ViewerHash m_viewerHash;
+        VisibilityPassStats m_visibilityStats;
+        TickProfiler::History m_tickHistory;
+
 #ifdef ENABLE_ELUNA
         Eluna* eluna;
 #endif /* ENABLE_ELUNA */
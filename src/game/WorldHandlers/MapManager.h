@@ -83,6 +83,9 @@ class MapManager : public MaNGOS::Singleton<MapManager>
         void Initialize(void);
         void Update(uint32);
 
+        /// The map worker pool. A continent's region pass borrows its idle workers.
+        MapUpdater& GetMapUpdater() { return m_updater; }
+
         void SetGridCleanUpDelay(uint32 t)
         {
             if (t < MIN_GRID_DELAY)
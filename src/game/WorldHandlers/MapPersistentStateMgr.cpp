@@ -121,6 +121,8 @@ bool MapPersistentState::UnloadIfEmpty()
  */
 void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
 {
+    Map::RegionSerialGuard guard(m_usedByMap);             // any region may save a respawn
+
     SetCreatureRespawnTime(loguid, t);
 
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
@@ -154,6 +156,8 @@ void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
  */
 void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
 {
+    Map::RegionSerialGuard guard(m_usedByMap);             // any region may save a respawn
+
     SetGORespawnTime(loguid, t);
 
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
@@ -187,6 +191,8 @@ void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
  */
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
 {
+    Map::RegionSerialGuard guard(m_usedByMap);
+
     if (t > sWorld.GetGameTime())
     {
         m_creatureRespawnTimes[loguid] = t;
@@ -206,6 +212,8 @@ void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
  */
 void MapPersistentState::SetGORespawnTime(uint32 loguid, time_t t)
 {
+    Map::RegionSerialGuard guard(m_usedByMap);
+
     if (t > sWorld.GetGameTime())
     {
         m_goRespawnTimes[loguid] = t;
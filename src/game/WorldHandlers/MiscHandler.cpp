@@ -171,30 +171,30 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
 
     DEBUG_LOG("Minlvl %u, maxlvl %u, name %s, guild %s, racemask %u, classmask %u, zones %u, strings %u", level_min, level_max, player_name.c_str(), guild_name.c_str(), racemask, classmask, zones_count, str_count);
 
-    std::wstring str[4];                                    // 4 is client limit
+    PlayerDirectory::WhoQuery query;
     for (uint32 i = 0; i < str_count; ++i)
     {
         std::string temp;
         recv_data >> temp;                                  // user entered string, it used as universal search pattern(guild+player name)?
 
-        if (!Utf8toWStr(temp, str[i]))
+        std::wstring wtemp;
+        if (!Utf8toWStr(temp, wtemp))
         {
             continue;
         }
 
-        wstrToLower(str[i]);
+        wstrToLower(wtemp);
+        query.strings.push_back(wtemp);
 
         DEBUG_LOG("String %u: %s", i, temp.c_str());
     }
 
-    std::wstring wplayer_name;
-    std::wstring wguild_name;
-    if (!(Utf8toWStr(player_name, wplayer_name) && Utf8toWStr(guild_name, wguild_name)))
+    if (!(Utf8toWStr(player_name, query.name) && Utf8toWStr(guild_name, query.guild)))
     {
         return;
     }
-    wstrToLower(wplayer_name);
-    wstrToLower(wguild_name);
+    wstrToLower(query.name);
+    wstrToLower(query.guild);
 
     // client send in case not set max level value 100 but mangos support 255 max level,
     // update it to show GMs with characters after 100 level
@@ -208,150 +208,74 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
     bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
     AccountTypes gmLevelInWhoList = (AccountTypes)sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST);
 
+    query.levelMin = level_min;
+    query.levelMax = level_max;
+    query.raceMask = racemask;
+    query.classMask = classmask;
+    query.zones.assign(zoneids, zoneids + zones_count);
+    // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
+    query.team = (security == SEC_PLAYER && !allowTwoSideWhoList) ? uint32(team) : 0;
+    query.limit = 50;
+
     WorldPacket data(SMSG_WHO, 50);                         // guess size
     data << uint32(clientcount);                            // clientcount place holder, listed count
     data << uint32(clientcount);                            // clientcount place holder, online count
 
-    uint32 count = 0;
-    sPlayerRegistry.ForEach([&](Player* pl)->void
+    // Zone names are only read for free strings the player's name and guild did not
+    // match, and each zone once per query.
+    std::map<std::pair<uint32, std::wstring const*>, bool> areaFit;
+    LocaleConstant locale = GetSessionDbcLocale();
+    auto areaFits = [&](uint32 zoneId, std::wstring const& s) -> bool
     {
-        ++count;
-
-        if (clientcount == 50)
+        std::pair<std::map<std::pair<uint32, std::wstring const*>, bool>::iterator, bool> memo =
+            areaFit.insert(std::make_pair(std::make_pair(zoneId, &s), false));
+        if (memo.second)
         {
-            return;
+            AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(zoneId);
+            memo.first->second = areaEntry && Utf8FitTo(areaEntry->AreaName_lang[locale], s);
         }
+        return memo.first->second;
+    };
 
-        if (security == SEC_PLAYER)
+    clientcount = sPlayerRegistry.Directory().Who(query, areaFits, [&](PlayerDirectory::Entry const& entry) -> bool
+    {
+        // the directory names its players by guid only
+        Player* pl = sPlayerRegistry.Find(entry.guid, false);
+        if (!pl)
         {
-            // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
-            if (pl->GetTeam() != team && !allowTwoSideWhoList)
-            {
-                return;
-            }
+            return false;
+        }
 
-            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if (pl->GetSession()->GetSecurity() > gmLevelInWhoList)
-            {
-                return;
-            }
+        // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+        if (security == SEC_PLAYER && pl->GetSession()->GetSecurity() > gmLevelInWhoList)
+        {
+            return false;
         }
 
         // do not process players which are not in world
         if (!pl->IsInWorld())
         {
-            return;
+            return false;
         }
 
         // check if target is globally visible for player
         if (!pl->IsVisibleGloballyFor(_player))
         {
-            return;
-        }
-
-        // check if target's level is in level range
-        uint32 lvl = pl->getLevel();
-        if (lvl < level_min || lvl > level_max)
-        {
-            return;
-        }
-
-        // check if class matches classmask
-        uint32 class_ = pl->getClass();
-        if (!(classmask & (1 << class_)))
-        {
-            return;
-        }
-
-        // check if race matches racemask
-        uint32 race = pl->getRace();
-        if (!(racemask & (1 << race)))
-        {
-            return;
-        }
-
-        uint32 pzoneid = pl->GetTerrain()->GetZoneId(pl->Where().X(), pl->Where().Y(), pl->Where().Z());
-        uint8 gender = pl->getGender();
-
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
-            {
-                z_show = true;
-                break;
-            }
-
-            z_show = false;
-        }
-        if (!z_show)
-        {
-            return;
-        }
-
-        std::string pname = pl->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-        {
-            return;
-        }
-        wstrToLower(wpname);
-
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
-        {
-            return;
-        }
-
-        std::string gname = sGuildMgr.GetGuildNameById(pl->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
-        {
-            return;
-        }
-        wstrToLower(wgname);
-
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
-        {
-            return;
-        }
-
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(pzoneid))
-        {
-            aname = areaEntry->AreaName_lang[GetSessionDbcLocale()];
+            return false;
         }
 
-        bool s_show = true;
-        for (uint32 i = 0; i < str_count; ++i)
-        {
-            if (!str[i].empty())
-            {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                    wpname.find(str[i]) != std::wstring::npos ||
-                    Utf8FitTo(aname, str[i]))
-                {
-                    s_show = true;
-                    break;
-                }
-                s_show = false;
-            }
-        }
-        if (!s_show)
-        {
-            return;
-        }
-
-        data << pname;                                      // player name
-        data << gname;                                      // guild name
-        data << uint32(lvl);                                // player level
-        data << uint32(class_);                             // player class
-        data << uint32(race);                               // player race
-        data << uint8(gender);                              // player gender
-        data << uint32(pzoneid);                            // player zone id
-
-        ++clientcount;
+        data << entry.name;                                 // player name
+        data << entry.guildName;                            // guild name
+        data << uint32(entry.level);                        // player level
+        data << uint32(entry.classId);                      // player class
+        data << uint32(entry.race);                         // player race
+        data << uint8(entry.gender);                        // player gender
+        data << uint32(entry.zone);                         // player zone id
+        return true;
     });
 
+    uint32 count = uint32(sPlayerRegistry.Count());
+
     data.put(0, clientcount);                               // insert right count, listed count
     data.put(4, count > 50 ? count : clientcount);          // insert right count, online count
 
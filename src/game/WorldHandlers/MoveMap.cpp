@@ -58,6 +58,10 @@
 
 namespace
 {
+    /// Navmesh tiles held for loadMap() at once. A continent tile runs to a few hundred
+    /// kilobytes, and a prediction rarely reaches more than a handful of grids ahead.
+    const size_t MAX_STAGED_TILES = 16;
+
     /// Named from the expansion, never from the format string: a deck map's id is seven
     /// digits and the old sizing silently cut the extension off.
     std::string MMapFileName(uint32 mapId)
@@ -182,6 +186,11 @@ namespace MMAP
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
+        for (std::deque<StagedTile>::iterator i = stagedTiles.begin(); i != stagedTiles.end(); ++i)
+        {
+            dtFree(i->data);
+        }
+
         for (MMapDataSet::iterator i = loadedMMaps.begin(); i != loadedMMaps.end(); ++i)
         {
             delete i->second;
@@ -286,6 +295,52 @@ namespace MMAP
         const int32 filenameTileX = y;
         const int32 filenameTileY = x;
 
+        // A tile the prefetcher already read costs no I/O here; only the addTile below,
+        // which must stay on the thread that owns the navmesh, is left to do.
+        unsigned char* data = NULL;
+        int dataSize = 0;
+        if (takeStaged(mapId, packedGridPos, data, dataSize))
+        {
+            ++prefetchHits;
+        }
+        else if (readTile(mapId, x, y, data, dataSize))
+        {
+            ++prefetchMisses;
+        }
+        else
+        {
+            return false;
+        }
+
+        dtMeshHeader* header = (dtMeshHeader*)data;
+        dtTileRef tileRef = 0;
+
+        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
+        dtStatus dtResult = mmap->navMesh->addTile(data, dataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+        if (dtStatusFailed(dtResult))
+        {
+            sLog.outError("MMAP:loadMap: Could not load "
+                          "%04u%02i%02i.mmtile into navmesh",
+                          mapId, filenameTileX, filenameTileY);
+            dtFree(data);
+            return false;
+        }
+
+        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        ++loadedTiles;
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING,
+                         "MMAP:loadMap: Loaded mmtile "
+                         "%04u[%02i,%02i] into %04u[%02i,%02i]",
+                         mapId, filenameTileX, filenameTileY, mapId,
+                         header->x, header->y);
+        return true;
+    }
+
+    bool MMapManager::readTile(uint32 mapId, int32 x, int32 y, unsigned char*& data, int& size)
+    {
+        const int32 filenameTileX = y;
+        const int32 filenameTileY = x;
+
         // load this tile :: mmaps/MMMYYXX.mmtile
         const std::string fileName = MMapTileFileName(mapId, filenameTileX, filenameTileY);
 
@@ -328,45 +383,93 @@ namespace MMAP
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
+        data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
         MANGOS_ASSERT(data);
 
         size_t result = fread(data, fileHeader.size, 1, file);
+        fclose(file);
         if (!result)
         {
             sLog.outError("MMAP:loadMap: Bad header or data in mmap "
                           "%04u%02i%02i.mmtile",
                           mapId, filenameTileX, filenameTileY);
-            fclose(file);
+            dtFree(data);
+            data = NULL;
             return false;
         }
 
-        fclose(file);
+        size = int(fileHeader.size);
+        return true;
+    }
 
-        dtMeshHeader* header = (dtMeshHeader*)data;
-        dtTileRef tileRef = 0;
+    bool MMapManager::prefetchTile(uint32 mapId, int32 x, int32 y)
+    {
+        const uint32 packedGridPos = packTileID(x, y);
+        {
+            std::lock_guard<std::mutex> guard(stagedLock);
+            for (std::deque<StagedTile>::const_iterator i = stagedTiles.begin(); i != stagedTiles.end(); ++i)
+            {
+                if (i->mapId == mapId && i->packedGridPos == packedGridPos)
+                {
+                    return true;
+                }
+            }
+        }
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
-        if (dtStatusFailed(dtResult))
+        // Read outside the lock: the map threads take it in loadMap().
+        StagedTile staged;
+        staged.mapId = mapId;
+        staged.packedGridPos = packedGridPos;
+        if (!readTile(mapId, x, y, staged.data, staged.size))
         {
-            sLog.outError("MMAP:loadMap: Could not load "
-                          "%04u%02i%02i.mmtile into navmesh",
-                          mapId, filenameTileX, filenameTileY);
-            dtFree(data);
             return false;
         }
 
-        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
-        ++loadedTiles;
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING,
-                         "MMAP:loadMap: Loaded mmtile "
-                         "%04u[%02i,%02i] into %04u[%02i,%02i]",
-                         mapId, filenameTileX, filenameTileY, mapId,
-                         header->x, header->y);
+        std::lock_guard<std::mutex> guard(stagedLock);
+        if (stagedTiles.size() >= MAX_STAGED_TILES)
+        {
+            dtFree(stagedTiles.front().data);
+            stagedTiles.pop_front();
+            ++prefetchDropped;
+        }
+        stagedTiles.push_back(staged);
         return true;
     }
 
+    bool MMapManager::takeStaged(uint32 mapId, uint32 packedGridPos, unsigned char*& data, int& size)
+    {
+        std::lock_guard<std::mutex> guard(stagedLock);
+        for (std::deque<StagedTile>::iterator i = stagedTiles.begin(); i != stagedTiles.end(); ++i)
+        {
+            if (i->mapId == mapId && i->packedGridPos == packedGridPos)
+            {
+                data = i->data;
+                size = i->size;
+                stagedTiles.erase(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void MMapManager::dropStaged(uint32 mapId)
+    {
+        std::lock_guard<std::mutex> guard(stagedLock);
+        for (std::deque<StagedTile>::iterator i = stagedTiles.begin(); i != stagedTiles.end();)
+        {
+            if (i->mapId == mapId)
+            {
+                dtFree(i->data);
+                i = stagedTiles.erase(i);
+                ++prefetchDropped;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
         // check if we have this map loaded
@@ -413,6 +516,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        dropStaged(mapId);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
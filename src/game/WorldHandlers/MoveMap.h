@@ -32,6 +32,9 @@
 #include "../../dep/recastnavigation/Detour/Include/DetourNavMeshQuery.h"
 
 #include "Platform/Define.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <set>
 
 //  memory management
@@ -83,10 +86,15 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), prefetchHits(0), prefetchMisses(0), prefetchDropped(0) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
+
+            // Reads a tile's file ahead of loadMap() and keeps the bytes for it. The only
+            // call here that is safe off the map threads: it touches nothing but the file
+            // and the staged list, and the navmesh itself is still only changed by loadMap.
+            bool prefetchTile(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
@@ -97,13 +105,39 @@ namespace MMAP
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+
+            /// Tiles loadMap() took from the staged list, read from disk itself, and
+            /// staged tiles thrown away unused.
+            uint32 getPrefetchHits() const { return prefetchHits; }
+            uint32 getPrefetchMisses() const { return prefetchMisses; }
+            uint32 getPrefetchDropped() const { return prefetchDropped; }
         private:
+            // A tile file read by prefetchTile(), waiting for loadMap(). `data` is dtAlloc'd.
+            struct StagedTile
+            {
+                uint32 mapId;
+                uint32 packedGridPos;
+                unsigned char* data;
+                int size;
+            };
+
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            bool readTile(uint32 mapId, int32 x, int32 y, unsigned char*& data, int& size);
+            bool takeStaged(uint32 mapId, uint32 packedGridPos, unsigned char*& data, int& size);
+            void dropStaged(uint32 mapId);
 
             MMapDataSet loadedMMaps;
             std::set<uint32> failedMMaps;   ///< maps with no mmap file, so we stop retrying
             uint32 loadedTiles;
+
+            // Bounded: a prediction that never comes true must not pin its tiles forever,
+            // so the oldest staged tile goes once the list is full.
+            std::deque<StagedTile> stagedTiles;
+            std::mutex stagedLock;
+            std::atomic<uint32> prefetchHits;
+            std::atomic<uint32> prefetchMisses;
+            std::atomic<uint32> prefetchDropped;
     };
 
     // static class
@@ -247,6 +247,7 @@ void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>&
         }
 
         grid.AddGridObject(obj);
+        map->IndexGridPosition(obj, Cell(cell));
 
         addUnitState(obj, cell);
         obj->SetMap(map);
@@ -300,6 +301,7 @@ void LoadHelper(CellCorpseSet const& cell_corpses, CellPair& cell, CorpseMapType
         }
 
         grid.AddWorldObject(obj);
+        map->IndexGridPosition(obj, Cell(cell));
 
         addUnitState(obj, cell);
         obj->SetMap(map);
@@ -461,6 +463,7 @@ ObjectGridUnloader::Visit(GridRefManager<T>& m)
         {
             obj->SaveRespawnTime();
         }
+        obj->GetMap()->UnindexGridPosition(obj);
         ///- object must be out of world before delete
         obj->RemoveFromWorld();
         ///- object will get delinked from the manager when deleted
@@ -1499,6 +1499,18 @@ template<typename T>
  */
 void PoolManager::UpdatePool(MapPersistentState& mapState, uint16 pool_id, uint32 db_guid_or_pool_id)
 {
+    // The replacement may spawn anywhere on the map, so a region hands this to its barrier.
+    Map* map = mapState.GetMap();
+    if (map && map->InRegionJob())
+    {
+        MapPersistentState* state = &mapState;
+        map->RunAtColourBarrier([this, state, pool_id, db_guid_or_pool_id]()
+        {
+            UpdatePool<T>(*state, pool_id, db_guid_or_pool_id);
+        });
+        return;
+    }
+
     if (uint16 motherpoolid = IsPartOfAPool<Pool>(pool_id))
     {
         SpawnPoolGroup<Pool>(mapState, motherpoolid, pool_id, false);
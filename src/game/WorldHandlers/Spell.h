@@ -949,74 +949,83 @@ namespace MaNGOS
             }
         }
 
+        /// True if the search has a caster to measure from and to filter for.
+        bool CanSearch() const { return i_originalCaster && i_castingObject; }
+
+        /// Adds @p target to the list if it passes the filter and lies in the pushed area.
+        void Consider(Unit* target)
+        {
+            if (!PassesTargetFilter(target))
+            {
+                return;
+            }
+
+            // we don't need to check InMap here, it's already done some lines above
+            switch (i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if (i_castingObject->Where().IsInFront(target->Where(), i_radius, 2 * M_PI_F / 3))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_IN_FRONT_90:
+                    if (i_castingObject->Where().IsInFront(target->Where(), i_radius, M_PI_F / 2))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_IN_FRONT_30:
+                    if (i_castingObject->Where().IsInFront(target->Where(), i_radius, M_PI_F / 6))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_IN_FRONT_15:
+                    if (i_castingObject->Where().IsInFront(target->Where(), i_radius, M_PI_F / 12))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_IN_BACK:
+                    if (i_castingObject->Where().IsInBack(target->Where(), i_radius, 2 * M_PI_F / 3))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_SELF_CENTER:
+                    if (i_castingObject->Where().WithinDist(target->Where(), i_radius))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_DEST_CENTER:
+                    if (target->Where().WithinDist(Geometry::Vector3(i_centerX, i_centerY, i_centerZ), i_radius))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->Where().WithinDist(target->Where(), i_radius))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+            }
+        }
+
         template<class T> inline void Visit(GridRefManager<T>&  m)
         {
             MANGOS_ASSERT(i_data);
 
-            if (!i_originalCaster || !i_castingObject)
+            if (!CanSearch())
             {
                 return;
             }
 
             for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
             {
-                if (!PassesTargetFilter(itr->getSource()))
-                {
-                    continue;
-                }
-
-                // we don't need to check InMap here, it's already done some lines above
-                switch (i_push_type)
-                {
-                    case PUSH_IN_FRONT:
-                        if (i_castingObject->Where().IsInFront(((Unit*)(itr->getSource()))->Where(), i_radius, 2 * M_PI_F / 3))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                    case PUSH_IN_FRONT_90:
-                        if (i_castingObject->Where().IsInFront(((Unit*)(itr->getSource()))->Where(), i_radius, M_PI_F / 2))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                    case PUSH_IN_FRONT_30:
-                        if (i_castingObject->Where().IsInFront(((Unit*)(itr->getSource()))->Where(), i_radius, M_PI_F / 6))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                    case PUSH_IN_FRONT_15:
-                        if (i_castingObject->Where().IsInFront(((Unit*)(itr->getSource()))->Where(), i_radius, M_PI_F / 12))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                    case PUSH_IN_BACK:
-                        if (i_castingObject->Where().IsInBack(((Unit*)(itr->getSource()))->Where(), i_radius, 2 * M_PI_F / 3))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                    case PUSH_SELF_CENTER:
-                        if (i_castingObject->Where().WithinDist(((Unit*)(itr->getSource()))->Where(), i_radius))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if (itr->getSource()->Where().WithinDist(Geometry::Vector3(i_centerX, i_centerY, i_centerZ), i_radius))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->Where().WithinDist(((Unit*)(itr->getSource()))->Where(), i_radius))
-                        {
-                            i_data->push_back(itr->getSource());
-                        }
-                        break;
-                }
+                Consider(itr->getSource());
             }
         }
 
@@ -233,7 +233,33 @@ void Spell::FillAreaTargets(UnitList& targetUnitMap, float radius, SpellNotifyPu
 
     // The ordinary sweep runs either way: on a deck it walks the deck map's own cells, in
     // the deck's own coordinates, and nothing in it knows a ship is involved.
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius);
+    //
+    // It reads the cells' position index rather than their containers: units of the
+    // caster's phase whose extent reaches the circle, padded by the centre's own extent
+    // since the exact checks measure edge to edge. Only those are handed to the filter.
+    if (notifier.CanSearch())
+    {
+        float centreExtent = 0.0f;
+        if (pushType == PUSH_TARGET_CENTER)
+        {
+            if (Unit* target = m_targets.getUnitTarget())
+            {
+                centreExtent = target->Where().Extent();
+            }
+        }
+        else if (pushType != PUSH_DEST_CENTER)
+        {
+            centreExtent = notifier.i_castingObject->Where().Extent();
+        }
+
+        std::vector<WorldObject*> candidates;
+        m_caster->GetMap()->CollectInCircle(notifier.GetCenterX(), notifier.GetCenterY(), radius + centreExtent,
+                                            TYPEMASK_UNIT, notifier.i_originalCaster->GetPhaseMask(), candidates);
+        for (WorldObject* candidate : candidates)
+        {
+            notifier.Consider(static_cast<Unit*>(candidate));
+        }
+    }
 
     if (!vessel)
     {
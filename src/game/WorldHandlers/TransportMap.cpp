@@ -150,7 +150,7 @@ namespace
         }
 
         minion->DestroyForPlayer(client);
-        client->m_clientGUIDs.erase(minion->GetObjectGuid());
+        client->m_clientGUIDs.Erase(minion->GetObjectGuid());
     }
 
     /**
@@ -0,0 +1,83 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file ViewerHash.cpp
+ * @brief Implementation of the per-pass viewer buckets.
+ */
+
+#include "ViewerHash.h"
+#include "Utilities/Errors.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /// Added to every bucket coordinate. A map spans a few hundred buckets at most.
+    const int32 BUCKET_BIAS = 1 << 20;
+}
+
+void ViewerHash::Reset(float reach)
+{
+    m_bucketSize = reach > 1.0f ? reach : 1.0f;
+    m_entries.clear();
+    m_built = false;
+}
+
+void ViewerHash::Add(float x, float y, uint32 index)
+{
+    Entry entry;
+    entry.key = Key(BucketOf(x), BucketOf(y));
+    entry.index = index;
+    m_entries.push_back(entry);
+}
+
+void ViewerHash::Build()
+{
+    // Stable, so viewers in one bucket keep the order they were added in, and a pass
+    // visits them the same way every time.
+    std::stable_sort(m_entries.begin(), m_entries.end(), [](Entry const& a, Entry const& b)
+    {
+        return a.key < b.key;
+    });
+    m_built = true;
+}
+
+uint32 ViewerHash::BucketOf(float v) const
+{
+    return uint32(int32(std::floor(v / m_bucketSize)) + BUCKET_BIAS);
+}
+
+ViewerHash::Entry const* ViewerHash::LowerBound(uint64 key) const
+{
+    MANGOS_ASSERT(m_built);
+
+    Entry const* begin = m_entries.data();
+    return std::lower_bound(begin, begin + m_entries.size(), key, [](Entry const& entry, uint64 k)
+    {
+        return entry.key < k;
+    });
+}
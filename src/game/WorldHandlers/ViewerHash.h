@@ -0,0 +1,118 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file ViewerHash.h
+ * @brief The viewers of one map, bucketed by position for one visibility pass.
+ *
+ * The batched visibility pass asks the same question for every object that moved this
+ * tick: which cameras are near enough to care. Visiting the grid once per object
+ * answers it by walking every cell in reach, and every type container in each cell, to
+ * find the handful of cameras among them. This answers it from a flat array of the
+ * cameras alone, built once per pass: square buckets no narrower than the reach,
+ * sorted by bucket, so everything in reach of a point lies in three runs of the array,
+ * one per row of the 3x3 buckets around it.
+ */
+
+#ifndef MANGOS_VIEWER_HASH_H
+#define MANGOS_VIEWER_HASH_H
+
+#include "Platform/Define.h"
+
+#include <vector>
+
+/**
+ * @brief Positions with an index each, queried by neighbourhood.
+ *
+ * Add() every viewer, Build(), then ForEachNear() as often as needed. Reset() keeps
+ * the storage, so a pass after the first allocates nothing.
+ */
+class ViewerHash
+{
+    public:
+
+        ViewerHash() : m_bucketSize(1.0f), m_built(false) {}
+
+        /// Drop every entry and start over with buckets @p reach yards wide.
+        void Reset(float reach);
+
+        /// File the viewer @p index standing at (@p x, @p y).
+        void Add(float x, float y, uint32 index);
+
+        /// Sort the entries by bucket. Nothing may be added after this until Reset().
+        void Build();
+
+        /// How many viewers were filed since the last Reset().
+        uint32 Size() const { return uint32(m_entries.size()); }
+
+        /**
+         * @brief Calls @p visit with the index of every viewer in the 3x3 buckets around a point.
+         *
+         * That is every viewer within the reach given to Reset(), and some further out:
+         * the caller still checks the distance it actually needs.
+         *
+         * @return The number of indexes @p visit was called with.
+         */
+        template<class Visitor>
+        uint32 ForEachNear(float x, float y, Visitor&& visit) const
+        {
+            uint32 visited = 0;
+            uint32 const bx = BucketOf(x);
+            uint32 const by = BucketOf(y);
+            for (uint32 row = by - 1; row <= by + 1; ++row)
+            {
+                Entry const* first = LowerBound(Key(bx - 1, row));
+                Entry const* last = LowerBound(Key(bx + 2, row));
+                for (Entry const* entry = first; entry != last; ++entry)
+                {
+                    visit(entry->index);
+                    ++visited;
+                }
+            }
+            return visited;
+        }
+
+    private:
+
+        struct Entry
+        {
+            uint64 key;
+            uint32 index;
+        };
+
+        /// Bucket coordinate, biased well clear of zero: a row's neighbours are then
+        /// adjacent keys, and bx - 1 cannot wrap.
+        uint32 BucketOf(float v) const;
+
+        static uint64 Key(uint32 bx, uint32 by) { return (uint64(by) << 32) | bx; }
+
+        Entry const* LowerBound(uint64 key) const;
+
+        float m_bucketSize;
+        bool m_built;
+        std::vector<Entry> m_entries;
+};
+
+#endif
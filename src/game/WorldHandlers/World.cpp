@@ -83,6 +83,7 @@
 #include "ScriptMgr.h"
 #include "CreatureAIRegistry.h"
 #include "ProgressBar.h"
+#include "TaskGraph.h"
 #include "Policies/Singleton.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "OutdoorPvP/OutdoorPvP.h"
@@ -111,6 +112,7 @@
 #include "GitRevision.h"
 #include "UpdateTime.h"
 #include "GameTime.h"
+#include "OpcodeProfiler.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -141,6 +143,7 @@ uint32 World::m_relocation_ai_notify_delay    = 1000u;
 
 bool   World::m_visibility_observer_sweep_enabled  = true;
 uint32 World::m_visibility_observer_sweep_interval = 2000u;
+bool   World::m_visibility_batched_pass            = true;
 
 /**
  * @brief World class constructor
@@ -529,121 +532,9 @@ void World::SetInitialWorldSettings()
     }
 #endif /* ENABLE_ELUNA */
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Disables...");                  // must be before loading quests and items
-    DisableMgr::LoadDisables();
-    // Order-independent rather than order-dependent: a terrain reads its collision row
-    // when it is built, and nothing here promises no map was touched before this line.
-    sTerrainMgr.RefreshCollisionDisables();
-
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
-
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
-
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
-
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
-
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
-
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
-
-    sLog.outString("Loading Vehicle Accessory...");         // must be after creature templates
-    sObjectMgr.LoadVehicleAccessory();
-
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
-
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
-
-    sLog.outString("Loading pet levelup spells...");
-    sSpellMgr.LoadPetLevelupSpellMap();
-
-    sLog.outString("Loading pet default spell additional to levelup spells...");
-    sSpellMgr.LoadPetDefaultSpells();
-
-    sLog.outString("Loading Creature Addon Data...");
-    sObjectMgr.LoadCreatureAddons();                        // must be after LoadCreatureTemplates() and LoadCreatures()
-    sLog.outString(">>> Creature Addon Data loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameObjects();
-
-    sLog.outString("Loading CreatureLinking Data...");      // must be after Creatures
-    sCreatureLinkingMgr.LoadFromDB();
-
-    sLog.outString("Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
-
-    sLog.outString("Loading Weather Data...");
-    sWeatherMgr.LoadWeatherZoneChances();
+    ///- Templates, spell data and spawns. Declared with their dependencies and run on
+    ///  Startup.LoaderThreads threads; with the default of 1 the order is unchanged.
+    LoadStaticWorldTables();
 
     sLog.outString("Loading Quests...");
     sObjectMgr.LoadQuests();                                // must be loaded after DBCs, creature_template, item_template, gameobject tables
@@ -1030,6 +921,142 @@ void World::SetInitialWorldSettings()
     sLog.outString();
 }
 
+/**
+ * @brief Loads the static world tables: templates, spell data and spawns.
+ *
+ * Every loader is a task naming the loaders it reads from; the "must be after" notes
+ * this block used to carry are now those dependency lists. With Startup.LoaderThreads
+ * at 1 the tasks run on this thread in the order they are declared here, which is the
+ * order they always ran in. With more, independent loaders overlap; each one still
+ * runs whole on one thread and only ever writes its own containers, and the world
+ * database hands them its WorldDatabaseConnections pool in turn.
+ *
+ * Loaders that share a container must not overlap even when neither reads the other:
+ * creature and gameobject spawns both file into the per-cell guid index, which is why
+ * Gameobject Data waits for Creature Data.
+ */
+void World::LoadStaticWorldTables()
+{
+    TaskGraph graph;
+
+    TaskGraph::TaskId pageTexts = graph.Add("Page Texts", []() { sObjectMgr.LoadPageTexts(); });
+    TaskGraph::TaskId goTemplates = graph.Add("Game Object Templates", []() { sObjectMgr.LoadGameobjectInfo(); }, { pageTexts });
+
+    TaskGraph::TaskId spellChains = graph.Add("Spell Chain Data", []() { sSpellMgr.LoadSpellChains(); });
+    graph.Add("Spell Elixir types", []() { sSpellMgr.LoadSpellElixirs(); });
+    graph.Add("Spell Learn Skills", []() { sSpellMgr.LoadSpellLearnSkills(); }, { spellChains });
+    graph.Add("Spell Learn Spells", []() { sSpellMgr.LoadSpellLearnSpells(); });
+    graph.Add("Spell Proc Event conditions", []() { sSpellMgr.LoadSpellProcEvents(); }, { spellChains });
+    graph.Add("Spell Bonus Data", []() { sSpellMgr.LoadSpellBonuses(); }, { spellChains });
+    graph.Add("Spell Proc Item Enchant", []() { sSpellMgr.LoadSpellProcItemEnchant(); }, { spellChains });
+    graph.Add("Aggro Spells Definitions", []() { sSpellMgr.LoadSpellThreats(); }, { spellChains });
+
+    graph.Add("NPC Texts", []() { sObjectMgr.LoadGossipText(); });
+    TaskGraph::TaskId randomEnchants = graph.Add("Item Random Enchantments Table", []() { LoadRandomEnchantmentsTable(); });
+
+    // Must be before quests and items. The terrain refresh is order-independent rather
+    // than order-dependent: a terrain reads its collision row when it is built, and
+    // nothing here promises no map was touched before this.
+    TaskGraph::TaskId disables = graph.Add("Disables", []()
+    {
+        DisableMgr::LoadDisables();
+        sTerrainMgr.RefreshCollisionDisables();
+    });
+
+    TaskGraph::TaskId itemTemplates = graph.Add("Item Templates", []() { sObjectMgr.LoadItemPrototypes(); }, { randomEnchants, pageTexts, disables });
+    graph.Add("Item converts", []() { sObjectMgr.LoadItemConverts(); }, { itemTemplates });
+    graph.Add("Item expire converts", []() { sObjectMgr.LoadItemExpireConverts(); }, { itemTemplates });
+
+    TaskGraph::TaskId modelInfo = graph.Add("Creature Model Based Info Data", []() { sObjectMgr.LoadCreatureModelInfo(); });
+    TaskGraph::TaskId equipment = graph.Add("Equipment templates", []() { sObjectMgr.LoadEquipmentTemplates(); });
+    TaskGraph::TaskId creatureStats = graph.Add("Creature Stats", []() { sObjectMgr.LoadCreatureClassLvlStats(); });
+    TaskGraph::TaskId creatureTemplates = graph.Add("Creature templates", []() { sObjectMgr.LoadCreatureTemplates(); }, { modelInfo, equipment, creatureStats });
+    graph.Add("Creature template spells", []() { sObjectMgr.LoadCreatureTemplateSpells(); }, { creatureTemplates });
+    graph.Add("Creature Model for race", []() { sObjectMgr.LoadCreatureModelRace(); }, { modelInfo, creatureTemplates });
+    graph.Add("SpellsScriptTarget", []() { sSpellMgr.LoadSpellScriptTarget(); }, { creatureTemplates, goTemplates });
+    graph.Add("Vehicle Accessory", []() { sObjectMgr.LoadVehicleAccessory(); }, { creatureTemplates });
+    graph.Add("ItemRequiredTarget", []() { sObjectMgr.LoadItemRequiredTarget(); }, { itemTemplates, creatureTemplates });
+    graph.Add("Reputation Reward Rates", []() { sObjectMgr.LoadReputationRewardRate(); });
+    graph.Add("Creature Reputation OnKill Data", []() { sObjectMgr.LoadReputationOnKill(); }, { creatureTemplates });
+    graph.Add("Reputation Spillover Data", []() { sObjectMgr.LoadReputationSpilloverTemplate(); });
+    graph.Add("Points Of Interest Data", []() { sObjectMgr.LoadPointsOfInterest(); });
+
+    TaskGraph::TaskId creatures = graph.Add("Creature Data", []() { sObjectMgr.LoadCreatures(); }, { creatureTemplates, equipment, disables });
+    graph.Add("pet levelup spells", []() { sSpellMgr.LoadPetLevelupSpellMap(); });
+    graph.Add("pet default spell additional to levelup spells", []() { sSpellMgr.LoadPetDefaultSpells(); }, { creatureTemplates });
+    graph.Add("Creature Addon Data", []()
+    {
+        sObjectMgr.LoadCreatureAddons();
+        sLog.outString(">>> Creature Addon Data loaded");
+        sLog.outString();
+    }, { creatureTemplates, creatures });
+
+    TaskGraph::TaskId gameObjects = graph.Add("Gameobject Data", []() { sObjectMgr.LoadGameObjects(); }, { goTemplates, disables, creatures });
+    graph.Add("CreatureLinking Data", []() { sCreatureLinkingMgr.LoadFromDB(); }, { creatureTemplates, creatures });
+    graph.Add("Objects Pooling Data", []() { sPoolMgr.LoadFromDB(); }, { goTemplates, creatures, gameObjects });
+    graph.Add("Weather Data", []() { sWeatherMgr.LoadWeatherZoneChances(); });
+
+    uint32 threads = getConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS);
+
+    // The loaders query the world database from whichever thread picks them up.
+    graph.SetThreadScope([](std::function<void()> const& work)
+    {
+        DbThreadGuard dbThread(&WorldDatabase);
+        work();
+    });
+
+    // Bars from loaders running side by side would overwrite each other on one line.
+    if (threads > 1)
+    {
+        BarGoLink::SetOutputState(false);
+    }
+
+    graph.Run(threads,
+        [](TaskGraph const& g, TaskGraph::TaskId id, uint32 /*finished*/)
+        {
+            sLog.outString("Loading %s...", g.Name(id).c_str());
+        },
+        [](TaskGraph const& g, TaskGraph::TaskId id, uint32 finished)
+        {
+            sLog.outString("[%u/%u] %s: %u ms", finished, g.Size(), g.Name(id).c_str(), g.ElapsedMs(id));
+        });
+
+    if (threads > 1)
+    {
+        BarGoLink::SetOutputState(sConfig.GetBoolDefault("ShowProgressBars", true));
+    }
+
+    ///- Timing report: where the time went, and what bounds it however many threads run.
+    std::vector<TaskGraph::TaskId> slowest;
+    for (TaskGraph::TaskId id = 0; id < graph.Size(); ++id)
+    {
+        slowest.push_back(id);
+    }
+    std::sort(slowest.begin(), slowest.end(), [&graph](TaskGraph::TaskId a, TaskGraph::TaskId b)
+    {
+        return graph.ElapsedMs(a) > graph.ElapsedMs(b);
+    });
+
+    std::vector<TaskGraph::TaskId> path;
+    uint32 critical = graph.CriticalPath(path);
+    std::string chain;
+    for (TaskGraph::TaskId id : path)
+    {
+        chain += chain.empty() ? "" : " -> ";
+        chain += graph.Name(id);
+    }
+
+    sLog.outString();
+    sLog.outString(">>> Static world tables loaded: %u loaders in %u ms on %u thread(s), %u ms of loading",
+                   graph.Size(), graph.WallMs(), threads, graph.TotalMs());
+    for (size_t i = 0; i < slowest.size() && i < 5; ++i)
+    {
+        sLog.outString("    %6u ms  %s", graph.ElapsedMs(slowest[i]), graph.Name(slowest[i]).c_str());
+    }
+    sLog.outString("    Critical path %u ms: %s", critical, chain.c_str());
+    sLog.outString();
+}
+
 /**
  * @brief Prints the startup footer and enabled module summary.
  */
@@ -1153,6 +1180,8 @@ void World::DetectDBCLang()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    TickProfiler::Tick tick(m_tickHistory, 0, 0, true);
+
     ///- Update the different timers
     for (int i = 0; i < WUPDATE_COUNT; ++i)
     {
@@ -1232,6 +1261,7 @@ void World::Update(uint32 diff)
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
+        TickProfiler::Zone zone(TICK_ZONE_WORLD_AUCTIONS);
         m_timers[WUPDATE_AUCTIONS].Reset();
 
         ///- Update mails (return old mails with item, or delete them)
@@ -1256,12 +1286,17 @@ void World::Update(uint32 diff)
     /// <li> Update Dungeon Finder
     if (m_timers[WUPDATE_LFGMGR].Passed())
     {
+        TickProfiler::Zone zone(TICK_ZONE_WORLD_LFG);
         sLFGMgr.Update();
         m_timers[WUPDATE_LFGMGR].Reset();
     }
 
     /// <li> Handle session updates
-    UpdateSessions(diff);
+    {
+        TickProfiler::Zone zone(TICK_ZONE_WORLD_SESSIONS);
+        UpdateSessions(diff);
+    }
+    OpcodeProfiler::Update(diff);
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
@@ -1275,7 +1310,10 @@ void World::Update(uint32 diff)
 
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
-    sMapMgr.Update(diff);
+    {
+        TickProfiler::Zone zone(TICK_ZONE_WORLD_MAPS);
+        sMapMgr.Update(diff);
+    }
     sBattleGroundMgr.Update(diff);
     sOutdoorPvPMgr.Update(diff);
 
@@ -1296,13 +1334,17 @@ void World::Update(uint32 diff)
     }
 
     // execute callbacks from sql queries that were queued recently
-    UpdateResultQueue();
+    {
+        TickProfiler::Zone zone(TICK_ZONE_WORLD_RESULTS);
+        UpdateResultQueue();
+    }
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
     {
         m_timers[WUPDATE_CORPSES].Reset();
 
+        TickProfiler::Zone zone(TICK_ZONE_WORLD_CORPSES);
         sCorpseManager.RemoveOldCorpses();
     }
 
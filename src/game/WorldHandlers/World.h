@@ -44,6 +44,7 @@
 #include "Timer.h"
 #include "Policies/Singleton.h"
 #include "SharedDefines.h"
+#include "TickProfiler.h"
 
 #include <map>
 #include <set>
@@ -219,6 +220,13 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CHARDELETE_METHOD,
     CONFIG_UINT32_CHARDELETE_MIN_LEVEL,
     CONFIG_UINT32_NUMTHREADS,
+    CONFIG_UINT32_MAPUPDATE_REGION_GRIDS,
+    CONFIG_UINT32_MAPUPDATE_REGION_MIN_CELLS,
+    CONFIG_UINT32_AUTH_LOOKUP_BATCH,
+    CONFIG_UINT32_OPCODE_PROFILER_DUMP_INTERVAL,
+    CONFIG_UINT32_TICK_PROFILER_SLOW_TICK,
+    CONFIG_UINT32_STARTUP_LOADER_THREADS,
+    CONFIG_UINT32_TERRAIN_PREFETCH_LOOKAHEAD,
     CONFIG_UINT32_GUID_RESERVE_SIZE_CREATURE,
     CONFIG_UINT32_GUID_RESERVE_SIZE_GAMEOBJECT,
     CONFIG_UINT32_MIN_LEVEL_FOR_RAID,
@@ -351,6 +359,8 @@ enum eConfigBoolValues
     CONFIG_BOOL_EVENT_ANNOUNCE,
     CONFIG_BOOL_QUEST_IGNORE_RAID,
     CONFIG_BOOL_LIVINGWORLD_CELL_ENVELOPE_LOAD,
+    CONFIG_BOOL_MAPUPDATE_REGIONS,
+    CONFIG_BOOL_TERRAIN_PREFETCH,
     CONFIG_BOOL_DETECT_POS_COLLISION,
     CONFIG_BOOL_RESTRICTED_LFG_CHANNEL,
     CONFIG_BOOL_SILENTLY_GM_JOIN_TO_CHANNEL,
@@ -400,6 +410,8 @@ enum eConfigBoolValues
     // Cinematic flyover
     CONFIG_BOOL_CINEMATIC_FLYOVER_ENABLE,
     CONFIG_BOOL_CINEMATIC_FLYOVER_DEBUG,
+    CONFIG_BOOL_OPCODE_PROFILER,
+    CONFIG_BOOL_TICK_PROFILER,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -554,6 +566,9 @@ class World
         /// Get the path where data (dbc, maps) are stored on disk
         std::string GetDataPath() const { return m_dataPath; }
 
+        /// Per-phase timing of world ticks, for `.debug ticks`.
+        TickProfiler::History& GetTickHistory() { return m_tickHistory; }
+
         /// When server started?
         time_t const& GetStartTime() const { return m_startTime; }
         /// What time is it?
@@ -658,6 +673,7 @@ class World
 
         static bool   GetVisibilityObserverSweepEnabled()   { return m_visibility_observer_sweep_enabled; }
         static uint32 GetVisibilityObserverSweepInterval()  { return m_visibility_observer_sweep_interval; }
+        static bool   GetVisibilityBatchedPass()            { return m_visibility_batched_pass; }
         void ProcessCliCommands();
         void QueueCliCommand(CliCommandHolder* commandHolder) { cliCmdQueue.add(commandHolder); }
 
@@ -757,9 +773,11 @@ class World
         LocaleConstant m_defaultDbcLocale;                  // from config for one from loaded DBC locales
         uint32 m_availableDbcLocaleMask;                    // by loaded DBC
         void DetectDBCLang();
+        void LoadStaticWorldTables();
         bool m_allowMovement;
         std::string m_motd;
         std::string m_dataPath;
+        TickProfiler::History m_tickHistory;
 
         // for max speed access
         static float m_MaxVisibleDistanceOnContinents;
@@ -775,6 +793,7 @@ class World
 
         static bool   m_visibility_observer_sweep_enabled;
         static uint32 m_visibility_observer_sweep_interval;
+        static bool   m_visibility_batched_pass;
 
         // CLI command holder to be thread safe
         MaNGOS::LockedQueue<CliCommandHolder*> cliCmdQueue;
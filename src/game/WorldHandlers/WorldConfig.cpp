@@ -38,6 +38,7 @@
 #include "LineOfSightExemptions.h"
 #include "Utilities/IdList.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SQLStorageSnapshot.h"
 #include "Config/Config.h"
 #include "Platform/Define.h"
 #include "SystemConfig.h"
@@ -61,6 +62,7 @@
 #include "LootMgr.h"
 #include "ItemEnchantmentMgr.h"
 #include "MapManager.h"
+#include "OpcodeProfiler.h"
 #include "ScriptMgr.h"
 #include "CreatureAIRegistry.h"
 #include "ProgressBar.h"
@@ -253,6 +255,26 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUMTHREADS, "MapUpdateThreads", 2);
+    setConfig(CONFIG_BOOL_MAPUPDATE_REGIONS, "MapUpdate.Regions.Enabled", false);
+    setConfigMinMax(CONFIG_UINT32_MAPUPDATE_REGION_GRIDS, "MapUpdate.Regions.GridsPerSide", 2, 1, MAX_NUMBER_OF_GRIDS / 2);
+    setConfig(CONFIG_UINT32_MAPUPDATE_REGION_MIN_CELLS, "MapUpdate.Regions.MinCells", 64);
+    setConfig(CONFIG_BOOL_TERRAIN_PREFETCH, "MapUpdate.Prefetch.Enabled", true);
+    setConfigMinMax(CONFIG_UINT32_TERRAIN_PREFETCH_LOOKAHEAD, "MapUpdate.Prefetch.Lookahead", 10, 1, 60);
+    setConfigMinMax(CONFIG_UINT32_AUTH_LOOKUP_BATCH, "AuthLookup.BatchSize", 32, 1, 256);
+
+    setConfig(CONFIG_BOOL_OPCODE_PROFILER, "OpcodeProfiler.Enabled", false);
+    setConfig(CONFIG_UINT32_OPCODE_PROFILER_DUMP_INTERVAL, "OpcodeProfiler.DumpInterval", 60);
+    OpcodeProfiler::Configure(getConfig(CONFIG_UINT32_OPCODE_PROFILER_DUMP_INTERVAL),
+                              sConfig.GetStringDefault("OpcodeProfiler.DumpFile", "opcodes.csv"));
+    OpcodeProfiler::SetEnabled(getConfig(CONFIG_BOOL_OPCODE_PROFILER));
+
+    setConfig(CONFIG_BOOL_TICK_PROFILER, "TickProfiler.Enabled", false);
+    setConfig(CONFIG_UINT32_TICK_PROFILER_SLOW_TICK, "TickProfiler.SlowTickThreshold", 300);
+    TickProfiler::SetEnabled(getConfig(CONFIG_BOOL_TICK_PROFILER));
+    TickProfiler::SetSlowTickThreshold(getConfig(CONFIG_UINT32_TICK_PROFILER_SLOW_TICK));
+
+    setConfigMinMax(CONFIG_UINT32_STARTUP_LOADER_THREADS, "Startup.LoaderThreads", 1, 1, 16);
+    SQLStorageSnapshot::SetDirectory(sConfig.GetStringDefault("Startup.TableSnapshotDir", ""));
 
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
@@ -556,6 +578,7 @@ void World::LoadConfigSettings(bool reload)
 
     m_visibility_observer_sweep_enabled  = sConfig.GetBoolDefault("Visibility.ObserverSweep.Enable", true);
     m_visibility_observer_sweep_interval = sConfig.GetIntDefault("Visibility.ObserverSweep.Interval", 2000);
+    m_visibility_batched_pass            = sConfig.GetBoolDefault("Visibility.BatchedPass", true);
 
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
     if (m_VisibleUnitGreyDistance >  MAX_VISIBILITY_DISTANCE)
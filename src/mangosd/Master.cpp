@@ -74,11 +74,12 @@ namespace
      * @param label       Name used in log messages.
      * @param infoKey     Config key holding the connection string.
      * @param countKey    Config key holding the extra connection count.
+     * @param asyncKey    Config key holding the async connection count.
      * @param versionKind Which schema this database is expected to carry.
      * @return false if the database could not be opened or is the wrong version.
      */
     bool OpenDatabase(Database& db, const char* label, const char* infoKey,
-                      const char* countKey, DatabaseTypes versionKind)
+                      const char* countKey, const char* asyncKey, DatabaseTypes versionKind)
     {
         const std::string info = sConfig.GetStringDefault(infoKey, "");
         if (info.empty())
@@ -88,9 +89,10 @@ namespace
         }
 
         const int connections = sConfig.GetIntDefault(countKey, 1);
-        sLog.outString("%s database total connections: %i", label, connections + 1);
+        const int asyncConnections = sConfig.GetIntDefault(asyncKey, 1);
+        sLog.outString("%s database total connections: %i (%i async)", label, connections + asyncConnections, asyncConnections);
 
-        if (!db.Initialize(info.c_str(), connections))
+        if (!db.Initialize(info.c_str(), connections, asyncConnections))
         {
             sLog.outError("Cannot connect to the %s database", label);
             return false;
@@ -144,14 +146,14 @@ bool Master::StartDatabases()
     // missed HaltDelayThread() hides: every new early return has to remember the
     // full list of everything opened so far.
     if (!OpenDatabase(WorldDatabase, "World", "WorldDatabaseInfo",
-                      "WorldDatabaseConnections", DATABASE_WORLD))
+                      "WorldDatabaseConnections", "WorldDatabaseAsyncConnections", DATABASE_WORLD))
     {
         WorldDatabase.HaltDelayThread();
         return false;
     }
 
     if (!OpenDatabase(CharacterDatabase, "Character", "CharacterDatabaseInfo",
-                      "CharacterDatabaseConnections", DATABASE_CHARACTER))
+                      "CharacterDatabaseConnections", "CharacterDatabaseAsyncConnections", DATABASE_CHARACTER))
     {
         CharacterDatabase.HaltDelayThread();
         WorldDatabase.HaltDelayThread();
@@ -159,7 +161,7 @@ bool Master::StartDatabases()
     }
 
     if (!OpenDatabase(LoginDatabase, "Login", "LoginDatabaseInfo",
-                      "LoginDatabaseConnections", DATABASE_REALMD))
+                      "LoginDatabaseConnections", "LoginDatabaseAsyncConnections", DATABASE_REALMD))
     {
         LoginDatabase.HaltDelayThread();
         CharacterDatabase.HaltDelayThread();
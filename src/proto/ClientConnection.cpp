@@ -68,6 +68,7 @@ namespace proto
           m_codec(),
           m_seed(MakeAuthSeed()),
           m_session(INVALID_SESSION_ID),
+          m_authPending(false),
           m_traceSession(INVALID_SESSION_ID),
           m_closed(false)
     {
@@ -103,6 +104,22 @@ namespace proto
 
     std::vector<uint8_t> ClientConnection::onData(const uint8_t* data, size_t len)
     {
+        if (m_authPending)
+        {
+            // A real client sends nothing until it has its SMSG_AUTH_RESPONSE, so
+            // anything more than a packet's worth here is a peer trying to make us
+            // buffer for it.
+            if (m_heldInput.size() + len > MAX_CLIENT_PACKET_SIZE)
+            {
+                sLog.outError("proto: %s kept sending during its account lookup, dropping",
+                              m_address.c_str());
+                Close();
+                return std::vector<uint8_t>();
+            }
+            m_heldInput.insert(m_heldInput.end(), data, data + len);
+            return std::vector<uint8_t>();
+        }
+
         std::vector<WorldPacket> packets;
 
         if (m_codec.Feed(data, len, packets) == DecodeStatus::Malformed)
@@ -128,6 +145,16 @@ namespace proto
                     Close();
                     break;
                 }
+
+                // Anything decoded behind a CMSG_AUTH_SESSION whose lookup is still
+                // out was framed before the cipher could be armed: unusable.
+                if (m_authPending && i + 1 < packets.size())
+                {
+                    sLog.outError("proto: %s sent packets ahead of its auth response, dropping",
+                                  m_address.c_str());
+                    Close();
+                    break;
+                }
             }
         }
         catch (ByteBufferException&)
@@ -207,9 +234,53 @@ namespace proto
         }
 
         // Policy and persistence: account row, bans, IP lock, allowed build,
-        // security level. None of it belongs on this side of the seam.
-        const AuthLookup lookup = m_gateway.LookupAccount(request);
+        // security level. None of it belongs on this side of the seam -- and it is
+        // a database round trip, so where the transport can bring us back to this
+        // thread the network worker does not sit and wait for it.
+        if (!m_taskPoster)
+        {
+            return CompleteAuthSession(request, m_gateway.LookupAccount(request));
+        }
+
+        m_authPending = true;
+        std::shared_ptr<ClientConnection> self =
+            std::static_pointer_cast<ClientConnection>(shared_from_this());
+        m_gateway.LookupAccountAsync(request,
+            [self, request](const AuthLookup& lookup)
+            {
+                self->m_taskPoster([self, request, lookup]()
+                {
+                    self->ResumeAuthSession(request, lookup);
+                });
+            });
+        return true;
+    }
+
+    void ClientConnection::ResumeAuthSession(const AuthRequest& request, const AuthLookup& lookup)
+    {
+        m_authPending = false;
+
+        if (m_closed.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        if (!CompleteAuthSession(request, lookup))
+        {
+            Close();
+            return;
+        }
+
+        if (!m_heldInput.empty())
+        {
+            std::vector<uint8_t> held;
+            held.swap(m_heldInput);
+            onData(held.data(), held.size());
+        }
+    }
 
+    bool ClientConnection::CompleteAuthSession(const AuthRequest& request, const AuthLookup& lookup)
+    {
         if (lookup.status != AuthStatus::Ok)
         {
             SendAuthStatus(lookup.status);
@@ -278,15 +349,62 @@ namespace proto
         SendPacket(packet);
     }
 
+    namespace
+    {
+        /// What the in-place fill needs: the packet and the header cipher.
+        struct InPlaceEncode
+        {
+            const WorldPacket* packet;
+            bool headerOnly;        ///< the payload travels by reference
+            AuthCrypt* crypt;
+            std::mutex* cryptLock;
+        };
+
+        void FillEncoded(void* ctx, uint8_t* dst)
+        {
+            InPlaceEncode& encode = *static_cast<InPlaceEncode*>(ctx);
+            PacketCodec::HeaderEncryptor encryptor =
+                [&encode](uint8* header, size_t len)
+                {
+                    if (encode.crypt->IsInitialized())
+                    {
+                        encode.crypt->EncryptSend(header, len);
+                    }
+                };
+
+            // Runs under the send buffer's own lock, so headers are encrypted in
+            // exactly the order they go out -- which the cipher, being a stream,
+            // depends on. The crypt lock still guards against the copying path.
+            std::lock_guard<std::mutex> lock(*encode.cryptLock);
+            if (encode.headerOnly)
+            {
+                PacketCodec::EncodeHeader(encode.packet->GetOpcode(), encode.packet->size(),
+                                          encryptor, dst);
+            }
+            else
+            {
+                PacketCodec::EncodeInto(*encode.packet, encryptor, dst);
+            }
+        }
+    }
+
     void ClientConnection::SendPacket(const WorldPacket& packet)
     {
-        if (m_closed.load(std::memory_order_acquire) || !m_sender)
+        if (m_closed.load(std::memory_order_acquire) || (!m_sender && !m_inPlaceSender))
         {
             return;
         }
 
         m_gateway.TracePacket(m_traceSession.load(std::memory_order_relaxed), packet, false);
 
+        if (m_inPlaceSender)
+        {
+            InPlaceEncode encode = { &packet, false, &m_crypt, &m_cryptSendLock };
+            net::SendFill fill = { &FillEncoded, &encode };
+            m_inPlaceSender(PacketCodec::EncodedSize(packet), fill, net::SharedPayload());
+            return;
+        }
+
         std::vector<uint8_t> wire;
         {
             // The cipher is a stream: two threads encrypting headers concurrently
@@ -305,6 +423,29 @@ namespace proto
         m_sender(wire.data(), wire.size());
     }
 
+    void ClientConnection::SendShared(const SharedPacket& shared)
+    {
+        if (m_closed.load(std::memory_order_acquire) || !m_inPlaceSender)
+        {
+            SendPacket(shared.Packet());
+            return;
+        }
+
+        const net::SharedPayload& payload = shared.PayloadForRecipient();
+        if (!payload)
+        {
+            SendPacket(shared.Packet());
+            return;
+        }
+
+        const WorldPacket& packet = shared.Packet();
+        m_gateway.TracePacket(m_traceSession.load(std::memory_order_relaxed), packet, false);
+
+        InPlaceEncode encode = { &packet, true, &m_crypt, &m_cryptSendLock };
+        net::SendFill fill = { &FillEncoded, &encode };
+        m_inPlaceSender(PacketCodec::HeaderSize(packet.size()), fill, payload);
+    }
+
     void ClientConnection::Close()
     {
         m_closed.store(true, std::memory_order_release);
@@ -78,11 +78,21 @@ namespace proto
                 m_sender = std::move(sender);
             }
 
+            void setInPlaceSender(net::InPlaceSender sender) override
+            {
+                m_inPlaceSender = std::move(sender);
+            }
+
             void setCloser(net::Closer closer) override
             {
                 m_closer = std::move(closer);
             }
 
+            void setTaskPoster(net::TaskPoster poster) override
+            {
+                m_taskPoster = std::move(poster);
+            }
+
             std::vector<uint8_t> onConnect() override;
             std::vector<uint8_t> onData(const uint8_t* data, size_t len) override;
             void onClose() override;
@@ -95,9 +105,15 @@ namespace proto
             // --- IClientLink (what the world may do to us) --------------------
 
             /// Encode, encrypt and queue a packet. Safe from any thread, and a
-            /// no-op once the peer is gone.
+            /// no-op once the peer is gone. Where the transport offers it, the
+            /// packet is encoded straight into the outbound buffer: one copy of
+            /// the payload and no allocation.
             void SendPacket(const WorldPacket& packet) override;
 
+            /// As SendPacket(), but only the header is encoded per connection: a
+            /// large broadcast payload is referenced from the send queue, not copied.
+            void SendShared(const SharedPacket& packet) override;
+
             /// Mark the connection dead and ask the transport to tear it down.
             void Close() override;
 
@@ -118,6 +134,14 @@ namespace proto
 
             bool HandleAuthSession(WorldPacket& packet);
 
+            /// Second half of the handshake, once the world has looked the account
+            /// up: verify the proof, arm the cipher, attach. False drops the peer.
+            bool CompleteAuthSession(const AuthRequest& request, const AuthLookup& lookup);
+
+            /// Back on the network thread after an asynchronous lookup: finish the
+            /// handshake, then replay whatever the client sent in the meantime.
+            void ResumeAuthSession(const AuthRequest& request, const AuthLookup& lookup);
+
             /// Send a bare SMSG_AUTH_RESPONSE carrying only a status byte.
             void SendAuthStatus(AuthStatus status);
 
@@ -137,6 +161,12 @@ namespace proto
 
             SessionId m_session;
 
+            /// An account lookup is in flight. Network thread only. Input arriving
+            /// meanwhile cannot be decoded yet -- whether its headers are encrypted
+            /// depends on the answer -- so it is held, raw, and replayed after.
+            bool m_authPending;
+            std::vector<uint8_t> m_heldInput;
+
             /// The same id, readable off the network thread. SendPacket runs on the
             /// world thread while m_session is written here on the network thread, so
             /// the trace needs a copy it can read without a race. Tracing only --
@@ -146,7 +176,9 @@ namespace proto
             std::atomic<bool> m_closed;
 
             net::Sender m_sender;
+            net::InPlaceSender m_inPlaceSender; ///< preferred; encodes into the send buffer
             net::Closer m_closer;
+            net::TaskPoster m_taskPoster; ///< resumes us on the network thread
 
             static std::atomic<uint32> s_openConnections;
     };
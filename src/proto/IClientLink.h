@@ -26,6 +26,7 @@
 #ifndef MANGOS_PROTO_ICLIENTLINK_H
 #define MANGOS_PROTO_ICLIENTLINK_H
 
+#include "SharedPacket.h"
 #include "WorldPacket.h"
 
 #include <string>
@@ -63,6 +64,14 @@ namespace proto
             /// Encode, encrypt and queue a packet for this client.
             virtual void SendPacket(const WorldPacket& packet) = 0;
 
+            /// Queue this client's share of a packet fanned out to many. A link
+            /// that can reference the shared payload overrides this; any other
+            /// simply sends the packet.
+            virtual void SendShared(const SharedPacket& packet)
+            {
+                SendPacket(packet.Packet());
+            }
+
             /// Ask the transport to tear the connection down.
             virtual void Close() = 0;
 
@@ -32,6 +32,7 @@
 #include "Platform/Define.h"
 #include "WorldPacket.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -132,7 +133,8 @@ namespace proto
      * rather than a naming convention.
      *
      * Threading: LookupAccount() and Attach() are called on a network thread, one
-     * connection at a time. Deliver() may be called concurrently for distinct
+     * connection at a time; LookupAccountAsync() is called there but may answer
+     * from anywhere. Deliver() may be called concurrently for distinct
      * sessions and must be safe against the world thread draining them.
      */
     class IWorldGateway
@@ -154,6 +156,30 @@ namespace proto
              */
             virtual AuthLookup LookupAccount(const AuthRequest& request) = 0;
 
+            /// Receives the verdict of LookupAccountAsync(), on whichever thread the
+            /// world produced it.
+            typedef std::function<void(const AuthLookup& lookup)> AuthLookupHandler;
+
+            /**
+             * @brief LookupAccount() without blocking the calling network thread.
+             *
+             * A lookup is a database round trip, and the network thread asking owns
+             * many other connections that would all stall behind it. Here the world
+             * answers whenever it can, from a thread of its own; getting back onto
+             * the connection's thread is the caller's business.
+             *
+             * The default answers inline, which is right for a gateway that has
+             * nothing to wait on.
+             *
+             * @param request What the client claimed. Untrusted.
+             * @param handler Called exactly once with the verdict.
+             */
+            virtual void LookupAccountAsync(const AuthRequest& request,
+                                            AuthLookupHandler handler)
+            {
+                handler(LookupAccount(request));
+            }
+
             /**
              * @brief Build the world-side session for a client that proved itself.
              *
@@ -137,46 +137,63 @@ namespace proto
         return DecodeStatus::Ok;
     }
 
-    std::vector<uint8> PacketCodec::Encode(const WorldPacket& packet,
-                                           const HeaderEncryptor& encryptor)
+    size_t PacketCodec::EncodedSize(const WorldPacket& packet)
+    {
+        return HeaderSize(packet.size()) + packet.size();
+    }
+
+    size_t PacketCodec::HeaderSize(size_t payloadSize)
+    {
+        return payloadSize + 2 > 0x7FFF ? 5 : 4;
+    }
+
+    void PacketCodec::EncodeHeader(uint16 opcode, size_t payloadSize,
+                                   const HeaderEncryptor& encryptor, uint8* dst)
     {
         // The size field counts the two opcode bytes along with the payload.
         // Over 0x7FFF the header grows to five bytes with 0x80 set in the first --
         // a WotLK addition, which is why CLASSIC and TBC compile it out.
-        const uint32 size  = uint32(packet.size()) + 2;
+        const uint32 size  = uint32(payloadSize) + 2;
         const bool   large = size > 0x7FFF;
 
-        uint8  header[5];
         size_t headerLen = 0;
 
         if (large)
         {
-            header[headerLen++] = uint8(0x80 | ((size >> 16) & 0xFF));
+            dst[headerLen++] = uint8(0x80 | ((size >> 16) & 0xFF));
         }
-        header[headerLen++] = uint8((size >> 8) & 0xFF);
-        header[headerLen++] = uint8(size & 0xFF);
+        dst[headerLen++] = uint8((size >> 8) & 0xFF);
+        dst[headerLen++] = uint8(size & 0xFF);
 
-        const uint16 opcode = uint16(packet.GetOpcode());
-        header[headerLen++] = uint8(opcode & 0xFF);
-        header[headerLen++] = uint8((opcode >> 8) & 0xFF);
+        dst[headerLen++] = uint8(opcode & 0xFF);
+        dst[headerLen++] = uint8((opcode >> 8) & 0xFF);
 
+        // Encrypted where it lies: the header never exists anywhere but its
+        // final position in the stream.
         if (encryptor)
         {
-            encryptor(header, headerLen);
+            encryptor(dst, headerLen);
         }
+    }
 
-        std::vector<uint8> wire;
-        wire.reserve(headerLen + packet.size());
-        wire.insert(wire.end(), header, header + headerLen);
+    void PacketCodec::EncodeInto(const WorldPacket& packet,
+                                 const HeaderEncryptor& encryptor, uint8* dst)
+    {
+        EncodeHeader(uint16(packet.GetOpcode()), packet.size(), encryptor, dst);
 
         // contents() is only safe on a non-empty buffer; many packets are pure
         // opcodes with no payload at all.
         if (!packet.empty())
         {
-            wire.insert(wire.end(), packet.contents(),
-                        packet.contents() + packet.size());
+            std::memcpy(dst + HeaderSize(packet.size()), packet.contents(), packet.size());
         }
+    }
 
+    std::vector<uint8> PacketCodec::Encode(const WorldPacket& packet,
+                                           const HeaderEncryptor& encryptor)
+    {
+        std::vector<uint8> wire(EncodedSize(packet));
+        EncodeInto(packet, encryptor, wire.data());
         return wire;
     }
 }
@@ -113,6 +113,34 @@ namespace proto
             static std::vector<uint8> Encode(const WorldPacket& packet,
                                              const HeaderEncryptor& encryptor);
 
+            /// Bytes Encode() would produce for @p packet: header plus payload.
+            static size_t EncodedSize(const WorldPacket& packet);
+
+            /// Length of the server header in front of a @p payloadSize byte payload.
+            static size_t HeaderSize(size_t payloadSize);
+
+            /**
+             * @brief Write just the (encrypted) server header, HeaderSize() bytes.
+             *
+             * For a payload that travels separately -- a broadcast, whose payload is
+             * shared between recipients and only the header is per connection.
+             */
+            static void EncodeHeader(uint16 opcode, size_t payloadSize,
+                                     const HeaderEncryptor& encryptor, uint8* dst);
+
+            /**
+             * @brief Encode() into caller-owned memory instead of a fresh vector.
+             *
+             * The send path uses this to serialise straight into the connection's
+             * outbound buffer, so the payload is copied once on its way to the socket.
+             *
+             * @param packet    Packet to serialise.
+             * @param encryptor Header encryption hook; may be empty.
+             * @param dst       Exactly EncodedSize(@p packet) writable bytes.
+             */
+            static void EncodeInto(const WorldPacket& packet,
+                                   const HeaderEncryptor& encryptor, uint8* dst);
+
             /// Install the header decryptor, once the session key has been agreed.
             void SetHeaderDecryptor(HeaderDecryptor decryptor)
             {
@@ -0,0 +1,101 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_PROTO_SHAREDPACKET_H
+#define MANGOS_PROTO_SHAREDPACKET_H
+
+#include "WorldPacket.h"
+
+#include "net/ISession.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace proto
+{
+    /**
+     * @brief One packet on its way to many clients.
+     *
+     * A broadcast is the same payload for every recipient; the only per-connection
+     * bytes are the four or five of the header, because each connection runs its
+     * own header cipher. This wraps the packet for the duration of one fan-out and
+     * hands the transport a single refcounted copy of the payload that every
+     * recipient's send queue references, instead of each one copying it in.
+     *
+     * Sharing is not free -- one allocation, one copy, and an extra span for the
+     * socket to write -- so it only starts with the second recipient, and only for
+     * payloads of at least MIN_SHARED_PAYLOAD bytes. The first recipient, and every
+     * recipient of a small packet, gets the ordinary in-place copy.
+     *
+     * Not thread-safe: one fan-out, on one thread. The wrapped packet must outlive
+     * this object and must not change while it exists.
+     */
+    class SharedPacket
+    {
+        public:
+
+            /// Below this, copying the payload beats referencing it.
+            static const size_t MIN_SHARED_PAYLOAD = 256;
+
+            explicit SharedPacket(const WorldPacket& packet)
+                : m_packet(packet), m_recipients(0) {}
+
+            const WorldPacket& Packet() const { return m_packet; }
+
+            /**
+             * @brief The payload to reference for one more recipient.
+             *
+             * @return NULL where this recipient should copy the payload instead;
+             *         otherwise the shared copy, built on first need.
+             */
+            const net::SharedPayload& PayloadForRecipient() const
+            {
+                static const net::SharedPayload none;
+
+                if (m_packet.size() < MIN_SHARED_PAYLOAD || ++m_recipients < 2)
+                {
+                    return none;
+                }
+
+                if (!m_payload)
+                {
+                    m_payload = std::make_shared<const std::vector<uint8>>(
+                        m_packet.contents(), m_packet.contents() + m_packet.size());
+                }
+                return m_payload;
+            }
+
+        private:
+
+            SharedPacket(const SharedPacket&);
+            SharedPacket& operator=(const SharedPacket&);
+
+            const WorldPacket& m_packet;
+            mutable uint32 m_recipients;
+            mutable net::SharedPayload m_payload;
+    };
+}
+
+#endif
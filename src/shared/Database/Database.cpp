@@ -76,6 +76,13 @@ void SqlConnection::FreePreparedStatements()
     }
 
     m_holder.clear();
+
+    for (size_t i = 0; i < m_batchShapes.size(); ++i)
+    {
+        delete m_batchShapes[i];
+    }
+
+    m_batchShapes.clear();
 }
 
 SqlPreparedStatement* SqlConnection::GetStmt(uint32 nIndex)
@@ -129,13 +136,46 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+SqlStatementBatch::Shape const& SqlConnection::GetBatchShape(int nIndex)
+{
+    if (m_batchShapes.size() <= size_t(nIndex))
+    {
+        m_batchShapes.resize(nIndex + 1, NULL);
+    }
+
+    if (!m_batchShapes[nIndex])
+    {
+        m_batchShapes[nIndex] = new SqlStatementBatch::Shape(m_db.GetStmtString(nIndex));
+    }
+
+    return *m_batchShapes[nIndex];
+}
+
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+    {
+        return NULL;
+    }
+
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    if (!pStmt->isQuery())
+    {
+        sLog.outError("SQL ERROR: statement is not a SELECT: %s", m_db.GetStmtString(nIndex).c_str());
+        return NULL;
+    }
+
+    pStmt->bind(id);
+    return pStmt->query();
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -180,12 +220,20 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
+    // create and initialize connections for async requests, one per delay thread
+    nAsyncConns = std::min(std::max(nAsyncConns, MIN_CONNECTION_POOL_SIZE), MAX_CONNECTION_POOL_SIZE);
+    for (int i = 0; i < nAsyncConns; ++i)
     {
-        return false;
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConnections.push_back(pConn);
     }
+    m_pAsyncConn = m_pAsyncConnections[0];
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -198,9 +246,13 @@ void Database::StopServer()
     HaltDelayThread();
 
     delete m_pResultQueue;
-    delete m_pAsyncConn;
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
+    {
+        delete m_pAsyncConnections[i];
+    }
 
     m_pResultQueue = NULL;
+    m_pAsyncConnections.clear();
     m_pAsyncConn = NULL;
 
     for (size_t i = 0; i < m_pQueryConnections.size(); ++i)
@@ -211,38 +263,56 @@ void Database::StopServer()
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, bool pingsDatabase)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, pingsDatabase);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(!m_asyncExecutor);
+    assert(!m_pAsyncConnections.empty());
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
+    // One delay thread per async connection. The first also pings the query pool.
+    m_asyncExecutor = new SqlAsyncExecutor();
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
+    {
+        m_asyncExecutor->AddShard(CreateDelayThread(m_pAsyncConnections[i], i == 0));
+    }
     m_TransStorage = new DBTransHelperTSS();
-    m_delayThread = new MaNGOS::Thread(m_threadBody);
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread)
+    if (!m_asyncExecutor)
     {
         return;
     }
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
+    m_asyncExecutor->Stop();                                // Stop event, wait for flush to DB
+    delete m_asyncExecutor;
     delete m_TransStorage;
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = NULL;
-    m_threadBody = NULL;
+    m_asyncExecutor = NULL;
     m_TransStorage=NULL;
 }
 
+bool Database::DelayAsync(SqlOperation* op)
+{
+    // skip the thread-local lookup where there is nothing to route
+    uint64 key = m_asyncExecutor->GetShardCount() > 1 ? m_asyncKey.get() : 0;
+    return m_asyncExecutor->Delay(op, key);
+}
+
+void Database::GetAsyncStats(std::vector<SqlDelayThread::Stats>& stats, bool resetPeaks) const
+{
+    stats.clear();
+    if (m_asyncExecutor)
+    {
+        m_asyncExecutor->GetStats(stats, resetPeaks);
+    }
+}
+
 void Database::ThreadStart()
 {
 }
@@ -296,6 +366,7 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    // the other async connections are pinged by their own delay threads
     {
         SqlConnection::Lock guard(m_pAsyncConn);
         delete guard->Query(sql);
@@ -420,7 +491,7 @@ bool Database::Execute(const char* sql)
         }
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayAsync(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -477,7 +548,7 @@ bool Database::AsyncQuery(std::function<void(QueryResult*)> callback, const char
         return false;
     }
 
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayAsync(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 bool Database::AsyncPQuery(std::function<void(QueryResult*)> callback, const char* format, ...)
@@ -509,7 +580,8 @@ bool Database::DelayQueryHolder(std::function<void(QueryResult*, SqlQueryHolder*
         return false;
     }
 
-    return holder->Execute(new MaNGOS::QueryHolderCallback(std::move(callback), holder), m_threadBody, m_pResultQueue);
+    SqlOperation* op = holder->Execute(new MaNGOS::QueryHolderCallback(std::move(callback), holder), m_pResultQueue);
+    return op && DelayAsync(op);
 }
 
 bool Database::BeginTransaction()
@@ -545,10 +617,21 @@ bool Database::CommitTransaction()
     }
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay((*m_TransStorage)->detach());
+    DelayAsync((*m_TransStorage)->detach());
     return true;
 }
 
+uint32 Database::GetTransactionSize() const
+{
+    if (!m_TransStorage)
+    {
+        return 0;
+    }
+
+    SqlTransaction* pTrans = (*m_TransStorage)->get();
+    return pTrans ? uint32(pTrans->GetSize()) : 0;
+}
+
 bool Database::CommitTransactionDirect()
 {
     if (!m_pAsyncConn)
@@ -599,7 +682,7 @@ bool Database::CommitTransactionChecked()
     // queued op still holds its address is a use-after-free, so a timeout is not an
     // option. The residual race is closed by shutdown ordering: the world thread is torn
     // down before the delay thread, so no world caller is here while it stops.
-    if (!m_threadBody->IsRunning())
+    if (!m_asyncExecutor->IsRunning())
     {
         SqlTransaction* t = (*m_TransStorage)->detach();
         bool r = t->Execute(m_pAsyncConn);
@@ -612,7 +695,7 @@ bool Database::CommitTransactionChecked()
     std::promise<bool> prom;
     std::future<bool> fut = prom.get_future();
     SqlTransaction* pTrans = (*m_TransStorage)->detach();
-    m_threadBody->Delay(new SqlTransactionResultSignal(pTrans, &prom));
+    DelayAsync(new SqlTransactionResultSignal(pTrans, &prom));
     return fut.get();
 }
 
@@ -788,7 +871,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
         }
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayAsync(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -803,6 +886,15 @@ bool Database::DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* pa
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+    std::shared_ptr<SqlStmtParameters> p(params);
+    // a query connection, like Query(): statements are prepared per connection
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
 {
     int nId = -1;
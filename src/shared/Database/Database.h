@@ -32,11 +32,13 @@
 #include <string>
 #include "Threading/Threading.h"
 #include "Database/SqlDelayThread.h"
+#include "Database/SqlAsyncExecutor.h"
 #include "Threading/ThreadLocalStore.h"
 
 #include <atomic>
 #include <mutex>
 #include "SqlPreparedStatement.h"
+#include "SqlStatementBatch.h"
 
 class SqlTransaction;
 class SqlResultQueue;
@@ -152,6 +154,22 @@ class SqlConnection
          * @return bool
          */
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        /**
+         * @brief run a prepared SELECT and fetch its rows
+         *
+         * @param nIndex
+         * @param id
+         * @return QueryResult, or NULL on error or no rows
+         */
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
+
+        /**
+         * @brief How prepared statement @p nIndex can be batched, parsed on first use
+         *
+         * @param nIndex
+         * @return SqlStatementBatch::Shape
+         */
+        SqlStatementBatch::Shape const& GetBatchShape(int nIndex);
 
         /**
          * @brief SqlConnection object lock
@@ -236,6 +254,9 @@ class SqlConnection
          */
         typedef std::vector<SqlPreparedStatement* > StmtHolder;
         StmtHolder m_holder; /**< TODO */
+
+        typedef std::vector<SqlStatementBatch::Shape*> BatchShapeHolder;
+        BatchShapeHolder m_batchShapes; /**< by statement index, NULL until asked for */
 };
 
 /**
@@ -255,10 +276,11 @@ class Database
          * @brief
          *
          * @param infoString
-         * @param nConns
+         * @param nConns connections for synchronous queries
+         * @param nAsyncConns connections, each with its own thread, for async work
          * @return bool
          */
-        virtual bool Initialize(const char* infoString, int nConns = 1);
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
         /**
          * @brief start worker thread for async DB request execution
          *
@@ -417,6 +439,13 @@ class Database
          */
         bool CommitTransactionChecked();
 
+        /**
+         * @brief Statements queued so far in this thread's open transaction
+         *
+         * @return uint32 0 when no transaction is open
+         */
+        uint32 GetTransactionSize() const;
+
         // PREPARED STATEMENT API
         /**
          * @brief allocate index for prepared statement with SQL request 'fmt'
@@ -495,6 +524,40 @@ class Database
          */
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
 
+        /**
+         * @brief Route the async work this thread queues to one entity's shard
+         *
+         * While one of these lives, every async Execute, prepared statement, query,
+         * query holder and committed transaction queued by the thread carries @p key,
+         * and runs on async connection `key % N` in order with the rest of that key's
+         * work -- see SqlAsyncExecutor. Only wrap work that touches nothing but that
+         * entity's rows. Scopes nest; the inner key wins until it ends.
+         */
+        class AsyncKeyScope
+        {
+            public:
+                AsyncKeyScope(Database& db, uint64 key) : m_db(db), m_previous(db.m_asyncKey.get())
+                {
+                    m_db.m_asyncKey.get() = key;
+                }
+                ~AsyncKeyScope() { m_db.m_asyncKey.get() = m_previous; }
+
+            private:
+                AsyncKeyScope(AsyncKeyScope const&);
+                AsyncKeyScope& operator=(AsyncKeyScope const&);
+
+                Database& m_db;
+                uint64 m_previous;
+        };
+
+        /**
+         * @brief Queue counters of every async connection, shard 0 first
+         *
+         * @param stats
+         * @param resetPeaks start a new window for the peak values
+         */
+        void GetAsyncStats(std::vector<SqlDelayThread::Stats>& stats, bool resetPeaks) const;
+
     protected:
         /**
          * @brief
@@ -502,7 +565,7 @@ class Database
          */
         Database() :
             m_TransStorage(NULL),m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pResultQueue(NULL),
-            m_threadBody(NULL), m_delayThread(NULL), m_bAllowAsyncTransactions(false),
+            m_asyncExecutor(NULL), m_bAllowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -523,9 +586,11 @@ class Database
         /**
          * @brief factory method to create SqlDelayThread objects
          *
+         * @param conn the async connection the thread executes on
+         * @param pingsDatabase whether this thread keeps every connection alive
          * @return SqlDelayThread
          */
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, bool pingsDatabase);
 
         /**
          * @brief
@@ -597,6 +662,13 @@ class Database
          * @return SqlConnection
          */
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        /**
+         * @brief queue async work under the calling thread's AsyncKeyScope, if any
+         *
+         * @param op
+         * @return bool
+         */
+        bool DelayAsync(SqlOperation* op);
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
@@ -616,6 +688,16 @@ class Database
          * @return bool
          */
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        /**
+         * @brief run a prepared SELECT on a query connection, synchronously
+         *
+         * Takes ownership of @p params.
+         *
+         * @param id
+         * @param params
+         * @return QueryResult, or NULL on error or no rows
+         */
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters* params);
 
         // connection helper counters
         int m_nQueryConnPoolSize;                               /**< current size of query connection pool */
@@ -628,12 +710,13 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections; /**< TODO */
 
-        // only one single DB connection for transactions
-        SqlConnection* m_pAsyncConn; /**< TODO */
+        // connections for async work and transactions, one per executor shard
+        SqlConnectionContainer m_pAsyncConnections; /**< shard connections; m_pAsyncConn is the first */
+        SqlConnection* m_pAsyncConn; /**< connection of shard 0, also used by the Direct* calls */
 
         SqlResultQueue*     m_pResultQueue;                 /**< Transaction queues from diff. threads */
-        SqlDelayThread*     m_threadBody;                   /**< Pointer to delay sql executer (owned by m_delayThread) */
-        MaNGOS::Thread*  m_delayThread;                  /**< Pointer to executer thread */
+        SqlAsyncExecutor*   m_asyncExecutor;                /**< delay threads, one per async connection */
+        MaNGOS::ThreadLocalStore<uint64> m_asyncKey;        /**< AsyncKeyScope of the calling thread; 0 outside one */
 
         bool m_bAllowAsyncTransactions;                     /**< flag which specifies if async transactions are enabled */
 
@@ -31,6 +31,7 @@
 
 #include "Database/Field.h"
 #include "Database/QueryResult.h"
+#include "Database/QueryResultTyped.h"
 
 #include "Database/QueryResultMysql.h"
 #include "Database/Database.h"
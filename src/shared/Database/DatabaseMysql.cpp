@@ -649,12 +649,72 @@ bool MySqlPreparedStatement::prepare()
         m_nColumns = mysql_num_fields(m_pResultMetadata);
 
         // bind output buffers
+        if (!BindResults())
+        {
+            return false;
+        }
     }
 
     m_bPrepared = true;
     return true;
 }
 
+/**
+ * Binds one output buffer per result column: numbers into an int64 or a double,
+ * everything else into a text buffer that grows to the longest value seen.
+ */
+bool MySqlPreparedStatement::BindResults()
+{
+    MYSQL_FIELD* fields = mysql_fetch_fields(m_pResultMetadata);
+
+    m_pResult = new MYSQL_BIND[m_nColumns];
+    memset(m_pResult, 0, sizeof(MYSQL_BIND) * m_nColumns);
+    // sized once: m_pResult holds pointers into it
+    m_columns.assign(m_nColumns, ResultColumn());
+
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        ResultColumn& column = m_columns[i];
+        MYSQL_BIND& pData = m_pResult[i];
+
+        column.kind = ToValueKind(fields[i]);
+        column.type = fields[i].type;
+
+        pData.is_null = &column.isNull;
+        pData.length = &column.length;
+        pData.error = &column.error;
+
+        switch (column.kind)
+        {
+            case Field::VALUE_INT:
+            case Field::VALUE_UINT:
+                pData.buffer_type = MYSQL_TYPE_LONGLONG;
+                pData.buffer = &column.integer;
+                pData.is_unsigned = column.kind == Field::VALUE_UINT;
+                break;
+            case Field::VALUE_REAL:
+                pData.buffer_type = MYSQL_TYPE_DOUBLE;
+                pData.buffer = &column.real;
+                break;
+            default:
+                column.text.resize(64);
+                pData.buffer_type = MYSQL_TYPE_STRING;
+                pData.buffer = &column.text[0];
+                pData.buffer_length = column.text.size();
+                break;
+        }
+    }
+
+    if (mysql_stmt_bind_result(m_stmt, m_pResult))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed for '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * Binds the prepared statement input parameters from the supplied holder.
  */
@@ -738,6 +798,7 @@ void MySqlPreparedStatement::RemoveBinds()
     m_pResultMetadata = NULL;
     m_pResult = NULL;
     m_pInputArgs = NULL;
+    m_columns.clear();
 
     m_bPrepared = false;
 }
@@ -762,6 +823,130 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+/**
+ * Executes the prepared SELECT and copies every row into a QueryResultTyped.
+ *
+ * mysql_stmt_store_result() pulls the whole set over first, as mysql_store_result()
+ * does for text queries, so the connection is free again before the caller reads a row.
+ * A text value longer than its buffer is fetched again into a bigger one, and the bigger
+ * buffer is kept for the rows after it.
+ */
+QueryResult* MySqlPreparedStatement::query()
+{
+    if (!isPrepared() || !isQuery())
+    {
+        return NULL;
+    }
+
+    uint32 _s = getMSTime();
+
+    if (!execute())
+    {
+        return NULL;
+    }
+
+    if (mysql_stmt_store_result(m_stmt))
+    {
+        sLog.outError("SQL: can not fetch the result of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return NULL;
+    }
+
+    uint64 rowCount = mysql_stmt_num_rows(m_stmt);
+    if (!rowCount)
+    {
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    QueryResultTyped* result = new QueryResultTyped(m_nColumns);
+    result->Reserve(rowCount);
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        result->SetColumn(i, m_columns[i].kind, m_columns[i].type);
+    }
+
+    int status;
+    while ((status = mysql_stmt_fetch(m_stmt)) == 0 || status == MYSQL_DATA_TRUNCATED)
+    {
+        bool rebind = false;
+        for (uint32 i = 0; i < m_nColumns; ++i)
+        {
+            ResultColumn& column = m_columns[i];
+            if (column.isNull)
+            {
+                result->AddNull(i);
+                continue;
+            }
+
+            switch (column.kind)
+            {
+                case Field::VALUE_INT:  result->AddInt(i, column.integer);                   break;
+                case Field::VALUE_UINT: result->AddUInt(i, uint64(column.integer));          break;
+                case Field::VALUE_REAL: result->AddReal(i, column.real);                     break;
+                default:
+                    if (column.length > column.text.size())
+                    {
+                        column.text.resize(column.length);
+                        m_pResult[i].buffer = &column.text[0];
+                        m_pResult[i].buffer_length = column.text.size();
+                        mysql_stmt_fetch_column(m_stmt, &m_pResult[i], i, 0);
+                        rebind = true;
+                    }
+                    result->AddText(i, &column.text[0], column.length);
+                    break;
+            }
+        }
+
+        if (rebind)
+        {
+            mysql_stmt_bind_result(m_stmt, m_pResult);
+        }
+    }
+
+    if (status != MYSQL_NO_DATA)
+    {
+        sLog.outError("SQL: can not fetch the rows of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+    }
+
+    mysql_stmt_free_result(m_stmt);
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL (binary): %s", getMSTimeDiff(_s, getMSTime()), m_szFmt.c_str());
+
+    if (status != MYSQL_NO_DATA || !result->Start())
+    {
+        delete result;
+        return NULL;
+    }
+
+    return result;
+}
+
+/**
+ * Picks how a result column is fetched. Integers and reals come as numbers;
+ * DECIMAL stays text to keep its exact digits, and dates, strings, blobs, BIT,
+ * ENUM and SET come as the same text the text protocol would have sent.
+ */
+Field::ValueKind MySqlPreparedStatement::ToValueKind(const MYSQL_FIELD& field)
+{
+    switch (field.type)
+    {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG:
+        case MYSQL_TYPE_YEAR:
+            return (field.flags & UNSIGNED_FLAG) ? Field::VALUE_UINT : Field::VALUE_INT;
+        case MYSQL_TYPE_FLOAT:
+        case MYSQL_TYPE_DOUBLE:
+            return Field::VALUE_REAL;
+        default:
+            return Field::VALUE_TEXT;
+    }
+}
+
 /**
  * Maps an internal prepared statement field type to a MySQL field type.
  */
@@ -32,6 +32,8 @@
 #include "Database.h"
 #include "Policies/Singleton.h"
 #include <mutex>
+#include <type_traits>
+#include <vector>
 #include <mysql.h>
 
 #ifdef WIN32
@@ -43,6 +45,8 @@
  *
  * MySqlPreparedStatement provides MySQL-specific implementation of
  * prepared statements for efficient SQL query execution with parameter binding.
+ * A SELECT fetches through the binary protocol into a QueryResultTyped: integer
+ * and real columns arrive as numbers and are never turned into text.
  */
 class MySqlPreparedStatement : public SqlPreparedStatement
 {
@@ -77,6 +81,12 @@ class MySqlPreparedStatement : public SqlPreparedStatement
          */
         bool execute() override;
 
+        /**
+         * @brief Execute the prepared SELECT and fetch all rows in binary form
+         * @return QueryResultTyped on its first row, or NULL on failure/no rows
+         */
+        QueryResult* query() override;
+
     protected:
         /**
          * @brief Add a parameter to the bind array
@@ -93,7 +103,38 @@ class MySqlPreparedStatement : public SqlPreparedStatement
          */
         static enum_field_types ToMySQLType(const SqlStmtFieldData& data, bool& bUnsigned);
 
+        /**
+         * @brief How a result column is fetched and kept
+         * @param field Column metadata
+         * @return VALUE_INT/VALUE_UINT/VALUE_REAL for numbers, VALUE_TEXT for the rest
+         */
+        static Field::ValueKind ToValueKind(const MYSQL_FIELD& field);
+
     private:
+        /// my_bool before MySQL 8, bool since; whatever MYSQL_BIND points at.
+        typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type BindFlag;
+
+        /**
+         * @brief Where mysql_stmt_fetch() leaves one column of the current row
+         */
+        struct ResultColumn
+        {
+            Field::ValueKind kind; /**< How the column is fetched */
+            enum_field_types type; /**< Column type from the metadata */
+            int64 integer; /**< VALUE_INT / VALUE_UINT buffer */
+            double real; /**< VALUE_REAL buffer */
+            std::vector<char> text; /**< VALUE_TEXT buffer, grown when a value does not fit */
+            unsigned long length; /**< Length of the fetched value */
+            BindFlag isNull; /**< Set by the client library for SQL NULL */
+            BindFlag error; /**< Set by the client library on truncation */
+        };
+
+        /**
+         * @brief Bind the result columns to m_columns
+         * @return True on success
+         */
+        bool BindResults();
+
         /**
          * @brief Remove and free parameter bindings
          */
@@ -104,6 +145,7 @@ class MySqlPreparedStatement : public SqlPreparedStatement
         MYSQL_BIND* m_pInputArgs; /**< Input parameter bindings */
         MYSQL_BIND* m_pResult; /**< Result bindings */
         MYSQL_RES* m_pResultMetadata; /**< Result metadata */
+        std::vector<ResultColumn> m_columns; /**< Output buffers m_pResult points into */
 };
 
 /**
@@ -25,13 +25,49 @@
 
 /**
  * @file Field.cpp
- * @brief Database field implementation placeholder
+ * @brief Database field implementation
  *
- * This file is intentionally minimal as the Field class is primarily
- * implemented inline in Field.h. The Field class represents a single
- * column value from a database query result and provides type conversion
- * methods for accessing the data in various formats.
+ * The Field class is primarily implemented inline in Field.h. What lives
+ * here is the text rendering of a value read through the binary protocol,
+ * which only callers asking a numeric column for its string ever reach.
  *
  * @see Field.h for the complete class implementation
  */
 
+#include "Field.h"
+
+/**
+ * @brief Render the binary number held by this field as text
+ * @return Pointer to the field's own buffer, valid until the field changes
+ *
+ * Integers print exactly. Reals print with the fewest digits that read back
+ * to the same value -- as the text protocol sends them -- judged at the
+ * column's own precision, so a FLOAT column shows 0.1 and not 0.100000001.
+ */
+const char* Field::RenderNumber() const
+{
+    switch (mKind)
+    {
+        case VALUE_INT:
+            snprintf(mText, sizeof(mText), SI64FMTD, mNumber.i);
+            break;
+        case VALUE_UINT:
+            snprintf(mText, sizeof(mText), UI64FMTD, static_cast<uint64>(mNumber.i));
+            break;
+        default:
+        {
+            bool single = mType == MYSQL_TYPE_FLOAT;
+            for (int precision = 1; precision <= 17; ++precision)
+            {
+                snprintf(mText, sizeof(mText), "%.*g", precision, mNumber.d);
+                double back = strtod(mText, NULL);
+                if (single ? static_cast<float>(back) == static_cast<float>(mNumber.d) : back == mNumber.d)
+                {
+                    break;
+                }
+            }
+            break;
+        }
+    }
+    return mText;
+}
@@ -38,6 +38,11 @@
  * Field provides type-safe access to database query result values.
  * It handles NULL values and converts between string representations
  * and various C++ types (int, float, bool, string, etc.).
+ *
+ * A field from a text-protocol query holds the string the server sent and parses it on
+ * every access. A field from a prepared statement's binary result holds the number
+ * itself, and the numeric getters only cast it; GetString() on such a field renders the
+ * number into a buffer of its own.
  */
 class Field
 {
@@ -55,16 +60,27 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
+        /**
+         * @brief How the value is held: as text, or as a number read in binary form
+         */
+        enum ValueKind
+        {
+            VALUE_TEXT      = 0x00, /**< mValue, parsed on access; NULL is SQL NULL */
+            VALUE_INT       = 0x01, /**< signed integer in mNumber.i */
+            VALUE_UINT      = 0x02, /**< unsigned integer, its bits in mNumber.i */
+            VALUE_REAL      = 0x03 /**< floating point in mNumber.d */
+        };
+
         /**
          * @brief Default constructor - creates NULL field
          */
-        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL) {}
+        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL), mKind(VALUE_TEXT) {}
         /**
          * @brief Constructor with value and type
          * @param value Pointer to string value
          * @param type MySQL field type
          */
-        Field(const char* value, enum_field_types type) : mValue(value), mType(type) {}
+        Field(const char* value, enum_field_types type) : mValue(value), mType(type), mKind(VALUE_TEXT) {}
 
         /**
          * @brief Destructor
@@ -80,74 +96,143 @@ class Field
          * @brief Check if field value is NULL
          * @return True if NULL, false otherwise
          */
-        bool IsNULL() const { return mValue == NULL; }
+        bool IsNULL() const { return mKind == VALUE_TEXT && mValue == NULL; }
 
         /**
          * @brief Get raw string value
          * @return Pointer to string value (may be NULL)
          */
-        const char* GetString() const { return mValue; }
+        const char* GetString() const { return mKind == VALUE_TEXT ? mValue : RenderNumber(); }
         /**
          * @brief Get C++ string value
          * @return String value (empty if NULL)
          */
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
         }
         /**
          * @brief Get float value
          * @return Float value (0.0 if NULL)
          */
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
+        float GetFloat() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<float>(NumberAsReal());
+            }
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+        }
         /**
          * @brief Get boolean value
          * @return Boolean value (false if NULL or 0)
          */
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
+        bool GetBool() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return mKind == VALUE_UINT ? mNumber.i != 0 : NumberAsInt() > 0;
+            }
+            return mValue ? atoi(mValue) > 0 : false;
+        }
         /**
          * @brief Get double value
          * @return Double value (0.0 if NULL)
          */
-        double GetDouble() const { return mValue ? static_cast<double>(atof(mValue)) : 0.0f; }
+        double GetDouble() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return NumberAsReal();
+            }
+            return mValue ? static_cast<double>(atof(mValue)) : 0.0f;
+        }
         /**
          * @brief Get 8-bit signed integer value
          * @return 8-bit signed integer (0 if NULL)
          */
         // strtol/strtoul, not atol: MSVC's long is 32 bits even on x64, so a DB
         // value above 2^31 overflows atol -- undefined, LONG_MAX in practice.
-        int8 GetInt8() const { return mValue ? static_cast<int8>(std::strtol(mValue, NULL, 10)) : int8(0); }
+        int8 GetInt8() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<int8>(NumberAsInt());
+            }
+            return mValue ? static_cast<int8>(std::strtol(mValue, NULL, 10)) : int8(0);
+        }
         /**
          * @brief Get 32-bit signed integer value
          * @return 32-bit signed integer (0 if NULL)
          */
-        int32 GetInt32() const { return mValue ? static_cast<int32>(std::strtol(mValue, NULL, 10)) : int32(0); }
+        int32 GetInt32() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<int32>(NumberAsInt());
+            }
+            return mValue ? static_cast<int32>(std::strtol(mValue, NULL, 10)) : int32(0);
+        }
         /**
          * @brief Get 8-bit unsigned integer value
          * @return 8-bit unsigned integer (0 if NULL)
          */
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(std::strtoul(mValue, NULL, 10)) : uint8(0); }
+        uint8 GetUInt8() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<uint8>(NumberAsInt());
+            }
+            return mValue ? static_cast<uint8>(std::strtoul(mValue, NULL, 10)) : uint8(0);
+        }
         /**
          * @brief Get 16-bit unsigned integer value
          * @return 16-bit unsigned integer (0 if NULL)
          */
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(std::strtoul(mValue, NULL, 10)) : uint16(0); }
+        uint16 GetUInt16() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<uint16>(NumberAsInt());
+            }
+            return mValue ? static_cast<uint16>(std::strtoul(mValue, NULL, 10)) : uint16(0);
+        }
         /**
          * @brief Get 16-bit signed integer value
          * @return 16-bit signed integer (0 if NULL)
          */
-        int16 GetInt16() const { return mValue ? static_cast<int16>(std::strtol(mValue, NULL, 10)) : int16(0); }
+        int16 GetInt16() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<int16>(NumberAsInt());
+            }
+            return mValue ? static_cast<int16>(std::strtol(mValue, NULL, 10)) : int16(0);
+        }
         /**
          * @brief Get 32-bit unsigned integer value
          * @return 32-bit unsigned integer (0 if NULL)
          */
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(std::strtoul(mValue, NULL, 10)) : uint32(0); }
+        uint32 GetUInt32() const
+        {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<uint32>(NumberAsInt());
+            }
+            return mValue ? static_cast<uint32>(std::strtoul(mValue, NULL, 10)) : uint32(0);
+        }
         /**
          * @brief Get 64-bit unsigned integer value
          * @return 64-bit unsigned integer (0 if NULL)
          */
         uint64 GetUInt64() const
         {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<uint64>(NumberAsInt());
+            }
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
             {
@@ -163,6 +248,11 @@ class Field
         // TODO: should this be int64 not uint64
         uint64 GetInt64() const
         {
+            if (mKind != VALUE_TEXT)
+            {
+                return static_cast<uint64>(NumberAsInt());
+            }
+
             int64 value = 0;
             if (!mValue || sscanf(mValue, SI64FMTD, &value) == -1)
             {
@@ -186,7 +276,29 @@ class Field
          *
          * @param value Pointer to string value
          */
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mKind = VALUE_TEXT; }
+
+        /**
+         * @brief Set a signed integer read in binary form
+         * @param value The value
+         */
+        void SetInt64(int64 value) { mNumber.i = value; mKind = VALUE_INT; }
+        /**
+         * @brief Set an unsigned integer read in binary form
+         * @param value The value
+         */
+        void SetUInt64(uint64 value) { mNumber.i = static_cast<int64>(value); mKind = VALUE_UINT; }
+        /**
+         * @brief Set a floating point value read in binary form
+         * @param value The value
+         */
+        void SetDouble(double value) { mNumber.d = value; mKind = VALUE_REAL; }
+
+        /**
+         * @brief How the current value is held
+         * @return VALUE_TEXT for text and NULL, otherwise the kind of number
+         */
+        ValueKind GetValueKind() const { return ValueKind(mKind); }
 
     private:
         /**
@@ -198,7 +310,36 @@ class Field
          */
         Field& operator=(Field const&);
 
+        /**
+         * @brief A binary integer as int64; a binary real truncated toward zero, as strtol would
+         */
+        int64 NumberAsInt() const { return mKind == VALUE_REAL ? static_cast<int64>(mNumber.d) : mNumber.i; }
+        /**
+         * @brief A binary number as double
+         */
+        double NumberAsReal() const
+        {
+            switch (mKind)
+            {
+                case VALUE_REAL: return mNumber.d;
+                case VALUE_UINT: return static_cast<double>(static_cast<uint64>(mNumber.i));
+                default:         return static_cast<double>(mNumber.i);
+            }
+        }
+        /**
+         * @brief Render a binary number as the text protocol would have sent it
+         * @return Pointer to mText
+         */
+        const char* RenderNumber() const;
+
         const char* mValue; /**< Pointer to field value string */
         enum_field_types mType; /**< MySQL field type */
+        uint8 mKind; /**< ValueKind of the current value */
+        union
+        {
+            int64 i;
+            double d;
+        } mNumber; /**< Current value when it is not text */
+        mutable char mText[32]; /**< GetString() rendering of mNumber */
 };
 #endif
@@ -0,0 +1,173 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file QueryResultTyped.cpp
+ * @brief Columnar, typed result set filled from a binary-protocol fetch
+ */
+
+#include "QueryResultTyped.h"
+#include "Utilities/Errors.h"
+
+#include <cstring>
+
+QueryResultTyped::QueryResultTyped(uint32 fieldCount) : QueryResult(0, fieldCount), m_columns(fieldCount), m_row(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        m_columns[i].kind = Field::VALUE_TEXT;
+    }
+}
+
+QueryResultTyped::~QueryResultTyped()
+{
+    EndQuery();
+}
+
+void QueryResultTyped::SetColumn(uint32 index, Field::ValueKind kind, enum_field_types type)
+{
+    MANGOS_ASSERT(index < mFieldCount);
+    m_columns[index].kind = kind;
+    mCurrentRow[index].SetType(type);
+}
+
+void QueryResultTyped::Reserve(uint64 rows)
+{
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        m_columns[i].cells.reserve(size_t(rows));
+        m_columns[i].nulls.reserve(size_t(rows));
+    }
+}
+
+void QueryResultTyped::AddNull(uint32 index)
+{
+    Cell cell;
+    cell.i = 0;
+    m_columns[index].cells.push_back(cell);
+    m_columns[index].nulls.push_back(1);
+}
+
+void QueryResultTyped::AddInt(uint32 index, int64 value)
+{
+    Cell cell;
+    cell.i = value;
+    m_columns[index].cells.push_back(cell);
+    m_columns[index].nulls.push_back(0);
+}
+
+void QueryResultTyped::AddUInt(uint32 index, uint64 value)
+{
+    AddInt(index, static_cast<int64>(value));
+}
+
+void QueryResultTyped::AddReal(uint32 index, double value)
+{
+    Cell cell;
+    cell.d = value;
+    m_columns[index].cells.push_back(cell);
+    m_columns[index].nulls.push_back(0);
+}
+
+void QueryResultTyped::AddText(uint32 index, const char* data, size_t length)
+{
+    Cell cell;
+    cell.text = m_pool.size();
+    m_pool.insert(m_pool.end(), data, data + length);
+    m_pool.push_back('\0');
+    m_columns[index].cells.push_back(cell);
+    m_columns[index].nulls.push_back(0);
+}
+
+bool QueryResultTyped::Start()
+{
+    mRowCount = mFieldCount ? m_columns[0].cells.size() : 0;
+    for (uint32 i = 1; i < mFieldCount; ++i)
+    {
+        MANGOS_ASSERT(m_columns[i].cells.size() == mRowCount && "every column needs one value per row");
+    }
+
+    m_row = 0;
+    if (!mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    LoadRow(0);
+    return true;
+}
+
+bool QueryResultTyped::NextRow()
+{
+    if (!mCurrentRow)
+    {
+        return false;
+    }
+
+    if (++m_row >= mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    LoadRow(m_row);
+    return true;
+}
+
+void QueryResultTyped::LoadRow(uint64 row)
+{
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Column const& column = m_columns[i];
+        Cell const& cell = column.cells[size_t(row)];
+        Field& field = mCurrentRow[i];
+
+        if (column.nulls[size_t(row)])
+        {
+            field.SetValue(NULL);
+            continue;
+        }
+
+        switch (column.kind)
+        {
+            case Field::VALUE_INT:  field.SetInt64(cell.i);                         break;
+            case Field::VALUE_UINT: field.SetUInt64(static_cast<uint64>(cell.i));   break;
+            case Field::VALUE_REAL: field.SetDouble(cell.d);                        break;
+            default:                field.SetValue(&m_pool[size_t(cell.text)]);     break;
+        }
+    }
+}
+
+void QueryResultTyped::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = NULL;
+
+    std::vector<Column>().swap(m_columns);
+    std::vector<char>().swap(m_pool);
+}
@@ -0,0 +1,114 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_QUERYRESULTTYPED_H
+#define MANGOS_QUERYRESULTTYPED_H
+
+#include "QueryResult.h"
+#include "Platform/Define.h"
+
+#include <vector>
+
+/**
+ * @file QueryResultTyped.h
+ * @brief A whole result set held by column, each value in its own type.
+ *
+ * The text protocol hands every value over as a string, and Field parses it again on
+ * each access. A prepared statement's binary result arrives typed; this keeps it that
+ * way. Integers and reals are stored as numbers, one array per column, strings in one
+ * pool, and the Fields of the current row are pointed at them -- so GetUInt32() on a
+ * row from here is a cast, not a strtoul.
+ *
+ * The database layer that fetched the rows fills the set one row after the other, each
+ * column's value in turn, then calls Start(); from there it reads like any QueryResult.
+ */
+class QueryResultTyped : public QueryResult
+{
+    public:
+        /**
+         * @brief An empty result of @p fieldCount columns, all text until SetColumn() says otherwise
+         * @param fieldCount Number of columns
+         */
+        explicit QueryResultTyped(uint32 fieldCount);
+        ~QueryResultTyped();
+
+        /**
+         * @brief Declare how column @p index is stored and what the server called its type
+         * @param index Column index
+         * @param kind VALUE_INT, VALUE_UINT, VALUE_REAL or VALUE_TEXT
+         * @param type The column's type as the server reported it, for Field::GetType()
+         */
+        void SetColumn(uint32 index, Field::ValueKind kind, enum_field_types type);
+
+        /**
+         * @brief Make room for @p rows rows up front
+         * @param rows Expected number of rows
+         */
+        void Reserve(uint64 rows);
+
+        /// Append the next value of column @p index. Every column gets one per row.
+        void AddNull(uint32 index);
+        void AddInt(uint32 index, int64 value);
+        void AddUInt(uint32 index, uint64 value);
+        void AddReal(uint32 index, double value);
+        void AddText(uint32 index, const char* data, size_t length);
+
+        /**
+         * @brief Finish filling and move to the first row
+         * @return false if no row was added; the result should then be dropped
+         */
+        bool Start();
+
+        /**
+         * @brief Move to the next row
+         * @return false past the last row, after which Fetch() returns NULL
+         */
+        bool NextRow() override;
+
+    private:
+        /// One value: the number, or the string's offset in the pool.
+        union Cell
+        {
+            int64 i;
+            double d;
+            uint64 text;
+        };
+
+        struct Column
+        {
+            Field::ValueKind kind;
+            std::vector<Cell> cells;
+            std::vector<uint8> nulls;                       ///< one per row, 1 for SQL NULL
+        };
+
+        void LoadRow(uint64 row);
+        void EndQuery();
+
+        std::vector<Column> m_columns;
+        std::vector<char> m_pool;                           ///< every string, each terminated
+        uint64 m_row;
+};
+
+#endif
@@ -724,6 +724,32 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
     private:
+        /**
+         * @brief Size of one destination record of @p store.
+         *
+         * @param store
+         * @return uint32
+         */
+        uint32 recordSize(StorageClass& store);
+
+        template<class Row>
+        /**
+         * @brief Build one record from a source row: a Field row or a snapshot row.
+         *
+         * @param store
+         * @param row
+         */
+        void loadRecord(StorageClass& store, Row const& row);
+
+        /**
+         * @brief Fill @p store from its snapshot, if the snapshot matches @p key.
+         *
+         * @param store
+         * @param key
+         * @return bool false if there is no usable snapshot
+         */
+        bool loadSnapshot(StorageClass& store, uint64 key);
+
         template<class V>
         /**
          * @brief
@@ -31,6 +31,7 @@
 #include "Utilities/ProgressBar.h"
 #include "Log/Log.h"
 #include "DataStores/DBCFileLoader.h"
+#include "Database/SQLStorageSnapshot.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>
@@ -263,6 +264,154 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
     }
 }
 
+/**
+ * @brief A Field row, read through the accessors a snapshot row also has.
+ */
+struct SQLStorageFieldRow
+{
+    explicit SQLStorageFieldRow(Field* fields) : m_fields(fields) {}
+
+    uint32 GetUInt32(uint32 column) const { return m_fields[column].GetUInt32(); }
+    uint8 GetUInt8(uint32 column) const { return m_fields[column].GetUInt8(); }
+    float GetFloat(uint32 column) const { return m_fields[column].GetFloat(); }
+    char const* GetString(uint32 column) const { return m_fields[column].GetString(); }
+
+    Field* m_fields;
+};
+
+template<class DerivedLoader, class StorageClass>
+/**
+ * @brief
+ *
+ * @param store
+ * @return uint32
+ */
+uint32 SQLStorageLoaderBase<DerivedLoader, StorageClass>::recordSize(StorageClass& store)
+{
+    uint32 recordsize = 0;
+    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            case DBC_FF_LOGIC:
+                recordsize += sizeof(bool);   break;
+            case DBC_FF_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_INT:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_STRING:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_NA:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_NA_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_NA_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_NA_POINTER:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_IND:
+            case DBC_FF_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+    return recordsize;
+}
+
+template<class DerivedLoader, class StorageClass>
+template<class Row>
+/**
+ * @brief
+ *
+ * @param store
+ * @param row
+ */
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::loadRecord(StorageClass& store, Row const& row)
+{
+    char* record = store.createRecord(row.GetUInt32(0));
+    uint32 offset = 0;
+
+    // dependend on dest-size
+    // iterate two indexes: x over dest, y over source
+    //                      y++ If and only If x != FT_NA*
+    //                      x++ If and only If a value is stored
+    for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            // For default fill continue and do not increase y
+            case DBC_FF_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
+            case DBC_FF_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
+            case DBC_FF_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
+            case DBC_FF_NA_POINTER: storeValue((char const*)NULL, store, record, x, offset); ++x; continue;
+            default:
+                break;
+        }
+
+        // It is required that the input has at least as many columns set as the output requires
+        if (y >= store.GetSrcFieldCount())
+        {
+            assert(false && "SQL storage has too few columns!");
+        }
+
+        switch (store.GetSrcFormat(y))
+        {
+            case DBC_FF_LOGIC:  storeValue((bool)(row.GetUInt32(y) > 0), store, record, x, offset);  ++x; break;
+            case DBC_FF_BYTE:   storeValue((char)row.GetUInt8(y), store, record, x, offset);         ++x; break;
+            case DBC_FF_INT:    storeValue((uint32)row.GetUInt32(y), store, record, x, offset);      ++x; break;
+            case DBC_FF_FLOAT:  storeValue((float)row.GetFloat(y), store, record, x, offset);        ++x; break;
+            case DBC_FF_STRING: storeValue((char const*)row.GetString(y), store, record, x, offset); ++x; break;
+            case DBC_FF_NA:
+            case DBC_FF_NA_BYTE:
+            case DBC_FF_NA_FLOAT:
+                // Do Not increase x
+                break;
+            case DBC_FF_IND:
+            case DBC_FF_SORT:
+            case DBC_FF_NA_POINTER:
+                assert(false && "SQL storage not have sort or pointer field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+        }
+        ++y;
+    }
+}
+
+template<class DerivedLoader, class StorageClass>
+/**
+ * @brief
+ *
+ * @param store
+ * @param key
+ * @return bool
+ */
+bool SQLStorageLoaderBase<DerivedLoader, StorageClass>::loadSnapshot(StorageClass& store, uint64 key)
+{
+    SQLStorageSnapshot::Reader snapshot;
+    if (!snapshot.Open(SQLStorageSnapshot::FileName(store.GetTableName()), store.GetSrcFormat(), key))
+    {
+        return false;
+    }
+
+    store.prepareToLoad(snapshot.MaxRecordId(), snapshot.RowCount(), recordSize(store));
+
+    BarGoLink bar(snapshot.RowCount());
+    for (uint32 i = 0; i < snapshot.RowCount(); ++i)
+    {
+        bar.step();
+        loadRecord(store, snapshot.GetRow(i));
+    }
+
+    sLog.outString("%s read from its snapshot", store.GetTableName());
+    return true;
+}
+
 template<class DerivedLoader, class StorageClass>
 /**
  * @brief
@@ -273,7 +422,30 @@ template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
     Field* fields = NULL;
-    QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(`%s`) FROM `%s`", store.EntryFieldName(), store.GetTableName());
+    QueryResult* result = NULL;
+
+    // A snapshot is keyed by the table's checksum, which the server works out without
+    // sending a row. No checksum (an engine or a server that will not give one) means no
+    // snapshot, read or written.
+    uint64 snapshotKey = 0;
+    bool useSnapshot = SQLStorageSnapshot::Enabled() && store.GetSrcFormat(0) == DBC_FF_INT;
+    if (useSnapshot)
+    {
+        result = WorldDatabase.PQuery("CHECKSUM TABLE `%s`", store.GetTableName());
+        useSnapshot = result && !(*result)[1].IsNULL();
+        if (useSnapshot)
+        {
+            snapshotKey = (*result)[1].GetUInt64();
+        }
+        delete result;
+
+        if (useSnapshot && loadSnapshot(store, snapshotKey))
+        {
+            return;
+        }
+    }
+
+    result = WorldDatabase.PQuery("SELECT MAX(`%s`) FROM `%s`", store.EntryFieldName(), store.GetTableName());
     if (!result)
     {
         sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
@@ -283,7 +455,6 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
 
     uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
     uint32 recordCount = 0;
-    uint32 recordsize = 0;
     delete result;
 
     result = WorldDatabase.PQuery("SELECT COUNT(*) FROM `%s`", store.GetTableName());
@@ -320,42 +491,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    // get struct size
-    uint32 offset = 0;
-    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
-    {
-        switch (store.GetDstFormat(x))
-        {
-            case DBC_FF_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case DBC_FF_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_INT:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_STRING:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_NA:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_NA_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_NA_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_NA_POINTER:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_IND:
-            case DBC_FF_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
-
     // Prepare data storage and lookup storage
-    store.prepareToLoad(maxRecordId, recordCount, recordsize);
+    store.prepareToLoad(maxRecordId, recordCount, recordSize(store));
+
+    SQLStorageSnapshot::Writer snapshot(store.GetSrcFormat(), snapshotKey, maxRecordId);
 
     BarGoLink bar(recordCount);
     do
@@ -363,58 +502,21 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         fields = result->Fetch();
         bar.step();
 
-        char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
-
-        // dependend on dest-size
-        // iterate two indexes: x over dest, y over source
-        //                      y++ If and only If x != FT_NA*
-        //                      x++ If and only If a value is stored
-        for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
+        SQLStorageFieldRow row(fields);
+        if (useSnapshot)
         {
-            switch (store.GetDstFormat(x))
-            {
-                // For default fill continue and do not increase y
-                case DBC_FF_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
-                case DBC_FF_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
-                case DBC_FF_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
-                case DBC_FF_NA_POINTER: storeValue((char const*)NULL, store, record, x, offset); ++x; continue;
-                default:
-                    break;
-            }
-
-            // It is required that the input has at least as many columns set as the output requires
-            if (y >= store.GetSrcFieldCount())
-            {
-                assert(false && "SQL storage has too few columns!");
-            }
-
-            switch (store.GetSrcFormat(y))
-            {
-                case DBC_FF_LOGIC:  storeValue((bool)(fields[y].GetUInt32() > 0), store, record, x, offset);  ++x; break;
-                case DBC_FF_BYTE:   storeValue((char)fields[y].GetUInt8(), store, record, x, offset);         ++x; break;
-                case DBC_FF_INT:    storeValue((uint32)fields[y].GetUInt32(), store, record, x, offset);      ++x; break;
-                case DBC_FF_FLOAT:  storeValue((float)fields[y].GetFloat(), store, record, x, offset);        ++x; break;
-                case DBC_FF_STRING: storeValue((char const*)fields[y].GetString(), store, record, x, offset); ++x; break;
-                case DBC_FF_NA:
-                case DBC_FF_NA_BYTE:
-                case DBC_FF_NA_FLOAT:
-                    // Do Not increase x
-                    break;
-                case DBC_FF_IND:
-                case DBC_FF_SORT:
-                case DBC_FF_NA_POINTER:
-                    assert(false && "SQL storage not have sort or pointer field types");
-                    break;
-                default:
-                    assert(false && "unknown format character");
-            }
-            ++y;
+            snapshot.Add(row);
         }
+        loadRecord(store, row);
     }
     while (result->NextRow());
 
     delete result;
+
+    if (useSnapshot && !snapshot.Commit(SQLStorageSnapshot::FileName(store.GetTableName())))
+    {
+        sLog.outError("Could not write the snapshot of %s to %s", store.GetTableName(), SQLStorageSnapshot::FileName(store.GetTableName()).c_str());
+    }
 }
 
 #endif
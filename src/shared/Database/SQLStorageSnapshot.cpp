@@ -0,0 +1,338 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file SQLStorageSnapshot.cpp
+ * @brief Binary snapshots of the SQLStorage tables: layout, writer and mapped reader.
+ */
+
+#include "SQLStorageSnapshot.h"
+#include "DataStores/DBCFileLoader.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const uint32 SNAPSHOT_MAGIC = 0x53514D4E;               // "NMQS" in file order
+    const uint32 SNAPSHOT_VERSION = 1;
+
+    struct SnapshotHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 key;
+        uint32 maxRecordId;
+        uint32 rowCount;
+        uint32 rowWidth;
+        uint32 formatLength;
+        uint32 poolSize;
+        uint32 reserved;
+    };
+}
+
+std::string SQLStorageSnapshot::s_directory;
+
+void SQLStorageSnapshot::SetDirectory(std::string const& dir)
+{
+    s_directory = dir;
+    if (!s_directory.empty() && s_directory[s_directory.size() - 1] != '/' && s_directory[s_directory.size() - 1] != '\\')
+    {
+        s_directory += '/';
+    }
+}
+
+bool SQLStorageSnapshot::Enabled()
+{
+    return !s_directory.empty();
+}
+
+std::string SQLStorageSnapshot::FileName(char const* table)
+{
+    return s_directory + table + ".snapshot";
+}
+
+SQLStorageSnapshot::ColumnKindType SQLStorageSnapshot::ColumnKind(char format)
+{
+    switch (format)
+    {
+        case DBC_FF_INT:
+        case DBC_FF_LOGIC:
+            return COLUMN_UINT32;
+        case DBC_FF_BYTE:
+            return COLUMN_UINT8;
+        case DBC_FF_FLOAT:
+            return COLUMN_FLOAT;
+        case DBC_FF_STRING:
+            return COLUMN_STRING;
+        default:
+            return COLUMN_SKIPPED;
+    }
+}
+
+uint32 SQLStorageSnapshot::Layout(char const* srcFormat, std::vector<uint32>& offsets)
+{
+    uint32 width = 0;
+    offsets.clear();
+    for (char const* c = srcFormat; *c; ++c)
+    {
+        offsets.push_back(width);
+        switch (ColumnKind(*c))
+        {
+            case COLUMN_UINT8:
+                width += 1;
+                break;
+            case COLUMN_UINT32:
+            case COLUMN_FLOAT:
+            case COLUMN_STRING:
+                width += 4;
+                break;
+            default:
+                break;
+        }
+    }
+    return width;
+}
+
+// -----------------------------------  Writer  ------------------------------------------------ //
+
+SQLStorageSnapshot::Writer::Writer(char const* srcFormat, uint64 key, uint32 maxRecordId)
+    : m_format(srcFormat), m_rowCount(0), m_maxRecordId(maxRecordId), m_key(key)
+{
+    m_rowWidth = Layout(srcFormat, m_offsets);
+}
+
+uint32 SQLStorageSnapshot::Writer::AddString(char const* str)
+{
+    if (!str)
+    {
+        return NULL_STRING;
+    }
+
+    uint32 at = uint32(m_pool.size());
+    m_pool.insert(m_pool.end(), str, str + strlen(str) + 1);
+    return at;
+}
+
+bool SQLStorageSnapshot::Writer::Commit(std::string const& path) const
+{
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.key = m_key;
+    header.maxRecordId = m_maxRecordId;
+    header.rowCount = m_rowCount;
+    header.rowWidth = m_rowWidth;
+    header.formatLength = uint32(m_format.size());
+    header.poolSize = uint32(m_pool.size());
+
+    std::string tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f)
+    {
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(m_format.data(), 1, m_format.size(), f) == m_format.size() &&
+              (m_rows.empty() || fwrite(&m_rows[0], 1, m_rows.size(), f) == m_rows.size()) &&
+              (m_pool.empty() || fwrite(&m_pool[0], 1, m_pool.size(), f) == m_pool.size());
+    ok = fclose(f) == 0 && ok;
+
+    if (ok)
+    {
+        // rename() will not replace an existing file on Windows.
+        remove(path.c_str());
+        ok = rename(tmp.c_str(), path.c_str()) == 0;
+    }
+    if (!ok)
+    {
+        remove(tmp.c_str());
+    }
+    return ok;
+}
+
+// -----------------------------------  Reader  ------------------------------------------------ //
+
+SQLStorageSnapshot::Reader::Reader()
+    : m_map(NULL), m_mapSize(0),
+#ifdef _WIN32
+      m_file(INVALID_HANDLE_VALUE), m_mapping(NULL),
+#endif
+      m_rows(NULL), m_pool(NULL), m_rowWidth(0), m_rowCount(0), m_maxRecordId(0)
+{
+}
+
+SQLStorageSnapshot::Reader::~Reader()
+{
+    Close();
+}
+
+void SQLStorageSnapshot::Reader::Close()
+{
+#ifdef _WIN32
+    if (m_map)
+    {
+        UnmapViewOfFile(m_map);
+    }
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+    }
+    m_mapping = NULL;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if (m_map)
+    {
+        munmap(m_map, m_mapSize);
+    }
+#endif
+    m_map = NULL;
+    m_mapSize = 0;
+    m_rows = NULL;
+    m_pool = NULL;
+    m_rowCount = 0;
+}
+
+bool SQLStorageSnapshot::Reader::Open(std::string const& path, char const* srcFormat, uint64 key)
+{
+    Close();
+
+#ifdef _WIN32
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart < LONGLONG(sizeof(SnapshotHeader)))
+    {
+        Close();
+        return false;
+    }
+    m_mapSize = size_t(size.QuadPart);
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    m_map = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!m_map)
+    {
+        Close();
+        return false;
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(SnapshotHeader))
+    {
+        close(fd);
+        return false;
+    }
+    m_mapSize = size_t(st.st_size);
+    void* map = mmap(NULL, m_mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);                                              // the mapping keeps the file
+    if (map == MAP_FAILED)
+    {
+        m_mapSize = 0;
+        return false;
+    }
+    m_map = map;
+    madvise(m_map, m_mapSize, MADV_SEQUENTIAL);
+#endif
+
+    char const* base = static_cast<char const*>(m_map);
+    SnapshotHeader header;
+    memcpy(&header, base, sizeof(header));
+
+    uint32 formatLength = uint32(strlen(srcFormat));
+    uint32 rowWidth = Layout(srcFormat, m_offsets);
+
+    // Every size is checked against the file before anything is read past the header.
+    uint64 expected = uint64(sizeof(header)) + formatLength + uint64(header.rowCount) * rowWidth + header.poolSize;
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.key != key ||
+        header.formatLength != formatLength || header.rowWidth != rowWidth || expected != m_mapSize ||
+        memcmp(base + sizeof(header), srcFormat, formatLength) != 0 ||
+        (header.poolSize && base[m_mapSize - 1] != 0))
+    {
+        Close();
+        return false;
+    }
+
+    m_rows = base + sizeof(header) + formatLength;
+    m_pool = m_rows + uint64(header.rowCount) * rowWidth;
+    m_rowWidth = rowWidth;
+    m_rowCount = header.rowCount;
+    m_maxRecordId = header.maxRecordId;
+
+    // The storage indexes its records by the key column, sized by maxRecordId.
+    if (!formatLength || ColumnKind(srcFormat[0]) != COLUMN_UINT32)
+    {
+        Close();
+        return false;
+    }
+    for (uint32 i = 0; i < m_rowCount; ++i)
+    {
+        if (GetRow(i).GetUInt32(0) >= m_maxRecordId)
+        {
+            Close();
+            return false;
+        }
+    }
+
+    // The pool ends in a terminator, so any offset inside it reads a terminated string.
+    for (uint32 y = 0; y < formatLength; ++y)
+    {
+        if (ColumnKind(srcFormat[y]) != COLUMN_STRING)
+        {
+            continue;
+        }
+        for (uint32 i = 0; i < m_rowCount; ++i)
+        {
+            uint32 at = GetRow(i).GetUInt32(y);
+            if (at != NULL_STRING && at >= header.poolSize)
+            {
+                Close();
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,209 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_SQLSTORAGE_SNAPSHOT_H
+#define MANGOS_SQLSTORAGE_SNAPSHOT_H
+
+// A BINARY COPY OF A STATIC TABLE, so a restart does not have to ask MySQL for it again.
+//
+// Every SQLStorage table -- creature_template, item_template, gameobject_template and the
+// rest -- arrives as text: the server selects every row, the client library copies it,
+// and every value is run through strtoul or atof on the way into the record. After a
+// crash that is most of the time the realm is down, and the tables have not changed.
+//
+// A snapshot holds the SOURCE rows of one table, typed: the values the loader read from
+// each Field, not the records it built from them. The loader's own conversions (script
+// names to ids, defaults for the columns the table lacks) therefore still run on every
+// load, and a snapshot never goes stale against anything but its table.
+//
+// KEY. The server's CHECKSUM TABLE of the source table, plus the storage's source
+// format. Any edit to the table changes the checksum; the snapshot then fails to open,
+// the table is loaded the slow way and the snapshot is rewritten.
+//
+// FORMAT. Native-endian, same-machine cache, in the spirit of the terrain tiles. A fixed
+// header, the source format string, the rows at a fixed width, then one pool holding
+// every string. The file is memory-mapped and read in place. Magic, version, key, format
+// and every size are checked at open, and every string offset against the pool, so a
+// damaged or foreign file is a miss, never a bad read.
+
+#include "Platform/Define.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reads and writes the binary snapshot of one SQLStorage table.
+ */
+class SQLStorageSnapshot
+{
+    public:
+
+        /**
+         * @brief Directory the snapshots live in. Empty, the default, turns them off.
+         */
+        static void SetDirectory(std::string const& dir);
+        static bool Enabled();
+
+        /// The snapshot file of @p table.
+        static std::string FileName(char const* table);
+
+        /// One source row of an open snapshot, read the way a Field row is.
+        class Row
+        {
+            public:
+                Row(char const* data, uint32 const* offsets, char const* pool)
+                    : m_data(data), m_offsets(offsets), m_pool(pool) {}
+
+                uint32 GetUInt32(uint32 column) const { uint32 v; memcpy(&v, m_data + m_offsets[column], sizeof(v)); return v; }
+                uint8 GetUInt8(uint32 column) const { return uint8(m_data[m_offsets[column]]); }
+                float GetFloat(uint32 column) const { float v; memcpy(&v, m_data + m_offsets[column], sizeof(v)); return v; }
+                char const* GetString(uint32 column) const
+                {
+                    uint32 at = GetUInt32(column);
+                    return at == NULL_STRING ? NULL : m_pool + at;
+                }
+
+            private:
+                char const* m_data;
+                uint32 const* m_offsets;
+                char const* m_pool;
+        };
+
+        /**
+         * @brief A snapshot opened for reading; the file stays mapped while this lives.
+         */
+        class Reader
+        {
+            public:
+                Reader();
+                ~Reader();
+
+                /**
+                 * @brief Map @p path and check it is a snapshot of @p srcFormat under @p key.
+                 * @return false on any mismatch, truncation or damage.
+                 */
+                bool Open(std::string const& path, char const* srcFormat, uint64 key);
+
+                uint32 MaxRecordId() const { return m_maxRecordId; }
+                uint32 RowCount() const { return m_rowCount; }
+                Row GetRow(uint32 index) const { return Row(m_rows + index * m_rowWidth, &m_offsets[0], m_pool); }
+
+            private:
+                Reader(Reader const&);
+                Reader& operator=(Reader const&);
+
+                void Close();
+
+                void* m_map;
+                size_t m_mapSize;
+#ifdef _WIN32
+                void* m_file;
+                void* m_mapping;
+#endif
+
+                std::vector<uint32> m_offsets;
+                char const* m_rows;
+                char const* m_pool;
+                uint32 m_rowWidth;
+                uint32 m_rowCount;
+                uint32 m_maxRecordId;
+        };
+
+        /**
+         * @brief Collects the rows of a table as it is loaded, then writes the snapshot.
+         */
+        class Writer
+        {
+            public:
+                Writer(char const* srcFormat, uint64 key, uint32 maxRecordId);
+
+                /// Record one source row. @p row is anything with Field's accessors.
+                template<class R>
+                void Add(R const& row)
+                {
+                    size_t base = m_rows.size();
+                    m_rows.resize(base + m_rowWidth);
+                    char* out = &m_rows[base];
+
+                    for (uint32 y = 0; y < m_format.size(); ++y)
+                    {
+                        switch (ColumnKind(m_format[y]))
+                        {
+                            case COLUMN_UINT32: { uint32 v = row.GetUInt32(y); memcpy(out + m_offsets[y], &v, sizeof(v)); break; }
+                            case COLUMN_UINT8:  { out[m_offsets[y]] = char(row.GetUInt8(y)); break; }
+                            case COLUMN_FLOAT:  { float v = row.GetFloat(y); memcpy(out + m_offsets[y], &v, sizeof(v)); break; }
+                            case COLUMN_STRING: { uint32 v = AddString(row.GetString(y)); memcpy(out + m_offsets[y], &v, sizeof(v)); break; }
+                            default:
+                                break;
+                        }
+                    }
+                    ++m_rowCount;
+                }
+
+                /**
+                 * @brief Write the snapshot to @p path.
+                 *
+                 * Goes through a temporary name and a rename, so a crash mid-write leaves
+                 * the old snapshot or none, never half of one.
+                 */
+                bool Commit(std::string const& path) const;
+
+            private:
+                uint32 AddString(char const* str);
+
+                std::string m_format;
+                std::vector<uint32> m_offsets;
+                uint32 m_rowWidth;
+                uint32 m_rowCount;
+                uint32 m_maxRecordId;
+                uint64 m_key;
+                std::vector<char> m_rows;
+                std::vector<char> m_pool;
+        };
+
+    private:
+
+        /// How a source column is kept in a row, by its format character.
+        enum ColumnKindType
+        {
+            COLUMN_SKIPPED,     ///< Not read by the loader, not stored
+            COLUMN_UINT32,      ///< Integers and logic, as GetUInt32() returned them
+            COLUMN_UINT8,
+            COLUMN_FLOAT,
+            COLUMN_STRING       ///< Offset into the string pool, or NULL_STRING
+        };
+
+        static const uint32 NULL_STRING = 0xFFFFFFFF;
+
+        static ColumnKindType ColumnKind(char format);
+
+        /// Each column's offset inside a row; returns the row width.
+        static uint32 Layout(char const* srcFormat, std::vector<uint32>& offsets);
+
+        static std::string s_directory;
+};
+
+#endif
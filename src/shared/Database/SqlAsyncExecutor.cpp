@@ -0,0 +1,209 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file SqlAsyncExecutor.cpp
+ * @brief Key-sharded async SQL execution over several delay threads
+ */
+
+#include "Database/SqlAsyncExecutor.h"
+#include "Database/SqlOperations.h"
+#include "DatabaseEnv.h"
+
+#include <condition_variable>
+
+/**
+ * @brief One run of unkeyed work, and the rendezvous of every shard before it
+ *
+ * Each shard gets a token in its queue. The last shard to reach its token runs the
+ * operations on its own connection while the others wait; then all of them go on.
+ * Tokens go into every queue in the same order under the executor lock, so the shards
+ * always meet at the same barrier.
+ */
+struct SqlAsyncExecutor::Barrier
+{
+    explicit Barrier(uint32 shards) : pending(shards), started(false), done(false) {}
+
+    ~Barrier()
+    {
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            delete ops[i];
+        }
+    }
+
+    std::mutex lock;
+    std::condition_variable cv;
+    uint32 pending;                                         ///< shards yet to arrive
+    bool started;                                           ///< the first shard has arrived; no more ops
+    bool done;
+    std::vector<SqlOperation*> ops;
+};
+
+/**
+ * @brief A shard's place in a barrier
+ */
+class SqlAsyncExecutor::BarrierToken : public SqlOperation
+{
+    public:
+        explicit BarrierToken(std::shared_ptr<Barrier> const& barrier) : m_barrier(barrier) {}
+
+        // Runs with this shard's connection locked; the operations run on it directly.
+        bool ExecuteLocked(SqlConnection* conn) override
+        {
+            std::unique_lock<std::mutex> guard(m_barrier->lock);
+            m_barrier->started = true;
+            if (--m_barrier->pending)
+            {
+                m_barrier->cv.wait(guard, [this]() { return m_barrier->done; });
+                return true;
+            }
+
+            guard.unlock();
+            for (size_t i = 0; i < m_barrier->ops.size(); ++i)
+            {
+                m_barrier->ops[i]->ExecuteLocked(conn);
+            }
+            guard.lock();
+
+            m_barrier->done = true;
+            m_barrier->cv.notify_all();
+            return true;
+        }
+
+    private:
+        std::shared_ptr<Barrier> m_barrier;
+};
+
+SqlAsyncExecutor::SqlAsyncExecutor() : m_running(true), m_stoppedConn(NULL)
+{
+}
+
+SqlAsyncExecutor::~SqlAsyncExecutor()
+{
+    Stop();
+}
+
+void SqlAsyncExecutor::AddShard(SqlDelayThread* body)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_bodies.empty())
+    {
+        m_stoppedConn = body->GetConnection();
+    }
+    m_bodies.push_back(body);
+    m_threads.push_back(new MaNGOS::Thread(body));
+}
+
+bool SqlAsyncExecutor::Delay(SqlOperation* op, uint64 key)
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+
+    if (!m_running)
+    {
+        // Nobody drains the queues any more. Late work (a save during shutdown) runs
+        // here instead of waiting for a thread that has gone.
+        guard.unlock();
+        op->Execute(m_stoppedConn);
+        delete op;
+        return true;
+    }
+
+    MANGOS_ASSERT(!m_bodies.empty());
+    if (m_bodies.size() == 1)
+    {
+        return m_bodies[0]->Delay(op);
+    }
+
+    if (key)
+    {
+        m_openBarrier.reset();
+        return m_bodies[key % m_bodies.size()]->Delay(op);
+    }
+
+    // Join the barrier queued last, as long as nothing was queued after it and no shard
+    // has reached it yet.
+    if (m_openBarrier)
+    {
+        std::lock_guard<std::mutex> barrierGuard(m_openBarrier->lock);
+        if (!m_openBarrier->started)
+        {
+            m_openBarrier->ops.push_back(op);
+            return true;
+        }
+    }
+
+    m_openBarrier.reset(new Barrier(uint32(m_bodies.size())));
+    m_openBarrier->ops.push_back(op);
+    for (size_t i = 0; i < m_bodies.size(); ++i)
+    {
+        m_bodies[i]->Delay(new BarrierToken(m_openBarrier));
+    }
+    return true;
+}
+
+void SqlAsyncExecutor::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!m_running)
+        {
+            return;
+        }
+        m_running = false;
+        m_openBarrier.reset();
+    }
+
+    // Stop them all before waiting on any: each drains its own queue on its way out,
+    // and a barrier in those queues needs every shard to get there.
+    for (size_t i = 0; i < m_bodies.size(); ++i)
+    {
+        m_bodies[i]->Stop();
+    }
+    for (size_t i = 0; i < m_threads.size(); ++i)
+    {
+        m_threads[i]->wait();
+        delete m_threads[i];                                // also deletes m_bodies[i]
+    }
+
+    m_threads.clear();
+    m_bodies.clear();
+}
+
+bool SqlAsyncExecutor::IsRunning() const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_running;
+}
+
+void SqlAsyncExecutor::GetStats(std::vector<SqlDelayThread::Stats>& stats, bool resetPeaks) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    stats.clear();
+    for (size_t i = 0; i < m_bodies.size(); ++i)
+    {
+        stats.push_back(m_bodies[i]->GetStats(resetPeaks));
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_SQLASYNCEXECUTOR
+#define MANGOS_H_SQLASYNCEXECUTOR
+
+#include "Platform/Define.h"
+#include "Database/SqlDelayThread.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class SqlConnection;
+class SqlOperation;
+
+/**
+ * @file SqlAsyncExecutor.h
+ * @brief The async side of a Database: one or more delay threads, each with its own connection.
+ *
+ * With a single shard this is the old single delay thread: every async write, query and
+ * transaction runs in the order it was queued.
+ *
+ * With several, work carries a key. Keyed work runs on shard `key % N`, in order with
+ * everything else of the same key, and in parallel with every other shard. Work with key 0
+ * -- everything that did not ask for a key -- stays in total order with ALL other work: it
+ * is a barrier that waits for every shard to finish what was queued before it, runs alone,
+ * and holds back whatever was queued after it. So code that never names a key sees exactly
+ * the ordering it always had, and only work that declares it touches nothing but its own
+ * entity's rows (a character save keyed by its guid) overlaps. Consecutive unkeyed
+ * operations share one barrier.
+ */
+class SqlAsyncExecutor
+{
+    public:
+        SqlAsyncExecutor();
+        /**
+         * @brief Stops the shards, if Stop() was not called
+         */
+        ~SqlAsyncExecutor();
+
+        /**
+         * @brief Add a shard and start its thread
+         *
+         * @param body the shard's thread body; owned by the executor from here on
+         */
+        void AddShard(SqlDelayThread* body);
+
+        /**
+         * @brief Queue @p op, ordered by @p key as described above
+         *
+         * Once stopped, the operation runs at once on the first shard's connection,
+         * which must then still exist.
+         *
+         * @param op operation to run; deleted once run
+         * @param key 0 for total order, otherwise the entity the work belongs to
+         * @return bool
+         */
+        bool Delay(SqlOperation* op, uint64 key);
+
+        /**
+         * @brief Stop taking work, let every shard drain its queue, and join the threads
+         */
+        void Stop();
+
+        /**
+         * @brief Whether queued work will still be run by the shard threads
+         *
+         * @return bool
+         */
+        bool IsRunning() const;
+
+        /**
+         * @brief Number of shards
+         *
+         * @return uint32
+         */
+        uint32 GetShardCount() const { return uint32(m_bodies.size()); }
+
+        /**
+         * @brief Per-shard queue counters, shard 0 first
+         *
+         * @param stats filled with one entry per shard
+         * @param resetPeaks start a new window for the peak values
+         */
+        void GetStats(std::vector<SqlDelayThread::Stats>& stats, bool resetPeaks) const;
+
+    private:
+        struct Barrier;
+        class BarrierToken;
+
+        SqlAsyncExecutor(SqlAsyncExecutor const&);
+        SqlAsyncExecutor& operator=(SqlAsyncExecutor const&);
+
+        std::vector<SqlDelayThread*> m_bodies;              /**< shard thread bodies, owned by m_threads */
+        std::vector<MaNGOS::Thread*> m_threads;             /**< shard threads */
+        mutable std::mutex m_lock;                          /**< orders Delay() against Delay() and Stop() */
+        bool m_running;                                     /**< taking work */
+        std::shared_ptr<Barrier> m_openBarrier;             /**< last thing queued, if it was a barrier nobody reached yet */
+        SqlConnection* m_stoppedConn;                       /**< first shard's connection, for work arriving after Stop() */
+};
+
+#endif
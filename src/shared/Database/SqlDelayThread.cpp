@@ -48,7 +48,9 @@
  * for executing queued operations. The thread starts in running state
  * but doesn't begin execution until run() is called.
  */
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingsDatabase) :
+    m_dbEngine(db), m_dbConnection(conn), m_pingsDatabase(pingsDatabase), m_running(true),
+    m_queued(0), m_executed(0), m_waitMs(0), m_waitMaxMs(0), m_execMs(0), m_execMaxMs(0)
 {
 }
 
@@ -114,9 +116,55 @@ void SqlDelayThread::run()
         if ((loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
-            m_dbEngine->Ping();
+            if (m_pingsDatabase)
+            {
+                m_dbEngine->Ping();
+            }
+            else
+            {
+                SqlConnection::Lock guard(m_dbConnection);
+                delete guard->Query("SELECT 1");
+            }
         }
     }
+
+    // Drain what was queued before the stop here, on this thread, and not in the
+    // destructor: with several shards an ordering barrier waits for every shard to
+    // reach it, and the destructors run one after another.
+    ProcessRequests();
+}
+
+/**
+ * @brief Queue an operation for this thread
+ * @param sql The operation; this thread deletes it once run
+ * @return true
+ */
+bool SqlDelayThread::Delay(SqlOperation* sql)
+{
+    QueuedOperation queued;
+    queued.op = sql;
+    queued.queuedAt = getMSTime();
+
+    ++m_queued;
+    m_sqlQueue.add(queued);
+    return true;
+}
+
+/**
+ * @brief Snapshot of the queue's counters
+ * @param resetPeaks Start a new window for the two peak values
+ * @return The counters as they stand
+ */
+SqlDelayThread::Stats SqlDelayThread::GetStats(bool resetPeaks)
+{
+    Stats stats;
+    stats.queued = m_queued;
+    stats.executed = m_executed;
+    stats.waitMs = m_waitMs;
+    stats.execMs = m_execMs;
+    stats.waitMaxMs = resetPeaks ? m_waitMaxMs.exchange(0) : m_waitMaxMs.load();
+    stats.execMaxMs = resetPeaks ? m_execMaxMs.exchange(0) : m_execMaxMs.load();
+    return stats;
 }
 
 /**
@@ -150,10 +198,29 @@ void SqlDelayThread::Stop()
  */
 void SqlDelayThread::ProcessRequests()
 {
-    SqlOperation* s = NULL;
+    QueuedOperation s;
     while (m_sqlQueue.next(s))
     {
-        s->Execute(m_dbConnection);
-        delete s;
+        const uint32 start = getMSTime();
+        s.op->Execute(m_dbConnection);
+        delete s.op;
+        const uint32 end = getMSTime();
+
+        const uint32 waited = getMSTimeDiff(s.queuedAt, start);
+        const uint32 took = getMSTimeDiff(start, end);
+
+        --m_queued;
+        ++m_executed;
+        m_waitMs += waited;
+        m_execMs += took;
+        // only this thread raises the peaks; a reset racing in just loses one sample
+        if (waited > m_waitMaxMs)
+        {
+            m_waitMaxMs = waited;
+        }
+        if (took > m_execMaxMs)
+        {
+            m_execMaxMs = took;
+        }
     }
 }
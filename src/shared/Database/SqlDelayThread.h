@@ -26,31 +26,69 @@
 #ifndef MANGOS_H_SQLDELAYTHREAD
 #define MANGOS_H_SQLDELAYTHREAD
 
+#include "Platform/Define.h"
 #include "LockedQueue/LockedQueue.h"
 #include "Threading/Threading.h"
 
+#include <atomic>
+
 class Database;
 class SqlOperation;
 class SqlConnection;
 
 /**
- * @brief
+ * @brief Worker thread draining one queue of async SQL onto one connection
  *
+ * A Database runs one of these per async connection; SqlAsyncExecutor decides which
+ * queue an operation goes to.
  */
 class SqlDelayThread : public MaNGOS::Runnable
 {
+    public:
         /**
-         * @brief
+         * @brief What the queue has been doing, for the shard report
          *
+         * Times are milliseconds. The peaks cover the time since they were last reset.
          */
-        typedef MaNGOS::LockedQueue<SqlOperation*> SqlQueue;
+        struct Stats
+        {
+            uint32 queued;                                  /**< operations waiting now */
+            uint64 executed;                                /**< operations run since start */
+            uint64 waitMs;                                  /**< total time spent queued */
+            uint32 waitMaxMs;                               /**< longest time one waited */
+            uint64 execMs;                                  /**< total time spent executing */
+            uint32 execMaxMs;                               /**< longest time one took */
+        };
 
     private:
+        /**
+         * @brief An operation and when it was queued
+         */
+        struct QueuedOperation
+        {
+            SqlOperation* op;
+            uint32 queuedAt;
+        };
+
+        /**
+         * @brief
+         *
+         */
+        typedef MaNGOS::LockedQueue<QueuedOperation> SqlQueue;
+
         SqlQueue m_sqlQueue;                                /**< Queue of SQL statements */
         Database* m_dbEngine;                               /**< Pointer to used Database engine */
         SqlConnection* m_dbConnection;                      /**< Pointer to DB connection */
+        bool m_pingsDatabase;                               /**< Ping every connection of the database, not only ours */
         volatile bool m_running; /**< TODO */
 
+        std::atomic<uint32> m_queued;                       /**< Stats::queued */
+        std::atomic<uint64> m_executed;                     /**< Stats::executed */
+        std::atomic<uint64> m_waitMs;                       /**< Stats::waitMs */
+        std::atomic<uint32> m_waitMaxMs;                    /**< Stats::waitMaxMs */
+        std::atomic<uint64> m_execMs;                       /**< Stats::execMs */
+        std::atomic<uint32> m_execMaxMs;                    /**< Stats::execMaxMs */
+
     public:
 
         /// True while the loop is running. CommitTransactionChecked() asks before it
@@ -72,8 +110,10 @@ class SqlDelayThread : public MaNGOS::Runnable
          *
          * @param db
          * @param conn
+         * @param pingsDatabase true for the one thread that keeps the whole database's
+         *        connections alive; the others only ping their own
          */
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingsDatabase = true);
         /**
          * @brief
          *
@@ -86,7 +126,22 @@ class SqlDelayThread : public MaNGOS::Runnable
          * @param sql
          * @return bool
          */
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        bool Delay(SqlOperation* sql);
+
+        /**
+         * @brief The connection this thread executes on
+         *
+         * @return SqlConnection
+         */
+        SqlConnection* GetConnection() const { return m_dbConnection; }
+
+        /**
+         * @brief Snapshot of the queue's counters
+         *
+         * @param resetPeaks start the next peak window
+         * @return Stats
+         */
+        Stats GetStats(bool resetPeaks);
 
         /**
          * @brief Stop event
@@ -109,12 +109,22 @@ bool SqlTransaction::ExecuteLocked(SqlConnection* conn)
         return false;
     }
 
-    const int nItems = m_queue.size();
-    for (int i = 0; i < nItems; ++i)
+    const size_t nItems = m_queue.size();
+    for (size_t i = 0; i < nItems;)
     {
-        SqlOperation* pStmt = m_queue[i];
+        // A run of one prepared statement -- a save's INSERT per spell -- goes out batched.
+        size_t end = i + 1;
+        if (SqlPreparedRequest* first = m_queue[i]->AsPreparedRequest())
+        {
+            SqlPreparedRequest* next;
+            while (end < nItems && (next = m_queue[end]->AsPreparedRequest()) && next->GetIndex() == first->GetIndex())
+            {
+                ++end;
+            }
+        }
 
-        if (!pStmt->ExecuteLocked(conn))
+        bool ok = end - i > 1 ? ExecuteRun(conn, i, end) : m_queue[i]->ExecuteLocked(conn);
+        if (!ok)
         {
             if (!conn->RollbackTransaction())
             {
@@ -122,11 +132,73 @@ bool SqlTransaction::ExecuteLocked(SqlConnection* conn)
             }
             return false;
         }
+        i = end;
     }
 
     return conn->CommitTransaction();
 }
 
+bool SqlTransaction::ExecuteRun(SqlConnection* conn, size_t begin, size_t end)
+{
+    SqlStatementBatch::Shape const& shape = conn->GetBatchShape(m_queue[begin]->AsPreparedRequest()->GetIndex());
+    if (!shape.IsBatchable())
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!m_queue[i]->ExecuteLocked(conn))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // the connection's own escaping: its lock is held for the whole transaction
+    SqlStatementBatch batch(shape, [conn](std::string& str)
+    {
+        std::vector<char> buf(str.size() * 2 + 1);
+        conn->escape_string(&buf[0], str.c_str(), str.size());
+        str = &buf[0];
+    });
+
+    // A batch of one row is sent as the prepared statement it was.
+    size_t first = begin;
+    auto flush = [&]() -> bool
+    {
+        bool ok = batch.GetRows() < 2 ? (batch.GetRows() == 0 || m_queue[first]->ExecuteLocked(conn))
+                                      : conn->Execute(batch.GetSql().c_str());
+        batch.Clear();
+        return ok;
+    };
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        SqlStmtParameters const& params = m_queue[i]->AsPreparedRequest()->GetParams();
+        if (batch.Add(params))
+        {
+            continue;
+        }
+
+        // over budget: send what there is and start again from this row
+        if (!flush())
+        {
+            return false;
+        }
+        first = i;
+        if (!batch.Add(params))
+        {
+            // a value with no literal form: this row goes as it is
+            if (!m_queue[i]->ExecuteLocked(conn))
+            {
+                return false;
+            }
+            first = i + 1;
+        }
+    }
+
+    return flush();
+}
+
 /**
  * @brief Constructor for SqlPreparedRequest
  * @param nIndex Index of the prepared statement
@@ -213,28 +285,26 @@ void SqlResultQueue::Update()
 }
 
 /**
- * @brief Execute all queries in the holder asynchronously
+ * @brief Package all queries in the holder for asynchronous execution
  * @param callback Callback to invoke when all queries complete
- * @param thread The delay thread to execute queries on
  * @param queue The result queue for callback synchronization
- * @return true if execution was scheduled, false if parameters invalid
+ * @return The operation for the caller to queue, or NULL if parameters invalid
  *
- * Schedules all queries for execution on the delay thread. When complete,
- * the callback will be invoked via the result queue on the original thread.
+ * Once the returned operation has run on a delay thread, the callback will be
+ * invoked via the result queue on the original thread. The caller picks the
+ * delay thread, so the holder goes wherever the rest of its key's work goes.
  * This batches multiple queries efficiently in a single operation.
  */
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+SqlOperation* SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
 {
-    if (!callback || !thread || !queue)
+    if (!callback || !queue)
     {
-        return false;
+        return NULL;
     }
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
-    thread->Delay(holderEx);
-    return true;
+    return new SqlQueryHolderEx(this, callback, queue);
 }
 
 /**
@@ -257,10 +327,10 @@ bool SqlQueryHolder::SetQuery(size_t index, const char* sql)
         return false;
     }
 
-    if (m_queries[index].first != NULL)
+    if (m_queries[index].first != NULL || m_prepared[index].params != NULL)
     {
         sLog.outError("Attempt assign query to holder index (%zu) where other query stored (Old: [%s] New: [%s])",
-                      index, m_queries[index].first, sql);
+                      index, m_queries[index].first ? m_queries[index].first : "prepared statement", sql);
         return false;
     }
 
@@ -304,6 +374,45 @@ bool SqlQueryHolder::SetPQuery(size_t index, const char* format, ...)
     return SetQuery(index, szQuery);
 }
 
+/**
+ * @brief Store a prepared SELECT at a specific index
+ * @param index The slot to store the query in
+ * @param stmt The statement, with every parameter bound
+ * @return true if stored successfully, false if slot invalid or occupied or a parameter is missing
+ *
+ * The holder takes the bound parameters over from the statement; the statement is
+ * prepared on the connection that runs the holder, the first time it does.
+ */
+bool SqlQueryHolder::SetQuery(size_t index, SqlStatement& stmt)
+{
+    SqlStmtParameters* args = stmt.detach();
+    if (args->boundParams() != stmt.arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i) for holder index (%zu)",
+                      args->boundParams(), stmt.arguments(), index);
+        delete args;
+        return false;
+    }
+
+    if (m_queries.size() <= index)
+    {
+        sLog.outError("Query index (%zu) out of range (size: %zu) for a prepared statement", index, m_queries.size());
+        delete args;
+        return false;
+    }
+
+    if (m_queries[index].first != NULL || m_prepared[index].params != NULL)
+    {
+        sLog.outError("Attempt assign prepared statement to holder index (%zu) where other query stored", index);
+        delete args;
+        return false;
+    }
+
+    m_prepared[index].index = stmt.ID();
+    m_prepared[index].params = args;
+    return true;
+}
+
 /**
  * @brief Get the query result at a specific index
  * @param index The slot to retrieve the result from
@@ -326,6 +435,11 @@ QueryResult* SqlQueryHolder::GetResult(size_t index)
             delete[](const_cast<char*>(m_queries[index].first));
             m_queries[index].first = NULL;
         }
+        if (m_prepared[index].params != NULL)
+        {
+            delete m_prepared[index].params;
+            m_prepared[index].params = NULL;
+        }
         /// when you get a result aways remember to delete it!
         return m_queries[index].second;
     }
@@ -374,6 +488,11 @@ SqlQueryHolder::~SqlQueryHolder()
             delete[](const_cast<char*>(m_queries[i].first));
             delete m_queries[i].second;
         }
+        else if (m_prepared[i].params != NULL)
+        {
+            delete m_prepared[i].params;
+            delete m_queries[i].second;
+        }
     }
 }
 
@@ -391,6 +510,7 @@ void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_prepared.resize(size);
 }
 
 /**
@@ -421,6 +541,10 @@ bool SqlQueryHolderEx::ExecuteLocked(SqlConnection* conn)
         {
             m_holder->SetResult(i, conn->Query(sql));
         }
+        else if (m_holder->m_prepared[i].params)
+        {
+            m_holder->SetResult(i, conn->QueryStmt(m_holder->m_prepared[i].index, *m_holder->m_prepared[i].params));
+        }
     }
 
     /// sync with the caller thread
@@ -42,6 +42,8 @@ class Database;
 class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
+class SqlPreparedRequest;
+class SqlStatement;
 
 /**
  * @brief
@@ -79,6 +81,14 @@ class SqlOperation
          * moment it stopped being.
          */
         virtual bool ExecuteLocked(SqlConnection* conn) = 0;
+
+        /**
+         * @brief This operation as a prepared statement, or NULL if it is anything else
+         *
+         * How SqlTransaction finds runs of one statement to batch, without a dynamic_cast.
+         */
+        virtual SqlPreparedRequest* AsPreparedRequest() { return NULL; }
+
         /**
          * @brief
          *
@@ -145,6 +155,13 @@ class SqlTransaction : public SqlOperation
          */
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
 
+        /**
+         * @brief Number of statements queued so far
+         *
+         * @return size_t
+         */
+        size_t GetSize() const { return m_queue.size(); }
+
         /**
          * @brief
          *
@@ -152,6 +169,13 @@ class SqlTransaction : public SqlOperation
          * @return bool
          */
         bool ExecuteLocked(SqlConnection* conn) override;
+
+    private:
+        /**
+         * @brief Run queue entries [begin, end), all the same prepared statement, as few
+         *        multi-row statements as the statement's shape and the byte budget allow
+         */
+        bool ExecuteRun(SqlConnection* conn, size_t begin, size_t end);
 };
 
 /**
@@ -182,6 +206,11 @@ class SqlPreparedRequest : public SqlOperation
          */
         bool ExecuteLocked(SqlConnection* conn) override;
 
+        SqlPreparedRequest* AsPreparedRequest() override { return this; }
+
+        int GetIndex() const { return m_nIndex; }
+        SqlStmtParameters const& GetParams() const { return *m_param; }
+
     private:
         const int m_nIndex; /**< TODO */
         SqlStmtParameters* m_param; /**< TODO */
@@ -282,6 +311,15 @@ class SqlQueryHolder
          */
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries; /**< TODO */
+
+        /// A slot filled by a prepared statement: its id and bound parameters, owned until GetResult().
+        struct PreparedQuery
+        {
+            PreparedQuery() : index(-1), params(NULL) {}
+            int index;
+            SqlStmtParameters* params;
+        };
+        std::vector<PreparedQuery> m_prepared;
     public:
         /**
          * @brief
@@ -309,6 +347,17 @@ class SqlQueryHolder
          * @return bool
          */
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
+        /**
+         * @brief Store a prepared SELECT, its parameters already bound.
+         *
+         * It runs with the holder's other queries, and its rows come back typed where
+         * the connection supports it (see SqlStatement::Query()).
+         *
+         * @param index
+         * @param stmt The statement; its parameters are taken from it.
+         * @return bool
+         */
+        bool SetQuery(size_t index, SqlStatement& stmt);
         /**
          * @brief
          *
@@ -333,11 +382,10 @@ class SqlQueryHolder
          * @brief
          *
          * @param callback
-         * @param thread
          * @param queue
-         * @return bool
+         * @return the operation to queue on a delay thread, or NULL if an argument is missing
          */
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        SqlOperation* Execute(MaNGOS::IQueryCallback* callback, SqlResultQueue* queue);
 };
 
 /**
@@ -122,6 +122,26 @@ bool SqlStatement::DirectExecute()
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+/**
+ * @brief Run the statement as a SELECT and return its rows.
+ * @return The result, or NULL on error or no rows.
+ */
+QueryResult* SqlStatement::Query()
+{
+    SqlStmtParameters* args = detach();
+    // verify amount of bound parameters
+    if (args->boundParams() != arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
+        sLog.outError("SQL ERROR: statement: %s", m_pDB->GetStmtString(ID()).c_str());
+        MANGOS_ASSERT(false);
+        delete args;
+        return NULL;
+    }
+
+    return m_pDB->QueryStmt(m_index, args);
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 /**
@@ -195,6 +215,20 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
+/**
+ * @brief Run the bound request as a text query.
+ * @return The result, or NULL on error or no rows.
+ */
+QueryResult* SqlPlainPreparedStatement::query()
+{
+    if (m_szPlainRequest.empty())
+    {
+        return NULL;
+    }
+
+    return m_pConn.Query(m_szPlainRequest.c_str());
+}
+
 /**
  * @brief Convert data to string format.
  * @param data The data to convert.
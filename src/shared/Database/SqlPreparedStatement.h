@@ -375,6 +375,16 @@ class SqlStatement
          * @return True if the execution was successful, false otherwise.
          */
         bool DirectExecute();
+        /**
+         * @brief Run the statement as a SELECT, now, and return its rows.
+         *
+         * Where the connection supports it the rows come back through the binary
+         * protocol, already typed: Field's numeric getters then read them without
+         * parsing. Otherwise this is an ordinary text query.
+         *
+         * @return The result positioned on its first row, or NULL on error or no rows.
+         */
+        QueryResult* Query();
 
         // templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
@@ -437,6 +447,66 @@ class SqlStatement
             return Execute();
         }
 
+        template<typename ParamType1>
+        /**
+         * @brief Query with one parameter.
+         * @param param1 The parameter to query with.
+         * @return The result, or NULL on error or no rows.
+         */
+        QueryResult* PQuery(ParamType1 param1)
+        {
+            arg(param1);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        /**
+         * @brief Query with two parameters.
+         * @param param1 The first parameter to query with.
+         * @param param2 The second parameter to query with.
+         * @return The result, or NULL on error or no rows.
+         */
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2)
+        {
+            arg(param1);
+            arg(param2);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3>
+        /**
+         * @brief Query with three parameters.
+         * @param param1 The first parameter to query with.
+         * @param param2 The second parameter to query with.
+         * @param param3 The third parameter to query with.
+         * @return The result, or NULL on error or no rows.
+         */
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3, typename ParamType4>
+        /**
+         * @brief Query with four parameters.
+         * @param param1 The first parameter to query with.
+         * @param param2 The second parameter to query with.
+         * @param param3 The third parameter to query with.
+         * @param param4 The fourth parameter to query with.
+         * @return The result, or NULL on error or no rows.
+         */
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3, ParamType4 param4)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            arg(param4);
+            return Query();
+        }
+
         // bind parameters with specified type
         /**
          * @brief Add a boolean parameter.
@@ -512,6 +582,7 @@ class SqlStatement
     protected:
         // don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        friend class SqlQueryHolder;                        // takes the bound parameters over
         /**
          * @brief Constructor to create a SqlStatement object.
          * @param index The statement ID.
@@ -613,6 +684,11 @@ class SqlPreparedStatement
          * @return True if the execution was successful, false otherwise.
          */
         virtual bool execute() = 0;
+        /**
+         * @brief Execute the statement and fetch its whole result set.
+         * @return The result positioned on its first row, or NULL on error or no rows.
+         */
+        virtual QueryResult* query() = 0;
 
     protected:
         /**
@@ -667,6 +743,11 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
          * @return True if the execution was successful, false otherwise.
          */
         bool execute() override;
+        /**
+         * @brief Run the bound request as a text query.
+         * @return The result, or NULL on error or no rows.
+         */
+        QueryResult* query() override;
 
     protected:
         /**
@@ -0,0 +1,392 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file SqlStatementBatch.cpp
+ * @brief Multi-row INSERT and DELETE built from a run of one prepared statement.
+ */
+
+#include "SqlStatementBatch.h"
+#include "SqlPreparedStatement.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    bool IsWordChar(char c)
+    {
+        return isalnum((unsigned char)c) || c == '_';
+    }
+
+    /// Whether @p word, any case, stands alone at @p pos of @p s
+    bool WordAt(std::string const& s, size_t pos, const char* word)
+    {
+        size_t len = strlen(word);
+        if (pos + len > s.size() || (pos > 0 && IsWordChar(s[pos - 1])))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < len; ++i)
+        {
+            if (toupper((unsigned char)s[pos + i]) != word[i])
+            {
+                return false;
+            }
+        }
+        return pos + len == s.size() || !IsWordChar(s[pos + len]);
+    }
+
+    /// First @p word at or after @p from that is not inside backquotes, or npos
+    size_t FindWord(std::string const& s, const char* word, size_t from = 0)
+    {
+        bool quoted = false;
+        for (size_t i = from; i < s.size(); ++i)
+        {
+            if (s[i] == '`')
+            {
+                quoted = !quoted;
+            }
+            else if (!quoted && WordAt(s, i, word))
+            {
+                return i;
+            }
+        }
+        return std::string::npos;
+    }
+
+    size_t SkipSpace(std::string const& s, size_t pos)
+    {
+        while (pos < s.size() && isspace((unsigned char)s[pos]))
+        {
+            ++pos;
+        }
+        return pos;
+    }
+
+    /// `col` or col, then = ?, and nothing else; the column is returned in @p column
+    bool ParseEqualsTerm(std::string const& term, std::string& column)
+    {
+        size_t pos = SkipSpace(term, 0);
+        size_t start = pos;
+        if (pos < term.size() && term[pos] == '`')
+        {
+            pos = term.find('`', pos + 1);
+            if (pos == std::string::npos)
+            {
+                return false;
+            }
+            ++pos;
+        }
+        else
+        {
+            while (pos < term.size() && (IsWordChar(term[pos]) || term[pos] == '.'))
+            {
+                ++pos;
+            }
+        }
+        if (pos == start)
+        {
+            return false;
+        }
+        column = term.substr(start, pos - start);
+
+        pos = SkipSpace(term, pos);
+        if (pos >= term.size() || term[pos] != '=')
+        {
+            return false;
+        }
+        pos = SkipSpace(term, pos + 1);
+        if (pos >= term.size() || term[pos] != '?')
+        {
+            return false;
+        }
+        return SkipSpace(term, pos + 1) == term.size();
+    }
+}
+
+// -----------------------------------  Shape  ------------------------------------------------- //
+
+SqlStatementBatch::Shape::Shape(std::string const& fmt) : m_kind(SHAPE_NONE), m_params(0)
+{
+    // String constants could hide a '?' or a keyword; such statements are not batched.
+    if (fmt.find_first_of("'\"") != std::string::npos)
+    {
+        return;
+    }
+
+    size_t start = SkipSpace(fmt, 0);
+    if (WordAt(fmt, start, "INSERT") || WordAt(fmt, start, "REPLACE"))
+    {
+        if (ParseInsert(fmt))
+        {
+            m_kind = SHAPE_INSERT;
+        }
+    }
+    else if (WordAt(fmt, start, "DELETE"))
+    {
+        if (ParseDelete(fmt))
+        {
+            m_kind = SHAPE_DELETE;
+        }
+    }
+}
+
+bool SqlStatementBatch::Shape::ParseInsert(std::string const& fmt)
+{
+    size_t values = FindWord(fmt, "VALUES");
+    if (values == std::string::npos)
+    {
+        return false;                                       // INSERT ... SELECT
+    }
+
+    size_t open = SkipSpace(fmt, values + strlen("VALUES"));
+    if (open >= fmt.size() || fmt[open] != '(')
+    {
+        return false;
+    }
+    size_t close = fmt.find_first_of("()", open + 1);
+    if (close == std::string::npos || fmt[close] != ')')
+    {
+        return false;                                       // a function call among the values
+    }
+
+    // Nothing may follow the row: no second row, no ON DUPLICATE KEY UPDATE.
+    size_t tail = SkipSpace(fmt, close + 1);
+    if (tail < fmt.size() && (fmt[tail] != ';' || SkipSpace(fmt, tail + 1) != fmt.size()))
+    {
+        return false;
+    }
+
+    m_tuple = fmt.substr(open, close - open + 1);
+    m_params = uint32(std::count(m_tuple.begin(), m_tuple.end(), '?'));
+    if (!m_params || m_params != uint32(std::count(fmt.begin(), fmt.end(), '?')))
+    {
+        return false;
+    }
+
+    m_head = fmt.substr(0, open);
+    return true;
+}
+
+bool SqlStatementBatch::Shape::ParseDelete(std::string const& fmt)
+{
+    if (fmt.find_first_of("();") != std::string::npos)
+    {
+        return false;
+    }
+
+    size_t where = FindWord(fmt, "WHERE");
+    if (where == std::string::npos)
+    {
+        return false;
+    }
+
+    // col = ? [AND col = ?]..., and nothing else: no OR, no LIMIT, no ORDER BY.
+    std::vector<std::string> columns;
+    size_t from = where + strlen("WHERE");
+    while (true)
+    {
+        size_t next = FindWord(fmt, "AND", from);
+        std::string column;
+        if (!ParseEqualsTerm(fmt.substr(from, next == std::string::npos ? std::string::npos : next - from), column))
+        {
+            return false;
+        }
+        columns.push_back(column);
+        if (next == std::string::npos)
+        {
+            break;
+        }
+        from = next + strlen("AND");
+    }
+
+    m_params = uint32(columns.size());
+    if (m_params != uint32(std::count(fmt.begin(), fmt.end(), '?')))
+    {
+        return false;
+    }
+
+    m_head = fmt.substr(0, where + strlen("WHERE")) + " ";
+    if (columns.size() == 1)
+    {
+        m_head += columns[0];
+    }
+    else
+    {
+        m_head += "(";
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            m_head += (i ? "," : "") + columns[i];
+        }
+        m_head += ")";
+    }
+    m_head += " IN (";
+    return true;
+}
+
+// -----------------------------------  Batch  ------------------------------------------------- //
+
+SqlStatementBatch::SqlStatementBatch(Shape const& shape, Escaper const& escape, size_t budget)
+    : m_shape(shape), m_escape(escape), m_budget(budget), m_rows(0), m_closed(false)
+{
+    MANGOS_ASSERT(shape.IsBatchable());
+    m_sql = m_shape.m_head;
+}
+
+bool SqlStatementBatch::Add(SqlStmtParameters const& params)
+{
+    m_row.clear();
+    if (!RenderRow(params))
+    {
+        return false;
+    }
+
+    if (m_closed)
+    {
+        m_sql.erase(m_sql.size() - 1);
+        m_closed = false;
+    }
+
+    // The first row always goes in: alone, it is no larger than the statement it replaces.
+    size_t closing = m_shape.m_kind == Shape::SHAPE_DELETE ? 1 : 0;
+    if (m_rows && m_sql.size() + 1 + m_row.size() + closing > m_budget)
+    {
+        return false;
+    }
+
+    if (m_rows)
+    {
+        m_sql += ',';
+    }
+    m_sql += m_row;
+    ++m_rows;
+    return true;
+}
+
+std::string const& SqlStatementBatch::GetSql()
+{
+    if (!m_closed && m_shape.m_kind == Shape::SHAPE_DELETE)
+    {
+        m_sql += ')';
+        m_closed = true;
+    }
+    return m_sql;
+}
+
+void SqlStatementBatch::Clear()
+{
+    m_sql = m_shape.m_head;
+    m_rows = 0;
+    m_closed = false;
+}
+
+bool SqlStatementBatch::RenderRow(SqlStmtParameters const& params)
+{
+    SqlStmtParameters::ParameterContainer const& values = params.params();
+    if (values.size() != m_shape.m_params)
+    {
+        return false;
+    }
+
+    std::string literal;
+    size_t next = 0;
+    size_t tupleAt = 0;
+    // a DELETE row of several columns is a row constructor: (a,b)
+    bool wrap = m_shape.m_kind == Shape::SHAPE_DELETE && m_shape.m_params > 1;
+    if (wrap)
+    {
+        m_row += '(';
+    }
+
+    for (SqlStmtParameters::ParameterContainer::const_iterator itr = values.begin(); itr != values.end(); ++itr)
+    {
+        char buf[32];
+        literal.clear();
+        switch (itr->type())
+        {
+            case FIELD_BOOL:    literal = itr->toBool() ? "1" : "0";            break;
+            case FIELD_UI8:     literal = std::to_string(uint32(itr->toUint8()));  break;
+            case FIELD_UI16:    literal = std::to_string(uint32(itr->toUint16())); break;
+            case FIELD_UI32:    literal = std::to_string(itr->toUint32());         break;
+            case FIELD_UI64:    literal = std::to_string(itr->toUint64());         break;
+            case FIELD_I8:      literal = std::to_string(int32(itr->toInt8()));    break;
+            case FIELD_I16:     literal = std::to_string(int32(itr->toInt16()));   break;
+            case FIELD_I32:     literal = std::to_string(itr->toInt32());          break;
+            case FIELD_I64:     literal = std::to_string(itr->toInt64());          break;
+            case FIELD_FLOAT:
+                if (!std::isfinite(itr->toFloat()))
+                {
+                    return false;
+                }
+                snprintf(buf, sizeof(buf), "%.9g", double(itr->toFloat()));
+                literal = buf;
+                break;
+            case FIELD_DOUBLE:
+                if (!std::isfinite(itr->toDouble()))
+                {
+                    return false;
+                }
+                snprintf(buf, sizeof(buf), "%.17g", itr->toDouble());
+                literal = buf;
+                break;
+            case FIELD_STRING:
+                literal = itr->toStr();
+                m_escape(literal);
+                literal = "'" + literal + "'";
+                break;
+            default:
+                return false;
+        }
+
+        if (m_shape.m_kind == Shape::SHAPE_INSERT)
+        {
+            // copy the row text up to this value's placeholder, then the value
+            size_t mark = m_shape.m_tuple.find('?', tupleAt);
+            m_row.append(m_shape.m_tuple, tupleAt, mark - tupleAt);
+            tupleAt = mark + 1;
+        }
+        else if (next)
+        {
+            m_row += ',';
+        }
+        m_row += literal;
+        ++next;
+    }
+
+    if (m_shape.m_kind == Shape::SHAPE_INSERT)
+    {
+        m_row.append(m_shape.m_tuple, tupleAt, std::string::npos);
+    }
+    else if (wrap)
+    {
+        m_row += ')';
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_SQLSTATEMENTBATCH_H
+#define MANGOS_SQLSTATEMENTBATCH_H
+
+#include "Platform/Define.h"
+
+#include <functional>
+#include <string>
+
+class SqlStmtParameters;
+
+/**
+ * @file SqlStatementBatch.h
+ * @brief Folds a run of one prepared INSERT or DELETE into multi-row statements.
+ *
+ * A character save queues the same statement many times in a row: an INSERT per new
+ * spell, a DELETE per removed one. In a transaction each is its own round trip. When
+ * SqlTransaction meets such a run it hands the rows to this class, which writes them out
+ * as one statement for as many rows as fit in the byte budget:
+ *
+ *   INSERT INTO t (a, b) VALUES (?, ?)        ->  INSERT INTO t (a, b) VALUES (1,2),(3,4)
+ *   DELETE FROM t WHERE `a` = ?               ->  DELETE FROM t WHERE `a` IN (1,3)
+ *   DELETE FROM t WHERE `a` = ? AND `b` = ?   ->  DELETE FROM t WHERE (`a`,`b`) IN ((1,2),(3,4))
+ *
+ * Any other statement is left alone, as is a row with a value that cannot be written as a
+ * literal (a non-finite float). The rows are written in the text protocol, strings through
+ * the connection's escaping and reals with enough digits to read back bit for bit.
+ *
+ * Inside a transaction the result is the same: if one row of a multi-row statement fails,
+ * the statement fails, and so does the transaction, as it would have at that row.
+ */
+class SqlStatementBatch
+{
+    public:
+        /// Bytes of SQL per statement; well under MySQL's smallest max_allowed_packet.
+        static const size_t DEFAULT_BUDGET = 64 * 1024;
+
+        /// Escapes a string for use inside quotes, in place
+        typedef std::function<void(std::string&)> Escaper;
+
+        /**
+         * @brief How a statement can be batched, worked out once from its text
+         */
+        class Shape
+        {
+            public:
+                explicit Shape(std::string const& fmt);
+
+                bool IsBatchable() const { return m_kind != SHAPE_NONE; }
+
+            private:
+                friend class SqlStatementBatch;
+
+                enum Kind
+                {
+                    SHAPE_NONE,
+                    SHAPE_INSERT,                           ///< INSERT/REPLACE ... VALUES (...)
+                    SHAPE_DELETE                            ///< DELETE ... WHERE a = ? [AND b = ?]...
+                };
+
+                bool ParseInsert(std::string const& fmt);
+                bool ParseDelete(std::string const& fmt);
+
+                Kind m_kind;
+                std::string m_head;                         ///< everything before the first row
+                std::string m_tuple;                        ///< INSERT: one row's VALUES text, '?' for each value
+                uint32 m_params;                            ///< placeholders per row
+        };
+
+        /**
+         * @param shape the statement, which must be batchable
+         * @param escape string escaping of the connection the batch will run on
+         * @param budget largest statement to build, in bytes
+         */
+        SqlStatementBatch(Shape const& shape, Escaper const& escape, size_t budget = DEFAULT_BUDGET);
+
+        /**
+         * @brief Add one row
+         *
+         * @return false, leaving the batch as it was, when the row would take the statement
+         *         over budget or has a value with no literal form
+         */
+        bool Add(SqlStmtParameters const& params);
+
+        uint32 GetRows() const { return m_rows; }
+
+        /// The statement for the rows added so far
+        std::string const& GetSql();
+
+        /// Drop the rows, ready for the next statement
+        void Clear();
+
+    private:
+        /// Append @p params as literals to m_row, in the statement's row syntax
+        bool RenderRow(SqlStmtParameters const& params);
+
+        Shape const& m_shape;
+        Escaper m_escape;
+        size_t m_budget;
+        uint32 m_rows;
+        std::string m_sql;                                  ///< head and the rows so far
+        std::string m_row;                                  ///< scratch for the row being added
+        bool m_closed;                                      ///< m_sql has its closing text
+};
+
+#endif
@@ -89,12 +89,14 @@ namespace Geometry
         // remains the final arbiter, so it cannot manufacture a false hit. Making the
         // broadphase at least as permissive as the narrowphase is the only safe
         // direction; never tighten this below rayTri's tolerance.
+        //
+        // Yards, comfortably above rayTri's world-space slop (kUVEps scaled by the
+        // longest edge a WMO triangle realistically has). Public because the packet walk
+        // in Bvh::RaycastPacket pads by exactly the same amount.
+        static constexpr float kSlabEps = 1e-2f;
+
         bool intersectsRay(const Vector3& o, const Vector3& invDir, float tMax) const
         {
-            // Yards, comfortably above rayTri's world-space slop (kUVEps scaled by the
-            // longest edge a WMO triangle realistically has).
-            constexpr float kSlabEps = 1e-2f;
-
             float t0 = 0.f, t1 = tMax;
             for (int a = 0; a < 3; ++a)
             {
@@ -249,12 +251,17 @@ namespace Geometry
         Vector3 a, b, c;
     };
 
+    // rayTri's tolerances, at namespace scope so the four-ray version of the same test
+    // (Bvh::RaycastPacket) cannot drift from it.
+    constexpr float kRayTriEps = 1e-6f;   // ray/triangle parallel tolerance
+    constexpr float kRayTriUVEps = 1e-5f; // tolerance for barycentric coords
+
     // Moller-Trumbore. Returns the ray parameter t (>= 0) of the hit, or nullopt.
     // Two-sided (we hit floors and ceilings alike); the caller decides what to keep.
     inline std::optional<float> rayTri(const Vector3& o, const Vector3& d, const Tri& t)
     {
-        constexpr float kEps = 1e-6f;   // ray/triangle parallel tolerance
-        constexpr float kUVEps = 1e-5f; // tolerance for barycentric coords
+        constexpr float kEps = kRayTriEps;
+        constexpr float kUVEps = kRayTriUVEps;
 
         const Vector3 e1 = t.b - t.a;
         const Vector3 e2 = t.c - t.a;
@@ -26,6 +26,195 @@
 #include <utility>
 #include "EventProcessor.h"
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+    const uint8 WHEEL_LEVELS = 4;                           // 64^4 ms, about 4.6 hours
+    const uint8 WHEEL_SLOT_BITS = 6;
+    const uint8 WHEEL_SLOTS = 1 << WHEEL_SLOT_BITS;
+    const uint8 LIST_DUE = WHEEL_LEVELS;                    // m_level of an event on the due list
+    const uint8 LIST_OVERFLOW = WHEEL_LEVELS + 1;           // ...and on the overflow list
+    const uint8 LIST_SORTED = WHEEL_LEVELS + 2;             // ...and on the sorted list, before there is a wheel
+    const uint32 SORTED_LIMIT = 16;                         // events kept on the sorted list before the wheel is built
+
+    /// Index of the lowest set bit of a non-zero value.
+    inline uint32 LowestBit(uint64 v)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, v);
+        return uint32(index);
+#else
+        return uint32(__builtin_ctzll(v));
+#endif
+    }
+
+    /// Index of the highest set bit of a non-zero value.
+    inline uint32 HighestBit(uint64 v)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, v);
+        return uint32(index);
+#else
+        return uint32(63 - __builtin_clzll(v));
+#endif
+    }
+
+    /// The level an event at `when` is filed at, seen from `cursor`: the highest digit
+    /// in which the two differ. WHEEL_LEVELS means beyond the wheel.
+    inline uint8 LevelOf(uint64 when, uint64 cursor)
+    {
+        uint64 diff = when ^ cursor;
+        if (diff < WHEEL_SLOTS)
+        {
+            return 0;
+        }
+        uint32 level = HighestBit(diff) / WHEEL_SLOT_BITS;
+        return level < WHEEL_LEVELS ? uint8(level) : WHEEL_LEVELS;
+    }
+
+    // -- event pool ------------------------------------------------------------------
+
+    const std::size_t EVENT_POOL_GRANULE = 16;
+    const std::size_t EVENT_POOL_SIZES = 16;                // blocks of 16 to 256 bytes
+    const uint32 EVENT_POOL_KEEP = 4096;                    // free blocks kept per size
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    /**
+     * @brief Free event blocks of one thread, per size.
+     *
+     * Map updates run on their own threads, so this is in effect a pool per map
+     * thread, and it takes no lock. A block freed on another thread than the one that
+     * allocated it simply joins that thread's pool.
+     */
+    struct EventPool
+    {
+        EventPool()
+        {
+            memset(free, 0, sizeof(free));
+            memset(count, 0, sizeof(count));
+        }
+
+        ~EventPool();
+
+        FreeBlock* free[EVENT_POOL_SIZES];
+        uint32 count[EVENT_POOL_SIZES];
+    };
+
+    // Trivially destructible, so it can still be read once the pool is gone: an event
+    // deleted during thread or static teardown then goes straight back to the heap.
+    thread_local bool t_eventPoolGone = false;
+    thread_local EventPool t_eventPool;
+
+    EventPool::~EventPool()
+    {
+        t_eventPoolGone = true;
+        for (std::size_t i = 0; i < EVENT_POOL_SIZES; ++i)
+        {
+            while (FreeBlock* block = free[i])
+            {
+                free[i] = block->next;
+                ::operator delete(block);
+            }
+        }
+    }
+
+    std::size_t PoolIndex(std::size_t size)
+    {
+        return (size + EVENT_POOL_GRANULE - 1) / EVENT_POOL_GRANULE - 1;
+    }
+}
+
+/**
+ * @brief Allocates an event from the calling thread's pool.
+ *
+ * @param size Size of the derived event.
+ * @return void* The block.
+ */
+void* BasicEvent::operator new(std::size_t size)
+{
+    std::size_t index = PoolIndex(size);
+    if (index >= EVENT_POOL_SIZES)
+    {
+        return ::operator new(size);
+    }
+
+    if (!t_eventPoolGone)
+    {
+        EventPool& pool = t_eventPool;
+        if (FreeBlock* block = pool.free[index])
+        {
+            pool.free[index] = block->next;
+            --pool.count[index];
+            return block;
+        }
+    }
+    return ::operator new((index + 1) * EVENT_POOL_GRANULE);
+}
+
+/**
+ * @brief Returns an event's block to the calling thread's pool.
+ *
+ * @param p The block.
+ * @param size Size of the derived event.
+ */
+void BasicEvent::operator delete(void* p, std::size_t size)
+{
+    if (!p)
+    {
+        return;
+    }
+
+    std::size_t index = PoolIndex(size);
+    if (index >= EVENT_POOL_SIZES || t_eventPoolGone)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    EventPool& pool = t_eventPool;
+    if (pool.count[index] >= EVENT_POOL_KEEP)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = pool.free[index];
+    pool.free[index] = block;
+    ++pool.count[index];
+}
+
+/**
+ * @brief The wheel's slots and side lists.
+ */
+struct EventProcessor::Wheel
+{
+    Wheel() : due(NULL), overflow(NULL)
+    {
+        memset(slots, 0, sizeof(slots));
+        memset(occupied, 0, sizeof(occupied));
+    }
+
+    BasicEvent* slots[WHEEL_LEVELS][WHEEL_SLOTS]; /**< Slot heads, per level */
+    uint64 occupied[WHEEL_LEVELS]; /**< One bit per non-empty slot, per level */
+    BasicEvent* due; /**< Events at or before the cursor, sorted by time */
+    BasicEvent* overflow; /**< Events beyond the top level, unsorted */
+};
+
 /**
  * @brief Construct a new Event Processor::Event Processor object
  * Initializes member variables m_time and m_aborting.
@@ -33,6 +222,10 @@
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_cursor = 0;
+    m_nothingBefore = UINT64_MAX;
+    m_sorted = NULL;
+    m_sortedCount = 0;
     m_aborting = false;
 }
 
@@ -48,6 +241,10 @@ EventProcessor::~EventProcessor()
 /**
  * @brief Updates the event processor with the given time.
  *
+ * Runs every event due by the new time, in time order. The cursor jumps from one
+ * event due to the next rather than stepping through the milliseconds between, and
+ * stays at the last one: it only has to be no later than the earliest event.
+ *
  * @param p_time Time to update the event processor with.
  */
 void EventProcessor::Update(uint32 p_time)
@@ -55,26 +252,69 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
+    // Most updates of most objects have nothing due, and this answers that without
+    // touching the wheel.
+    if (m_time < m_nothingBefore)
+    {
+        return;
+    }
+
+    // Before the wheel is built the events are one sorted list, run from the front.
+    // An event re-added from Execute may build the wheel; the rest then run from there.
+    while (!m_wheel)
+    {
+        BasicEvent* Event = m_sorted;
+        if (!Event || Event->m_execTime > m_time)
+        {
+            m_nothingBefore = Event ? Event->m_execTime : UINT64_MAX;
+            return;
+        }
+
+        Remove(m_sorted, Event);
+        --m_sortedCount;
+        Dispatch(Event, p_time);
+    }
+
+    Wheel& wheel = *m_wheel;
+
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    for (;;)
     {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        while (BasicEvent* Event = PopFront(wheel.due))
+        {
+            Dispatch(Event, p_time);
+        }
 
-        if (!Event->to_Abort)
+        uint64 bound;
+        if (!NextBound(bound))
         {
-            if (Event->Execute(m_time, p_time))
-            {
-                // completely destroy event if it is not re-added
-                delete Event;
-            }
+            m_nothingBefore = UINT64_MAX;
+            break;
         }
-        else
+        if (bound > m_time)
         {
-            Event->Abort(m_time);
-            delete Event;
+            m_nothingBefore = bound;
+            break;
+        }
+        // Straight to the earliest event: its slot is filed lower on the way, and the
+        // event itself lands in the level 0 slot of the cursor. That slot holds exactly
+        // the events due at the cursor, and they go to the due list whole.
+        MoveCursor(bound);
+
+        uint8 slot = uint8(m_cursor & (WHEEL_SLOTS - 1));
+        if (BasicEvent* now = wheel.slots[0][slot])
+        {
+            wheel.slots[0][slot] = NULL;
+            wheel.occupied[0] &= ~(uint64(1) << slot);
+
+            BasicEvent* Event = now;
+            do
+            {
+                Event->m_level = LIST_DUE;
+                Event = Event->m_next;
+            }
+            while (Event != now);
+            wheel.due = now;
         }
     }
 }
@@ -89,29 +329,51 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    // Take every event off the lists first: Abort may touch this processor.
+    BasicEvent* all = NULL;
+    Splice(all, m_sorted);
+    m_sortedCount = 0;
+    if (m_wheel)
     {
-        EventList::iterator i_old = i;
-        ++i;
-
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        Wheel& wheel = *m_wheel;
+        Splice(all, wheel.due);
+        for (uint8 level = 0; level < WHEEL_LEVELS; ++level)
         {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
+            for (uint8 slot = 0; slot < WHEEL_SLOTS; ++slot)
             {
-                m_events.erase(i_old);
+                Splice(all, wheel.slots[level][slot]);
             }
+            wheel.occupied[level] = 0;
         }
+        Splice(all, wheel.overflow);
     }
 
-    // fast clear event list (in force case)
-    if (force)
+    // Abort them in time order, as the events have always seen it. Only the overflow
+    // list is out of order, but this is rare enough to just sort.
+    std::vector<BasicEvent*> events;
+    while (BasicEvent* Event = PopFront(all))
     {
-        m_events.clear();
+        events.push_back(Event);
+    }
+    std::stable_sort(events.begin(), events.end(), [](BasicEvent const* a, BasicEvent const* b)
+    {
+        return a->m_execTime < b->m_execTime;
+    });
+
+    // first, abort all existing events
+    for (std::vector<BasicEvent*>::const_iterator i = events.begin(); i != events.end(); ++i)
+    {
+        BasicEvent* Event = *i;
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
+        {
+            delete Event;
+        }
+        else
+        {
+            Schedule(Event);                                // keeps its time; deleted when it comes up
+        }
     }
 }
 
@@ -130,7 +392,23 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     }
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Schedule(Event);
+}
+
+/**
+ * @brief Removes a pending event at once.
+ *
+ * @param Event Pointer to the event to cancel.
+ */
+void EventProcessor::CancelEvent(BasicEvent* Event)
+{
+    Event->to_Abort = true;
+    Event->Abort(m_time);
+    if (Event->IsDeletable())
+    {
+        Unlink(Event);
+        delete Event;
+    }
 }
 
 /**
@@ -143,3 +421,364 @@ uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return m_time + t_offset;
 }
+
+/**
+ * @brief Appends an event to a list.
+ *
+ * @param head The list.
+ * @param Event The event.
+ */
+void EventProcessor::PushBack(BasicEvent*& head, BasicEvent* Event)
+{
+    if (!head)
+    {
+        Event->m_next = Event;
+        Event->m_prev = Event;
+        head = Event;
+        return;
+    }
+
+    BasicEvent* tail = head->m_prev;
+    Event->m_prev = tail;
+    Event->m_next = head;
+    tail->m_next = Event;
+    head->m_prev = Event;
+}
+
+/**
+ * @brief Inserts an event after every event of a time-sorted list due no later than it.
+ *
+ * Searched from the tail: an event added late is nearly always due last.
+ *
+ * @param head The list.
+ * @param Event The event.
+ */
+void EventProcessor::InsertSorted(BasicEvent*& head, BasicEvent* Event)
+{
+    if (!head || head->m_prev->m_execTime <= Event->m_execTime)
+    {
+        PushBack(head, Event);
+        return;
+    }
+
+    // `at` is always due later than Event; it stops at the first such event.
+    BasicEvent* at = head->m_prev;
+    while (at != head && at->m_prev->m_execTime > Event->m_execTime)
+    {
+        at = at->m_prev;
+    }
+
+    Event->m_next = at;
+    Event->m_prev = at->m_prev;
+    at->m_prev->m_next = Event;
+    at->m_prev = Event;
+    if (at == head)
+    {
+        head = Event;
+    }
+}
+
+/**
+ * @brief Takes an event out of a list.
+ *
+ * @param head The list.
+ * @param Event The event.
+ */
+void EventProcessor::Remove(BasicEvent*& head, BasicEvent* Event)
+{
+    if (Event->m_next == Event)
+    {
+        head = NULL;
+    }
+    else
+    {
+        Event->m_prev->m_next = Event->m_next;
+        Event->m_next->m_prev = Event->m_prev;
+        if (head == Event)
+        {
+            head = Event->m_next;
+        }
+    }
+    Event->m_next = NULL;
+    Event->m_prev = NULL;
+}
+
+/**
+ * @brief Takes the first event out of a list.
+ *
+ * @param head The list.
+ * @return BasicEvent* The event, or NULL if the list is empty.
+ */
+BasicEvent* EventProcessor::PopFront(BasicEvent*& head)
+{
+    BasicEvent* Event = head;
+    if (Event)
+    {
+        Remove(head, Event);
+    }
+    return Event;
+}
+
+/**
+ * @brief Moves all of one list onto the end of another.
+ *
+ * @param head The list appended to.
+ * @param other The list emptied.
+ */
+void EventProcessor::Splice(BasicEvent*& head, BasicEvent*& other)
+{
+    if (!other)
+    {
+        return;
+    }
+    if (head)
+    {
+        BasicEvent* tail = head->m_prev;
+        BasicEvent* otherTail = other->m_prev;
+        tail->m_next = other;
+        other->m_prev = tail;
+        otherTail->m_next = head;
+        head->m_prev = otherTail;
+    }
+    else
+    {
+        head = other;
+    }
+    other = NULL;
+}
+
+/**
+ * @brief Files an event on the sorted list while it is short, on the wheel after.
+ *
+ * @param Event The event.
+ */
+void EventProcessor::Schedule(BasicEvent* Event)
+{
+    if (!m_wheel)
+    {
+        if (m_sortedCount < SORTED_LIMIT)
+        {
+            Event->m_level = LIST_SORTED;
+            InsertSorted(m_sorted, Event);
+            ++m_sortedCount;
+            m_nothingBefore = std::min(m_nothingBefore, Event->m_execTime);
+            return;
+        }
+        BuildWheel();
+    }
+    File(Event);
+}
+
+/**
+ * @brief Builds the wheel and moves the sorted list onto it.
+ *
+ * The cursor starts at the current time: nothing is filed yet, so nothing can be
+ * before it, and an event already due goes to the due list in its order.
+ */
+void EventProcessor::BuildWheel()
+{
+    m_wheel.reset(new Wheel());
+    m_cursor = m_time;
+    while (BasicEvent* Event = PopFront(m_sorted))
+    {
+        File(Event);
+    }
+    m_sortedCount = 0;
+}
+
+/**
+ * @brief Files an event at its place in the wheel, seen from the cursor.
+ *
+ * @param Event The event.
+ */
+void EventProcessor::File(BasicEvent* Event)
+{
+    Wheel& wheel = *m_wheel;
+    uint64 when = Event->m_execTime;
+
+    if (when < m_cursor)
+    {
+        Event->m_level = LIST_DUE;
+        InsertSorted(wheel.due, Event);
+        m_nothingBefore = 0;
+        return;
+    }
+
+    uint8 level = LevelOf(when, m_cursor);
+    if (level == WHEEL_LEVELS)
+    {
+        Event->m_level = LIST_OVERFLOW;
+        PushBack(wheel.overflow, Event);
+        m_nothingBefore = std::min(m_nothingBefore, when);
+        return;
+    }
+
+    uint8 slot = uint8((when >> (WHEEL_SLOT_BITS * level)) & (WHEEL_SLOTS - 1));
+    Event->m_level = level;
+    Event->m_slot = slot;
+    PushBack(wheel.slots[level][slot], Event);
+    wheel.occupied[level] |= uint64(1) << slot;
+
+    m_nothingBefore = std::min(m_nothingBefore, when);
+}
+
+/**
+ * @brief Takes an event off the wheel, wherever it is filed.
+ *
+ * @param Event The event.
+ */
+void EventProcessor::Unlink(BasicEvent* Event)
+{
+    if (Event->m_level == LIST_SORTED)
+    {
+        Remove(m_sorted, Event);
+        --m_sortedCount;
+        return;
+    }
+
+    BasicEvent** head = ListOf(Event->m_level, Event->m_slot);
+    Remove(*head, Event);
+    if (Event->m_level < WHEEL_LEVELS && !*head)
+    {
+        m_wheel->occupied[Event->m_level] &= ~(uint64(1) << Event->m_slot);
+    }
+}
+
+/**
+ * @brief Runs, or aborts, one event taken off the wheel.
+ *
+ * @param Event The event.
+ * @param p_time Update interval.
+ */
+void EventProcessor::Dispatch(BasicEvent* Event, uint32 p_time)
+{
+    if (!Event->to_Abort)
+    {
+        if (Event->Execute(m_time, p_time))
+        {
+            // completely destroy event if it is not re-added
+            delete Event;
+        }
+    }
+    else
+    {
+        Event->Abort(m_time);
+        delete Event;
+    }
+}
+
+/**
+ * @brief Advances the cursor, filing lower the events of the slot it enters.
+ *
+ * Only the slot at the highest digit that changes needs it: no event may be due
+ * before `to`, so every slot the cursor passes over on the way is empty. The cursor
+ * must also stay at or before the current time, or an event added between it and
+ * the time would go on the due list early.
+ *
+ * @param to The new cursor; no event may be due before it.
+ */
+void EventProcessor::MoveCursor(uint64 to)
+{
+    if (to <= m_cursor)
+    {
+        return;
+    }
+
+    uint8 level = LevelOf(to, m_cursor);
+    m_cursor = to;
+    if (!m_wheel || level == 0)
+    {
+        return;                                             // level 0 slots hold exact times
+    }
+
+    Wheel& wheel = *m_wheel;
+    BasicEvent* moved;
+    if (level == WHEEL_LEVELS)
+    {
+        moved = wheel.overflow;
+        wheel.overflow = NULL;
+    }
+    else
+    {
+        uint8 slot = uint8((to >> (WHEEL_SLOT_BITS * level)) & (WHEEL_SLOTS - 1));
+        moved = wheel.slots[level][slot];
+        wheel.slots[level][slot] = NULL;
+        wheel.occupied[level] &= ~(uint64(1) << slot);
+    }
+
+    while (BasicEvent* Event = PopFront(moved))
+    {
+        File(Event);
+    }
+}
+
+/**
+ * @brief The time the earliest event on the wheel is due.
+ *
+ * Every event in the first non-empty slot of the lowest non-empty level is due before
+ * any other on the wheel, so only that slot is searched; at level 0 not even that.
+ *
+ * @param bound Set to that time.
+ * @return bool False if the wheel holds no event.
+ */
+bool EventProcessor::NextBound(uint64& bound) const
+{
+    Wheel const& wheel = *m_wheel;
+    BasicEvent const* list = NULL;
+    for (uint8 level = 0; level < WHEEL_LEVELS && !list; ++level)
+    {
+        uint64 occupied = wheel.occupied[level];
+        if (!occupied)
+        {
+            continue;
+        }
+
+        uint8 slot = uint8(LowestBit(occupied));
+        if (level == 0)
+        {
+            bound = ((m_cursor >> WHEEL_SLOT_BITS) << WHEEL_SLOT_BITS) | slot;
+            return true;
+        }
+        list = wheel.slots[level][slot];
+    }
+
+    if (!list)
+    {
+        list = wheel.overflow;
+    }
+    if (!list)
+    {
+        return false;
+    }
+
+    bound = list->m_execTime;
+    for (BasicEvent const* Event = list->m_next; Event != list; Event = Event->m_next)
+    {
+        if (Event->m_execTime < bound)
+        {
+            bound = Event->m_execTime;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The list an event filed at a level and slot is on.
+ *
+ * @param level Wheel level, LIST_DUE or LIST_OVERFLOW.
+ * @param slot Slot within the level.
+ * @return BasicEvent** The list's head.
+ */
+BasicEvent** EventProcessor::ListOf(uint8 level, uint8 slot)
+{
+    Wheel& wheel = *m_wheel;
+    if (level == LIST_DUE)
+    {
+        return &wheel.due;
+    }
+    if (level == LIST_OVERFLOW)
+    {
+        return &wheel.overflow;
+    }
+    return &wheel.slots[level][slot];
+}
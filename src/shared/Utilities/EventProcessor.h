@@ -27,11 +27,18 @@
 #define MANGOS_H_EVENTPROCESSOR
 
 #include "Platform/Define.h"
-#include <map>
+#include <cstddef>
+#include <memory>
+
+class EventProcessor;
 
 /**
  * @brief Note. All times are in milliseconds here.
  *
+ * Events are created with new and owned by the EventProcessor they are added to,
+ * which deletes them. The allocation comes from a per-thread pool (see operator new
+ * below): a unit that moves schedules a relocation event every few hundred
+ * milliseconds, and those should not each cost a trip to the heap.
  */
 class BasicEvent
 {
@@ -41,7 +48,8 @@ class BasicEvent
          * Initializes member variables to_Abort, m_addTime, and m_execTime.
          */
         BasicEvent()
-            : to_Abort(false), m_addTime(0), m_execTime(0) // Initialize member variables
+            : to_Abort(false), m_addTime(0), m_execTime(0), // Initialize member variables
+              m_next(NULL), m_prev(NULL), m_level(0), m_slot(0)
         {
         }
 
@@ -76,22 +84,57 @@ class BasicEvent
          */
         virtual void Abort(uint64 /*e_time*/) {}
 
+        /**
+         * @brief Allocates an event of any derived type from the calling thread's pool.
+         *
+         * Blocks are kept per size, 16 bytes apart; larger events go to the heap.
+         *
+         * @param size Size of the derived event
+         * @return void* The block
+         */
+        static void* operator new(std::size_t size);
+
+        /**
+         * @brief Returns an event's block to the calling thread's pool.
+         *
+         * @param p The block
+         * @param size Size of the derived event, as the virtual destructor reports it
+         */
+        static void operator delete(void* p, std::size_t size);
+
         bool to_Abort; /**< Set by externals when the event is aborted, aborted events don't execute and get Abort call when deleted */
 
         // These can be used for time offset control
         uint64 m_addTime; /**< Time when the event was added to queue, filled by event handler */
         uint64 m_execTime; /**< Planned time of next execution, filled by event handler */
-};
 
-/**
- * @brief Typedef for a multimap of events
- *
- */
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        friend class EventProcessor;
+
+        BasicEvent* m_next; /**< Next event in the same wheel slot, owned by the event handler */
+        BasicEvent* m_prev; /**< Previous event in the slot; the slot head's points at the tail */
+        uint8 m_level; /**< Wheel level (or one of the side lists) the event is filed in */
+        uint8 m_slot; /**< Slot within the level */
+};
 
 /**
  * @brief Event Processor class
  *
+ * Most objects have one or two events pending -- a relocation notify, a despawn -- and
+ * for them the events are a single list sorted by time, held in the processor itself:
+ * adding one is a link near the tail, running one a pop from the front.
+ *
+ * Past 16 pending events the processor builds a hierarchical timing wheel and keeps
+ * using it. Level k has 64 slots of 64^k milliseconds each, and an event is filed at
+ * the level of the highest 6-bit digit in which its time differs from the wheel's
+ * cursor. Adding and cancelling an event is therefore a list link or unlink, whatever
+ * the number of events. When the cursor reaches a slot on a higher level, that slot's
+ * events are filed again, one level down or more. A slot is a circular list, so events
+ * due in the same millisecond run in the order they were added.
+ *
+ * Events due before the cursor wait on a due list sorted by time. Events more than
+ * 64^4 ms (about 4.6 hours) out wait on an overflow list until the cursor nears them.
+ * The cursor moves only in Update, and straight to the next event due.
  */
 class EventProcessor
 {
@@ -131,6 +174,16 @@ class EventProcessor
          */
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
 
+        /**
+         * @brief Removes a pending event at once, instead of at its time
+         *
+         * The event gets its Abort call and is deleted, unless it is not deletable, in
+         * which case it stays scheduled with to_Abort set, as KillAllEvents leaves it.
+         *
+         * @param Event Pointer to an event added to this processor and not yet executed
+         */
+        void CancelEvent(BasicEvent* Event);
+
         /**
          * @brief Calculates the time with the given offset
          *
@@ -140,8 +193,30 @@ class EventProcessor
         uint64 CalculateTime(uint64 t_offset) const;
 
     protected:
+        struct Wheel;
+
+        // Circular lists of events; a head's m_prev is the list's tail.
+        static void PushBack(BasicEvent*& head, BasicEvent* Event);
+        static void InsertSorted(BasicEvent*& head, BasicEvent* Event);
+        static void Remove(BasicEvent*& head, BasicEvent* Event);
+        static BasicEvent* PopFront(BasicEvent*& head);
+        static void Splice(BasicEvent*& head, BasicEvent*& other);
+
+        void Schedule(BasicEvent* Event);
+        void BuildWheel();
+        void File(BasicEvent* Event);
+        void Unlink(BasicEvent* Event);
+        void Dispatch(BasicEvent* Event, uint32 p_time);
+        void MoveCursor(uint64 to);
+        bool NextBound(uint64& bound) const;
+        BasicEvent** ListOf(uint8 level, uint8 slot);
+
         uint64 m_time; /**< Current time in milliseconds */
-        EventList m_events; /**< List of events */
+        uint64 m_cursor; /**< Where the wheel stands; no event is filed earlier, bar the due list */
+        uint64 m_nothingBefore; /**< No event is due before this time; kept with m_time so an idle Update stays here */
+        BasicEvent* m_sorted; /**< Every pending event, by time, until the wheel is built */
+        uint32 m_sortedCount; /**< Events on m_sorted */
+        std::unique_ptr<Wheel> m_wheel; /**< Slots, due and overflow lists; built once m_sorted grows too long */
         bool m_aborting; /**< Flag indicating if the event processor is aborting */
 };
 
@@ -0,0 +1,204 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file TaskGraph.cpp
+ * @brief Implementation of the startup task graph.
+ */
+
+#include "TaskGraph.h"
+#include "Utilities/Errors.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+TaskGraph::TaskId TaskGraph::Add(std::string const& name, Task task, std::initializer_list<TaskId> after)
+{
+    TaskId id = TaskId(m_nodes.size());
+
+    m_nodes.push_back(Node());
+    Node& node = m_nodes.back();
+    node.name = name;
+    node.task = task;
+    node.elapsedMs = 0;
+
+    for (TaskId dep : after)
+    {
+        // Only earlier tasks can be named, which is what keeps the graph acyclic.
+        MANGOS_ASSERT(dep < id);
+        node.after.push_back(dep);
+        m_nodes[dep].unlocks.push_back(id);
+    }
+
+    return id;
+}
+
+void TaskGraph::Run(uint32 threads, Listener const& onStart, Listener const& onFinish)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    uint32 const total = Size();
+    Clock::time_point const runStart = Clock::now();
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::set<TaskId> ready;                 // ordered: lowest id is always taken first
+    std::vector<uint32> waiting(total);
+    uint32 finished = 0;
+
+    for (TaskId id = 0; id < total; ++id)
+    {
+        waiting[id] = uint32(m_nodes[id].after.size());
+        if (!waiting[id])
+        {
+            ready.insert(id);
+        }
+    }
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;)
+        {
+            wake.wait(guard, [&]() { return !ready.empty() || finished == total; });
+            if (ready.empty())
+            {
+                return;                     // everything has finished
+            }
+
+            TaskId id = *ready.begin();
+            ready.erase(ready.begin());
+            if (onStart)
+            {
+                onStart(*this, id, finished);
+            }
+
+            guard.unlock();
+            Clock::time_point start = Clock::now();
+            m_nodes[id].task();
+            uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+            guard.lock();
+
+            m_nodes[id].elapsedMs = elapsed;
+            ++finished;
+            for (TaskId next : m_nodes[id].unlocks)
+            {
+                if (!--waiting[next])
+                {
+                    ready.insert(next);
+                }
+            }
+            if (onFinish)
+            {
+                onFinish(*this, id, finished);
+            }
+
+            wake.notify_all();
+        }
+    };
+
+    if (threads > total)
+    {
+        threads = total;
+    }
+
+    std::vector<std::thread> pool;
+    for (uint32 i = 1; i < threads; ++i)
+    {
+        if (m_threadScope)
+        {
+            pool.push_back(std::thread([this, &worker]() { m_threadScope(worker); }));
+        }
+        else
+        {
+            pool.push_back(std::thread(worker));
+        }
+    }
+    worker();                               // the calling thread works the graph too
+    for (std::thread& thread : pool)
+    {
+        thread.join();
+    }
+
+    m_wallMs = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - runStart).count());
+}
+
+uint32 TaskGraph::TotalMs() const
+{
+    uint32 sum = 0;
+    for (Node const& node : m_nodes)
+    {
+        sum += node.elapsedMs;
+    }
+    return sum;
+}
+
+uint32 TaskGraph::CriticalPath(std::vector<TaskId>& path) const
+{
+    path.clear();
+    if (m_nodes.empty())
+    {
+        return 0;
+    }
+
+    // Dependencies always point backwards, so one pass in id order sees every
+    // predecessor's finish time before it is needed.
+    std::vector<uint32> reach(m_nodes.size());
+    std::vector<TaskId> via(m_nodes.size());
+    TaskId last = 0;
+
+    for (TaskId id = 0; id < m_nodes.size(); ++id)
+    {
+        uint32 longest = 0;
+        via[id] = id;
+        for (TaskId dep : m_nodes[id].after)
+        {
+            if (reach[dep] > longest || via[id] == id)
+            {
+                longest = reach[dep];
+                via[id] = dep;
+            }
+        }
+        reach[id] = longest + m_nodes[id].elapsedMs;
+        if (reach[id] > reach[last])
+        {
+            last = id;
+        }
+    }
+
+    for (TaskId id = last;; id = via[id])
+    {
+        path.insert(path.begin(), id);
+        if (via[id] == id)
+        {
+            break;
+        }
+    }
+
+    return reach[last];
+}
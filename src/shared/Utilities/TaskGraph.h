@@ -0,0 +1,149 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file TaskGraph.h
+ * @brief A set of one-shot tasks with explicit ordering, run on a small pool of threads.
+ *
+ * Built for world startup, where a hundred loaders used to run one after another even
+ * though most of them read unrelated tables. Each task names the tasks it must follow;
+ * a task only starts once all of those have finished. Among the tasks that are ready,
+ * the one declared first always goes first, so a graph run on one thread executes in
+ * exactly the declaration order -- the graph can replace a sequential block without
+ * changing it until more threads are asked for.
+ *
+ * Dependencies can only point at tasks already added, so a graph can never hold a
+ * cycle.
+ */
+
+#ifndef MANGOS_TASK_GRAPH_H
+#define MANGOS_TASK_GRAPH_H
+
+#include "Platform/Define.h"
+
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One-shot dependency graph of tasks, run once by Run().
+ */
+class TaskGraph
+{
+    public:
+
+        typedef uint32 TaskId;
+        typedef std::function<void()> Task;
+
+        /**
+         * @brief Progress callback.
+         *
+         * Called with the graph's mutex held, so calls never overlap and may use
+         * Name()/ElapsedMs(); they must not call back into Add() or Run().
+         *
+         * @param graph The graph being run.
+         * @param id The task that is starting or has just finished.
+         * @param finished Tasks finished so far, this one included once it is done.
+         */
+        typedef std::function<void(TaskGraph const& graph, TaskId id, uint32 finished)> Listener;
+
+        /**
+         * @brief Wraps the whole life of each thread Run() starts.
+         *
+         * Must call @p work exactly once. This is where a thread takes on what every
+         * task expects of it, such as registering with the database client library;
+         * the calling thread is not wrapped, having set itself up already.
+         */
+        typedef std::function<void(std::function<void()> const& work)> ThreadScope;
+
+        TaskGraph() : m_wallMs(0) {}
+
+        /// Set the scope each started thread runs in. Empty by default.
+        void SetThreadScope(ThreadScope scope) { m_threadScope = scope; }
+
+        /**
+         * @brief Declare a task.
+         *
+         * @param name Shown in progress and timing reports.
+         * @param task The work. Runs on whichever thread picks it up.
+         * @param after Tasks that must finish before this one starts.
+         * @return The id to name this task in later dependency lists.
+         */
+        TaskId Add(std::string const& name, Task task, std::initializer_list<TaskId> after = {});
+
+        /**
+         * @brief Run every task, returning once all have finished.
+         *
+         * @param threads Threads working the graph, the calling thread included. With 1
+         *                no thread is started and the tasks run in declaration order.
+         * @param onStart Called as each task is picked up. May be empty.
+         * @param onFinish Called as each task completes. May be empty.
+         */
+        void Run(uint32 threads, Listener const& onStart = Listener(), Listener const& onFinish = Listener());
+
+        uint32 Size() const { return uint32(m_nodes.size()); }
+        std::string const& Name(TaskId id) const { return m_nodes[id].name; }
+
+        /// How long the task took, once it has run.
+        uint32 ElapsedMs(TaskId id) const { return m_nodes[id].elapsedMs; }
+
+        /// Wall time of the last Run().
+        uint32 WallMs() const { return m_wallMs; }
+
+        /// Sum of every task's time: what the last Run() would have taken on one thread.
+        uint32 TotalMs() const;
+
+        /**
+         * @brief The longest chain of dependent tasks of the last Run(), by time.
+         *
+         * No number of threads gets the run below this; a critical path close to the
+         * wall time means adding threads will not help, splitting a loader might.
+         *
+         * @param path Filled with the chain, first task first.
+         * @return Its length in milliseconds.
+         */
+        uint32 CriticalPath(std::vector<TaskId>& path) const;
+
+    private:
+
+        TaskGraph(TaskGraph const&);
+        TaskGraph& operator=(TaskGraph const&);
+
+        struct Node
+        {
+            std::string name;
+            Task task;
+            std::vector<TaskId> after;      ///< Tasks this one waits for
+            std::vector<TaskId> unlocks;    ///< Tasks waiting for this one
+            uint32 elapsedMs;
+        };
+
+        std::vector<Node> m_nodes;
+        ThreadScope m_threadScope;
+        uint32 m_wallMs;
+};
+
+#endif
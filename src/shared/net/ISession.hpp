@@ -44,9 +44,36 @@ namespace net {
 // span need only stay valid for the duration of the call.
 using Sender = std::function<void(const uint8_t* data, size_t len)>;
 
+// Writes exactly the byte count it was announced with at `dst`, which points into the
+// connection's own outbound buffer. It runs under that buffer's lock, so anything it does
+// on the way -- encrypting a header with a stream cipher, say -- happens in wire order.
+// A plain function pointer and a context rather than a std::function: the send path is
+// per packet, and this must never allocate. `ctx` need only outlive the call.
+struct SendFill {
+    void (*fill)(void* ctx, uint8_t* dst);
+    void* ctx;
+};
+
+// Immutable bytes several connections' outbound queues may reference at once -- the
+// payload of a broadcast, which is identical for every recipient. Refcounted so the
+// last connection to write it out is the one that frees it.
+using SharedPayload = std::shared_ptr<const std::vector<uint8_t>>;
+
+// In-place counterpart of Sender: reserve `len` bytes at the tail of the outbound buffer
+// and have `fill` write them there, so a protocol can encode straight into the memory the
+// transport drains instead of building a copy first. A non-null `tail` follows those
+// bytes on the wire by reference, not by copy. Same lifetime rules as Sender.
+using InPlaceSender = std::function<void(size_t len, const SendFill& fill, const SharedPayload& tail)>;
+
 // Lets a session ask the transport to tear the connection down. No-op once gone.
 using Closer = std::function<void()>;
 
+// Runs a task on the thread that delivers this connection's onData(), in order with it,
+// so a session can finish work it handed elsewhere (an auth lookup, say) without any
+// locking against its own input path. Callable from any thread; the task is dropped,
+// unrun, once the connection is gone.
+using TaskPoster = std::function<void(std::function<void()> task)>;
+
 // Backpressure handle for bulk producers (realmd's patch stream): awaitWritable()
 // blocks until this connection's outbound backlog drains to at most
 // maxOutstandingBytes, or returns false once the connection is gone.
@@ -80,9 +107,19 @@ public:
     // Default: ignored (request/response sessions only ever use onData's return).
     virtual void setSender(Sender) {}
 
+    // Hands the session the in-place outbound channel (net thread, once, before
+    // onConnect), alongside the Sender. Default: ignored -- only a session whose
+    // framing is worth encoding in place (the world protocol) takes it.
+    virtual void setInPlaceSender(InPlaceSender) {}
+
     // Hands the session a way to request its own teardown (net thread, once).
     virtual void setCloser(Closer) {}
 
+    // Hands the session a way back onto its own net thread (net thread, once, before
+    // onConnect). Default: ignored -- only a session that waits on something slow
+    // without blocking the worker needs it.
+    virtual void setTaskPoster(TaskPoster) {}
+
     // Hands the session a backpressure handle for this connection (net thread,
     // once, before onConnect). Default: ignored — only bulk producers (the patch
     // stream) use it; request/response and world sessions never need to throttle.
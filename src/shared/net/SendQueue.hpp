@@ -40,8 +40,17 @@
 //
 // It lives in the per-connection SendChannel, a shared_ptr the session captures, so the
 // buffers outlive the socket and a parked producer cannot wake into freed memory.
+//
+// SHARED PAYLOADS are the one exception to "everything is copied in". A broadcast sends
+// the same bytes to every connection in range and only the encrypted header differs, so
+// appendInPlace() may take a refcounted payload as the tail of a packet. It is recorded
+// as a reference at its byte offset in m_pending rather than copied, and nextSpan() hands
+// it out as its own span when the cursor reaches that offset. The reference rides along
+// into the in-flight set, which keeps the payload alive -- and its storage put -- until
+// the socket has taken the last byte of it.
 
 #include "net/FlowControl.hpp"
+#include "net/ISession.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -80,6 +89,42 @@ public:
         return true;
     }
 
+    /// Producer (any thread): reserve `len` bytes at the tail of the pending buffer and
+    /// let `fill` write them in place, followed -- if `tail` is set -- by a reference
+    /// to the shared payload `tail`. Same ownership contract as append().
+    ///
+    /// This is the encode-in-place path: the producer serialises straight into the
+    /// buffer the transport drains, so an outgoing packet is copied once, not built in
+    /// a scratch vector and then copied again. `fill` runs under the queue lock, which
+    /// also puts whatever it does in the exact order the bytes leave.
+    bool appendInPlace(size_t len, const SendFill& fill,
+                       const SharedPayload& tail = SharedPayload())
+    {
+        if (len == 0)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mu);
+        size_t const at = m_pending.size();
+        m_pending.resize(at + len);
+        fill.fill(fill.ctx, m_pending.data() + at);
+        m_gate.onQueued(len);
+
+        if (tail && !tail->empty())
+        {
+            m_pendingRefs.push_back(PayloadRef{ m_pending.size(), tail });
+            m_gate.onQueued(tail->size());
+        }
+
+        if (m_writing)
+        {
+            return false;
+        }
+        m_writing = true;
+        return true;
+    }
+
     /// Transport (the thread that owns the write): hand back the next contiguous
     /// span to write to the socket.
     ///
@@ -94,24 +139,39 @@ public:
     {
         std::lock_guard<std::mutex> lock(m_mu);
 
-        if (m_off == m_inflight.size())
+        if (inflightDrained())
         {
             // Fully drained: promote whatever accumulated while we were writing.
             // swap() keeps both buffers' capacity, so this never allocates once
-            // the connection has reached its steady state.
+            // the connection has reached its steady state. Clearing the old refs
+            // drops this connection's hold on every payload it has finished with.
             m_inflight.swap(m_pending);
             m_pending.clear();
-            m_off = 0;
+            m_inflightRefs.swap(m_pendingRefs);
+            m_pendingRefs.clear();
+            m_off    = 0;
+            m_ref    = 0;
+            m_refOff = 0;
         }
 
-        if (m_inflight.empty())
+        if (inflightDrained())
         {
             m_writing = false;
             return false;
         }
 
+        if (inRef())
+        {
+            const std::vector<uint8_t>& payload = *m_inflightRefs[m_ref].payload;
+            data = payload.data() + m_refOff;
+            len  = payload.size() - m_refOff;
+            return true;
+        }
+
+        // Own bytes up to the next shared payload, or to the end.
+        size_t const end = m_ref < m_inflightRefs.size() ? m_inflightRefs[m_ref].at : m_inflight.size();
         data = m_inflight.data() + m_off;
-        len  = m_inflight.size() - m_off;
+        len  = end - m_off;
         return true;
     }
 
@@ -121,7 +181,19 @@ public:
     void consume(size_t n)
     {
         std::lock_guard<std::mutex> lock(m_mu);
-        m_off += n;
+        if (inRef())
+        {
+            m_refOff += n;
+            if (m_refOff == m_inflightRefs[m_ref].payload->size())
+            {
+                ++m_ref;
+                m_refOff = 0;
+            }
+        }
+        else
+        {
+            m_off += n;
+        }
         m_gate.onSent(n);
     }
 
@@ -138,7 +210,7 @@ public:
     bool empty() const
     {
         std::lock_guard<std::mutex> lock(m_mu);
-        return m_off == m_inflight.size() && m_pending.empty();
+        return inflightDrained() && m_pending.empty();
     }
 
     /// Teardown: wake any producer parked on backpressure so it stops producing.
@@ -147,12 +219,33 @@ public:
     FlowGate& gate() { return m_gate; }
 
 private:
-    mutable std::mutex   m_mu;
-    std::vector<uint8_t> m_pending;        ///< producers append here
-    std::vector<uint8_t> m_inflight;       ///< the socket is draining this
-    size_t               m_off = 0;        ///< bytes of m_inflight already written
-    bool                 m_writing = false;///< a write is in flight (proactors)
-    FlowGate             m_gate;           ///< byte-counted backpressure
+    /// A shared payload spliced into the stream at byte offset `at` of its buffer.
+    struct PayloadRef {
+        size_t        at;
+        SharedPayload payload;
+    };
+
+    /// The cursor sits on a shared payload rather than on our own bytes.
+    bool inRef() const
+    {
+        return m_ref < m_inflightRefs.size() && m_off == m_inflightRefs[m_ref].at;
+    }
+
+    bool inflightDrained() const
+    {
+        return m_off == m_inflight.size() && m_ref == m_inflightRefs.size();
+    }
+
+    mutable std::mutex      m_mu;
+    std::vector<uint8_t>    m_pending;        ///< producers append here
+    std::vector<uint8_t>    m_inflight;       ///< the socket is draining this
+    std::vector<PayloadRef> m_pendingRefs;    ///< shared payloads within m_pending
+    std::vector<PayloadRef> m_inflightRefs;   ///< shared payloads within m_inflight
+    size_t                  m_off = 0;        ///< bytes of m_inflight already written
+    size_t                  m_ref = 0;        ///< next unfinished entry of m_inflightRefs
+    size_t                  m_refOff = 0;     ///< bytes of that payload already written
+    bool                    m_writing = false;///< a write is in flight (proactors)
+    FlowGate                m_gate;           ///< byte-counted backpressure
 };
 
 } // namespace net
@@ -30,7 +30,8 @@
 // mints one ISession per accepted connection.
 //
 //   Windows                     -> IocpServer    (proactor, I/O completion ports)
-//   Linux + MANGOS_USE_IO_URING -> UringServer   (proactor, io_uring)
+//   Linux + MANGOS_USE_IO_URING -> UringServer   (proactor, io_uring), or the epoll
+//                                  reactor if the kernel is older than 6.0
 //   Linux (default)             -> ReactorServer (readiness, epoll)
 //   BSD / macOS                 -> ReactorServer (readiness, kqueue)
 //
@@ -48,9 +49,42 @@ namespace net { using Server = IocpServer; }
 
 #elif defined(MANGOS_USE_IO_URING)
 
+#include "net/reactor/Poller.hpp"
+#include "net/reactor/ReactorServer.hpp"
 #include "net/uring/UringServer.hpp"
+#include "Log.h"
+
+#include <cstdint>
+#include <string>
+
+namespace net {
+
+// io_uring when the running kernel can do what UringServer needs, the epoll reactor
+// when it cannot. The binary is built against liburing, but the kernel it lands on
+// is only known at start(), and a too-old one should cost the faster backend, not
+// the listener.
+class Server {
+public:
+    bool start(uint16_t port, SessionFactory factory,
+               const std::string& bindIp = std::string()) {
+        if (m_uring.start(port, factory, bindIp)) return true;
+        sLog.outError("WorldSocket: the io_uring backend did not start on port %u; trying the epoll reactor",
+                      (unsigned)port);
+        m_usingReactor = true;
+        return m_reactor.start(port, std::move(factory), bindIp);
+    }
+    void stop() {
+        if (m_usingReactor) m_reactor.stop();
+        else                m_uring.stop();
+    }
 
-namespace net { using Server = UringServer; }
+private:
+    UringServer   m_uring;
+    ReactorServer m_reactor{ &makePoller };
+    bool          m_usingReactor = false;
+};
+
+} // namespace net
 
 #else
 
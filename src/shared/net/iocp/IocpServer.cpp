@@ -49,6 +49,12 @@ void SendChannel::post(const uint8_t* data, size_t len) {
         ctx->enqueue(data, len);
 }
 
+void SendChannel::postInPlace(size_t len, const SendFill& fill, const SharedPayload& tail) {
+    std::lock_guard<std::mutex> lock(mu);
+    if (ctx)
+        ctx->enqueueInPlace(len, fill, tail);
+}
+
 // The session asked to close. Do NOT close the socket here.
 //
 // Closing it discards whatever is still queued, and what is queued at this exact
@@ -77,6 +83,35 @@ void SendChannel::requestClose() {
     }
 }
 
+// IOCP has no owning thread to hand the task to -- completions land on any worker -- so
+// it runs right here, under the per-ctx callback lock every completion takes. That is
+// the same ordering guarantee onData itself gets.
+void SendChannel::postTask(std::function<void()> task) {
+    ConnCtx* c = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        c = ctx;
+        if (!c)
+        {
+            return;
+        }
+        c->addRef();  // armed means the alive ref is still held; keep it across the gap
+    }
+
+    {
+        std::lock_guard<std::mutex> cbLock(c->cb);
+        if (!c->dead.load(std::memory_order_acquire))
+        {
+            c->dispatching.store(true, std::memory_order_release);
+            task();
+            c->dispatching.store(false, std::memory_order_release);
+            c->closeIfDrained();
+        }
+    }
+
+    c->release();
+}
+
 void SendChannel::disarm() {
     std::lock_guard<std::mutex> lock(mu);
     ctx = nullptr;
@@ -119,6 +154,11 @@ void ConnCtx::enqueue(const uint8_t* data, size_t len) {
         startSend();
 }
 
+void ConnCtx::enqueueInPlace(size_t len, const SendFill& fill, const SharedPayload& tail) {
+    if (channel && channel->out.appendInPlace(len, fill, tail))
+        startSend();
+}
+
 void ConnCtx::startSend() {
     const uint8_t* data = nullptr;
     size_t         len  = 0;
@@ -535,7 +575,11 @@ void IocpServer::handleAccept(AcceptOv* aov, DWORD /*bytes*/) {
     ctx->channel->ctx = ctx;
     ctx->session->setSender(
         [ch = ctx->channel](const uint8_t* d, size_t n) { ch->post(d, n); });
+    ctx->session->setInPlaceSender(
+        [ch = ctx->channel](size_t n, const SendFill& f, const SharedPayload& t) { ch->postInPlace(n, f, t); });
     ctx->session->setCloser([ch = ctx->channel] { ch->requestClose(); });
+    ctx->session->setTaskPoster(
+        [ch = ctx->channel](std::function<void()> t) { ch->postTask(std::move(t)); });
     ctx->session->setFlowControl(
         std::shared_ptr<net::FlowControl>(ctx->channel, &ctx->channel->out.gate()));
 
@@ -47,6 +47,7 @@
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -120,7 +121,9 @@ struct SendChannel {
     bool closeRequested = false;
 
     void post(const uint8_t* data, size_t len);  // append + kick a write while armed
+    void postInPlace(size_t len, const SendFill& fill, const SharedPayload& tail);  // same, encoding in place
     void requestClose();                   // drain, then close
+    void postTask(std::function<void()> task);  // run, serialised with callbacks
     void disarm();                         // detach from the ctx, forever
 };
 
@@ -194,6 +197,8 @@ struct ConnCtx {
     // Append bytes to the outbound buffer and start a write if none is in flight.
     // Thread-safe; callable from any thread.
     void enqueue(const uint8_t* data, size_t len);
+    // The same, but `fill` writes the bytes straight into the outbound buffer.
+    void enqueueInPlace(size_t len, const SendFill& fill, const SharedPayload& tail);
     // Post the next contiguous span from the SendQueue, if any. Exactly one write is
     // ever in flight, which is what keeps the byte stream ordered.
     void startSend();
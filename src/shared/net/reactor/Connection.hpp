@@ -29,20 +29,23 @@
 #include "net/SendQueue.hpp"
 #include "net/reactor/Poller.hpp"
 
+#include <atomic>
 #include <cstdint>
-#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace net {
 
 struct Connection;
+class ReadyList;
 
 // Lifetime-safe bridge that lets the world thread send to / close a connection
 // that is otherwise owned end-to-end by one worker thread. The session captures
 // this (shared_ptr) as its Sender/Closer. post()/requestClose() run on the world
-// thread; they append bytes (or set a close flag) and hand the channel to the
-// owning worker's request queue, then wake its poller. The worker drains the queue
+// thread; they append bytes (or set a close flag) and put the channel on the
+// owning worker's ReadyList, waking its poller if the list was empty. The worker drains the queue
 // on its own thread, where touching the Connection is race-free. Once the worker
 // tears the connection down it calls disarm(), after which every later
 // post()/requestClose() is a no-op — so a freed Connection is never read.
@@ -55,27 +58,76 @@ struct Connection;
 // FlowGate outlive the socket, so a bulk producer parked on backpressure is always
 // woken into live memory.
 //
-// The reqMu/reqQueue/poller pointers alias the owning Worker's members; they
-// stay valid because workers are shut down only after every connection is gone
-// (and the world loop is stopped before the network layer at shutdown).
+// A channel sits on its worker's ready list at most once between drains
+// (notifyQueued): a tick that sends a connection forty packets costs one list
+// entry, and at most one wake, not forty entries the worker would flush in vain.
+// While listed, the channel holds a reference to itself (queuedSelf), so a
+// session dropped in the meantime cannot free it out from under the worker.
+//
+// The ready/poller pointers alias the owning Worker's members; they stay valid
+// because workers are shut down only after every connection is gone (and the
+// world loop is stopped before the network layer at shutdown).
 struct SendChannel : public std::enable_shared_from_this<SendChannel> {
     std::mutex  mu;
     bool        alive = true;
     Connection* conn  = nullptr;
     bool        closeRequested = false;
+    bool        notifyQueued   = false;     // already on the worker's ready list
+    std::shared_ptr<SendChannel> queuedSelf; // keeps a listed channel alive
+    SendChannel* readyNext = nullptr;       // ReadyList link
     SendQueue   out;                        // coalescing buffer + byte backpressure
+    std::vector<std::function<void()>> tasks; // to run on the worker (postTask)
 
     // Owning worker's wake plumbing (set at hand-off; valid while alive).
-    std::mutex*                                 reqMu    = nullptr;
-    std::deque<std::shared_ptr<SendChannel>>*   reqQueue = nullptr;
-    Poller*                                     poller   = nullptr;
+    ReadyList*  ready  = nullptr;
+    Poller*     poller = nullptr;
 
     void post(const uint8_t* data, size_t len);  // world thread
+    void postInPlace(size_t len, const SendFill& fill, const SharedPayload& tail);  // world thread
     void requestClose();                         // world thread
+    void postTask(std::function<void()> task);   // any thread
     void disarm();                               // worker thread
 
 private:
-    void notifyWorker();                    // enqueue self + wake the worker
+    bool schedule();                        // mu held: claim the one list entry
+    void notifyWorker();                    // list self + wake the worker if needed
+};
+
+// The channels with work for one worker: a lock-free multi-producer,
+// single-consumer list threaded through SendChannel::readyNext. Every map thread
+// flushing updates posts here at once, so a mutex would have them queue on each
+// other; a push is one CAS on the head instead. The worker takes the whole list
+// in one exchange.
+//
+// push() reports whether the list was empty. Only that producer wakes the
+// worker: any later push lands before the worker's next takeAll(), which that
+// wake is already due to trigger.
+class ReadyList {
+public:
+    bool push(SendChannel* ch) {
+        SendChannel* head = m_head.load(std::memory_order_relaxed);
+        do {
+            ch->readyNext = head;
+        } while (!m_head.compare_exchange_weak(head, ch, std::memory_order_release,
+                                               std::memory_order_relaxed));
+        return head == nullptr;
+    }
+
+    // Everything pushed so far, oldest first. Worker thread only.
+    SendChannel* takeAll() {
+        SendChannel* lifo = m_head.exchange(nullptr, std::memory_order_acquire);
+        SendChannel* fifo = nullptr;
+        while (lifo) {
+            SendChannel* next = lifo->readyNext;
+            lifo->readyNext = fifo;
+            fifo = lifo;
+            lifo = next;
+        }
+        return fifo;
+    }
+
+private:
+    std::atomic<SendChannel*> m_head{nullptr};
 };
 
 // Passive per-connection state. A Connection is owned end-to-end by exactly one
@@ -44,7 +44,6 @@
 #include <cerrno>
 #include <utility>
 #include <cstdint>
-#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -155,6 +154,16 @@ void ReactorServer::stop() {
             delete c;
         }
         w->incoming.clear();
+
+        // Every channel is disarmed by now, so nothing lists itself again; release
+        // the self-references of those still listed, or they would never be freed.
+        SendChannel* next = nullptr;
+        for (SendChannel* listed = w->ready.takeAll(); listed; listed = next) {
+            next = listed->readyNext;
+            std::shared_ptr<SendChannel> dropped;
+            std::lock_guard<std::mutex> lock(listed->mu);
+            dropped.swap(listed->queuedSelf);
+        }
         if (w->poller) w->poller->shutdown();
     }
     m_workers.clear();
@@ -201,16 +210,19 @@ void ReactorServer::acceptLoop() {
                 // Pick the owning worker up front so the SendChannel can target
                 // it before the session (in onConnect) registers with the world
                 // loop and could be ticked. The Worker lives in a unique_ptr, so
-                // its address (and its reqMu/reqQueue/poller) is stable.
+                // its address (and its ready list and poller) is stable.
                 Worker& w = *m_workers[m_rr.fetch_add(1) % m_workers.size()];
                 conn->channel = std::make_shared<SendChannel>();
                 conn->channel->conn     = conn;
-                conn->channel->reqMu    = &w.reqMu;
-                conn->channel->reqQueue = &w.reqQueue;
+                conn->channel->ready    = &w.ready;
                 conn->channel->poller   = w.poller.get();
                 conn->session->setSender(
                     [ch = conn->channel](const uint8_t* d, size_t n) { ch->post(d, n); });
+                conn->session->setInPlaceSender(
+                    [ch = conn->channel](size_t n, const SendFill& f, const SharedPayload& t) { ch->postInPlace(n, f, t); });
                 conn->session->setCloser([ch = conn->channel] { ch->requestClose(); });
+                conn->session->setTaskPoster(
+                    [ch = conn->channel](std::function<void()> t) { ch->postTask(std::move(t)); });
                 conn->session->setFlowControl(
                     std::shared_ptr<net::FlowControl>(conn->channel, &conn->channel->out.gate()));
 
@@ -238,14 +250,18 @@ void ReactorServer::handoff(Worker& w, Connection* conn) {
 
 // ── SendChannel (cross-thread send / close) ───────────────────────────────────
 
+bool SendChannel::schedule() {
+    if (notifyQueued) return false;  // the worker is already due to flush this channel
+    notifyQueued = true;
+    queuedSelf   = shared_from_this();
+    return true;
+}
+
 void SendChannel::notifyWorker() {
-    // mu must NOT be held here. reqMu/reqQueue/poller are set once at hand-off and
-    // the worker outlives every connection, so they are safe to touch unlocked.
-    {
-        std::lock_guard<std::mutex> lock(*reqMu);
-        reqQueue->push_back(shared_from_this());
-    }
-    poller->wake();
+    // mu must NOT be held here. ready/poller are set once at hand-off and the
+    // worker outlives every connection, so they are safe to touch unlocked.
+    if (ready->push(this))
+        poller->wake();
 }
 
 void SendChannel::post(const uint8_t* data, size_t len) {
@@ -257,6 +273,18 @@ void SendChannel::post(const uint8_t* data, size_t len) {
         // hand-off, so a producer cannot outrun a lagging worker. The worker drains
         // the very same buffer — no second hand-off, no per-packet allocation.
         out.append(data, len);
+        if (!schedule()) return;
+    }
+    notifyWorker();
+}
+
+void SendChannel::postInPlace(size_t len, const SendFill& fill, const SharedPayload& tail) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        // As post(), but the producer encodes straight into the outbound buffer.
+        out.appendInPlace(len, fill, tail);
+        if (!schedule()) return;
     }
     notifyWorker();
 }
@@ -266,15 +294,32 @@ void SendChannel::requestClose() {
         std::lock_guard<std::mutex> lock(mu);
         if (!alive) return;
         closeRequested = true;
+        if (!schedule()) return;
+    }
+    notifyWorker();
+}
+
+void SendChannel::postTask(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        tasks.push_back(std::move(task));
+        if (!schedule()) return;
     }
     notifyWorker();
 }
 
 void SendChannel::disarm() {
-    std::lock_guard<std::mutex> lock(mu);
-    alive = false;
-    conn  = nullptr;
-    out.close();  // release any bulk producer parked on backpressure
+    // Unrun tasks typically hold the session, which holds this channel: drop them,
+    // outside the lock, or the pair would keep each other alive for good.
+    std::vector<std::function<void()>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        alive = false;
+        conn  = nullptr;
+        dropped.swap(tasks);
+        out.close();  // release any bulk producer parked on backpressure
+    }
 }
 
 void ReactorServer::drainIncoming(Worker& w) {
@@ -332,24 +377,36 @@ bool ReactorServer::flush(Worker& w, Connection* conn) {
 
 // Runs on the worker thread: apply the sends/closes the world thread queued.
 void ReactorServer::drainSendRequests(Worker& w) {
-    std::deque<std::shared_ptr<SendChannel>> reqs;
-    {
-        std::lock_guard<std::mutex> lock(w.reqMu);
-        reqs.swap(w.reqQueue);
-    }
-    for (auto& ch : reqs) {
+    SendChannel* next = nullptr;
+    for (SendChannel* listed = w.ready.takeAll(); listed; listed = next) {
+        // Read the link before notifyQueued drops: from then on a producer may
+        // list the channel again, which rewrites it.
+        next = listed->readyNext;
+
+        std::shared_ptr<SendChannel> ch;
         Connection* conn = nullptr;
         bool        wantClose = false;
+        std::vector<std::function<void()>> tasks;
         {
-            std::lock_guard<std::mutex> lock(ch->mu);
+            std::lock_guard<std::mutex> lock(listed->mu);
+            ch.swap(listed->queuedSelf);  // ours until the end of this pass
+            ch->notifyQueued = false;     // later posts must list it again
             if (!ch->alive)
                 continue;  // connection already torn down; channel kept alive only by us
             conn      = ch->conn;
             wantClose = ch->closeRequested;
+            tasks.swap(ch->tasks);
         }
         if (!conn)
             continue;
 
+        // Work the session handed back to its own thread. It runs here, between
+        // reads, exactly as onData would -- and may send, or close, like onData.
+        for (auto& task : tasks)
+            task();
+        if (!tasks.empty() && conn->session->closed())
+            conn->closeAfterDrain = true;
+
         // The bytes are already in conn->channel->out — post() appended them there
         // directly, so there is nothing to move across; just push them at the socket.
         if (!flush(w, conn)) {
@@ -38,7 +38,6 @@
 #include <thread>
 #include <unordered_set>
 #include <vector>
-#include <deque>
 
 namespace net {
 
@@ -69,10 +68,9 @@ private:
         std::vector<Connection*>        incoming; // handed off by the acceptor
         std::unordered_set<Connection*> conns;    // owned by this thread
 
-        // Cross-thread send/close requests posted by the world thread via a
-        // connection's SendChannel; drained on this worker's own thread.
-        std::mutex                                reqMu;
-        std::deque<std::shared_ptr<SendChannel>>  reqQueue;
+        // Channels the world thread posted sends/closes to; drained on this
+        // worker's own thread.
+        ReadyList                       ready;
     };
 
     PollerFactory             m_pollerFactory;
@@ -38,6 +38,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/eventfd.h>
+#include <sys/resource.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -47,6 +48,7 @@
 #include <cstdint>
 #include <utility>
 #include <deque>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -68,6 +70,16 @@ io_uring_sqe* UringServer::getSqe(io_uring* ring) {
     return sqe;
 }
 
+// The descriptor an SQE names: the registered slot when the connection has one,
+// in which case the SQE must also carry IOSQE_FIXED_FILE.
+static int sqeFd(const UringConn* conn) {
+    return conn->fixedSlot >= 0 ? conn->fixedSlot : conn->fd;
+}
+
+static unsigned sqeFileFlags(const UringConn* conn) {
+    return conn->fixedSlot >= 0 ? IOSQE_FIXED_FILE : 0;
+}
+
 UringServer::~UringServer() { stop(); }
 
 bool UringServer::start(uint16_t port, SessionFactory factory,
@@ -103,14 +115,23 @@ bool UringServer::start(uint16_t port, SessionFactory factory,
 
     for (unsigned i = 0; i < nWorkers; ++i) {
         auto w = std::make_unique<Worker>();
-        if (io_uring_queue_init(RING_ENTRIES, &w->ring, 0) < 0) { stop(); return false; }
         w->evfd = ::eventfd(0, EFD_CLOEXEC);
-        if (w->evfd < 0) { io_uring_queue_exit(&w->ring); stop(); return false; }
+        if (w->evfd < 0) { stop(); return false; }
         m_workers.push_back(std::move(w));
     }
 
-    for (auto& w : m_workers)
+    // Each worker builds its own ring (see setupRing), so wait for all of them to
+    // report before accepting: a kernel too old for it fails the start here, and
+    // net::Server moves on to the epoll reactor.
+    std::vector<std::future<bool>> ready;
+    for (auto& w : m_workers) {
+        ready.push_back(w->ready.get_future());
         w->thread = std::thread([this, wp = w.get()] { workerLoop(*wp); });
+    }
+    bool ringsUp = true;
+    for (auto& r : ready)
+        ringsUp = r.get() && ringsUp;
+    if (!ringsUp) { stop(); return false; }
 
     m_acceptThread = std::thread([this] { acceptLoop(); });
 
@@ -137,10 +158,9 @@ void UringServer::stop() {
     for (auto& w : m_workers)
         if (w->thread.joinable()) w->thread.join();
 
-    // Workers leave their connections allocated; tear down the ring FIRST so the
-    // kernel stops referencing any in-flight recv/send buffers, THEN free.
+    // Workers leave their connections allocated, but each tore its ring down on the
+    // way out, so the kernel no longer references any in-flight buffer: free them.
     for (auto& w : m_workers) {
-        io_uring_queue_exit(&w->ring);
         // disarm() first so a bulk producer parked on backpressure (patch stream)
         // wakes and stops instead of blocking forever / posting into a freed conn.
         for (auto* c : w->conns)    { if (c->channel) c->channel->disarm(); ::close(c->fd); delete c; }
@@ -189,7 +209,11 @@ void UringServer::acceptLoop() {
         conn->channel->evfd     = w.evfd;
         conn->session->setSender(
             [ch = conn->channel](const uint8_t* d, size_t n) { ch->post(d, n); });
+        conn->session->setInPlaceSender(
+            [ch = conn->channel](size_t n, const SendFill& f, const SharedPayload& t) { ch->postInPlace(n, f, t); });
         conn->session->setCloser([ch = conn->channel] { ch->requestClose(); });
+        conn->session->setTaskPoster(
+            [ch = conn->channel](std::function<void()> t) { ch->postTask(std::move(t)); });
         conn->session->setFlowControl(
             std::shared_ptr<net::FlowControl>(conn->channel, &conn->channel->out.gate()));
 
@@ -235,6 +259,20 @@ void UringSendChannel::post(const uint8_t* data, size_t len) {
         // its SQEs out of the very same buffer — no second hand-off, no per-packet
         // allocation.
         out.append(data, len);
+        if (notifyQueued) return;  // the worker is already due to flush this channel
+        notifyQueued = true;
+    }
+    notifyWorker();
+}
+
+void UringSendChannel::postInPlace(size_t len, const SendFill& fill, const SharedPayload& tail) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        // As post(), but the producer encodes straight into the outbound buffer.
+        out.appendInPlace(len, fill, tail);
+        if (notifyQueued) return;
+        notifyQueued = true;
     }
     notifyWorker();
 }
@@ -244,15 +282,34 @@ void UringSendChannel::requestClose() {
         std::lock_guard<std::mutex> lock(mu);
         if (!alive) return;
         closeRequested = true;
+        if (notifyQueued) return;
+        notifyQueued = true;
+    }
+    notifyWorker();
+}
+
+void UringSendChannel::postTask(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        tasks.push_back(std::move(task));
+        if (notifyQueued) return;
+        notifyQueued = true;
     }
     notifyWorker();
 }
 
 void UringSendChannel::disarm() {
-    std::lock_guard<std::mutex> lock(mu);
-    alive = false;
-    conn  = nullptr;
-    out.close();  // release any bulk producer parked on backpressure
+    // Unrun tasks typically hold the session, which holds this channel: drop them,
+    // outside the lock, or the pair would keep each other alive for good.
+    std::vector<std::function<void()>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        alive = false;
+        conn  = nullptr;
+        dropped.swap(tasks);
+        out.close();  // release any bulk producer parked on backpressure
+    }
 }
 
 void UringServer::drainIncoming(Worker& w) {
@@ -263,6 +320,13 @@ void UringServer::drainIncoming(Worker& w) {
     }
     for (auto* conn : pending) {
         w.conns.insert(conn);
+        // A registered file spares the kernel an fd-table lookup and a file
+        // reference on every SQE for this connection.
+        if (!w.freeSlots.empty() &&
+            io_uring_register_files_update(&w.ring, unsigned(w.freeSlots.back()), &conn->fd, 1) == 1) {
+            conn->fixedSlot = w.freeSlots.back();
+            w.freeSlots.pop_back();
+        }
         // Full-duplex: keep a recv pending so reads/closes are always noticed, and
         // also kick a send if onConnect() queued a greeting.
         submitRecv(w, conn);
@@ -281,16 +345,26 @@ void UringServer::drainSendRequests(Worker& w) {
     for (auto& ch : reqs) {
         UringConn* conn = nullptr;
         bool       wantClose = false;
+        std::vector<std::function<void()>> tasks;
         {
             std::lock_guard<std::mutex> lock(ch->mu);
+            ch->notifyQueued = false;  // later posts must wake us again
             if (!ch->alive)
                 continue;
             conn      = ch->conn;
             wantClose = ch->closeRequested;
+            tasks.swap(ch->tasks);
         }
         if (!conn || conn->dead)
             continue;
 
+        // Work the session handed back to its own thread. It runs here, between
+        // recv completions, exactly as onData would -- and may send, or close.
+        for (auto& task : tasks)
+            task();
+        if (!tasks.empty() && conn->session->closed())
+            conn->closeAfterDrain = true;
+
         // The bytes are already in ch->out — post() appended them there directly, so
         // there is nothing to move across; just get a write going.
         if (wantClose)
@@ -309,7 +383,11 @@ void UringServer::submitRecv(Worker& w, UringConn* conn) {
     if (conn->dead || conn->recvInFlight) return;
     io_uring_sqe* sqe = getSqe(&w.ring);
     if (!sqe) return;
-    io_uring_prep_recv(sqe, conn->fd, conn->recvBuf, sizeof(conn->recvBuf), 0);
+    // One SQE keeps delivering until the socket closes, errors or the buffer ring
+    // runs dry; each completion carries the id of the provided buffer it filled.
+    io_uring_prep_recv_multishot(sqe, sqeFd(conn), nullptr, 0, 0);
+    io_uring_sqe_set_flags(sqe, IOSQE_BUFFER_SELECT | sqeFileFlags(conn));
+    sqe->buf_group = BUF_GROUP;
     io_uring_sqe_set_data64(sqe, reinterpret_cast<uint64_t>(conn) | OP_RECV);
     conn->recvInFlight = true;
     ++conn->inflight;
@@ -328,7 +406,8 @@ void UringServer::submitSend(Worker& w, UringConn* conn) {
 
     io_uring_sqe* sqe = getSqe(&w.ring);
     if (!sqe) { conn->channel->out.abortWrite(); return; }
-    io_uring_prep_send(sqe, conn->fd, data, len, MSG_NOSIGNAL);
+    io_uring_prep_send(sqe, sqeFd(conn), data, len, MSG_NOSIGNAL);
+    io_uring_sqe_set_flags(sqe, sqeFileFlags(conn));
     io_uring_sqe_set_data64(sqe, reinterpret_cast<uint64_t>(conn) | OP_SEND);
     conn->sendInFlight = true;
     ++conn->inflight;
@@ -341,6 +420,14 @@ void UringServer::submitWakeRead(Worker& w) {
     io_uring_sqe_set_data64(sqe, WAKE_DATA);
 }
 
+void UringServer::recycleBuffer(Worker& w, unsigned bid) {
+    // Queued only; workerLoop publishes the whole reap's worth in one advance.
+    io_uring_buf_ring_add(w.bufRing, w.bufMem.get() + size_t(bid) * RECV_BUFFER_SIZE,
+                          RECV_BUFFER_SIZE, static_cast<unsigned short>(bid),
+                          io_uring_buf_ring_mask(RECV_BUFFERS), int(w.bufsRecycled));
+    ++w.bufsRecycled;
+}
+
 void UringServer::markDead(UringConn* conn) {
     if (conn->dead) return;
     conn->dead = true;
@@ -352,6 +439,11 @@ void UringServer::markDead(UringConn* conn) {
 void UringServer::maybeFree(Worker& w, UringConn* conn) {
     if (!conn->dead || conn->inflight != 0) return;
     w.conns.erase(conn);
+    if (conn->fixedSlot >= 0) {
+        int none = -1;
+        io_uring_register_files_update(&w.ring, unsigned(conn->fixedSlot), &none, 1);
+        w.freeSlots.push_back(conn->fixedSlot);
+    }
     ::close(conn->fd);
     delete conn;
 }
@@ -371,29 +463,42 @@ bool UringServer::handleCqe(Worker& w, io_uring_cqe* cqe) {
     const uint64_t tag  = data & OP_MASK;
 
     if (tag == OP_RECV) {
-        conn->recvInFlight = false;
-        --conn->inflight;
-
-        if (res <= 0) {
-            markDead(conn);            // 0 = peer closed; <0 = error/cancelled
-        } else {
-            auto resp = conn->session->onData(conn->recvBuf, static_cast<size_t>(res));
-            if (!resp.empty())
-                conn->channel->out.append(resp.data(), resp.size());
-
-            // A session that closes having just queued its final bytes (an auth
-            // rejection, say) must still get them out, so only tear down once the
-            // outbound buffer has drained; otherwise let the send completion do it.
-            if (conn->session->closed()) {
-                if (conn->channel->out.empty())
-                    markDead(conn);
-                else
-                    conn->closeAfterDrain = true;
-            }
-            if (!conn->dead) {
-                submitRecv(w, conn);             // keep reading
-                submitSend(w, conn);             // flush any reply/queued bytes
+        if (cqe->flags & IORING_CQE_F_BUFFER) {
+            const unsigned bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+            // A dead connection may still have data completions queued behind the
+            // shutdown; their buffers go straight back.
+            if (res > 0 && !conn->dead) {
+                const uint8_t* buf = w.bufMem.get() + size_t(bid) * RECV_BUFFER_SIZE;
+                auto resp = conn->session->onData(buf, static_cast<size_t>(res));
+                if (!resp.empty())
+                    conn->channel->out.append(resp.data(), resp.size());
+
+                // A session that closes having just queued its final bytes (an auth
+                // rejection, say) must still get them out, so only tear down once the
+                // outbound buffer has drained; otherwise let the send completion do it.
+                if (conn->session->closed()) {
+                    if (conn->channel->out.empty())
+                        markDead(conn);
+                    else
+                        conn->closeAfterDrain = true;
+                }
+                if (!conn->dead)
+                    submitSend(w, conn);         // flush any reply/queued bytes
             }
+            recycleBuffer(w, bid);               // onData is done with it
+        }
+
+        // Without F_MORE the multishot has ended. -ENOBUFS only means the ring ran
+        // dry for a moment -- this reap's recycled buffers are published before the
+        // next submit -- so re-arm, as after a data completion; 0 (peer closed) and
+        // any other error end the connection.
+        if (!(cqe->flags & IORING_CQE_F_MORE)) {
+            conn->recvInFlight = false;
+            --conn->inflight;
+            if (res > 0 || res == -ENOBUFS)
+                submitRecv(w, conn);
+            else
+                markDead(conn);
         }
         maybeFree(w, conn);
         return false;
@@ -422,12 +527,82 @@ bool UringServer::handleCqe(Worker& w, io_uring_cqe* cqe) {
     return false;
 }
 
+bool UringServer::setupRing(Worker& w) {
+    // SINGLE_ISSUER with DEFER_TASKRUN: completions are processed only when this
+    // thread waits for them, in one batch, rather than interrupting it as each
+    // one lands. Only the thread that creates the ring may submit to it, which is
+    // why the ring is created here and not in start().
+    //
+    // Both are optimisations, not requirements, so a kernel that rejects them gets
+    // a plainer ring rather than a failed start: DEFER_TASKRUN is 6.1, SINGLE_ISSUER
+    // 6.0. Below 6.0 there is no multishot recv either, which this backend cannot
+    // do without -- so that is where it gives up, and net::Server falls back to the
+    // epoll reactor.
+    static const unsigned LADDER[] = {
+        IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN,
+        IORING_SETUP_SINGLE_ISSUER,
+    };
+    int ret = -EINVAL;
+    for (unsigned flags : LADDER) {
+        io_uring_params params{};
+        params.flags = flags;
+        ret = io_uring_queue_init_params(RING_ENTRIES, &w.ring, &params);
+        if (ret != -EINVAL) break;
+    }
+    if (ret < 0) {
+        sLog.outError("WorldSocket: io_uring setup failed (%d); the io_uring backend needs Linux 6.0 or later", ret);
+        return false;
+    }
+    w.ringUp = true;
+
+    w.bufRing = io_uring_setup_buf_ring(&w.ring, RECV_BUFFERS, BUF_GROUP, 0, &ret);
+    if (!w.bufRing) {
+        sLog.outError("WorldSocket: could not register the io_uring receive buffer ring (%d)", ret);
+        return false;
+    }
+    w.bufMem.reset(new uint8_t[size_t(RECV_BUFFERS) * RECV_BUFFER_SIZE]);
+    for (unsigned bid = 0; bid < RECV_BUFFERS; ++bid)
+        recycleBuffer(w, bid);
+    io_uring_buf_ring_advance(w.bufRing, int(w.bufsRecycled));
+    w.bufsRecycled = 0;
+
+    // The kernel refuses a file table larger than RLIMIT_NOFILE. Without one the
+    // connections just name their plain fds.
+    unsigned slots = FILE_SLOTS;
+    rlimit nofile{};
+    if (::getrlimit(RLIMIT_NOFILE, &nofile) == 0 && nofile.rlim_cur < slots)
+        slots = unsigned(nofile.rlim_cur);
+    if (slots && io_uring_register_files_sparse(&w.ring, slots) == 0) {
+        w.freeSlots.reserve(slots);
+        for (unsigned i = slots; i-- > 0;)
+            w.freeSlots.push_back(int(i));   // lowest slot handed out first
+    }
+    return true;
+}
+
+void UringServer::teardownRing(Worker& w) {
+    if (!w.ringUp) return;
+    if (w.bufRing)
+        io_uring_free_buf_ring(&w.ring, w.bufRing, RECV_BUFFERS, BUF_GROUP);
+    w.bufRing = nullptr;
+    w.freeSlots.clear();
+    io_uring_queue_exit(&w.ring);   // also drops the registered files
+    w.ringUp = false;
+}
+
 void UringServer::workerLoop(Worker& w) {
+    const bool up = setupRing(w);
+    if (!up) teardownRing(w);
+    w.ready.set_value(up);
+    if (!up) return;
+
     submitWakeRead(w);
     io_uring_submit(&w.ring);
 
     bool stopping = false;
     while (!stopping) {
+        // Every SQE queued while handling the previous batch -- re-armed recvs,
+        // sends, the wake read -- goes to the kernel in this one call.
         int ret = io_uring_submit_and_wait(&w.ring, 1);
         if (ret < 0 && ret == -EINTR) continue;
 
@@ -438,10 +613,14 @@ void UringServer::workerLoop(Worker& w) {
             if (handleCqe(w, cqe)) stopping = true;
             ++count;
         }
-        io_uring_cq_advance(&w.ring, count);
+        // Retire the batch and hand its receive buffers back in one step, before
+        // anything re-armed above is submitted.
+        io_uring_buf_ring_cq_advance(&w.ring, w.bufRing, int(w.bufsRecycled), count);
+        w.bufsRecycled = 0;
     }
-    // Connections are freed in stop(), after io_uring_queue_exit() guarantees the
-    // kernel no longer touches their buffers.
+    // Connections are freed in stop(); the ring goes first so the kernel no longer
+    // touches their buffers by then.
+    teardownRing(w);
 }
 
 } // namespace net
@@ -42,6 +42,8 @@
 #include <atomic>
 #include <cstdint>
 #include <deque>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -69,14 +71,18 @@ struct UringSendChannel : public std::enable_shared_from_this<UringSendChannel>
     bool        alive = true;
     UringConn*  conn  = nullptr;
     bool        closeRequested = false;
+    bool        notifyQueued   = false;     // already on the worker's request queue
     SendQueue   out;                        // coalescing buffer + byte backpressure
+    std::vector<std::function<void()>> tasks; // to run on the worker (postTask)
 
     std::mutex*                                    reqMu    = nullptr;
     std::deque<std::shared_ptr<UringSendChannel>>* reqQueue = nullptr;
     int                                            evfd     = -1;
 
     void post(const uint8_t* data, size_t len);  // world thread
+    void postInPlace(size_t len, const SendFill& fill, const SharedPayload& tail);  // world thread
     void requestClose();                         // world thread
+    void postTask(std::function<void()> task);   // any thread
     void disarm();                               // worker thread
 
 private:
@@ -89,24 +95,22 @@ private:
 // not only in reply to a read). Because two ops can reference a connection, we
 // reference-count in-flight ops (inflight) and free the connection only once it
 // is `dead` AND inflight == 0 — markDead() shuts the socket so pending ops drain.
+//
+// There is no receive buffer here. The recv is multishot and picks a buffer from
+// the worker's provided-buffer ring only when bytes actually arrive, so an idle
+// connection costs its bookkeeping and nothing more.
 struct UringConn {
     int      fd = -1;
+    int      fixedSlot = -1;        // registered-file slot, or -1 to name `fd` directly
     std::shared_ptr<ISession>        session;
     std::shared_ptr<UringSendChannel> channel;
-    // Kernel-filled: io_uring_prep_recv() writes it, and the completion handler
-    // reads back exactly the `res` bytes the kernel reported. Deliberately left
-    // uninitialised -- nothing reads it before recv fills it, and zeroing 8 KB per
-    // accepted connection would only enshrine the idea that its initial value means
-    // something. It does not.
-    uint8_t  recvBuf[8192];
-
-    bool     recvInFlight  = false;
+
+    bool     recvInFlight  = false; // the multishot recv is armed
     bool     sendInFlight  = false;
     int      inflight      = 0;     // submitted-but-not-completed ops
     bool     dead          = false; // teardown started; stop submitting new ops
     bool     closeAfterDrain = false;
 
-    // cppcheck-suppress uninitMemberVar ; recvBuf is a kernel-filled recv buffer, see above
     explicit UringConn(const SessionFactory& factory) : session(factory()) {}
 };
 
@@ -130,8 +134,25 @@ private:
 
     static constexpr unsigned RING_ENTRIES = 1024;
 
+    // Provided receive buffers, shared by every connection on a worker. The ring
+    // size must be a power of two; 512 x 4 KB is 2 MB per worker however many
+    // connections it holds, where a buffer per connection grew with each one.
+    static constexpr unsigned RECV_BUFFERS     = 512;
+    static constexpr unsigned RECV_BUFFER_SIZE = 4096;
+    static constexpr int      BUF_GROUP        = 0;
+
+    // Registered-file slots per worker, capped further by RLIMIT_NOFILE. A
+    // connection accepted with the table full just uses its plain fd.
+    static constexpr unsigned FILE_SLOTS = 16384;
+
     struct Worker {
         io_uring                          ring{};
+        bool                              ringUp = false;
+        io_uring_buf_ring*                bufRing = nullptr;
+        std::unique_ptr<uint8_t[]>        bufMem;       // RECV_BUFFERS x RECV_BUFFER_SIZE
+        unsigned                          bufsRecycled = 0; // re-added since the last advance
+        std::vector<int>                  freeSlots;    // unused registered-file slots
+        std::promise<bool>                ready;        // ring set up (or not) on its thread
         int                               evfd = -1;   // wakeup eventfd
         uint64_t                          evbuf = 0;   // read target for the eventfd
         std::thread                       thread;
@@ -154,6 +175,8 @@ private:
 
     void acceptLoop();
     void workerLoop(Worker& w);
+    bool setupRing(Worker& w);           // on the worker thread: it is the ring's sole issuer
+    void teardownRing(Worker& w);
     void handoff(Worker& w, UringConn* conn);
     void drainIncoming(Worker& w);
     void drainSendRequests(Worker& w);   // apply world-thread sends/closes
@@ -164,6 +187,7 @@ private:
     void submitRecv(Worker& w, UringConn* conn);
     void submitSend(Worker& w, UringConn* conn);
     void submitWakeRead(Worker& w);
+    void recycleBuffer(Worker& w, unsigned bid);
     void markDead(UringConn* conn);          // begin teardown (shutdown socket)
     void maybeFree(Worker& w, UringConn* conn);  // free once dead && no ops left
 
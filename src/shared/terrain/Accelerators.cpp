@@ -7,6 +7,13 @@
 #include <limits>
 #include <type_traits>
 
+// The packet walk is written against SSE, which every x86-64 target has; anywhere else
+// RaycastPacket falls back to one scalar walk per ray.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TERRAIN_PACKET_SSE 1
+#include <xmmintrin.h>
+#endif
+
 namespace world::terrain
 {
     namespace
@@ -32,6 +39,100 @@ namespace world::terrain
             const float dz = std::max(0.f, b.hi.z - b.lo.z);
             return 2.f * (dx * dy + dy * dz + dz * dx);
         }
+
+#ifdef TERRAIN_PACKET_SSE
+        // A packet's rays in structure-of-arrays form, one lane each, prepared exactly
+        // as Raycast prepares its one ray.
+        struct PacketRays
+        {
+            __m128 ox, oy, oz;
+            __m128 dx, dy, dz;
+            __m128 ix, iy, iz;
+        };
+
+        inline __m128 Select(__m128 mask, __m128 yes, __m128 no)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, yes), _mm_andnot_ps(mask, no));
+        }
+
+        inline __m128 Dot(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+        {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                              _mm_mul_ps(az, bz));
+        }
+
+        // Aabb::intersectsRay in all four lanes, each against its own best t: the lane
+        // bits of the rays that enter the box. The reciprocals come from the same
+        // clamp Raycast uses, so they are always finite and the non-finite branch the
+        // scalar test carries has nothing to do here.
+        inline int SlabHits(const Aabb& box, const PacketRays& r, __m128 best)
+        {
+            __m128 t0 = _mm_setzero_ps();
+            __m128 t1 = best;
+            auto axis = [&](float lo, float hi, __m128 o, __m128 inv)
+            {
+                const __m128 loa = _mm_set1_ps(lo - Aabb::kSlabEps);
+                const __m128 hia = _mm_set1_ps(hi + Aabb::kSlabEps);
+                const __m128 ta = _mm_mul_ps(_mm_sub_ps(loa, o), inv);
+                const __m128 tb = _mm_mul_ps(_mm_sub_ps(hia, o), inv);
+                t0 = _mm_max_ps(t0, _mm_min_ps(ta, tb));
+                t1 = _mm_min_ps(t1, _mm_max_ps(ta, tb));
+            };
+            axis(box.lo.x, box.hi.x, r.ox, r.ix);
+            axis(box.lo.y, box.hi.y, r.oy, r.iy);
+            axis(box.lo.z, box.hi.z, r.oz, r.iz);
+            return _mm_movemask_ps(_mm_cmple_ps(t0, t1));
+        }
+
+        // rayTri against one triangle in all four lanes, operation for operation, and
+        // Raycast's acceptance on top: a lane takes the hit only when it lies in
+        // [0, best). Returns the new best of every lane.
+        inline __m128 NearerHits(const Tri& tri, const PacketRays& r, __m128 best)
+        {
+            const Vec3 e1s = tri.b - tri.a;
+            const Vec3 e2s = tri.c - tri.a;
+            const __m128 e1x = _mm_set1_ps(e1s.x), e1y = _mm_set1_ps(e1s.y);
+            const __m128 e1z = _mm_set1_ps(e1s.z);
+            const __m128 e2x = _mm_set1_ps(e2s.x), e2y = _mm_set1_ps(e2s.y);
+            const __m128 e2z = _mm_set1_ps(e2s.z);
+
+            // p = cross(d, e2)
+            const __m128 px = _mm_sub_ps(_mm_mul_ps(r.dy, e2z), _mm_mul_ps(r.dz, e2y));
+            const __m128 py = _mm_sub_ps(_mm_mul_ps(r.dz, e2x), _mm_mul_ps(r.dx, e2z));
+            const __m128 pz = _mm_sub_ps(_mm_mul_ps(r.dx, e2y), _mm_mul_ps(r.dy, e2x));
+            const __m128 det = Dot(e1x, e1y, e1z, px, py, pz);
+
+            const __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.f), det);
+            __m128 ok = _mm_cmpge_ps(absDet, _mm_set1_ps(::Geometry::kRayTriEps));
+            const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+            const __m128 tvx = _mm_sub_ps(r.ox, _mm_set1_ps(tri.a.x));
+            const __m128 tvy = _mm_sub_ps(r.oy, _mm_set1_ps(tri.a.y));
+            const __m128 tvz = _mm_sub_ps(r.oz, _mm_set1_ps(tri.a.z));
+
+            const __m128 lowUV = _mm_set1_ps(-::Geometry::kRayTriUVEps);
+            const __m128 highUV = _mm_set1_ps(1.0f + ::Geometry::kRayTriUVEps);
+
+            const __m128 u = _mm_mul_ps(Dot(tvx, tvy, tvz, px, py, pz), invDet);
+            ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(u, lowUV), _mm_cmple_ps(u, highUV)));
+
+            // q = cross(tv, e1)
+            const __m128 qx = _mm_sub_ps(_mm_mul_ps(tvy, e1z), _mm_mul_ps(tvz, e1y));
+            const __m128 qy = _mm_sub_ps(_mm_mul_ps(tvz, e1x), _mm_mul_ps(tvx, e1z));
+            const __m128 qz = _mm_sub_ps(_mm_mul_ps(tvx, e1y), _mm_mul_ps(tvy, e1x));
+
+            const __m128 v = _mm_mul_ps(Dot(r.dx, r.dy, r.dz, qx, qy, qz), invDet);
+            ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(v, lowUV),
+                                           _mm_cmple_ps(_mm_add_ps(u, v), highUV)));
+
+            // rayTri's own "behind the origin" cut at -kEps is subsumed by t >= 0.
+            const __m128 t = _mm_mul_ps(Dot(e2x, e2y, e2z, qx, qy, qz), invDet);
+            ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(t, _mm_setzero_ps()),
+                                           _mm_cmplt_ps(t, best)));
+
+            return Select(ok, t, best);
+        }
+#endif
     }
 
     static_assert(std::is_trivially_copyable<Bvh::Node>::value,
@@ -50,7 +151,7 @@ namespace world::terrain
         return true;
     }
 
-    bool Bvh::Adopt(std::vector<Node> nodes, size_t triangleCount)
+    bool Bvh::Adopt(TileArray<Node> nodes, size_t triangleCount)
     {
         m_nodes.clear();
         m_maxDepth = 0;
@@ -67,9 +168,11 @@ namespace world::terrain
         std::vector<int> depth(nodes.size(), -1);
         depth[0] = 0;
 
-        for (size_t i = 0; i < nodes.size(); ++i)
+        // Read through a const reference: indexing a mapped array mutably would copy it.
+        const TileArray<Node>& in = nodes;
+        for (size_t i = 0; i < in.size(); ++i)
         {
-            const Node& node = nodes[i];
+            const Node& node = in[i];
             if (depth[i] < 0 || depth[i] > MAX_DEPTH)
             {
                 return false;                       // unreachable, or too deep to walk
@@ -313,6 +416,92 @@ namespace world::terrain
         return best;
     }
 
+    void Bvh::RaycastPacket(const TriSoup& soup, const Vec3* o, const Vec3* d, int count,
+                            float* best) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+        for (; count > PACKET_WIDTH; count -= PACKET_WIDTH)
+        {
+            RaycastPacket(soup, o, d, PACKET_WIDTH, best);
+            o += PACKET_WIDTH;
+            d += PACKET_WIDTH;
+            best += PACKET_WIDTH;
+        }
+        if (count <= 0)
+        {
+            return;
+        }
+
+#ifdef TERRAIN_PACKET_SSE
+        auto inv = [](float v) { return std::fabs(v) > 1e-9f ? 1.f / v : 1e30f; };
+
+        // A lane past `count` replays ray 0 with a best of -1, which no box and no
+        // triangle can come under: it rides along without ever widening the walk.
+        alignas(16) float lane[10][PACKET_WIDTH];
+        for (int i = 0; i < PACKET_WIDTH; ++i)
+        {
+            const int src = i < count ? i : 0;
+            lane[0][i] = o[src].x;
+            lane[1][i] = o[src].y;
+            lane[2][i] = o[src].z;
+            lane[3][i] = d[src].x;
+            lane[4][i] = d[src].y;
+            lane[5][i] = d[src].z;
+            lane[6][i] = inv(d[src].x);
+            lane[7][i] = inv(d[src].y);
+            lane[8][i] = inv(d[src].z);
+            lane[9][i] = i < count ? best[i] : -1.f;
+        }
+        const PacketRays rays{_mm_load_ps(lane[0]), _mm_load_ps(lane[1]), _mm_load_ps(lane[2]),
+                              _mm_load_ps(lane[3]), _mm_load_ps(lane[4]), _mm_load_ps(lane[5]),
+                              _mm_load_ps(lane[6]), _mm_load_ps(lane[7]), _mm_load_ps(lane[8])};
+        __m128 nearest = _mm_load_ps(lane[9]);
+
+        // The same walk as Raycast's, descending wherever ANY lane enters the box. A
+        // lane that did not enter still runs the leaf's triangles, harmlessly: rayTri
+        // decides every hit, and a box only ever decides how much gets asked.
+        int stack[MAX_DEPTH + 16];
+        int sp = 0;
+        stack[sp++] = 0;
+
+        while (sp)
+        {
+            const Node& n = m_nodes[stack[--sp]];
+            if (!SlabHits(n.box, rays, nearest))
+            {
+                continue;
+            }
+            if (n.left < 0)
+            {
+                for (uint32_t i = n.first; i < n.first + n.count; ++i)
+                {
+                    nearest = NearerHits(soup.At(i), rays, nearest);
+                }
+                continue;
+            }
+            stack[sp++] = n.left;
+            stack[sp++] = n.right;
+        }
+
+        _mm_store_ps(lane[9], nearest);
+        for (int i = 0; i < count; ++i)
+        {
+            best[i] = lane[9][i];
+        }
+#else
+        for (int i = 0; i < count; ++i)
+        {
+            if (auto t = Raycast(soup, o[i], d[i], best[i]))
+            {
+                best[i] = *t;
+            }
+        }
+#endif
+    }
+
     void Bvh::RaycastAll(const TriSoup& soup, const Vec3& o, const Vec3& d, float tMax,
                          std::vector<Crossing>& out) const
     {
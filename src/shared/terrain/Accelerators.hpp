@@ -2,9 +2,11 @@
 
 // A triangle soup in model space and the binned-SAH BVH built over it. The BVH is
 // built offline by the baker and stored in the tile verbatim, so the server never
-// pays to construct one.
+// pays to construct one -- and, the tile being mapped, never even copies it: a loaded
+// soup and node array are views of the file.
 
 #include "terrain/Geometry.hpp"
+#include "terrain/TileArray.hpp"
 
 #include <array>
 #include <cstdint>
@@ -15,8 +17,8 @@ namespace world::terrain
 {
     struct TriSoup
     {
-        std::vector<Vec3> verts;
-        std::vector<std::array<uint32_t, 3>> tris;
+        TileArray<Vec3> verts;
+        TileArray<std::array<uint32_t, 3>> tris;
 
         Tri At(uint32_t i) const
         {
@@ -77,6 +79,20 @@ namespace world::terrain
         std::optional<float> Raycast(const TriSoup& soup, const Vec3& o, const Vec3& d,
                                      float tMax, uint32_t* hitTri = nullptr) const;
 
+        // How many rays RaycastPacket walks the tree with at once: one SSE register.
+        static constexpr int PACKET_WIDTH = 4;
+
+        // Raycast for up to PACKET_WIDTH rays in one walk. best[i] comes in as ray i's
+        // tMax and goes out as its nearest hit, or untouched when nothing is nearer.
+        //
+        // Worth it when the rays are COHERENT -- one caster's sight lines to the targets
+        // around it -- because they then want the same nodes: each box is fetched once
+        // and tested against all of them in one slab test, and each leaf triangle once
+        // against all of them. Incoherent rays still get the right answer, only the walk
+        // is then the union of theirs. Without SSE it is Raycast, once per ray.
+        void RaycastPacket(const TriSoup& soup, const Vec3* o, const Vec3* d, int count,
+                           float* best) const;
+
         struct Crossing
         {
             float t = 0.f;
@@ -90,7 +106,7 @@ namespace world::terrain
         void RaycastAll(const TriSoup& soup, const Vec3& o, const Vec3& d, float tMax,
                         std::vector<Crossing>& out) const;
 
-        const std::vector<Node>& Nodes() const { return m_nodes; }
+        const TileArray<Node>& Nodes() const { return m_nodes; }
 
         /**
          * @brief Take a node array read from disk, after checking it really is a tree.
@@ -106,10 +122,13 @@ namespace world::terrain
          * therefore part of the tile format, not an implementation detail: it makes a
          * cycle unrepresentable, which is what lets the depth pass be one forward sweep.
          *
+         * A mapped array is adopted as it stands, still a view of the file: the check
+         * reads every node once and copies none.
+         *
          * @return false when the array is not a depth-first tree over @p triangleCount
          *         triangles; the tree is left empty and the caller must reject the tile.
          */
-        bool Adopt(std::vector<Node> nodes, size_t triangleCount);
+        bool Adopt(TileArray<Node> nodes, size_t triangleCount);
 
         size_t NodeCount() const { return m_nodes.size(); }
         int MaxDepth() const { return m_maxDepth; }
@@ -119,7 +138,7 @@ namespace world::terrain
         int BuildNode(const TriSoup& soup, std::vector<uint32_t>& order, uint32_t first,
                       uint32_t count, int leafSize, int depth);
 
-        std::vector<Node> m_nodes;
+        TileArray<Node> m_nodes;
         int m_maxDepth = 0;
     };
 }
@@ -17,6 +17,15 @@ namespace world::terrain
     {
         m_bounds = Aabb{};
         m_empty = m_soup.tris.empty();
+
+        // The root box IS the union of every triangle's bounds -- Build computes it that
+        // way -- so a model with a tree takes it from there rather than walking a mapped
+        // soup, page by page, just to learn a box the file already holds.
+        if (!m_bvh.Empty())
+        {
+            m_bounds = m_bvh.Nodes()[0].box;
+            return;
+        }
         for (uint32_t i = 0; i < m_soup.tris.size(); ++i)
         {
             m_bounds.expand(m_soup.TriBounds(i));
@@ -29,6 +38,12 @@ namespace world::terrain
         return m_bvh.Raycast(m_soup, origin, dir, tMax);
     }
 
+    void CollisionModel::RaycastNearestPacket(const Vec3* origins, const Vec3* dirs,
+                                              int count, float* best) const
+    {
+        m_bvh.RaycastPacket(m_soup, origins, dirs, count, best);
+    }
+
     void CollisionModel::RaycastAll(const Vec3& origin, const Vec3& dir, float tMax,
                                     std::vector<float>& out) const
     {
@@ -28,6 +28,9 @@ namespace world::terrain
         std::optional<float> RaycastNearest(const Vec3& origin, const Vec3& dir,
                                             float tMax) const override;
 
+        void RaycastNearestPacket(const Vec3* origins, const Vec3* dirs, int count,
+                                  float* best) const override;
+
         void RaycastAll(const Vec3& origin, const Vec3& dir, float tMax,
                         std::vector<float>& out) const override;
 
@@ -2,7 +2,6 @@
 #include <string>
 #include <vector>
 #include <mutex>
-#include <shared_mutex>
 #include "terrain/FusedTerrain.hpp"
 #include "terrain/TileSerializer.hpp"
 #include "terrain/WmoModel.hpp"
@@ -10,6 +9,7 @@
 #include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <utility>
 
@@ -25,6 +25,120 @@ namespace world::terrain
 
         std::string g_tileDir;
 
+        // The absent-tile memo. Only its address is used: a slot holding it has been
+        // probed and the map has no tile there.
+        const TerrainTile g_absentTile;
+
+        // READ EPOCHS. A query announces the global epoch it started in, and clears the
+        // announcement when it ends; that is the whole of the reader's side, one store
+        // to a line no other thread writes. The sweep takes a tile out of the table,
+        // bumps the epoch, and frees the tile only once every announced epoch is newer
+        // than the bump -- by then no query that could have loaded the pointer is left.
+        //
+        // The records are per thread and process-wide, since a MapUpdater thread queries
+        // every map it is handed. A thread that exits gives its record back for reuse;
+        // records themselves are never freed, so the sweep can walk the list unlocked.
+        struct ReaderRecord
+        {
+            alignas(64) std::atomic<uint64_t> epoch{0};  ///< 0 while outside a query
+            std::atomic<bool> inUse{false};
+            ReaderRecord* next = nullptr;
+        };
+
+        std::atomic<uint64_t> g_epoch{1};
+        std::atomic<ReaderRecord*> g_readers{nullptr};
+
+        ReaderRecord* AcquireReaderRecord()
+        {
+            for (ReaderRecord* r = g_readers.load(std::memory_order_acquire); r; r = r->next)
+            {
+                bool expected = false;
+                if (!r->inUse.load(std::memory_order_relaxed) &&
+                    r->inUse.compare_exchange_strong(expected, true,
+                                                     std::memory_order_acquire))
+                {
+                    return r;
+                }
+            }
+
+            ReaderRecord* r = new ReaderRecord;
+            r->inUse.store(true, std::memory_order_relaxed);
+            r->next = g_readers.load(std::memory_order_relaxed);
+            while (!g_readers.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                                    std::memory_order_relaxed))
+            {
+            }
+            return r;
+        }
+
+        struct ThreadReader
+        {
+            ReaderRecord* record = nullptr;
+            uint32_t depth = 0;
+
+            ~ThreadReader()
+            {
+                if (record)
+                {
+                    record->epoch.store(0, std::memory_order_release);
+                    record->inUse.store(false, std::memory_order_release);
+                }
+            }
+        };
+
+        thread_local ThreadReader t_reader;
+
+        // Held for the length of one query. Nested guards ride on the outermost one, so
+        // a query that calls another announces once.
+        class ReadEpoch
+        {
+        public:
+            ReadEpoch()
+            {
+                ThreadReader& self = t_reader;
+                if (self.depth++ != 0)
+                {
+                    return;
+                }
+                if (!self.record)
+                {
+                    self.record = AcquireReaderRecord();
+                }
+                self.record->epoch.store(g_epoch.load(std::memory_order_relaxed),
+                                         std::memory_order_relaxed);
+                // Pairs with the fence in the sweep: either it sees this announcement,
+                // or every slot this query loads already reads as taken down.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            ~ReadEpoch()
+            {
+                ThreadReader& self = t_reader;
+                if (--self.depth == 0)
+                {
+                    self.record->epoch.store(0, std::memory_order_release);
+                }
+            }
+
+            ReadEpoch(const ReadEpoch&) = delete;
+            ReadEpoch& operator=(const ReadEpoch&) = delete;
+        };
+
+        // The oldest epoch any query is running in; UINT64_MAX when none is.
+        uint64_t OldestReadEpoch()
+        {
+            uint64_t oldest = std::numeric_limits<uint64_t>::max();
+            for (ReaderRecord* r = g_readers.load(std::memory_order_acquire); r; r = r->next)
+            {
+                const uint64_t e = r->epoch.load(std::memory_order_acquire);
+                if (e != 0 && e < oldest)
+                {
+                    oldest = e;
+                }
+            }
+            return oldest;
+        }
+
         float SegmentHitFrac(const std::vector<const StaticInstance*>& instances,
                              const Vec3& a, const Vec3& b)
         {
@@ -68,6 +182,10 @@ namespace world::terrain
     {
     }
 
+    // Nothing may be querying a terrain that is being destroyed, so the retired tiles go
+    // with the owners, whatever epoch they were waiting for.
+    FusedTerrain::~FusedTerrain() = default;
+
     // READ, not stat. This answers the start-up question "does this map have terrain",
     // and a file that opens is not an answer: a truncated tile, one from another build,
     // or one whose grids are the wrong shape passes an existence check and then fails
@@ -102,7 +220,7 @@ namespace world::terrain
         return ReadTile(g_tileDir + "/" + TileFileName(m_mapId, tx, ty));
     }
 
-    FusedTerrain::TilePtr FusedTerrain::TileAt(float x, float y) const
+    const TerrainTile* FusedTerrain::TileAt(float x, float y) const
     {
         const int tx = TileIndex(x);
         const int ty = TileIndex(y);
@@ -111,38 +229,75 @@ namespace world::terrain
             return nullptr;
         }
 
+        // Written only when the clock has moved. Every worker hits the same resident
+        // tiles, and an unconditional store here puts back the shared-line traffic the
+        // table exists to remove.
         const uint32_t now = m_clockMs.load(std::memory_order_relaxed);
+        std::atomic<uint32_t>& lastUse = m_tileLastUse[tx][ty];
+        if (lastUse.load(std::memory_order_relaxed) != now)
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            if (m_loaded[tx][ty])
-            {
-                m_tileLastUse[tx][ty].store(now, std::memory_order_relaxed);
-                return m_tiles[tx][ty];
-            }
+            lastUse.store(now, std::memory_order_relaxed);
+        }
+
+        if (const TerrainTile* hit = m_tiles[tx][ty].load(std::memory_order_acquire))
+        {
+            return hit != &g_absentTile ? hit : nullptr;
         }
 
         // Read outside the lock so I/O does not stall other columns. A racing thread may
-        // load the same cell; either result describes the same tile.
-        TilePtr tile = LoadCell(tx, ty);
+        // load the same cell; either result describes the same tile, and the first one
+        // published is the one every query sees.
+        const TerrainTile* published = Publish(tx, ty, LoadCell(tx, ty));
+        return published != &g_absentTile ? published : nullptr;
+    }
 
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
-        if (!m_loaded[tx][ty])
+    const TerrainTile* FusedTerrain::Publish(int tx, int ty, TilePtr tile) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const TerrainTile* published = m_tiles[tx][ty].load(std::memory_order_relaxed);
+        if (!published)
         {
-            m_tiles[tx][ty] = std::move(tile);
-            m_loaded[tx][ty] = 1;
+            m_owners[tx][ty] = std::move(tile);
+            published = m_owners[tx][ty] ? m_owners[tx][ty].get() : &g_absentTile;
+            m_tiles[tx][ty].store(published, std::memory_order_release);
         }
-        m_tileLastUse[tx][ty].store(now, std::memory_order_relaxed);
-        return m_tiles[tx][ty];
+        return published;
     }
 
-    FusedTerrain::TilePtr FusedTerrain::GlobalWmo() const
+    bool FusedTerrain::Prefetch(int tx, int ty) const
     {
+        if (tx < 0 || tx >= GRID_COUNT || ty < 0 || ty >= GRID_COUNT)
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            if (m_globalWmoProbed)
-            {
-                return m_globalWmo;
-            }
+            return false;
+        }
+        if (m_tiles[tx][ty].load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        // Stamped as a use: a tile fetched for a player still minutes away must not look
+        // idle to the next sweep before anyone pins it. The slot is only published, never
+        // read, so no read epoch is needed here.
+        m_tileLastUse[tx][ty].store(m_clockMs.load(std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+        Publish(tx, ty, LoadCell(tx, ty));
+        return true;
+    }
+
+    bool FusedTerrain::IsResident(int tx, int ty) const
+    {
+        if (tx < 0 || tx >= GRID_COUNT || ty < 0 || ty >= GRID_COUNT)
+        {
+            return false;
+        }
+        return m_tiles[tx][ty].load(std::memory_order_acquire) != nullptr;
+    }
+
+    const TerrainTile* FusedTerrain::GlobalWmo() const
+    {
+        if (const TerrainTile* hit = m_globalWmo.load(std::memory_order_acquire))
+        {
+            return hit != &g_absentTile ? hit : nullptr;
         }
 
         TilePtr tile;
@@ -155,30 +310,58 @@ namespace world::terrain
             tile = ReadTile(g_tileDir + "/" + GlobalWmoFileName(m_mapId));
         }
 
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
-        if (!m_globalWmoProbed)
+        // Never swept: a global WMO is the whole map, so it lives as long as the terrain.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const TerrainTile* published = m_globalWmo.load(std::memory_order_relaxed);
+        if (!published)
         {
-            m_globalWmo = std::move(tile);
-            m_globalWmoProbed = 1;
+            m_globalWmoOwner = std::move(tile);
+            published = m_globalWmoOwner ? m_globalWmoOwner.get() : &g_absentTile;
+            m_globalWmo.store(published, std::memory_order_release);
         }
-        return m_globalWmo;
+        return published != &g_absentTile ? published : nullptr;
     }
 
-    void FusedTerrain::EvictTile(int tx, int ty) const
+    void FusedTerrain::EvictTile(int tx, int ty)
     {
-        // m_loaded goes back to 0 so the next query re-probes. The absent-tile memo is
-        // not kept here: its whole value is recording that the file is missing, and this
-        // tile plainly exists.
-        m_tiles[tx][ty].reset();
-        m_loaded[tx][ty] = 0;
+        // The slot goes back to empty so the next query re-probes. The absent-tile memo
+        // is not kept here: its whole value is recording that the file is missing, and
+        // this tile plainly exists. The tile itself is only retired -- a query may have
+        // loaded the pointer a moment ago and still be walking it.
+        m_tiles[tx][ty].store(nullptr, std::memory_order_relaxed);
+        m_retired.push_back(RetiredTile{0, std::move(m_owners[tx][ty])});
+        m_owners[tx][ty].reset();
         m_tileLastUse[tx][ty].store(0, std::memory_order_relaxed);
     }
 
+    void FusedTerrain::ReclaimRetired()
+    {
+        if (m_retired.empty())
+        {
+            return;
+        }
+
+        // A query still announcing an epoch at or before a tile's retirement may have
+        // loaded it before the slot was cleared; any later one cannot have.
+        const uint64_t oldest = OldestReadEpoch();
+        m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                       [oldest](const RetiredTile& r)
+                                       {
+                                           return r.epoch < oldest;
+                                       }),
+                        m_retired.end());
+    }
+
     void FusedTerrain::Update(uint32_t diff)
     {
         const uint32_t now = m_clockMs.load(std::memory_order_relaxed) + diff;
         m_clockMs.store(now, std::memory_order_relaxed);
 
+        // Retired tiles are looked at every tick, not every sweep: a query lasts well
+        // under one, so a tile waits one tick for its readers rather than a minute.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ReclaimRetired();
+
         m_sweepAccumMs += diff;
         if (m_sweepAccumMs < SWEEP_INTERVAL_MS)
         {
@@ -186,15 +369,15 @@ namespace world::terrain
         }
         m_sweepAccumMs = 0;
 
-        // Lock order is cell-ref then tile cache; nothing else takes both.
+        // Lock order is tile cache then cell-ref; nothing else takes both.
         std::lock_guard<std::mutex> refLock(m_cellRefMutex);
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
 
+        const size_t retiredBefore = m_retired.size();
         for (int tx = 0; tx < GRID_COUNT; ++tx)
         {
             for (int ty = 0; ty < GRID_COUNT; ++ty)
             {
-                if (!m_tiles[tx][ty] || m_cellRef[tx][ty] > 0)
+                if (!m_owners[tx][ty] || m_cellRef[tx][ty] > 0)
                 {
                     continue;
                 }
@@ -207,6 +390,22 @@ namespace world::terrain
                 EvictTile(tx, ty);
             }
         }
+
+        if (m_retired.size() == retiredBefore)
+        {
+            return;
+        }
+
+        // Pairs with the fence in ReadEpoch. Every query that starts in the new epoch
+        // finds the cleared slots; one that started earlier is still announcing an epoch
+        // no newer than `retiredAt`, and holds these tiles until it ends.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint64_t retiredAt = g_epoch.fetch_add(1, std::memory_order_seq_cst);
+        for (size_t i = retiredBefore; i < m_retired.size(); ++i)
+        {
+            m_retired[i].epoch = retiredAt;
+        }
+        ReclaimRetired();
     }
 
     void FusedTerrain::PinCell(int tx, int ty)
@@ -242,13 +441,13 @@ namespace world::terrain
 
     size_t FusedTerrain::ResidentTiles() const
     {
-        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
         size_t n = 0;
         for (int tx = 0; tx < GRID_COUNT; ++tx)
         {
             for (int ty = 0; ty < GRID_COUNT; ++ty)
             {
-                n += m_tiles[tx][ty] ? 1 : 0;
+                n += m_owners[tx][ty] ? 1 : 0;
             }
         }
         return n;
@@ -269,8 +468,9 @@ namespace world::terrain
         const bool wantStaticLiquid = (sources & SOURCE_STATIC_LIQUID) != 0;
         const bool wantLive = (sources & SOURCE_LIVE) != 0;
 
-        TilePtr tile = TileAt(x, y);
-        TilePtr global = GlobalWmo();
+        ReadEpoch epoch;
+        const TerrainTile* tile = TileAt(x, y);
+        const TerrainTile* global = GlobalWmo();
         if (!tile && !global)
         {
             return column;
@@ -392,24 +592,21 @@ namespace world::terrain
     }
 
     void FusedTerrain::CollectSegmentInstances(const Vec3& a, const Vec3& b,
-                                               std::vector<const StaticInstance*>& out,
-                                               std::vector<TilePtr>& keepAlive) const
+                                               std::vector<const StaticInstance*>& out) const
     {
         out.clear();
-        keepAlive.clear();
 
         const float minx = std::min(a.x, b.x), maxx = std::max(a.x, b.x);
         const float miny = std::min(a.y, b.y), maxy = std::max(a.y, b.y);
 
         const float dx = b.x - a.x, dy = b.y - a.y;
 
-        auto gather = [&](const TilePtr& tile)
+        auto gather = [&](const TerrainTile* tile)
         {
             if (!tile)
             {
                 return;
             }
-            keepAlive.push_back(tile);
             for (const StaticInstance& inst : tile->instances)
             {
                 const Aabb& wb = inst.worldBounds;
@@ -548,8 +745,9 @@ namespace world::terrain
     {
         const Vec3 a{x1, y1, z1}, b{x2, y2, z2};
         std::vector<const StaticInstance*> instances;
-        std::vector<TilePtr> keepAlive;
-        CollectSegmentInstances(a, b, instances, keepAlive);
+        // The instances point into the tiles, so the epoch spans the hit test too.
+        ReadEpoch epoch;
+        CollectSegmentInstances(a, b, instances);
         return SegmentHitFrac(instances, a, b);
     }
 
@@ -559,9 +757,95 @@ namespace world::terrain
         return NearestHitFraction(x1, y1, z1, x2, y2, z2) > 1.0f;
     }
 
+    void FusedTerrain::NearestHitFractions(const Vec3* a, const Vec3* b, size_t count,
+                                           float* out) const
+    {
+        using Pair = std::pair<const StaticInstance*, uint32_t>;
+        thread_local std::vector<const StaticInstance*> instances;
+        thread_local std::vector<Pair> pairs;
+        pairs.clear();
+
+        auto inv = [](float d) { return std::fabs(d) > 1e-9f ? 1.0f / d : 1e30f; };
+
+        // The instances point into the tiles, so the epoch spans the hit tests too.
+        ReadEpoch epoch;
+
+        // Every (placement, segment) pair SegmentHitFrac would have raycast, screened by
+        // the same world-box test...
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = 2.0f;
+            const Vec3 seg = b[i] - a[i];
+            if (dot(seg, seg) < 1e-6f)
+            {
+                continue;
+            }
+            const Vec3 invDir{inv(seg.x), inv(seg.y), inv(seg.z)};
+
+            CollectSegmentInstances(a[i], b[i], instances);
+            for (const StaticInstance* inst : instances)
+            {
+                if (inst->model && !inst->model->Empty() &&
+                    inst->worldBounds.intersectsRay(a[i], invDir, 1.0f))
+                {
+                    pairs.emplace_back(inst, uint32_t(i));
+                }
+            }
+        }
+
+        // ...then grouped by placement, so each model is walked once per packet of the
+        // segments that reach it rather than once per segment.
+        std::sort(pairs.begin(), pairs.end(), [](const Pair& l, const Pair& r)
+        {
+            return std::less<const StaticInstance*>()(l.first, r.first) ||
+                   (l.first == r.first && l.second < r.second);
+        });
+
+        constexpr int WIDTH = Bvh::PACKET_WIDTH;
+        for (size_t run = 0; run < pairs.size();)
+        {
+            const StaticInstance* inst = pairs[run].first;
+            int n = 0;
+            Vec3 origins[WIDTH], dirs[WIDTH];
+            float best[WIDTH];
+            while (n < WIDTH && run + n < pairs.size() && pairs[run + n].first == inst)
+            {
+                const uint32_t seg = pairs[run + n].second;
+                origins[n] = inst->xf.worldToLocal(a[seg]);
+                dirs[n] = inst->xf.worldToLocal(b[seg]) - origins[n];
+                best[n] = 1.0f;
+                ++n;
+            }
+
+            inst->model->RaycastNearestPacket(origins, dirs, n, best);
+            for (int k = 0; k < n; ++k)
+            {
+                float& frac = out[pairs[run + k].second];
+                if (best[k] < 1.0f && best[k] < frac)
+                {
+                    frac = best[k];
+                }
+            }
+            run += size_t(n);
+        }
+    }
+
+    void FusedTerrain::IsInLineOfSight(const Vec3* a, const Vec3* b, size_t count,
+                                       bool* visible) const
+    {
+        thread_local std::vector<float> fractions;
+        fractions.resize(count);
+        NearestHitFractions(a, b, count, fractions.data());
+        for (size_t i = 0; i < count; ++i)
+        {
+            visible[i] = fractions[i] > 1.0f;
+        }
+    }
+
     uint16_t FusedTerrain::GetAreaId(float x, float y) const
     {
-        TilePtr tile = TileAt(x, y);
+        ReadEpoch epoch;
+        const TerrainTile* tile = TileAt(x, y);
         if (!tile || !tile->hasTerrain)
         {
             return 0;
@@ -573,8 +857,9 @@ namespace world::terrain
                                    int32_t& adtId, int32_t& rootId, int32_t& groupId,
                                    float& groundZ) const
     {
-        TilePtr tile = TileAt(x, y);
-        TilePtr global = GlobalWmo();
+        ReadEpoch epoch;
+        const TerrainTile* tile = TileAt(x, y);
+        const TerrainTile* global = GlobalWmo();
         if (!tile && !global)
         {
             return false;
@@ -19,7 +19,6 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -37,6 +36,8 @@ namespace world::terrain
         explicit FusedTerrain(uint32_t mapId,
                               std::shared_ptr<ITileSource> source = nullptr);
 
+        ~FusedTerrain();
+
         FusedTerrain(const FusedTerrain&) = delete;
         FusedTerrain& operator=(const FusedTerrain&) = delete;
 
@@ -87,6 +88,18 @@ namespace world::terrain
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                              float z2) const;
 
+        // NearestHitFraction for `count` segments a[i]->b[i] in one read epoch: out[i] is
+        // exactly what the scalar call would have answered for segment i. Rather than
+        // walking every model once per segment, each placement is walked once per four of
+        // the segments that reach it (Bvh::RaycastPacket) -- which pays off for the
+        // batches the server actually makes, one caster's sight lines to the targets
+        // around it, all crossing the same few buildings.
+        void NearestHitFractions(const Vec3* a, const Vec3* b, size_t count,
+                                 float* out) const;
+
+        void IsInLineOfSight(const Vec3* a, const Vec3* b, size_t count,
+                             bool* visible) const;
+
         // AreaTable.dbc id of the MCNK chunk under (x,y), or 0 when unknown.
         uint16_t GetAreaId(float x, float y) const;
 
@@ -99,8 +112,20 @@ namespace world::terrain
         // Advances the cache clock and, once a minute, drops tiles that nothing pins and
         // no query has touched for a while. Without it the cache is monotonic: a player
         // walking a continent leaves every WMO he passed resident for the map's life.
+        // A dropped tile leaves the table at once but is freed on a later call, when no
+        // query that could have picked it up is still running.
         void Update(uint32_t diff);
 
+        // Reads a cell's tile ahead of the first query that wants it, and publishes it
+        // exactly as that query would have. Any thread may call it -- it is meant for one
+        // that is not running a map -- and a query racing it just finds the slot filled.
+        // True when this call did the read, false when the slot was already settled.
+        bool Prefetch(int tx, int ty) const;
+
+        // True when a query at this cell would read no file: a tile is resident, or the
+        // map is known to have none there.
+        bool IsResident(int tx, int ty) const;
+
         // Pins a cell's tile against the sweep while a grid is active.
         void PinCell(int tx, int ty);
         void UnpinCell(int tx, int ty);
@@ -110,30 +135,46 @@ namespace world::terrain
     private:
         using TilePtr = std::shared_ptr<const TerrainTile>;
 
-        TilePtr TileAt(float x, float y) const;
-        TilePtr GlobalWmo() const;
+        // Both answer only inside a query's read epoch (see FusedTerrain.cpp): the tile
+        // they return stays valid until that epoch ends, and not a moment longer.
+        const TerrainTile* TileAt(float x, float y) const;
+        const TerrainTile* GlobalWmo() const;
         TilePtr LoadCell(int tx, int ty) const;
-        void EvictTile(int tx, int ty) const;
+        const TerrainTile* Publish(int tx, int ty, TilePtr tile) const;
+        void EvictTile(int tx, int ty);
+        void ReclaimRetired();
 
         void CollectSegmentInstances(const Vec3& a, const Vec3& b,
-                                     std::vector<const StaticInstance*>& out,
-                                     std::vector<TilePtr>& keepAlive) const;
+                                     std::vector<const StaticInstance*>& out) const;
 
         const uint32_t m_mapId;
         const std::shared_ptr<ITileSource> m_source;
 
-        // Every query from every map-update thread goes through this cache, so the hit
-        // path takes the lock SHARED: readers do not serialise against each other. All
-        // instances of one dungeon share a single FusedTerrain, so they would otherwise
-        // contend on one exclusive lock for every height, liquid and sight query.
+        // Every query from every map-update thread goes through this table, so the hit
+        // path is a single acquire load of the slot: no lock, no reference count, no
+        // store to a line another worker reads. All instances of one dungeon share one
+        // FusedTerrain; a shared lock or a shared_ptr copy there is an atomic write to
+        // the same cache line from every MapUpdater thread on every query.
         //
-        // A null-but-probed entry is a memo that the map has no such tile; it costs one
-        // byte and spares a failed file open per query, so the sweep keeps it.
-        mutable std::array<std::array<TilePtr, GRID_COUNT>, GRID_COUNT> m_tiles;
-        mutable std::array<std::array<uint8_t, GRID_COUNT>, GRID_COUNT> m_loaded{};
-        mutable TilePtr m_globalWmo;
-        mutable uint8_t m_globalWmoProbed = 0;
-        mutable std::shared_mutex m_mutex;
+        // A slot is empty (never probed), a tile, or the absent-tile memo: the map has
+        // no such tile, which spares a failed file open per query and which the sweep
+        // keeps. The owning references sit beside the table and are touched only under
+        // m_mutex, by a load publishing a tile or by the sweep taking one down.
+        mutable std::array<std::array<std::atomic<const TerrainTile*>, GRID_COUNT>,
+                           GRID_COUNT> m_tiles{};
+        mutable std::array<std::array<TilePtr, GRID_COUNT>, GRID_COUNT> m_owners;
+        mutable std::atomic<const TerrainTile*> m_globalWmo{nullptr};
+        mutable TilePtr m_globalWmoOwner;
+        mutable std::mutex m_mutex;
+
+        // A tile the sweep took down, held until every query that could still be reading
+        // it has finished: freed once no reader is left in an epoch at or before `epoch`.
+        struct RetiredTile
+        {
+            uint64_t epoch;
+            TilePtr tile;
+        };
+        std::vector<RetiredTile> m_retired;
 
         mutable std::array<std::array<std::atomic<uint32_t>, GRID_COUNT>, GRID_COUNT>
             m_tileLastUse{};
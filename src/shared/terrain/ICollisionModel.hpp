@@ -29,6 +29,22 @@ namespace world::terrain
         virtual std::optional<float> RaycastNearest(const Vec3& origin, const Vec3& dir,
                                                     float tMax) const = 0;
 
+        // RaycastNearest for `count` rays at once. best[i] comes in as ray i's tMax and
+        // goes out as its nearest hit, or untouched when it hit nothing nearer. Rays from
+        // one caster's batch of sight lines are coherent, and a model that can walk them
+        // together should; the default asks one at a time.
+        virtual void RaycastNearestPacket(const Vec3* origins, const Vec3* dirs, int count,
+                                          float* best) const
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                if (auto t = RaycastNearest(origins[i], dirs[i], best[i]))
+                {
+                    best[i] = *t;
+                }
+            }
+        }
+
         // Every surface the ray crosses, appended in no particular order. What the
         // nearest hit cannot answer: which floor a point is standing on when the point
         // sits under one, and how many more lie beneath it.
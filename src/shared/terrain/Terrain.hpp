@@ -2,6 +2,7 @@
 
 #include "terrain/Geometry.hpp"
 #include "terrain/ICollisionModel.hpp"
+#include "terrain/TileArray.hpp"
 
 #include <array>
 #include <cmath>
@@ -62,17 +63,17 @@ namespace world::terrain
         bool hasTerrain = false;
         bool isGlobalWmo = false;
 
-        std::vector<float> v9;                         ///< V9_SIDE*V9_SIDE corner heights
-        std::vector<float> v8;                         ///< GRID_PER_TILE^2 centre heights
+        TileArray<float> v9;                           ///< V9_SIDE*V9_SIDE corner heights
+        TileArray<float> v8;                           ///< GRID_PER_TILE^2 centre heights
         std::array<uint16_t, CHUNKS * CHUNKS> holes{};
         std::array<uint16_t, CHUNKS * CHUNKS> areaIds{};
 
         bool hasLiquid = false;
-        std::vector<float> liquidHeight;    ///< V9_SIDE*V9_SIDE corner grid
-        std::vector<uint8_t> liquidShow;    ///< GRID_PER_TILE^2 cell mask
-        std::vector<uint8_t> liquidKind;    ///< GRID_PER_TILE^2 LiquidKind
-        std::vector<uint16_t> liquidEntry;  ///< GRID_PER_TILE^2 LiquidType.dbc id
-        std::vector<uint8_t> liquidDeep;    ///< GRID_PER_TILE^2 dark-water mask
+        TileArray<float> liquidHeight;      ///< V9_SIDE*V9_SIDE corner grid
+        TileArray<uint8_t> liquidShow;      ///< GRID_PER_TILE^2 cell mask
+        TileArray<uint8_t> liquidKind;      ///< GRID_PER_TILE^2 LiquidKind
+        TileArray<uint16_t> liquidEntry;    ///< GRID_PER_TILE^2 LiquidType.dbc id
+        TileArray<uint8_t> liquidDeep;      ///< GRID_PER_TILE^2 dark-water mask
 
         std::vector<StaticInstance> instances;
 
@@ -0,0 +1,191 @@
+#pragma once
+
+// The array type of everything a tile holds in bulk: height grids, liquid masks,
+// triangle soups, BVH nodes. It is one of two things.
+//
+//   OWNED -- a std::vector, as the baker and the tests build it. Every mutating call
+//   the baker makes on a vector works here unchanged.
+//
+//   A VIEW -- a run of elements inside a tile file that ReadTile mapped, plus a
+//   reference that keeps the mapping alive. Nothing was parsed, allocated or copied to
+//   produce it; the query path reads the file's pages in place.
+//
+// Reading is the same either way: one pointer and a count, with no branch. Writing to a
+// view copies it into owned storage first, so a loaded tile can still be edited -- by a
+// test, say -- without the file ever being written through.
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace world::terrain
+{
+    template <class T>
+    class TileArray
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "a TileArray may be a view of file bytes; T must be trivially copyable");
+
+    public:
+        using value_type = T;
+        using const_iterator = const T*;
+        using iterator = T*;
+
+        TileArray() = default;
+
+        // Implicit on purpose: the baker assigns vectors to these fields throughout.
+        TileArray(std::vector<T> owned) : m_own(std::move(owned)) { Sync(); }
+        TileArray(std::initializer_list<T> init) : m_own(init) { Sync(); }
+
+        TileArray(const TileArray& other)
+            : m_data(other.m_data), m_size(other.m_size), m_own(other.m_own),
+              m_backing(other.m_backing)
+        {
+            if (!m_backing)
+            {
+                Sync();
+            }
+        }
+
+        TileArray(TileArray&& other) noexcept
+            : m_data(other.m_data), m_size(other.m_size), m_own(std::move(other.m_own)),
+              m_backing(std::move(other.m_backing))
+        {
+            other.Reset();
+            if (!m_backing)
+            {
+                Sync();
+            }
+        }
+
+        TileArray& operator=(TileArray other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        /// `count` elements at `data`, valid for as long as `backing` is held.
+        static TileArray View(const T* data, size_t count, std::shared_ptr<const void> backing)
+        {
+            TileArray view;
+            view.m_data = data;
+            view.m_size = count;
+            view.m_backing = std::move(backing);
+            return view;
+        }
+
+        bool IsView() const { return m_backing != nullptr; }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        const T* data() const { return m_data; }
+        const T& operator[](size_t i) const { return m_data[i]; }
+        const T* begin() const { return m_data; }
+        const T* end() const { return m_data + m_size; }
+        const T& front() const { return m_data[0]; }
+        const T& back() const { return m_data[m_size - 1]; }
+
+        std::vector<T> ToVector() const { return std::vector<T>(begin(), end()); }
+
+        // -- mutation: owned storage only, a view is copied out first ---------------
+
+        T* data() { Detach(); return m_own.data(); }
+        T& operator[](size_t i) { Detach(); return m_own[i]; }
+        T* begin() { Detach(); return m_own.data(); }
+        T* end() { Detach(); return m_own.data() + m_own.size(); }
+
+        void push_back(const T& v) { Detach(); m_own.push_back(v); Sync(); }
+        void reserve(size_t n) { Detach(); m_own.reserve(n); Sync(); }
+        void resize(size_t n) { Detach(); m_own.resize(n); Sync(); }
+        void resize(size_t n, const T& v) { Detach(); m_own.resize(n, v); Sync(); }
+        void assign(size_t n, const T& v) { Detach(); m_own.assign(n, v); Sync(); }
+
+        template <class It,
+                  class = typename std::iterator_traits<It>::iterator_category>
+        void assign(It first, It last)
+        {
+            m_backing.reset();
+            m_own.assign(first, last);
+            Sync();
+        }
+
+        void clear()
+        {
+            m_backing.reset();
+            m_own.clear();
+            Sync();
+        }
+
+        void swap(std::vector<T>& other)
+        {
+            Detach();
+            m_own.swap(other);
+            Sync();
+        }
+
+        void swap(TileArray& other) noexcept
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            m_own.swap(other.m_own);
+            m_backing.swap(other.m_backing);
+        }
+
+    private:
+        void Sync()
+        {
+            m_data = m_own.data();
+            m_size = m_own.size();
+        }
+
+        void Detach()
+        {
+            if (m_backing)
+            {
+                m_own.assign(m_data, m_data + m_size);
+                m_backing.reset();
+                Sync();
+            }
+        }
+
+        void Reset()
+        {
+            m_data = nullptr;
+            m_size = 0;
+            m_own.clear();
+            m_backing.reset();
+        }
+
+        const T* m_data = nullptr;
+        size_t m_size = 0;
+        std::vector<T> m_own;
+        std::shared_ptr<const void> m_backing;
+    };
+
+    template <class T>
+    bool operator==(const TileArray<T>& a, const TileArray<T>& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (!(a[i] == b[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class T>
+    bool operator!=(const TileArray<T>& a, const TileArray<T>& b)
+    {
+        return !(a == b);
+    }
+}
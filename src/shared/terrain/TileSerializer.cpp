@@ -8,111 +8,317 @@
 #include <array>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 #include <unordered_map>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace world::terrain
 {
     namespace
     {
         constexpr uint32_t MAGIC = 0x32474E4D;  // "MNG2" in file order
-        // Version 2 is the same byte LAYOUT as 1 and a different set of accepted files.
-        // The reader now requires each present grid to match its fixed dimensions, a WMO
-        // group's liquid to match its own tile counts, a BVH node array to be a tree over
-        // the triangles it indexes, and an instance to carry a finite pose -- all of which
-        // a version 1 bake was free to violate. A tile that does is now REJECTED, and a
-        // rejected tile is silence: no height, no liquid, no collision, no diagnostic
-        // beyond the miss. The version is what turns "this map answers nothing" into
-        // "this bake is stale, run the extractor".
-        constexpr uint32_t VERSION = 2;
+        // Version 3 is a new LAYOUT: the file is mapped and read in place. Every bulk
+        // array sits at an aligned offset named by a fixed-size record, so the reader
+        // builds views instead of reading into vectors. Version 2 (the sequential,
+        // length-prefixed layout) is a miss like any other stale bake: the version is
+        // what turns "this map answers nothing" into "this bake is stale, run the
+        // extractor".
+        //
+        // Everything version 2 screened is still screened: each present grid must match
+        // its fixed dimensions, a WMO group's liquid its own tile counts, a BVH node array
+        // must be a tree over the triangles it indexes, and an instance must carry a
+        // finite pose. On top of that every array must lie inside the file, aligned for
+        // its element type.
+        constexpr uint32_t VERSION = 3;
 
         constexpr uint32_t MAX_MODELS = 1u << 20;
         constexpr uint32_t MAX_INSTANCES = 1u << 22;
-        // A WMO's group count is a uint32 in the file and a few hundred in reality. The
-        // model ceiling is far too loose for it: it lets a corrupt header size a vector
-        // of a million groups -- each one a Group with two vectors inside -- before any
-        // per-group read measures anything against the file.
+        // A WMO's group count is a uint32 in the file and a few hundred in reality.
         constexpr uint32_t MAX_GROUPS = 4096;
 
-        // A count is only believable if the file still holds that many elements. A fixed
-        // ceiling is not enough: it still lets a corrupt header reserve hundreds of
-        // megabytes before the short read is noticed, and on an overcommitting kernel
-        // that reservation succeeds, so the guard never fires and the test that was
-        // supposed to prove it stays green either way. Measuring against the actual file
-        // makes the allocation impossible rather than merely unlikely.
-        long RemainingBytes(std::FILE* f)
+        // Every array starts on this boundary. It covers the alignment of every element
+        // type a tile holds, and a mapping starts on a page, so a view's pointer is
+        // always aligned for what it points at.
+        constexpr uint32_t ARRAY_ALIGN = 16;
+
+        // A run of elements: a byte offset from the start of the file and an element
+        // count. Offsets rather than pointers, so the file means the same wherever it is
+        // mapped.
+        struct ArrayRef
         {
-            const long here = std::ftell(f);
-            if (here < 0 || std::fseek(f, 0, SEEK_END) != 0)
+            uint32_t offset = 0;
+            uint32_t count = 0;
+        };
+
+        struct FileHeader
+        {
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            uint32_t fileSize = 0;
+            int32_t tx = 0;
+            int32_t ty = 0;
+            uint8_t hasTerrain = 0;
+            uint8_t isGlobalWmo = 0;
+            uint8_t hasLiquid = 0;
+            uint8_t reserved = 0;
+            ArrayRef v9, v8;
+            ArrayRef liquidHeight, liquidShow, liquidKind, liquidEntry, liquidDeep;
+            std::array<uint16_t, CHUNKS * CHUNKS> holes{};
+            std::array<uint16_t, CHUNKS * CHUNKS> areaIds{};
+            ArrayRef models;     ///< ModelRecord
+            ArrayRef instances;  ///< InstanceRecord
+        };
+
+        struct ModelRecord
+        {
+            uint32_t kind = 0;
+            uint32_t rootId = 0;  ///< WMO only
+            ArrayRef groups;      ///< GroupRecord, WMO only
+            ArrayRef verts, tris, triGroup, nodes;
+        };
+
+        struct GroupRecord
+        {
+            uint32_t mogpFlags = 0;
+            uint32_t groupWmoId = 0;
+            uint32_t hasLiquid = 0;
+            uint32_t tilesX = 0, tilesY = 0;
+            Vec3 corner;
+            uint16_t entry = 0;
+            uint8_t kind = 0;
+            uint8_t reserved = 0;
+            ArrayRef heights, flags;
+        };
+
+        struct InstanceRecord
+        {
+            Vec3 pos;
+            std::array<float, 9> rot{};
+            float scale = 1.0f;
+            Vec3 lo, hi;
+            uint32_t model = 0;
+            int32_t adtId = 0;
+        };
+
+        static_assert(std::is_trivially_copyable<FileHeader>::value &&
+                      std::is_trivially_copyable<ModelRecord>::value &&
+                      std::is_trivially_copyable<GroupRecord>::value &&
+                      std::is_trivially_copyable<InstanceRecord>::value,
+                      "tile records are written and read as raw bytes");
+        static_assert(alignof(Bvh::Node) <= ARRAY_ALIGN && alignof(Vec3) <= ARRAY_ALIGN,
+                      "ARRAY_ALIGN must cover every element type a view points at");
+
+        // The whole file, mapped read-only; every view of a loaded tile holds this.
+        class MappedFile
+        {
+        public:
+            static std::shared_ptr<const MappedFile> Open(const std::string& path)
             {
-                return -1;
+                std::shared_ptr<MappedFile> file(new MappedFile());
+#ifdef _WIN32
+                file->m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                if (file->m_file == INVALID_HANDLE_VALUE)
+                {
+                    return nullptr;
+                }
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file->m_file, &size) ||
+                    size.QuadPart < LONGLONG(sizeof(FileHeader)) ||
+                    size.QuadPart > LONGLONG(std::numeric_limits<uint32_t>::max()))
+                {
+                    return nullptr;
+                }
+                file->m_size = size_t(size.QuadPart);
+                file->m_mapping = CreateFileMappingA(file->m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+                file->m_data = file->m_mapping
+                                   ? static_cast<const char*>(
+                                         MapViewOfFile(file->m_mapping, FILE_MAP_READ, 0, 0, 0))
+                                   : nullptr;
+                if (!file->m_data)
+                {
+                    return nullptr;
+                }
+#else
+                const int fd = open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    return nullptr;
+                }
+                struct stat st;
+                if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(FileHeader) ||
+                    uint64_t(st.st_size) > std::numeric_limits<uint32_t>::max())
+                {
+                    close(fd);
+                    return nullptr;
+                }
+                void* map = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                close(fd);  // the mapping keeps the file
+                if (map == MAP_FAILED)
+                {
+                    return nullptr;
+                }
+                file->m_data = static_cast<const char*>(map);
+                file->m_size = size_t(st.st_size);
+#endif
+                return file;
             }
-            const long end = std::ftell(f);
-            if (end < 0 || std::fseek(f, here, SEEK_SET) != 0)
+
+            ~MappedFile()
             {
-                return -1;
+#ifdef _WIN32
+                if (m_data)
+                {
+                    UnmapViewOfFile(m_data);
+                }
+                if (m_mapping)
+                {
+                    CloseHandle(m_mapping);
+                }
+                if (m_file != INVALID_HANDLE_VALUE)
+                {
+                    CloseHandle(m_file);
+                }
+#else
+                if (m_data)
+                {
+                    munmap(const_cast<char*>(m_data), m_size);
+                }
+#endif
             }
-            return end - here;
-        }
 
-        template <class T>
-        bool WPod(std::FILE* f, const T& v)
-        {
-            return std::fwrite(&v, sizeof(T), 1, f) == 1;
-        }
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
 
-        template <class T>
-        bool RPod(std::FILE* f, T& v)
-        {
-            return std::fread(&v, sizeof(T), 1, f) == 1;
-        }
+            const char* Data() const { return m_data; }
+            size_t Size() const { return m_size; }
+
+        private:
+            MappedFile() = default;
+
+            const char* m_data = nullptr;
+            size_t m_size = 0;
+#ifdef _WIN32
+            HANDLE m_file = INVALID_HANDLE_VALUE;
+            HANDLE m_mapping = NULL;
+#endif
+        };
 
-        template <class T>
-        bool WVec(std::FILE* f, const std::vector<T>& v)
+        // The reader's side of an ArrayRef: bounds and alignment checked against the
+        // mapping BEFORE a view is formed, so a corrupt count or offset is a rejected
+        // file rather than a read outside it.
+        class TileReader
         {
-            const uint32_t n = uint32_t(v.size());
-            if (std::fwrite(&n, 4, 1, f) != 1)
+        public:
+            explicit TileReader(std::shared_ptr<const MappedFile> file)
+                : m_file(std::move(file))
             {
-                return false;
             }
-            return n == 0 || std::fwrite(v.data(), sizeof(T), n, f) == n;
-        }
 
-        template <class T>
-        bool RVec(std::FILE* f, std::vector<T>& v)
-        {
-            uint32_t n = 0;
-            if (std::fread(&n, 4, 1, f) != 1)
+            template <class T>
+            bool Array(const ArrayRef& ref, TileArray<T>& out) const
             {
-                return false;
+                if (ref.count == 0)
+                {
+                    out = TileArray<T>();
+                    return true;
+                }
+                if (ref.offset % alignof(T) != 0 ||
+                    uint64_t(ref.offset) + uint64_t(ref.count) * sizeof(T) > m_file->Size())
+                {
+                    return false;
+                }
+                out = TileArray<T>::View(reinterpret_cast<const T*>(m_file->Data() + ref.offset),
+                                         ref.count, m_file);
+                return true;
             }
-            const long left = RemainingBytes(f);
-            if (left < 0 || uint64_t(n) * sizeof(T) > uint64_t(left))
+
+            // A record is copied out rather than viewed: there are few of them, and a
+            // copy is free of any question about the alignment of the field it sits in.
+            template <class T>
+            bool Record(const ArrayRef& table, uint32_t index, T& out) const
             {
-                return false;
+                const uint64_t at = uint64_t(table.offset) + uint64_t(index) * sizeof(T);
+                if (index >= table.count || at + sizeof(T) > m_file->Size())
+                {
+                    return false;
+                }
+                std::memcpy(&out, m_file->Data() + at, sizeof(T));
+                return true;
             }
-            v.resize(n);
-            return n == 0 || std::fread(v.data(), sizeof(T), n, f) == n;
-        }
 
-        template <class T, size_t N>
-        bool WArray(std::FILE* f, const std::array<T, N>& a)
-        {
-            return std::fwrite(a.data(), sizeof(T), N, f) == N;
-        }
+        private:
+            std::shared_ptr<const MappedFile> m_file;
+        };
 
-        template <class T, size_t N>
-        bool RArray(std::FILE* f, std::array<T, N>& a)
+        // The writer's side: the whole file is assembled in memory, arrays first, so
+        // every record can carry its arrays' final offsets, then written in one go.
+        class TileBuilder
         {
-            return std::fread(a.data(), sizeof(T), N, f) == N;
-        }
+        public:
+            TileBuilder() : m_bytes(sizeof(FileHeader), 0) {}
+
+            template <class T>
+            ArrayRef Array(const T* data, size_t count)
+            {
+                ArrayRef ref;
+                if (count == 0)
+                {
+                    return ref;
+                }
+                Align();
+                ref.offset = uint32_t(m_bytes.size());
+                ref.count = uint32_t(count);
+                const char* bytes = reinterpret_cast<const char*>(data);
+                m_bytes.insert(m_bytes.end(), bytes, bytes + count * sizeof(T));
+                return ref;
+            }
+
+            template <class C>
+            ArrayRef Array(const C& c)
+            {
+                return Array(c.data(), c.size());
+            }
+
+            void SetHeader(FileHeader header)
+            {
+                header.fileSize = uint32_t(m_bytes.size());
+                std::memcpy(m_bytes.data(), &header, sizeof(header));
+            }
+
+            bool Fits() const
+            {
+                return m_bytes.size() <= std::numeric_limits<uint32_t>::max();
+            }
+
+            const std::vector<char>& Bytes() const { return m_bytes; }
+
+        private:
+            void Align()
+            {
+                m_bytes.resize((m_bytes.size() + ARRAY_ALIGN - 1) / ARRAY_ALIGN * ARRAY_ALIGN, 0);
+            }
+
+            std::vector<char> m_bytes;
+        };
 
         // MLIQ is a (tilesX+1) x (tilesY+1) grid of corner heights over a tilesX x tilesY
         // grid of flags. WmoModel::LiquidLocal interpolates the four corners around a
         // point with no bounds test, so a pair of counts that does not match the vectors
         // is an out-of-bounds read at query time -- long after the file was accepted.
         bool LiquidSizesOk(uint32_t tilesX, uint32_t tilesY,
-                           const std::vector<float>& heights,
-                           const std::vector<uint8_t>& flags)
+                           const TileArray<float>& heights,
+                           const TileArray<uint8_t>& flags)
         {
             if (tilesX == 0 || tilesY == 0)
             {
@@ -165,40 +371,6 @@ namespace world::terrain
             return std::fabs(det - 1.0f) < eps || std::fabs(det + 1.0f) < eps;
         }
 
-        bool WriteGroup(std::FILE* f, const WmoModel::Group& g)
-        {
-            bool ok = WPod(f, g.mogpFlags) && WPod(f, g.groupWmoId);
-            const uint8_t hasLiquid = g.hasLiquid ? 1 : 0;
-            ok = ok && WPod(f, hasLiquid);
-            if (g.hasLiquid)
-            {
-                ok = ok && LiquidSizesOk(g.liquid.tilesX, g.liquid.tilesY,
-                                         g.liquid.heights, g.liquid.flags);
-                ok = ok && WPod(f, g.liquid.tilesX) && WPod(f, g.liquid.tilesY) &&
-                     WPod(f, g.liquid.corner) && WPod(f, g.liquid.entry) &&
-                     WPod(f, g.liquid.kind) && WVec(f, g.liquid.heights) &&
-                     WVec(f, g.liquid.flags);
-            }
-            return ok;
-        }
-
-        bool ReadGroup(std::FILE* f, WmoModel::Group& g)
-        {
-            bool ok = RPod(f, g.mogpFlags) && RPod(f, g.groupWmoId);
-            uint8_t hasLiquid = 0;
-            ok = ok && RPod(f, hasLiquid);
-            g.hasLiquid = hasLiquid != 0;
-            if (ok && g.hasLiquid)
-            {
-                ok = RPod(f, g.liquid.tilesX) && RPod(f, g.liquid.tilesY) &&
-                     RPod(f, g.liquid.corner) && RPod(f, g.liquid.entry) &&
-                     RPod(f, g.liquid.kind) && RVec(f, g.liquid.heights) &&
-                     RVec(f, g.liquid.flags);
-                ok = ok && LiquidSizesOk(g.liquid.tilesX, g.liquid.tilesY,
-                                         g.liquid.heights, g.liquid.flags);
-            }
-            return ok;
-        }
     }
 
     std::string TileFileName(uint32_t mapId, int tx, int ty)
@@ -224,24 +396,29 @@ namespace world::terrain
 
     bool WriteTile(const TerrainTile& tile, const std::string& path)
     {
-        std::FILE* f = std::fopen(path.c_str(), "wb");
-        if (!f)
+        if (!TerrainGridSizesOk(tile))
         {
             return false;
         }
 
-        const uint8_t hasTerrain = tile.hasTerrain ? 1 : 0;
-        const uint8_t globalWmo = tile.isGlobalWmo ? 1 : 0;
-        const uint8_t hasLiquid = tile.hasLiquid ? 1 : 0;
-
-        bool ok = TerrainGridSizesOk(tile);
-        ok = ok && WPod(f, MAGIC) && WPod(f, VERSION) && WPod(f, tile.tx) &&
-                  WPod(f, tile.ty) && WPod(f, hasTerrain) && WPod(f, globalWmo) &&
-                  WVec(f, tile.v9) && WVec(f, tile.v8) && WArray(f, tile.holes) &&
-                  WArray(f, tile.areaIds) && WPod(f, hasLiquid) &&
-                  WVec(f, tile.liquidHeight) && WVec(f, tile.liquidShow) &&
-                  WVec(f, tile.liquidKind) && WVec(f, tile.liquidEntry) &&
-                  WVec(f, tile.liquidDeep);
+        TileBuilder out;
+        FileHeader header;
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.tx = tile.tx;
+        header.ty = tile.ty;
+        header.hasTerrain = tile.hasTerrain ? 1 : 0;
+        header.isGlobalWmo = tile.isGlobalWmo ? 1 : 0;
+        header.hasLiquid = tile.hasLiquid ? 1 : 0;
+        header.v9 = out.Array(tile.v9);
+        header.v8 = out.Array(tile.v8);
+        header.holes = tile.holes;
+        header.areaIds = tile.areaIds;
+        header.liquidHeight = out.Array(tile.liquidHeight);
+        header.liquidShow = out.Array(tile.liquidShow);
+        header.liquidKind = out.Array(tile.liquidKind);
+        header.liquidEntry = out.Array(tile.liquidEntry);
+        header.liquidDeep = out.Array(tile.liquidDeep);
 
         // Deduped model table: a WMO instanced fifty times is written once and the
         // instances index it.
@@ -257,143 +434,200 @@ namespace world::terrain
             }
         }
 
-        const uint32_t nModels = uint32_t(models.size());
-        ok = ok && WPod(f, nModels);
-        for (const ICollisionModel* m : models)
+        bool ok = true;
+        std::vector<ModelRecord> modelRecords(models.size());
+        for (size_t i = 0; i < models.size(); ++i)
         {
-            const uint8_t kind = uint8_t(m->Kind());
-            ok = ok && WPod(f, kind);
+            const ICollisionModel* m = models[i];
+            ModelRecord& rec = modelRecords[i];
+            rec.kind = uint32_t(m->Kind());
+
+            // soup.tris is already in the BVH's leaf order, so nothing is rebuilt.
+            const auto* c = static_cast<const CollisionModel*>(m);
+            rec.verts = out.Array(c->Soup().verts);
+            rec.tris = out.Array(c->Soup().tris);
+            rec.nodes = out.Array(c->GetBvh().Nodes());
+
             if (m->Kind() == ModelKind::Wmo)
             {
                 const auto* w = static_cast<const WmoModel*>(m);
-                const uint32_t nGroups = uint32_t(w->Groups().size());
-                ok = ok && WPod(f, w->RootId()) && WPod(f, nGroups);
-                for (const WmoModel::Group& g : w->Groups())
+                rec.rootId = w->RootId();
+                rec.triGroup = out.Array(w->TriGroups());
+
+                std::vector<GroupRecord> groups(w->Groups().size());
+                for (size_t g = 0; g < groups.size(); ++g)
                 {
-                    ok = ok && WriteGroup(f, g);
+                    const WmoModel::Group& src = w->Groups()[g];
+                    GroupRecord& dst = groups[g];
+                    dst.mogpFlags = src.mogpFlags;
+                    dst.groupWmoId = src.groupWmoId;
+                    dst.hasLiquid = src.hasLiquid ? 1 : 0;
+                    if (src.hasLiquid)
+                    {
+                        ok = ok && LiquidSizesOk(src.liquid.tilesX, src.liquid.tilesY,
+                                                 src.liquid.heights, src.liquid.flags);
+                        dst.tilesX = src.liquid.tilesX;
+                        dst.tilesY = src.liquid.tilesY;
+                        dst.corner = src.liquid.corner;
+                        dst.entry = src.liquid.entry;
+                        dst.kind = src.liquid.kind;
+                        dst.heights = out.Array(src.liquid.heights);
+                        dst.flags = out.Array(src.liquid.flags);
+                    }
                 }
-                // soup.tris is already in the BVH's leaf order, so nothing is rebuilt.
-                ok = ok && WVec(f, w->Soup().verts) && WVec(f, w->Soup().tris) &&
-                     WVec(f, w->TriGroups()) && WVec(f, w->GetBvh().Nodes());
-            }
-            else
-            {
-                const auto* c = static_cast<const CollisionModel*>(m);
-                ok = ok && WVec(f, c->Soup().verts) && WVec(f, c->Soup().tris) &&
-                     WVec(f, c->GetBvh().Nodes());
+                rec.groups = out.Array(groups);
             }
         }
+        header.models = out.Array(modelRecords);
 
-        const uint32_t nInstances = uint32_t(tile.instances.size());
-        ok = ok && WPod(f, nInstances);
-        for (const StaticInstance& inst : tile.instances)
+        std::vector<InstanceRecord> instances(tile.instances.size());
+        for (size_t i = 0; i < instances.size(); ++i)
         {
+            const StaticInstance& inst = tile.instances[i];
+            InstanceRecord& rec = instances[i];
             auto found = modelIndex.find(inst.model.get());
-            const uint32_t idx = found != modelIndex.end() ? found->second : 0xFFFFFFFFu;
-            ok = ok && WPod(f, inst.xf.pos) && WArray(f, inst.xf.rot.m) &&
-                 WPod(f, inst.xf.scale) && WPod(f, inst.worldBounds.lo) &&
-                 WPod(f, inst.worldBounds.hi) && WPod(f, idx) && WPod(f, inst.adtId);
+            rec.pos = inst.xf.pos;
+            rec.rot = inst.xf.rot.m;
+            rec.scale = inst.xf.scale;
+            rec.lo = inst.worldBounds.lo;
+            rec.hi = inst.worldBounds.hi;
+            rec.model = found != modelIndex.end() ? found->second : 0xFFFFFFFFu;
+            rec.adtId = inst.adtId;
         }
+        header.instances = out.Array(instances);
+
+        out.SetHeader(header);
+        if (!ok || !out.Fits())
+        {
+            return false;
+        }
+
+        // Through a temporary name and a rename. The server maps tiles, and a file
+        // truncated in place under a live mapping is a fault on the next page touched,
+        // not a short read; a rename leaves the old file whole for whoever has it mapped.
+        const std::string tmp = path + ".tmp";
+        std::FILE* f = std::fopen(tmp.c_str(), "wb");
+        if (!f)
+        {
+            return false;
+        }
+        const std::vector<char>& bytes = out.Bytes();
+        ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
 
         // fclose is what flushes: a write that failed only in the buffer -- a full disk
         // is the ordinary way -- reports success here and leaves a truncated tile that
         // looks complete to every later reader.
         ok = (std::fclose(f) == 0) && ok;
-        if (!ok)
+        if (ok)
         {
+            // rename() will not replace an existing file on Windows.
             std::remove(path.c_str());
+            ok = std::rename(tmp.c_str(), path.c_str()) == 0;
+        }
+        if (!ok)
+        {
+            std::remove(tmp.c_str());
         }
         return ok;
     }
 
     std::shared_ptr<TerrainTile> ReadTile(const std::string& path)
     {
-        std::FILE* f = std::fopen(path.c_str(), "rb");
-        if (!f)
+        std::shared_ptr<const MappedFile> file = MappedFile::Open(path);
+        if (!file)
         {
             return nullptr;
         }
 
-        uint32_t magic = 0, version = 0;
-        if (!RPod(f, magic) || !RPod(f, version) || magic != MAGIC || version != VERSION)
+        FileHeader header;
+        std::memcpy(&header, file->Data(), sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION ||
+            header.fileSize != file->Size() || header.models.count > MAX_MODELS ||
+            header.instances.count > MAX_INSTANCES)
         {
-            std::fclose(f);
             return nullptr;
         }
 
+        const TileReader in(file);
         auto tile = std::make_shared<TerrainTile>();
-        uint8_t hasTerrain = 0, globalWmo = 0, hasLiquid = 0;
-
-        bool ok = RPod(f, tile->tx) && RPod(f, tile->ty) && RPod(f, hasTerrain) &&
-                  RPod(f, globalWmo) && RVec(f, tile->v9) && RVec(f, tile->v8) &&
-                  RArray(f, tile->holes) && RArray(f, tile->areaIds) &&
-                  RPod(f, hasLiquid) && RVec(f, tile->liquidHeight) &&
-                  RVec(f, tile->liquidShow) && RVec(f, tile->liquidKind) &&
-                  RVec(f, tile->liquidEntry) && RVec(f, tile->liquidDeep);
-
-        tile->hasTerrain = hasTerrain != 0;
-        tile->isGlobalWmo = globalWmo != 0;
-        tile->hasLiquid = hasLiquid != 0;
-        ok = ok && TerrainGridSizesOk(*tile);
-
-        uint32_t nModels = 0;
-        ok = ok && RPod(f, nModels) && nModels <= MAX_MODELS;
+        tile->tx = header.tx;
+        tile->ty = header.ty;
+        tile->hasTerrain = header.hasTerrain != 0;
+        tile->isGlobalWmo = header.isGlobalWmo != 0;
+        tile->hasLiquid = header.hasLiquid != 0;
+        tile->holes = header.holes;
+        tile->areaIds = header.areaIds;
+
+        bool ok = in.Array(header.v9, tile->v9) && in.Array(header.v8, tile->v8) &&
+                  in.Array(header.liquidHeight, tile->liquidHeight) &&
+                  in.Array(header.liquidShow, tile->liquidShow) &&
+                  in.Array(header.liquidKind, tile->liquidKind) &&
+                  in.Array(header.liquidEntry, tile->liquidEntry) &&
+                  in.Array(header.liquidDeep, tile->liquidDeep) &&
+                  TerrainGridSizesOk(*tile);
 
         std::vector<std::shared_ptr<const ICollisionModel>> models;
         if (ok)
         {
-            models.resize(nModels);
+            models.resize(header.models.count);
         }
 
-        for (uint32_t i = 0; ok && i < nModels; ++i)
+        for (uint32_t i = 0; ok && i < header.models.count; ++i)
         {
-            uint8_t kind = 0;
-            if (!RPod(f, kind))
+            ModelRecord rec;
+            TriSoup soup;
+            TileArray<Bvh::Node> nodes;
+            ok = in.Record(header.models, i, rec) && in.Array(rec.verts, soup.verts) &&
+                 in.Array(rec.tris, soup.tris) && in.Array(rec.nodes, nodes) &&
+                 soup.IndicesValid();
+
+            Bvh bvh;
+            ok = ok && bvh.Adopt(std::move(nodes), soup.tris.size());
+            if (!ok)
             {
-                ok = false;
                 break;
             }
 
-            TriSoup soup;
-            std::vector<Bvh::Node> nodes;
-
-            if (kind == uint8_t(ModelKind::Wmo))
+            if (rec.kind == uint32_t(ModelKind::Wmo))
             {
-                uint32_t rootId = 0, nGroups = 0;
-                ok = RPod(f, rootId) && RPod(f, nGroups) && nGroups <= MAX_GROUPS;
-                std::vector<WmoModel::Group> groups(ok ? nGroups : 0);
-                for (uint32_t g = 0; ok && g < nGroups; ++g)
+                ok = rec.groups.count <= MAX_GROUPS;
+                std::vector<WmoModel::Group> groups(ok ? rec.groups.count : 0);
+                for (uint32_t g = 0; ok && g < rec.groups.count; ++g)
                 {
-                    ok = ReadGroup(f, groups[g]);
+                    GroupRecord src;
+                    ok = in.Record(rec.groups, g, src);
+                    WmoModel::Group& dst = groups[g];
+                    dst.mogpFlags = src.mogpFlags;
+                    dst.groupWmoId = src.groupWmoId;
+                    dst.hasLiquid = src.hasLiquid != 0;
+                    if (ok && dst.hasLiquid)
+                    {
+                        dst.liquid.tilesX = src.tilesX;
+                        dst.liquid.tilesY = src.tilesY;
+                        dst.liquid.corner = src.corner;
+                        dst.liquid.entry = src.entry;
+                        dst.liquid.kind = src.kind;
+                        ok = in.Array(src.heights, dst.liquid.heights) &&
+                             in.Array(src.flags, dst.liquid.flags) &&
+                             LiquidSizesOk(src.tilesX, src.tilesY, dst.liquid.heights,
+                                           dst.liquid.flags);
+                    }
                 }
 
-                std::vector<uint16_t> triGroup;
-                ok = ok && RVec(f, soup.verts) && RVec(f, soup.tris) &&
-                     RVec(f, triGroup) && RVec(f, nodes) &&
-                     triGroup.size() == soup.tris.size() && soup.IndicesValid();
-
-                Bvh bvh;
-                ok = ok && bvh.Adopt(std::move(nodes), soup.tris.size());
+                TileArray<uint16_t> triGroup;
+                ok = ok && in.Array(rec.triGroup, triGroup) &&
+                     triGroup.size() == soup.tris.size();
                 if (ok)
                 {
                     models[i] = std::make_shared<WmoModel>(std::move(soup),
                                                            std::move(triGroup),
-                                                           std::move(groups), rootId,
+                                                           std::move(groups), rec.rootId,
                                                            std::move(bvh));
                 }
             }
-            else if (kind == uint8_t(ModelKind::Mesh))
+            else if (rec.kind == uint32_t(ModelKind::Mesh))
             {
-                ok = RVec(f, soup.verts) && RVec(f, soup.tris) && RVec(f, nodes) &&
-                     soup.IndicesValid();
-
-                Bvh bvh;
-                ok = ok && bvh.Adopt(std::move(nodes), soup.tris.size());
-                if (ok)
-                {
-                    models[i] = std::make_shared<CollisionModel>(std::move(soup),
-                                                                 std::move(bvh));
-                }
+                models[i] = std::make_shared<CollisionModel>(std::move(soup), std::move(bvh));
             }
             else
             {
@@ -401,36 +635,39 @@ namespace world::terrain
             }
         }
 
-        uint32_t nInstances = 0;
-        ok = ok && RPod(f, nInstances) && nInstances <= MAX_INSTANCES;
-        for (uint32_t i = 0; ok && i < nInstances; ++i)
+        if (ok)
         {
-            StaticInstance inst;
-            uint32_t idx = 0;
-            float scale = 1.0f;
-            ok = RPod(f, inst.xf.pos) && RArray(f, inst.xf.rot.m) &&
-                 RPod(f, scale) && RPod(f, inst.worldBounds.lo) &&
-                 RPod(f, inst.worldBounds.hi) && RPod(f, idx) && RPod(f, inst.adtId) &&
-                 inst.xf.pos.isFinite() && inst.worldBounds.lo.isFinite() &&
-                 inst.worldBounds.hi.isFinite() && RotationOk(inst.xf.rot);
+            tile->instances.reserve(header.instances.count);
+        }
+        for (uint32_t i = 0; ok && i < header.instances.count; ++i)
+        {
+            InstanceRecord rec;
+            Mat3 rot;
+            ok = in.Record(header.instances, i, rec);
+            rot.m = rec.rot;
+            ok = ok && rec.pos.isFinite() && rec.lo.isFinite() && rec.hi.isFinite() &&
+                 RotationOk(rot);
             if (ok)
             {
+                StaticInstance inst;
                 // Through the CLAMPING constructor, never by assigning the field. The
                 // comment on that constructor says a non-positive or non-finite scale
                 // is screened once, where a model is placed -- and this is the one place
                 // a scale enters the server without passing through it. A zero read off
                 // disk divides to infinity in worldToLocal, and every ray then misses
                 // the model instead of failing.
-                inst.xf = Transform(inst.xf.pos, inst.xf.rot, scale);
-                if (idx < models.size())
+                inst.xf = Transform(rec.pos, rot, rec.scale);
+                inst.worldBounds.lo = rec.lo;
+                inst.worldBounds.hi = rec.hi;
+                inst.adtId = rec.adtId;
+                if (rec.model < models.size())
                 {
-                    inst.model = models[idx];
+                    inst.model = models[rec.model];
                 }
                 tile->instances.push_back(std::move(inst));
             }
         }
 
-        std::fclose(f);
         return ok ? tile : nullptr;
     }
 }
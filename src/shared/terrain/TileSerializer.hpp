@@ -3,12 +3,15 @@
 // Flat binary form of an assembled TerrainTile: the height and liquid grids, the
 // collidable geometry of every model on it, and the BVH the baker built over each.
 // Reading the client MPQs -- decompression, hundreds of WMO group opens -- and
-// building the acceleration structures happens once, offline; a load is then a
-// single sequential read with none of it.
+// building the acceleration structures happens once, offline. A load then does none
+// of it, and does not even read the file: ReadTile maps it, checks it, and hands back
+// a tile whose grids, soups and node arrays are views of the mapping. What it builds is
+// the handful of records around them -- one per model, group and instance.
 //
 // Native-endian, same-machine cache, not a portable archive. Magic and version guard
 // the format: ReadTile returns nullptr on any mismatch or truncation, which the
-// caller treats as a miss and rebakes.
+// caller treats as a miss and rebakes. WriteTile replaces a file by renaming over it,
+// never by rewriting it in place, because a server may have the old one mapped.
 
 #include "terrain/Terrain.hpp"
 
@@ -10,7 +10,7 @@ namespace world::terrain
         constexpr float LIQUID_TILE_SIZE = 533.333f / 128.f;
     }
 
-    WmoModel::WmoModel(TriSoup soup, std::vector<uint16_t> triGroup,
+    WmoModel::WmoModel(TriSoup soup, TileArray<uint16_t> triGroup,
                        std::vector<Group> groups, uint32_t rootWmoId, Bvh bvh)
         : m_triGroup(std::move(triGroup)), m_groups(std::move(groups)), m_rootId(rootWmoId)
     {
@@ -18,7 +18,9 @@ namespace world::terrain
         m_bvh = std::move(bvh);
         if (m_bvh.Empty() && !m_soup.tris.empty())
         {
-            m_bvh.Build(m_soup, &m_triGroup, 4);
+            std::vector<uint16_t> triGroups = m_triGroup.ToVector();
+            m_bvh.Build(m_soup, &triGroups, 4);
+            m_triGroup = std::move(triGroups);
         }
         DeriveWmoBounds();
     }
@@ -0,0 +1,280 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+// The account lookup stage, with the login database replaced by a resolver that
+// records what it was asked. What the database would answer is WorldGateway's
+// business; what is checked here is the plumbing a restart storm leans on: a batch
+// never exceeds AuthLookup.BatchSize, every login hears back exactly once and with
+// its own verdict, and shutting down answers whatever was still queued.
+
+#include "TestHarness.h"
+#include "AccountLookupStage.h"
+#include "WorldGatewayAuth.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief A resolver that can be held shut, so logins pile up behind it.
+     *
+     * Answers every request with a status derived from its build, so a handler can
+     * tell whether the verdict it got was meant for it.
+     */
+    class FakeResolver
+    {
+        public:
+
+            FakeResolver() : m_held(false), m_inside(false) {}
+
+            AccountLookupStage::Resolver Get()
+            {
+                return [this](std::vector<const proto::AuthRequest*> const& requests,
+                              std::vector<proto::AuthLookup>& results)
+                {
+                    std::unique_lock<std::mutex> guard(m_lock);
+                    m_batches.push_back(requests.size());
+                    m_inside = true;
+                    m_changed.notify_all();
+                    m_changed.wait(guard, [this] { return !m_held; });
+                    m_inside = false;
+
+                    for (size_t i = 0; i < requests.size(); ++i)
+                    {
+                        results[i].status = VerdictFor(*requests[i]);
+                    }
+                };
+            }
+
+            void Hold()
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_held = true;
+            }
+
+            /// Block until the stage's thread is inside the resolver.
+            void WaitUntilInside()
+            {
+                std::unique_lock<std::mutex> guard(m_lock);
+                m_changed.wait(guard, [this] { return m_inside; });
+            }
+
+            void Release()
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_held = false;
+                m_changed.notify_all();
+            }
+
+            std::vector<size_t> Batches()
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_batches;
+            }
+
+            static proto::AuthStatus VerdictFor(proto::AuthRequest const& request)
+            {
+                return request.build % 2 ? proto::AuthStatus::Banned : proto::AuthStatus::Ok;
+            }
+
+        private:
+
+            std::mutex m_lock;
+            std::condition_variable m_changed;
+            bool m_held;
+            bool m_inside;
+            std::vector<size_t> m_batches;
+    };
+
+    proto::AuthRequest Login(uint32 build)
+    {
+        proto::AuthRequest request = proto::AuthRequest();
+        request.build = build;
+        request.account = "PLAYER" + std::to_string(build);
+        return request;
+    }
+
+    /// Counts answers per login and whether each one was the login's own.
+    struct Answers
+    {
+        explicit Answers(size_t logins) : calls(logins), wrong(0) {}
+
+        proto::IWorldGateway::AuthLookupHandler For(proto::AuthRequest const& request, size_t index)
+        {
+            proto::AuthStatus const expected = FakeResolver::VerdictFor(request);
+            return [this, index, expected](proto::AuthLookup const& lookup)
+            {
+                ++calls[index];
+                if (lookup.status != expected)
+                {
+                    ++wrong;
+                }
+            };
+        }
+
+        std::vector<std::atomic<int>> calls;
+        std::atomic<int> wrong;
+    };
+
+    AccountLookupStage::BatchLimit Limit(uint32 limit)
+    {
+        return [limit]() { return limit; };
+    }
+}
+
+TEST(AccountLookupStage_batches_never_exceed_the_configured_size)
+{
+    FakeResolver resolver;
+    AccountLookupStage stage(resolver.Get(), Limit(4));
+    Answers answers(11);
+
+    // The first login occupies the thread; the next ten queue behind it.
+    resolver.Hold();
+    stage.Enqueue(Login(0), answers.For(Login(0), 0));
+    resolver.WaitUntilInside();
+    for (uint32 i = 1; i < 11; ++i)
+    {
+        stage.Enqueue(Login(i), answers.For(Login(i), i));
+    }
+
+    resolver.Release();
+    stage.Stop();
+
+    std::vector<size_t> const batches = resolver.Batches();
+    REQUIRE(batches.size() == 4);
+    CHECK_EQ(batches[0], 1u);
+    CHECK_EQ(batches[1], 4u);
+    CHECK_EQ(batches[2], 4u);
+    CHECK_EQ(batches[3], 2u);
+
+    for (size_t i = 0; i < answers.calls.size(); ++i)
+    {
+        CHECK_EQ(answers.calls[i].load(), 1);
+    }
+    CHECK_EQ(answers.wrong.load(), 0);
+
+    AccountLookupStage::Stats stats;
+    stage.GetStats(stats);
+    CHECK_EQ(stats.lookups, 11u);
+    CHECK_EQ(stats.batches, 4u);
+    CHECK_EQ(stats.largestBatch, 4u);
+    CHECK_EQ(stats.peakQueued, 10u);
+    CHECK_EQ(stats.queued, 0u);
+}
+
+TEST(AccountLookupStage_reads_the_batch_size_per_batch_and_treats_zero_as_one)
+{
+    FakeResolver resolver;
+
+    // Zero for the first two batches, then a reload to eight.
+    std::atomic<int> asked(0);
+    AccountLookupStage stage(resolver.Get(),
+                             [&asked]() { return asked++ < 2 ? 0u : 8u; });
+    Answers answers(6);
+
+    resolver.Hold();
+    stage.Enqueue(Login(0), answers.For(Login(0), 0));
+    resolver.WaitUntilInside();
+    for (uint32 i = 1; i < 6; ++i)
+    {
+        stage.Enqueue(Login(i), answers.For(Login(i), i));
+    }
+
+    resolver.Release();
+    stage.Stop();
+
+    std::vector<size_t> const batches = resolver.Batches();
+    REQUIRE(batches.size() == 3);
+    CHECK_EQ(batches[0], 1u);
+    CHECK_EQ(batches[1], 1u);
+    CHECK_EQ(batches[2], 4u);
+    CHECK_EQ(answers.wrong.load(), 0);
+}
+
+TEST(AccountLookupStage_stop_answers_everything_still_queued)
+{
+    FakeResolver resolver;
+    AccountLookupStage stage(resolver.Get(), Limit(3));
+    Answers answers(8);
+
+    resolver.Hold();
+    stage.Enqueue(Login(0), answers.For(Login(0), 0));
+    resolver.WaitUntilInside();
+    for (uint32 i = 1; i < 8; ++i)
+    {
+        stage.Enqueue(Login(i), answers.For(Login(i), i));
+    }
+
+    // Stop while the thread is still stuck in the resolver with seven queued: it has
+    // to drain them, not drop them, before the join returns.
+    std::thread stopper([&stage]() { stage.Stop(); });
+    resolver.Release();
+    stopper.join();
+
+    for (size_t i = 0; i < answers.calls.size(); ++i)
+    {
+        CHECK_EQ(answers.calls[i].load(), 1);
+    }
+    CHECK_EQ(answers.wrong.load(), 0);
+
+    // Anything arriving after the stop is refused inline, never left hanging.
+    bool refused = false;
+    stage.Enqueue(Login(8), [&refused](proto::AuthLookup const& lookup)
+    {
+        refused = lookup.status == proto::AuthStatus::SystemError;
+    });
+    CHECK(refused);
+    CHECK_EQ(resolver.Batches().size(), 4u);
+
+    stage.Stop();
+}
+
+TEST(AccountLookupStage_stop_without_a_lookup_starts_no_thread)
+{
+    FakeResolver resolver;
+    AccountLookupStage stage(resolver.Get(), Limit(4));
+    stage.Stop();
+    stage.Stop();
+    CHECK(resolver.Batches().empty());
+}
+
+TEST(AccountKey_folds_latin_case_and_nothing_else)
+{
+    // The batched query gets rows back in the database's spelling; matching them to
+    // the logins that asked goes through this on both sides.
+    CHECK(AccountKey("player") == "PLAYER");
+    CHECK(AccountKey("PlAyEr1") == "PLAYER1");
+    CHECK(AccountKey("PLAYER") == "PLAYER");
+    CHECK(AccountKey("") == "");
+
+    // Only A-Z fold, as in Utf8ToUpperOnlyLatin: accented and Cyrillic letters keep
+    // their case, because the login database stored them that way.
+    CHECK(AccountKey("\xC3\xA9t\xC3\xA9") == "\xC3\xA9T\xC3\xA9");
+    CHECK(AccountKey("a\xD0\xB8\xD0\xB3") == "A\xD0\xB8\xD0\xB3");
+}
@@ -0,0 +1,91 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_BENCH_H
+#define MANGOS_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief The one timing loop and the one result line every mangos_bench case uses.
+ *
+ * A bench pits a data structure against the one it replaced on the same input, so
+ * each case is two BestOf() calls and a Report(). Keeping the loop here means every
+ * number in the output was taken the same way: the fastest of five runs, which on a
+ * shared build host is far steadier than the mean.
+ */
+namespace bench
+{
+    /// How many times BestOf() runs the work.
+    const uint32_t RUNS = 5;
+
+    /// The fastest of RUNS runs of @p work, in nanoseconds per one of @p count.
+    template <typename Work>
+    double BestOf(uint32_t count, Work&& work)
+    {
+        double best = 0.0;
+        for (uint32_t run = 0; run < RUNS; ++run)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            work();
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+            if (run == 0 || ns < best)
+            {
+                best = ns;
+            }
+        }
+        return best;
+    }
+
+    /// One contender's time, in nanoseconds per unit of work.
+    struct Timing
+    {
+        const char* name;
+        double      ns;
+    };
+
+    /// `<scenario>: <before> <t>, <after> <t> <per> (<speedup>x)`, one line per case.
+    inline void Report(const char* scenario, const Timing& before, const Timing& after, const char* per)
+    {
+        const double scale = before.ns >= 10000.0 ? 1000.0 : 1.0;
+        const char* unit = scale > 1.0 ? "us" : "ns";
+        std::printf("    %s: %s %.1f %s, %s %.1f %s %s (%.1fx)\n",
+                    scenario, before.name, before.ns / scale, unit,
+                    after.name, after.ns / scale, unit, per,
+                    after.ns > 0.0 ? before.ns / after.ns : 0.0);
+    }
+
+    /// `<scenario>: <name> <t> <per>`, for a case with nothing to race against.
+    inline void Report(const char* scenario, const Timing& only, const char* per)
+    {
+        const double scale = only.ns >= 10000.0 ? 1000.0 : 1.0;
+        std::printf("    %s: %s %.1f %s %s\n",
+                    scenario, only.name, only.ns / scale, scale > 1.0 ? "us" : "ns", per);
+    }
+}
+
+#endif
@@ -0,0 +1,213 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#include "TestHarness.h"
+#include "Bench.h"
+#include "CellPositionIndexFixture.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @brief The position columns against the grid's list walk, and what a move costs.
+ *
+ * The search is a FillAreaTargets-sized one over cells holding a few objects each up
+ * to a city's worth. Every move pays for the index too, so the relocation of each
+ * object in the nine cells is timed as well: through its slot, and by the GUID scan of
+ * its cell that the slot replaced.
+ */
+
+using namespace CellFixture;
+
+namespace
+{
+    /// Nine cells of @p density bodies each, laid out as one 100-yard square.
+    void LayOut(Cell* cells, std::vector<Body*>& owned, std::mt19937& rng, uint32 density)
+    {
+        for (uint32 c = 0; c < 9; ++c)
+        {
+            Populate(cells[c], owned, rng, density);
+        }
+
+        for (uint32 c = 0; c < 9; ++c)
+        {
+            float ox = float(c % 3) * 33.3333f;
+            float oy = float(c / 3) * 33.3333f;
+            cells[c].index.Clear();
+            for (Body* body = cells[c].head; body; body = body->next)
+            {
+                body->px += ox;
+                body->py += oy;
+                cells[c].index.Insert(body->slot, body, body->px, body->py, body->extent, body->typeMask, body->phaseMask);
+            }
+        }
+    }
+}
+
+TEST(CellPositionIndex_bench_area_search_at_varying_densities)
+{
+    // The 3x3 cells around a caster, a radius of eight, twenty or thirty yards, units
+    // of the caster's phase.
+    uint32 const densities[] = { 4, 8, 16, 64, 256 };
+    float const radii[] = { 8.0f, 20.0f, 30.0f };
+    uint32 const QUERIES = 20000;
+
+    for (uint32 density : densities)
+    {
+        std::mt19937 rng(density);
+        std::vector<Body*> owned;
+        Cell cells[9];
+        LayOut(cells, owned, rng, density);
+
+        for (float radius : radii)
+        {
+            std::uniform_real_distribution<float> centre(33.3333f, 66.6666f);
+            std::vector<float> xs, ys;
+            for (uint32 q = 0; q < QUERIES; ++q)
+            {
+                xs.push_back(centre(rng));
+                ys.push_back(centre(rng));
+            }
+
+            std::vector<Body*> out;
+            uint64 walkedHits = 0;
+            double walkNs = bench::BestOf(QUERIES, [&]()
+            {
+                walkedHits = 0;
+                for (uint32 q = 0; q < QUERIES; ++q)
+                {
+                    out.clear();
+                    for (Cell const& cell : cells)
+                    {
+                        walkedHits += WalkList(cell, xs[q], ys[q], radius, TYPE_UNIT, 1, out);
+                    }
+                }
+            });
+
+            uint64 filteredHits = 0;
+            double filterNs = bench::BestOf(QUERIES, [&]()
+            {
+                filteredHits = 0;
+                for (uint32 q = 0; q < QUERIES; ++q)
+                {
+                    out.clear();
+                    for (Cell const& cell : cells)
+                    {
+                        filteredHits += cell.index.CollectInCircle(xs[q], ys[q], radius, TYPE_UNIT, 1, out);
+                    }
+                }
+            });
+
+            char scenario[64];
+            std::snprintf(scenario, sizeof(scenario), "%3u a cell, radius %2.0f, %5.1f found",
+                          density, radius, double(filteredHits) / QUERIES);
+            bench::Report(scenario, { "list walk", walkNs }, { "columns", filterNs }, "a search");
+            CHECK_EQ(filteredHits, walkedHits);
+        }
+
+        Release(cells, 9, owned);
+    }
+}
+
+TEST(CellPositionIndex_bench_relocation)
+{
+    // Every object in the nine cells takes a step inside its cell, two hundred times.
+    uint32 const densities[] = { 4, 16, 64, 256 };
+    uint32 const ROUNDS = 200;
+
+    for (uint32 density : densities)
+    {
+        std::mt19937 rng(density);
+        std::vector<Body*> owned;
+        Cell cells[9];
+        LayOut(cells, owned, rng, density);
+
+        // The GUID column the scan searched, row for row.
+        std::vector<uint64> guids[9];
+        std::vector<std::pair<Body*, uint32> > movers;       // body, cell
+        for (uint32 c = 0; c < 9; ++c)
+        {
+            guids[c].resize(cells[c].index.Size());
+            for (Body* body = cells[c].head; body; body = body->next)
+            {
+                guids[c][body->slot.row] = body->guid;
+                movers.push_back(std::make_pair(body, c));
+            }
+        }
+        std::shuffle(movers.begin(), movers.end(), rng);
+        uint32 const moves = ROUNDS * uint32(movers.size());
+
+        uint64 scanned = 0;
+        double scanNs = bench::BestOf(moves, [&]()
+        {
+            for (uint32 round = 0; round < ROUNDS; ++round)
+            {
+                float const step = (round & 1) ? 0.5f : -0.5f;
+                for (std::pair<Body*, uint32> const& mover : movers)
+                {
+                    Body* body = mover.first;
+                    BodyIndex* index = &cells[mover.second].index;
+                    std::vector<uint64> const& column = guids[mover.second];
+                    BodyIndex::Slot found;
+                    for (uint32 row = 0; row < column.size(); ++row)
+                    {
+                        if (column[row] == body->guid)
+                        {
+                            found.index = index;
+                            found.row = row;
+                            break;
+                        }
+                    }
+                    scanned += found.row;
+                    index->Update(found, body->px + step, body->py, body->extent, body->phaseMask);
+                }
+            }
+        });
+
+        double slotNs = bench::BestOf(moves, [&]()
+        {
+            for (uint32 round = 0; round < ROUNDS; ++round)
+            {
+                float const step = (round & 1) ? 0.5f : -0.5f;
+                for (std::pair<Body*, uint32> const& mover : movers)
+                {
+                    Body* body = mover.first;
+                    body->slot.index->Update(body->slot, body->px + step, body->py, body->extent, body->phaseMask);
+                }
+            }
+        });
+
+        std::string const scenario = std::to_string(density) + " a cell";
+        bench::Report(scenario.c_str(), { "GUID scan", scanNs }, { "slot", slotNs }, "a move");
+        CHECK(scanned > 0);
+
+        Release(cells, 9, owned);
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_TESTS_CELL_POSITION_INDEX_FIXTURE_H
+#define MANGOS_TESTS_CELL_POSITION_INDEX_FIXTURE_H
+
+#include "CellPositionIndexImpl.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/**
+ * @file
+ * @brief Cells of stand-in grid objects, searched the grid's way and filed in the index.
+ *
+ * Shared by the unit tests, which hold the index to the list walk, and the benchmark,
+ * which times the two. The index is instantiated over the stand-ins themselves, so
+ * the rows point at real Bodies and nothing poses as a WorldObject.
+ */
+
+namespace CellFixture
+{
+    const uint16 TYPE_UNIT = 0x0008;
+    const uint16 TYPE_PLAYER = 0x0010;
+    const uint16 TYPE_GAMEOBJECT = 0x0020;
+
+    /// Stands in for a grid object: heap allocated, linked, and only ever asked through
+    /// a virtual call -- as the grid asks a WorldObject through its placement.
+    struct Body;
+
+    /// The map's index, filing Bodies.
+    typedef CellPositionIndexOf<Body> BodyIndex;
+
+    struct Body
+    {
+        virtual ~Body() {}
+        virtual bool WithinDist(float x, float y, float radius) const
+        {
+            float dx = px - x;
+            float dy = py - y;
+            float reach = radius + extent;
+            return dx * dx + dy * dy <= reach * reach;
+        }
+
+        float px, py, extent;
+        uint16 typeMask;
+        uint32 phaseMask;
+        uint64 guid;
+        BodyIndex::Slot slot;
+        Body* next;
+        char payload[480];                                  // the rest of a creature, roughly
+    };
+
+    struct Cell
+    {
+        Body* head;
+        BodyIndex index;
+    };
+
+    /// @p count bodies scattered over a 33-yard cell, allocated in random order so the
+    /// list hops about the heap the way a long-lived grid's does.
+    inline void Populate(Cell& cell, std::vector<Body*>& owned, std::mt19937& rng, uint32 count)
+    {
+        std::uniform_real_distribution<float> coord(0.0f, 33.3333f);
+        std::uniform_int_distribution<int> kind(0, 9);
+
+        std::vector<Body*> bodies;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            bodies.push_back(new Body());
+        }
+        std::shuffle(bodies.begin(), bodies.end(), rng);
+
+        cell.head = NULL;
+        for (Body* body : bodies)
+        {
+            int k = kind(rng);
+            body->px = coord(rng);
+            body->py = coord(rng);
+            body->extent = 0.4f + (k % 3) * 0.5f;
+            body->typeMask = k < 6 ? TYPE_UNIT : (k < 8 ? uint16(TYPE_UNIT | TYPE_PLAYER) : TYPE_GAMEOBJECT);
+            body->phaseMask = k == 9 ? 2 : 1;
+            body->guid = uint64(owned.size() + 1);
+            body->next = cell.head;
+            cell.head = body;
+            cell.index.Insert(body->slot, body, body->px, body->py, body->extent, body->typeMask, body->phaseMask);
+            owned.push_back(body);
+        }
+    }
+
+    /// The grid's way: every link, a type and phase check, then the virtual distance call.
+    inline uint32 WalkList(Cell const& cell, float x, float y, float radius, uint16 typeMask, uint32 phaseMask, std::vector<Body*>& out)
+    {
+        uint32 found = 0;
+        for (Body* body = cell.head; body; body = body->next)
+        {
+            if ((body->typeMask & typeMask) && (body->phaseMask & phaseMask) && body->WithinDist(x, y, radius))
+            {
+                out.push_back(body);
+                ++found;
+            }
+        }
+        return found;
+    }
+
+    /// Empties the cells' indexes, then frees their bodies: the rows must go first.
+    inline void Release(Cell* cells, uint32 count, std::vector<Body*>& owned)
+    {
+        for (uint32 c = 0; c < count; ++c)
+        {
+            cells[c].index.Clear();
+        }
+        for (Body* body : owned)
+        {
+            delete body;
+        }
+        owned.clear();
+    }
+}
+
+#endif
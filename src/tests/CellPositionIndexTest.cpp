@@ -0,0 +1,174 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+#include "CellPositionIndexFixture.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/**
+ * @file
+ * @brief The per-cell position columns behind area searches.
+ *
+ * The tests hold the index to the check it stands in front of: whatever the exact,
+ * extent-padded distance test would accept, the circle offers, and rows that moved,
+ * changed phase or left are seen as they are now. A row is found through its object's
+ * slot, so every removal must leave the slot of the row moved into the hole pointing
+ * at it. CellPositionIndexBench.cpp times the search and the relocation against the
+ * grid's list walk.
+ */
+
+using namespace CellFixture;
+
+namespace
+{
+    std::vector<Body*> Sorted(std::vector<Body*> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+}
+
+TEST(CellPositionIndex_circle_matches_the_exact_check)
+{
+    std::mt19937 rng(5);
+    std::vector<Body*> owned;
+    Cell cell;
+    Populate(cell, owned, rng, 300);
+    CHECK_EQ(cell.index.Size(), 300u);
+
+    std::uniform_real_distribution<float> coord(-5.0f, 38.0f);
+    uint32 mismatches = 0;
+    for (uint32 q = 0; q < 500; ++q)
+    {
+        float x = coord(rng);
+        float y = coord(rng);
+        float radius = float(q % 30);
+        std::vector<Body*> walked, filtered;
+        WalkList(cell, x, y, radius, TYPE_UNIT, 1, walked);
+        uint32 found = cell.index.CollectInCircle(x, y, radius, TYPE_UNIT, 1, filtered);
+        CHECK_EQ(found, uint32(filtered.size()));
+        if (Sorted(walked) != Sorted(filtered))
+        {
+            ++mismatches;
+        }
+    }
+    CHECK_EQ(mismatches, 0u);
+
+    Release(&cell, 1, owned);
+}
+
+TEST(CellPositionIndex_box_pads_by_extent)
+{
+    Body a, b;
+    BodyIndex index;
+    index.Insert(a.slot, &a, 10.0f, 10.0f, 1.5f, TYPE_UNIT, 1);
+    index.Insert(b.slot, &b, 20.0f, 10.0f, 0.5f, TYPE_UNIT, 1);
+
+    std::vector<Body*> out;
+    CHECK_EQ(index.CollectInBox(11.0f, 5.0f, 19.0f, 15.0f, TYPE_UNIT, 1, out), 1u);   // a's edge is in, b's is not
+    REQUIRE(out.size() == 1u);
+    CHECK(out[0] == &a);
+}
+
+TEST(CellPositionIndex_rows_follow_moves_phases_and_removal)
+{
+    Body a, b, c;
+    BodyIndex index;
+    index.Insert(a.slot, &a, 0.0f, 0.0f, 0.5f, TYPE_UNIT, 1);
+    index.Insert(b.slot, &b, 5.0f, 0.0f, 0.5f, TYPE_UNIT, 1);
+    index.Insert(c.slot, &c, 0.0f, 5.0f, 0.5f, TYPE_GAMEOBJECT, 1);
+    CHECK(a.slot.index == &index);
+
+    std::vector<Body*> out;
+    CHECK_EQ(index.CollectInCircle(0.0f, 0.0f, 2.0f, TYPE_UNIT, 1, out), 1u);
+
+    // b walks up to a; a shifts out of phase one.
+    index.Update(b.slot, 1.0f, 0.0f, 0.5f, 1);
+    index.Update(a.slot, 0.0f, 0.0f, 0.5f, 2);
+    out.clear();
+    CHECK_EQ(index.CollectInCircle(0.0f, 0.0f, 2.0f, TYPE_UNIT, 1, out), 1u);
+    REQUIRE(out.size() == 1u);
+    CHECK(out[0] == &b);
+
+    // The hole b leaves is filled by the last row, whose slot must follow it.
+    index.Remove(b.slot);
+    CHECK(b.slot.index == NULL);
+    CHECK_EQ(index.Size(), 2u);
+    CHECK_EQ(c.slot.row, 1u);
+    index.Update(c.slot, 0.0f, 1.0f, 0.5f, 1);
+    out.clear();
+    CHECK_EQ(index.CollectInCircle(0.0f, 0.0f, 2.0f, TYPE_GAMEOBJECT, 3, out), 1u);
+    REQUIRE(out.size() == 1u);
+    CHECK(out[0] == &c);
+
+    index.Clear();
+    CHECK_EQ(index.Size(), 0u);
+    CHECK(a.slot.index == NULL);
+    CHECK(c.slot.index == NULL);
+}
+
+TEST(CellPositionIndex_slots_survive_any_order_of_removal)
+{
+    std::mt19937 rng(9);
+    std::vector<Body*> owned;
+    Cell cell;
+    Populate(cell, owned, rng, 200);
+
+    // Drop half in random order, moving the rest as it goes: every surviving slot must
+    // still name the row holding its own object, where it now stands.
+    std::vector<Body*> order(owned);
+    std::shuffle(order.begin(), order.end(), rng);
+    std::uniform_real_distribution<float> coord(0.0f, 33.3333f);
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        cell.index.Remove(order[i]->slot);
+        for (uint32 j = i + 1; j < order.size(); j += 7)
+        {
+            Body* mover = order[j];
+            mover->px = coord(rng);
+            mover->py = coord(rng);
+            cell.index.Update(mover->slot, mover->px, mover->py, mover->extent, mover->phaseMask);
+        }
+    }
+    CHECK_EQ(cell.index.Size(), 100u);
+
+    uint32 lost = 0;
+    for (uint32 i = 100; i < order.size(); ++i)
+    {
+        Body* body = order[i];
+        std::vector<Body*> out;
+        cell.index.CollectInCircle(body->px, body->py, 0.0f, body->typeMask, body->phaseMask, out);
+        if (body->slot.index != &cell.index || std::find(out.begin(), out.end(), body) == out.end())
+        {
+            ++lost;
+        }
+    }
+    CHECK_EQ(lost, 0u);
+
+    Release(&cell, 1, owned);
+}
@@ -0,0 +1,309 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+// The client side of an asynchronous account lookup: CMSG_AUTH_SESSION goes out to
+// the gateway, the connection parks, and the verdict comes back as a task posted to
+// the connection's own thread. The gateway here answers whenever the test says so,
+// and the "network thread" is a queue the test drains by hand, so each ordering the
+// reactor can produce -- answer first, close first, input held in between -- is one
+// line of the test rather than a timing accident.
+
+#include "TestHarness.h"
+#include "ClientConnection.h"
+#include "Opcodes.h"
+
+#include "Auth/AuthCrypt.h"
+#include "Auth/BigNumber.h"
+#include "Auth/Sha1.h"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// Holds each lookup until the test answers it; records what reaches the world.
+    class PendingGateway : public proto::IWorldGateway
+    {
+        public:
+
+            proto::AuthLookup LookupAccount(const proto::AuthRequest&) override
+            {
+                ++syncLookups;
+                return proto::AuthLookup();
+            }
+
+            void LookupAccountAsync(const proto::AuthRequest& request,
+                                    AuthLookupHandler handler) override
+            {
+                requests.push_back(request);
+                handlers.push_back(std::move(handler));
+            }
+
+            proto::SessionId Attach(const proto::AuthRequest& request,
+                                    const std::shared_ptr<proto::IClientLink>&,
+                                    const std::shared_ptr<proto::AuthContext>&) override
+            {
+                attached.push_back(request.account);
+                return 7;
+            }
+
+            void TracePacket(proto::SessionId, const WorldPacket&, bool) override {}
+
+            void Deliver(proto::SessionId session, WorldPacket&& packet) override
+            {
+                delivered.push_back(uint32(packet.GetOpcode()));
+                deliveredTo = session;
+            }
+
+            void Detach(proto::SessionId) override {}
+
+            int syncLookups = 0;
+            std::vector<proto::AuthRequest> requests;
+            std::vector<AuthLookupHandler> handlers;
+            std::vector<std::string> attached;
+            std::vector<uint32> delivered;
+            proto::SessionId deliveredTo = proto::INVALID_SESSION_ID;
+    };
+
+    /// A connection wired the way the reactor wires one, minus the socket.
+    struct Wired
+    {
+        explicit Wired(PendingGateway& gateway)
+            : connection(std::make_shared<proto::ClientConnection>(gateway)), closes(0)
+        {
+            connection->setPeerAddress("192.0.2.1");
+            connection->setSender([this](const uint8_t* data, size_t len)
+            {
+                sent.insert(sent.end(), data, data + len);
+            });
+            connection->setCloser([this]() { ++closes; });
+            connection->setTaskPoster([this](std::function<void()> task)
+            {
+                posted.push_back(std::move(task));
+            });
+
+            challenge = connection->onConnect();
+        }
+
+        /// Run what the gateway's answer posted back, as the network thread would.
+        void RunPosted()
+        {
+            std::vector<std::function<void()> > tasks;
+            tasks.swap(posted);
+            for (std::function<void()>& task : tasks)
+            {
+                task();
+            }
+        }
+
+        /// The server half of the proof nonce, from SMSG_AUTH_CHALLENGE: after the
+        /// 4-byte header and the uint32 shuffle marker.
+        uint32 ServerSeed() const
+        {
+            uint32 seed;
+            std::memcpy(&seed, challenge.data() + 8, 4);
+            return seed;
+        }
+
+        std::shared_ptr<proto::ClientConnection> connection;
+        std::vector<uint8_t> challenge;
+        std::vector<uint8_t> sent;
+        std::vector<std::function<void()> > posted;
+        int closes;
+    };
+
+    /// One client->server frame: big-endian size, little-endian opcode, payload.
+    std::vector<uint8> Frame(uint16 opcode, const std::vector<uint8>& payload)
+    {
+        const uint32 size = uint32(payload.size()) + 4;
+
+        std::vector<uint8> out;
+        out.push_back(uint8((size >> 8) & 0xFF));
+        out.push_back(uint8(size & 0xFF));
+        out.push_back(uint8(opcode & 0xFF));
+        out.push_back(uint8((opcode >> 8) & 0xFF));
+        out.push_back(0);
+        out.push_back(0);
+        out.insert(out.end(), payload.begin(), payload.end());
+        return out;
+    }
+
+    std::string const ACCOUNT = "PLAYER";
+    uint32 const CLIENT_SEED = 0x01020304;
+
+    /// CMSG_AUTH_SESSION with the proof a client holding @p key would send.
+    std::vector<uint8> AuthSession(uint32 serverSeed, BigNumber& key)
+    {
+        uint8 const zero[4] = { 0, 0, 0, 0 };
+        Sha1Hash sha;
+        sha.UpdateData(ACCOUNT);
+        sha.UpdateData(zero, 4);
+        sha.UpdateData(reinterpret_cast<const uint8*>(&CLIENT_SEED), 4);
+        sha.UpdateData(reinterpret_cast<const uint8*>(&serverSeed), 4);
+        sha.UpdateBigNumbers(&key, NULL);
+        sha.Finalize();
+
+        ByteBuffer body;
+        body << uint32(12340) << uint32(0) << ACCOUNT << uint32(0) << CLIENT_SEED;
+        body << uint32(0) << uint32(0) << uint32(0) << uint64(0);
+        body.append(sha.GetDigest(), 20);
+
+        return Frame(CMSG_AUTH_SESSION,
+                     std::vector<uint8>(body.contents(), body.contents() + body.size()));
+    }
+
+    /// The one status byte of a bare SMSG_AUTH_RESPONSE, sent before the cipher is armed.
+    int AuthResponseStatus(std::vector<uint8_t> const& sent)
+    {
+        if (sent.size() != 5 || sent[2] != uint8(SMSG_AUTH_RESPONSE & 0xFF) ||
+            sent[3] != uint8(SMSG_AUTH_RESPONSE >> 8))
+        {
+            return -1;
+        }
+        return sent[4];
+    }
+}
+
+TEST(ClientConnection_refused_lookup_answers_on_the_connection_thread_then_closes)
+{
+    PendingGateway gateway;
+    Wired client(gateway);
+
+    BigNumber key;
+    key.SetRand(40 * 8);
+    std::vector<uint8> const login = AuthSession(client.ServerSeed(), key);
+    client.connection->onData(login.data(), login.size());
+
+    REQUIRE(gateway.handlers.size() == 1);
+    CHECK_EQ(gateway.syncLookups, 0);
+    CHECK(gateway.requests[0].account == ACCOUNT);
+    CHECK(gateway.requests[0].peerAddress == "192.0.2.1");
+
+    // The lookup thread answers; nothing happens until the connection's thread runs it.
+    proto::AuthLookup banned;
+    banned.status = proto::AuthStatus::Banned;
+    gateway.handlers[0](banned);
+    CHECK(client.sent.empty());
+    CHECK_EQ(client.closes, 0);
+
+    client.RunPosted();
+    CHECK_EQ(AuthResponseStatus(client.sent), int(proto::AuthStatus::Banned));
+    CHECK_EQ(client.closes, 1);
+    CHECK(gateway.attached.empty());
+}
+
+TEST(ClientConnection_answer_after_close_sends_nothing)
+{
+    PendingGateway gateway;
+    Wired client(gateway);
+
+    BigNumber key;
+    key.SetRand(40 * 8);
+    std::vector<uint8> const login = AuthSession(client.ServerSeed(), key);
+    client.connection->onData(login.data(), login.size());
+    REQUIRE(gateway.handlers.size() == 1);
+
+    // The peer hangs up while its lookup is out.
+    client.connection->Close();
+    CHECK_EQ(client.closes, 1);
+
+    proto::AuthLookup ok;
+    ok.status = proto::AuthStatus::Ok;
+    ok.sessionKey = key;
+    gateway.handlers[0](ok);
+    client.RunPosted();
+
+    CHECK(client.sent.empty());
+    CHECK(gateway.attached.empty());
+    CHECK_EQ(client.closes, 1);
+}
+
+TEST(ClientConnection_input_held_during_the_lookup_is_replayed_after_attach)
+{
+    PendingGateway gateway;
+    Wired client(gateway);
+
+    BigNumber key;
+    key.SetRand(40 * 8);
+    std::vector<uint8> const login = AuthSession(client.ServerSeed(), key);
+    client.connection->onData(login.data(), login.size());
+    REQUIRE(gateway.handlers.size() == 1);
+
+    // A packet that only decodes once the cipher is armed: its header is encrypted
+    // with the keystream the server will decrypt with. RC4 is an XOR stream, so a
+    // second instance running the same direction produces it.
+    AuthCrypt mirror;
+    mirror.Init(&key);
+    std::vector<uint8> ping = Frame(CMSG_PING, std::vector<uint8>(8, 0));
+    mirror.DecryptRecv(ping.data(), 6);
+
+    // Split across two reads, both while the lookup is out: held, not decoded.
+    client.connection->onData(ping.data(), 3);
+    client.connection->onData(ping.data() + 3, ping.size() - 3);
+    CHECK(gateway.delivered.empty());
+    CHECK_EQ(client.closes, 0);
+
+    proto::AuthLookup ok;
+    ok.status = proto::AuthStatus::Ok;
+    ok.sessionKey = key;
+    gateway.handlers[0](ok);
+    CHECK(gateway.attached.empty());
+
+    client.RunPosted();
+    REQUIRE(gateway.attached.size() == 1);
+    CHECK(gateway.attached[0] == ACCOUNT);
+    REQUIRE(gateway.delivered.size() == 1);
+    CHECK_EQ(gateway.delivered[0], uint32(CMSG_PING));
+    CHECK_EQ(gateway.deliveredTo, proto::SessionId(7));
+    CHECK_EQ(client.closes, 0);
+}
+
+TEST(ClientConnection_bad_proof_after_the_lookup_is_refused)
+{
+    PendingGateway gateway;
+    Wired client(gateway);
+
+    BigNumber key;
+    key.SetRand(40 * 8);
+    std::vector<uint8> const login = AuthSession(client.ServerSeed(), key);
+    client.connection->onData(login.data(), login.size());
+    REQUIRE(gateway.handlers.size() == 1);
+
+    // The account exists, but the client proved a different session key.
+    BigNumber other;
+    other.SetRand(40 * 8);
+    proto::AuthLookup ok;
+    ok.status = proto::AuthStatus::Ok;
+    ok.sessionKey = other;
+    gateway.handlers[0](ok);
+    client.RunPosted();
+
+    CHECK_EQ(AuthResponseStatus(client.sent), int(proto::AuthStatus::Failed));
+    CHECK_EQ(client.closes, 1);
+    CHECK(gateway.attached.empty());
+}
@@ -0,0 +1,123 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#include "TestHarness.h"
+#include "Bench.h"
+#include "ClientGuidSet.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief The sweep of the objects a client holds, against the copy-and-erase it replaced.
+ *
+ * A player in a city: a few hundred objects at the client, a sweep every visibility
+ * update that finds all but a handful again, and a HaveAtClient per object per build.
+ */
+
+namespace
+{
+    /// A creature guid as the server mints them: high guid, entry, counter.
+    ObjectGuid CreatureGuid(uint32 entry, uint32 counter)
+    {
+        return ObjectGuid((uint64(0xF130) << 48) | (uint64(entry) << 24) | counter);
+    }
+}
+
+TEST(ClientGuidSet_bench_sweep_against_copy_and_erase)
+{
+    uint32 const held[] = { 50, 300, 1500 };
+    uint32 const SWEEPS = 2000;
+
+    for (uint32 count : held)
+    {
+        std::mt19937 rng(count);
+        std::vector<ObjectGuid> objects;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            objects.push_back(CreatureGuid(1000 + rng() % 50, rng() & 0xFFFFFF));
+        }
+        std::sort(objects.begin(), objects.end());
+        objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
+
+        // Visit order is cell order, not guid order.
+        std::vector<ObjectGuid> visit(objects);
+        std::shuffle(visit.begin(), visit.end(), rng);
+        uint32 const stay = uint32(visit.size()) - 5;
+
+        std::set<ObjectGuid> tree(objects.begin(), objects.end());
+        ClientGuidSet flat;
+        for (ObjectGuid guid : objects)
+        {
+            flat.Insert(guid);
+        }
+
+        uint64 treeLeft = 0;
+        double const treeNs = bench::BestOf(SWEEPS, [&]()
+        {
+            for (uint32 s = 0; s < SWEEPS; ++s)
+            {
+                std::set<ObjectGuid> leftovers(tree);
+                for (uint32 i = 0; i < stay; ++i)
+                {
+                    treeLeft += tree.count(visit[i]);        // HaveAtClient
+                    leftovers.erase(visit[i]);
+                }
+                treeLeft += leftovers.size();
+            }
+        });
+
+        uint64 flatLeft = 0;
+        std::vector<ObjectGuid> left;
+        double const flatNs = bench::BestOf(SWEEPS, [&]()
+        {
+            for (uint32 s = 0; s < SWEEPS; ++s)
+            {
+                flat.BeginSweep();
+                for (uint32 i = 0; i < stay; ++i)
+                {
+                    flatLeft += flat.Contains(visit[i]);
+                    flat.MarkSeen(visit[i]);
+                }
+                left.clear();
+                flat.TakeUnseen(left);
+                flatLeft += left.size();
+                for (ObjectGuid guid : left)
+                {
+                    flat.Insert(guid);                       // back for the next round
+                }
+            }
+        });
+
+        std::string const scenario = std::to_string(objects.size()) + " held";
+        bench::Report(scenario.c_str(), { "std::set copy and erase", treeNs }, { "ClientGuidSet sweep", flatNs }, "a sweep");
+        CHECK_EQ(flatLeft, treeLeft);
+    }
+}
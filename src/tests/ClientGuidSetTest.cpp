@@ -0,0 +1,205 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+#include "ClientGuidSet.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+/**
+ * @file
+ * @brief The set of objects a client holds.
+ *
+ * A guid the set loses is an object the client keeps drawing after the server has
+ * forgotten it; a guid it keeps is one never destroyed. So the first test drives it
+ * and a std::set through the same long run of inserts and erases, with enough
+ * erases to exercise every way a probe run can be closed up. The sweep is checked
+ * against the copy-and-erase it replaces; ClientGuidSetBench.cpp times both.
+ */
+
+namespace
+{
+    /// A creature guid as the server mints them: high guid, entry, counter.
+    ObjectGuid CreatureGuid(uint32 entry, uint32 counter)
+    {
+        return ObjectGuid((uint64(0xF130) << 48) | (uint64(entry) << 24) | counter);
+    }
+
+    std::set<ObjectGuid> Members(ClientGuidSet const& set)
+    {
+        std::set<ObjectGuid> members;
+        for (ObjectGuid guid : set)
+        {
+            members.insert(guid);
+        }
+        return members;
+    }
+}
+
+TEST(ClientGuidSet_agrees_with_std_set)
+{
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<uint32> counter(1, 3000);
+    std::uniform_int_distribution<int> op(0, 9);
+
+    ClientGuidSet flat;
+    std::set<ObjectGuid> tree;
+    uint32 disagreements = 0;
+    for (uint32 i = 0; i < 200000; ++i)
+    {
+        ObjectGuid guid = CreatureGuid(1000 + counter(rng) % 7, counter(rng));
+        if (op(rng) < 5)
+        {
+            if (flat.Insert(guid) != tree.insert(guid).second)
+            {
+                ++disagreements;
+            }
+        }
+        else if (flat.Erase(guid) != (tree.erase(guid) == 1))
+        {
+            ++disagreements;
+        }
+
+        if (flat.Contains(guid) != (tree.count(guid) == 1))
+        {
+            ++disagreements;
+        }
+    }
+
+    CHECK_EQ(disagreements, 0u);
+    CHECK_EQ(flat.Size(), uint32(tree.size()));
+    CHECK(Members(flat) == tree);
+
+    flat.Clear();
+    CHECK(flat.Empty());
+    CHECK(!flat.Contains(*tree.begin()));
+    CHECK(!flat.Insert(ObjectGuid()));                       // the empty guid is never a member
+}
+
+TEST(ClientGuidSet_sweep_takes_what_was_not_seen)
+{
+    ClientGuidSet set;
+    for (uint32 i = 1; i <= 100; ++i)
+    {
+        set.Insert(CreatureGuid(1, i));
+    }
+
+    set.BeginSweep();
+    for (uint32 i = 1; i <= 100; i += 2)
+    {
+        CHECK(set.MarkSeen(CreatureGuid(1, i)));             // the odd ones are still in reach
+    }
+    set.Insert(CreatureGuid(2, 1));                          // walked into reach: seen
+    CHECK(!set.MarkSeen(CreatureGuid(3, 1)));                // never held: nothing to mark
+    CHECK(set.IsUnseen(CreatureGuid(1, 2)));
+    CHECK(!set.IsUnseen(CreatureGuid(1, 3)));
+    CHECK(set.Erase(CreatureGuid(1, 4)));                    // destroyed mid-sweep by someone else
+
+    std::vector<ObjectGuid> left;
+    set.TakeUnseen(left);
+    CHECK_EQ(uint32(left.size()), 49u);
+    CHECK_EQ(set.Size(), 51u);
+    for (ObjectGuid guid : left)
+    {
+        CHECK(!set.Contains(guid));
+        CHECK((guid.GetRawValue() & 1) == 0);
+    }
+
+    // The next sweep starts everyone unseen again.
+    set.BeginSweep();
+    left.clear();
+    set.TakeUnseen(left);
+    CHECK_EQ(uint32(left.size()), 51u);
+    CHECK(set.Empty());
+}
+
+TEST(ClientGuidSet_sweep_leaves_what_copy_and_erase_leaves)
+{
+    // A visibility update at a few crowd sizes: the objects visited again stay, the
+    // rest are taken, and the next round starts from what is held.
+    uint32 const held[] = { 50, 300, 1500 };
+
+    for (uint32 count : held)
+    {
+        std::mt19937 rng(count);
+        std::vector<ObjectGuid> objects;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            objects.push_back(CreatureGuid(1000 + rng() % 50, rng() & 0xFFFFFF));
+        }
+
+        std::set<ObjectGuid> tree(objects.begin(), objects.end());
+        ClientGuidSet flat;
+        for (ObjectGuid guid : objects)
+        {
+            flat.Insert(guid);
+        }
+
+        uint32 disagreements = 0;
+        for (uint32 round = 0; round < 20; ++round)
+        {
+            // Visit order is cell order, not guid order; some of the visited are new.
+            std::vector<ObjectGuid> visit(tree.begin(), tree.end());
+            std::shuffle(visit.begin(), visit.end(), rng);
+            visit.resize(visit.size() - visit.size() / 10);
+            for (uint32 i = 0; i < 5; ++i)
+            {
+                visit.push_back(CreatureGuid(2000 + round, rng() & 0xFFFFFF));
+            }
+
+            std::set<ObjectGuid> leftovers(tree);
+            flat.BeginSweep();
+            for (ObjectGuid guid : visit)
+            {
+                if (flat.Contains(guid) != (tree.count(guid) == 1))
+                {
+                    ++disagreements;
+                }
+                if (!flat.MarkSeen(guid))
+                {
+                    flat.Insert(guid);
+                }
+                tree.insert(guid);
+                leftovers.erase(guid);
+            }
+
+            std::vector<ObjectGuid> left;
+            flat.TakeUnseen(left);
+            for (ObjectGuid guid : leftovers)
+            {
+                tree.erase(guid);
+            }
+
+            if (std::set<ObjectGuid>(left.begin(), left.end()) != leftovers || Members(flat) != tree)
+            {
+                ++disagreements;
+            }
+        }
+        CHECK_EQ(disagreements, 0u);
+    }
+}
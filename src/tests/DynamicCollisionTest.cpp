@@ -161,6 +161,41 @@ TEST(DynamicCollisionRespectsThePhaseMask)
     CHECK(!world.IsInLineOfSight(-20.f, 0.f, 0.f, 20.f, 0.f, 0.f, 3));
 }
 
+TEST(DynamicCollisionBatchAnswersEachSegmentAsTheScalarQueryDoes)
+{
+    // Two bodies, one in another phase, and six lines from one caster: through both,
+    // through the phased one only, past both, and a degenerate one. Six is one full
+    // packet and a partial one.
+    DynamicCollision world;
+    Body wall(3.f, Vector3{0.f, 0.f, 0.f});
+    Body phased(3.f, Vector3{0.f, 20.f, 0.f}, /*phase*/ 2);
+    REQUIRE(wall.model != nullptr);
+    REQUIRE(phased.model != nullptr);
+    world.Insert(*wall.model);
+    world.Insert(*phased.model);
+
+    const Vector3 caster{-20.f, 0.f, 0.f};
+    const Vector3 from[] = {caster, caster, caster, caster, caster, caster};
+    const Vector3 to[] = {{20.f, 0.f, 0.f},  {20.f, 40.f, 0.f}, {20.f, 2.f, 0.f},
+                          {-20.f, 50.f, 0.f}, {-40.f, 0.f, 0.f}, caster};
+
+    float fracs[6];
+    world.NearestHitFractions(from, to, 6, 1, fracs);
+    for (int i = 0; i < 6; ++i)
+    {
+        const float scalar = world.NearestHitFraction(from[i].x, from[i].y, from[i].z,
+                                                      to[i].x, to[i].y, to[i].z, 1);
+        CHECK((fracs[i] > 1.0f) == (scalar > 1.0f));
+        if (scalar <= 1.0f)
+        {
+            CHECK(std::fabs(fracs[i] - scalar) < 1e-5f);
+        }
+    }
+    CHECK(fracs[0] <= 1.0f);
+    CHECK(fracs[1] > 1.0f);     // the body it crosses is not in phase 1
+    CHECK(fracs[5] > 1.0f);
+}
+
 TEST(DynamicCollisionReportsTheSurfaceUnderAColumn)
 {
     DynamicCollision world;
@@ -0,0 +1,113 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#include "TestHarness.h"
+#include "Bench.h"
+
+#include "Utilities/EventProcessor.h"
+#include "MultimapEventProcessor.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief What the timing wheel bought over the multimap, on the load that matters.
+ *
+ * Units that re-arm a relocation notify every few hundred milliseconds: most hold one
+ * or two events and stay on the sorted list, a few busy ones hold dozens and build the
+ * wheel. Both are timed. The equivalence checks are in EventProcessorTest.cpp.
+ */
+
+namespace
+{
+    /// A unit's relocation notify: runs, and the unit schedules the next one afresh.
+    template <class Processor>
+    struct NotifyEvent : public BasicEvent
+    {
+        NotifyEvent(Processor& owner, uint64& ran) : m_owner(owner), m_ran(ran) {}
+
+        bool Execute(uint64, uint32) override
+        {
+            ++m_ran;
+            m_owner.AddEvent(new NotifyEvent(m_owner, m_ran), m_owner.CalculateTime(200 + m_ran % 200));
+            return true;
+        }
+
+        Processor& m_owner;
+        uint64& m_ran;
+    };
+
+    uint32 const TICKS = 200;
+
+    /// Nanoseconds per Update() of one unit, over TICKS ticks of 50 ms per run.
+    template <class Processor>
+    double NanosecondsPerUpdate(int units, int eventsEach, uint64& ran)
+    {
+        std::vector<Processor> processors(units);
+        for (int i = 0; i < units; ++i)
+        {
+            for (int e = 0; e < eventsEach; ++e)
+            {
+                processors[i].AddEvent(new NotifyEvent<Processor>(processors[i], ran), processors[i].CalculateTime((i + e * 37) % 400));
+            }
+        }
+
+        // Each run carries on from where the last stopped: the load is steady, so
+        // every run sees the same mix.
+        return bench::BestOf(TICKS * units, [&]()
+        {
+            for (uint32 tick = 0; tick < TICKS; ++tick)
+            {
+                for (int i = 0; i < units; ++i)
+                {
+                    processors[i].Update(50);
+                }
+            }
+        });
+    }
+
+    void Compare(int units, int eventsEach)
+    {
+        uint64 ranMultimap = 0;
+        uint64 ranWheel = 0;
+        double multimap = NanosecondsPerUpdate<MultimapEventProcessor>(units, eventsEach, ranMultimap);
+        double wheel = NanosecondsPerUpdate<EventProcessor>(units, eventsEach, ranWheel);
+
+        std::string const scenario = std::to_string(units) + " units x " + std::to_string(eventsEach) + " events";
+        bench::Report(scenario.c_str(), { "multimap", multimap }, { "EventProcessor", wheel }, "a unit a tick");
+        CHECK_EQ(ranWheel, ranMultimap);
+    }
+}
+
+TEST(EventProcessor_bench_rearming_notifies)
+{
+    // Runs of ten seconds of 50 ms ticks: 5000 units with one notify each, the relocation
+    // load of a busy map, then a few hundred units carrying fifty events apiece.
+    Compare(5000, 1);
+    Compare(5000, 4);
+    Compare(500, 50);
+}
@@ -0,0 +1,318 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "Utilities/EventProcessor.h"
+#include "MultimapEventProcessor.h"
+
+#include <random>
+#include <vector>
+
+/**
+ * @file
+ * @brief The timing-wheel EventProcessor: same events, same order, as the multimap it replaced.
+ *
+ * Spells, despawns and relocation notifies are all BasicEvents, and they rely on the
+ * old contract to the letter: an event runs in the Update that reaches its time, in
+ * time order, ties in the order they were added; an event re-added from Execute keeps
+ * its object; aborted and non-deletable events get their Abort calls as before. So
+ * the main test replays one random schedule through both processors and asks for an
+ * identical log. A processor with few events never builds its wheel, so the schedules
+ * cross that line both between updates and in the middle of one. The timings are in
+ * EventProcessorBench.cpp.
+ */
+
+namespace
+{
+    struct LogEntry
+    {
+        uint32 id;
+        uint64 time;
+        char what;                                          // 'x' executed, 'a' aborted
+
+        bool operator==(LogEntry const& other) const
+        {
+            return id == other.id && time == other.time && what == other.what;
+        }
+    };
+
+    struct Script
+    {
+        std::vector<LogEntry> log;
+        uint32 nextId = 1;
+    };
+
+    uint32 Mix(uint32 a, uint32 b)
+    {
+        uint32 h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u);
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        return h;
+    }
+
+    /// An event whose behaviour is a function of its id and run count only, so it does
+    /// the same things under either processor.
+    template <class Processor>
+    class ScriptedEvent : public BasicEvent
+    {
+        public:
+            ScriptedEvent(Processor& owner, Script& script, uint32 depth)
+                : m_owner(owner), m_script(script), m_id(script.nextId++), m_depth(depth), m_runs(0)
+            {
+            }
+
+            bool Execute(uint64 e_time, uint32 /*p_time*/) override
+            {
+                LogEntry entry = { m_id, e_time, 'x' };
+                m_script.log.push_back(entry);
+
+                uint32 h = Mix(m_id, m_runs++);
+                if (m_depth < 3 && h % 4 == 0)
+                {
+                    // Children may be due at once, in this very Update.
+                    m_owner.AddEvent(new ScriptedEvent(m_owner, m_script, m_depth + 1), m_owner.CalculateTime((h >> 4) % 300));
+                }
+                if (h % 5 == 0 && m_runs < 4)
+                {
+                    // As SpellEvent does: the same object, again, later.
+                    m_owner.AddEvent(this, e_time + 1 + (h >> 8) % 2000, false);
+                    return false;
+                }
+                return true;
+            }
+
+            bool IsDeletable() const override { return m_id % 3 != 0; }
+
+            void Abort(uint64 e_time) override
+            {
+                LogEntry entry = { m_id, e_time, 'a' };
+                m_script.log.push_back(entry);
+            }
+
+        private:
+            Processor& m_owner;
+            Script& m_script;
+            uint32 m_id;
+            uint32 m_depth;
+            uint32 m_runs;
+    };
+
+    template <class Processor>
+    std::vector<LogEntry> RunScript(uint32 seed)
+    {
+        Script script;
+        {
+            Processor processor;
+            std::mt19937 rng(seed);
+
+            for (int step = 0; step < 400; ++step)
+            {
+                int adds = int(rng() % 4);
+                for (int i = 0; i < adds; ++i)
+                {
+                    uint64 at;
+                    switch (rng() % 6)
+                    {
+                        case 0:  at = processor.CalculateTime(0); break;
+                        case 1:  at = processor.CalculateTime(0) - std::min<uint64>(processor.CalculateTime(0), rng() % 500); break;
+                        case 2:  at = processor.CalculateTime(rng() % 40); break;
+                        case 3:  at = processor.CalculateTime(rng() % 70000); break;
+                        case 4:  at = processor.CalculateTime(20000000 + rng() % 1000); break;    // past the wheel
+                        default: at = processor.CalculateTime(rng() % 3000); break;
+                    }
+                    processor.AddEvent(new ScriptedEvent<Processor>(processor, script, 0), at);
+                }
+
+                uint32 p_time;
+                switch (rng() % 8)
+                {
+                    case 0:  p_time = 0; break;
+                    case 1:  p_time = 65536 + rng() % 10; break;
+                    case 2:  p_time = 5000000; break;
+                    default: p_time = 1 + rng() % 250; break;
+                }
+                processor.Update(p_time);
+            }
+
+            // Non-deletable events survive this, aborted, and are deleted when they come up.
+            processor.KillAllEvents(false);
+            processor.Update(1000);
+            processor.AddEvent(new ScriptedEvent<Processor>(processor, script, 3), processor.CalculateTime(10));
+        }
+        return script.log;
+    }
+}
+
+TEST(EventProcessor_runs_the_same_schedule_as_the_multimap)
+{
+    for (uint32 seed = 1; seed <= 20; ++seed)
+    {
+        std::vector<LogEntry> expected = RunScript<MultimapEventProcessor>(seed);
+        std::vector<LogEntry> actual = RunScript<EventProcessor>(seed);
+
+        REQUIRE(expected.size() > 100);
+        CHECK_EQ(actual.size(), expected.size());
+
+        size_t firstDifference = 0;
+        while (firstDifference < expected.size() && firstDifference < actual.size() &&
+               actual[firstDifference] == expected[firstDifference])
+        {
+            ++firstDifference;
+        }
+        CHECK_EQ(firstDifference, expected.size());
+    }
+}
+
+namespace
+{
+    struct CountingEvent : public BasicEvent
+    {
+        CountingEvent(int& runs, int& aborts, bool deletable = true)
+            : m_runs(runs), m_aborts(aborts), m_deletable(deletable) {}
+
+        bool Execute(uint64, uint32) override { ++m_runs; return true; }
+        void Abort(uint64) override { ++m_aborts; }
+        bool IsDeletable() const override { return m_deletable; }
+
+        int& m_runs;
+        int& m_aborts;
+        bool m_deletable;
+    };
+}
+
+TEST(EventProcessor_cancelled_event_is_gone_at_once)
+{
+    int runs = 0;
+    int aborts = 0;
+    EventProcessor processor;
+
+    BasicEvent* first = new CountingEvent(runs, aborts);
+    BasicEvent* second = new CountingEvent(runs, aborts);
+    BasicEvent* third = new CountingEvent(runs, aborts);
+    processor.AddEvent(first, processor.CalculateTime(100));
+    processor.AddEvent(second, processor.CalculateTime(100));
+    processor.AddEvent(third, processor.CalculateTime(5000000));
+
+    processor.CancelEvent(second);
+    processor.CancelEvent(third);
+    CHECK_EQ(aborts, 2);
+
+    processor.Update(10000000);
+    CHECK_EQ(runs, 1);
+    CHECK_EQ(aborts, 2);
+
+    // One that may not be deleted yet stays, aborted, and is aborted again when it comes up.
+    BasicEvent* busy = new CountingEvent(runs, aborts, false);
+    processor.AddEvent(busy, processor.CalculateTime(50));
+    processor.CancelEvent(busy);
+    CHECK_EQ(aborts, 3);
+    processor.Update(50);
+    CHECK_EQ(runs, 1);
+    CHECK_EQ(aborts, 4);
+}
+
+namespace
+{
+    /// Runs, and re-adds `fanout` children due in the same Update until `depth` runs out.
+    template <class Processor>
+    class BurstEvent : public BasicEvent
+    {
+        public:
+            BurstEvent(Processor& owner, Script& script, uint32 depth, uint32 fanout)
+                : m_owner(owner), m_script(script), m_id(script.nextId++), m_depth(depth), m_fanout(fanout) {}
+
+            bool Execute(uint64 e_time, uint32) override
+            {
+                LogEntry entry = { m_id, e_time, 'x' };
+                m_script.log.push_back(entry);
+                for (uint32 i = 0; m_depth && i < m_fanout; ++i)
+                {
+                    m_owner.AddEvent(new BurstEvent(m_owner, m_script, m_depth - 1, m_fanout), m_owner.CalculateTime(i % 2));
+                }
+                return true;
+            }
+
+        private:
+            Processor& m_owner;
+            Script& m_script;
+            uint32 m_id;
+            uint32 m_depth;
+            uint32 m_fanout;
+    };
+
+    template <class Processor>
+    std::vector<LogEntry> RunBurst()
+    {
+        Script script;
+        Processor processor;
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            processor.AddEvent(new BurstEvent<Processor>(processor, script, 3, 3), processor.CalculateTime(10 - i));
+        }
+        for (uint32 i = 0; i < 8; ++i)
+        {
+            processor.Update(5);
+        }
+        return script.log;
+    }
+}
+
+TEST(EventProcessor_builds_its_wheel_in_the_middle_of_an_update)
+{
+    // Four events fan out to well past the sorted list's limit, all due within the
+    // same few updates: the wheel is built while events are being run.
+    std::vector<LogEntry> expected = RunBurst<MultimapEventProcessor>();
+    std::vector<LogEntry> actual = RunBurst<EventProcessor>();
+
+    REQUIRE(expected.size() == 4 * (1 + 3 + 9 + 27));
+    CHECK_EQ(actual.size(), expected.size());
+    CHECK(actual == expected);
+}
+
+TEST(EventProcessor_cancels_on_the_wheel)
+{
+    int runs = 0;
+    int aborts = 0;
+    EventProcessor processor;
+
+    std::vector<BasicEvent*> events;
+    for (uint32 i = 0; i < 40; ++i)
+    {
+        events.push_back(new CountingEvent(runs, aborts));
+        processor.AddEvent(events.back(), processor.CalculateTime(i * 997 % 7000000));
+    }
+
+    for (uint32 i = 0; i < 40; i += 2)
+    {
+        processor.CancelEvent(events[i]);
+    }
+    CHECK_EQ(aborts, 20);
+
+    processor.Update(8000000);
+    CHECK_EQ(runs, 20);
+    CHECK_EQ(aborts, 20);
+}
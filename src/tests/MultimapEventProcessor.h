@@ -0,0 +1,113 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_TESTS_MULTIMAP_EVENT_PROCESSOR_H
+#define MANGOS_TESTS_MULTIMAP_EVENT_PROCESSOR_H
+
+#include "Utilities/EventProcessor.h"
+
+#include <map>
+
+/**
+ * @file
+ * @brief The reference EventProcessor: the multimap the timing wheel replaced.
+ *
+ * The unit test replays schedules through both and compares the logs; the benchmark
+ * times both in mangos_bench.
+ */
+
+/// EventProcessor as it was: one multimap, ordered by time.
+class MultimapEventProcessor
+{
+    public:
+        ~MultimapEventProcessor() { KillAllEvents(true); }
+
+        void Update(uint32 p_time)
+        {
+            m_time += p_time;
+
+            std::multimap<uint64, BasicEvent*>::iterator i;
+            while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+            {
+                BasicEvent* Event = i->second;
+                m_events.erase(i);
+
+                if (!Event->to_Abort)
+                {
+                    if (Event->Execute(m_time, p_time))
+                    {
+                        delete Event;
+                    }
+                }
+                else
+                {
+                    Event->Abort(m_time);
+                    delete Event;
+                }
+            }
+        }
+
+        void KillAllEvents(bool force)
+        {
+            for (std::multimap<uint64, BasicEvent*>::iterator i = m_events.begin(); i != m_events.end();)
+            {
+                std::multimap<uint64, BasicEvent*>::iterator i_old = i;
+                ++i;
+
+                i_old->second->to_Abort = true;
+                i_old->second->Abort(m_time);
+                if (force || i_old->second->IsDeletable())
+                {
+                    delete i_old->second;
+                    if (!force)
+                    {
+                        m_events.erase(i_old);
+                    }
+                }
+            }
+            if (force)
+            {
+                m_events.clear();
+            }
+        }
+
+        void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true)
+        {
+            if (set_addtime)
+            {
+                Event->m_addTime = m_time;
+            }
+            Event->m_execTime = e_time;
+            m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+        }
+
+        uint64 CalculateTime(uint64 t_offset) const { return m_time + t_offset; }
+
+    private:
+        uint64 m_time = 0;
+        std::multimap<uint64, BasicEvent*> m_events;
+};
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "NetFanOut.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace netsockets;
+
+/// A session that only sends: the producers drive its Sender from other threads.
+class FanOutSession : public net::ISession
+{
+    public:
+
+        void setSender(net::Sender sender) override { m_sender = std::move(sender); }
+        std::vector<uint8_t> onData(const uint8_t*, size_t) override { return std::vector<uint8_t>(); }
+        void onClose() override { m_closed.store(true); }
+        bool closed() const override { return m_closed.load(); }
+
+        void send(const uint8* data, size_t len) const { m_sender(data, len); }
+
+    private:
+
+        net::Sender       m_sender;
+        std::atomic<bool> m_closed{false};
+};
+
+namespace
+{
+    /// One fan-out packet: who sent it, its place in that sender's stream, and a check word.
+    const size_t FRAME_SIZE = 12;
+
+    inline uint32 FrameCheck(uint32 producer, uint32 seq)
+    {
+        return (producer * 2654435761u) ^ seq ^ 0x5EED5EEDu;
+    }
+}
+
+FanOut::FanOut(uint16 port, int clients, int producers, uint32 packets)
+    : m_clients(clients), m_producers(producers), m_packets(packets), m_bound(false)
+{
+    m_bound = m_server.start(port,
+        [this]() -> std::shared_ptr<net::ISession>
+        {
+            auto session = std::make_shared<FanOutSession>();
+            std::lock_guard<std::mutex> lock(m_sessionsMu);
+            m_sessions.push_back(session);
+            return session;
+        },
+        "127.0.0.1");
+    if (!m_bound)
+    {
+        return;
+    }
+
+    for (int c = 0; c < clients; ++c)
+    {
+        socket_t s = ConnectTo(port);
+        if (s != INVALID_SOCKET)
+        {
+            m_sockets.push_back(s);
+        }
+    }
+    WaitFor([this]
+    {
+        std::lock_guard<std::mutex> lock(m_sessionsMu);
+        return int(m_sessions.size()) == int(m_sockets.size());
+    });
+}
+
+FanOut::~FanOut()
+{
+    for (socket_t s : m_sockets)
+    {
+        CLOSESOCKET(s);
+    }
+    m_server.stop();
+}
+
+bool FanOut::Ready() const
+{
+    std::lock_guard<std::mutex> lock(m_sessionsMu);
+    return m_bound && int(m_sockets.size()) == m_clients && int(m_sessions.size()) == m_clients;
+}
+
+FanOut::Round FanOut::Send()
+{
+    std::atomic<int> badFrames{0};
+    std::atomic<int> shortStreams{0};
+    std::atomic<int> readersDone{0};
+    std::vector<std::thread> readers;
+    for (socket_t s : m_sockets)
+    {
+        readers.emplace_back([&, s]
+        {
+            std::vector<uint32> nextSeq(m_producers, 0);
+            const uint64 expected = uint64(m_producers) * m_packets * FRAME_SIZE;
+            uint64 received = 0;
+
+            std::vector<uint8> buf(16384);
+            size_t held = 0;
+            while (received < expected)
+            {
+                // Never past this round's stream, so the next round starts on a frame.
+                const size_t room = size_t(std::min<uint64>(buf.size() - held, expected - received));
+                const int n = ::recv(s, reinterpret_cast<char*>(buf.data() + held), int(room), 0);
+                if (n <= 0)
+                {
+                    break;
+                }
+                held += size_t(n);
+                received += uint64(n);
+
+                size_t at = 0;
+                for (; at + FRAME_SIZE <= held; at += FRAME_SIZE)
+                {
+                    uint32 frame[3];
+                    std::memcpy(frame, &buf[at], FRAME_SIZE);
+                    if (frame[0] >= uint32(m_producers) || frame[1] != nextSeq[frame[0]] ||
+                        frame[2] != FrameCheck(frame[0], frame[1]))
+                    {
+                        badFrames.fetch_add(1);
+                        continue;
+                    }
+                    ++nextSeq[frame[0]];
+                }
+                std::memmove(buf.data(), buf.data() + at, held - at);
+                held -= at;
+            }
+            if (received != expected)
+            {
+                shortStreams.fetch_add(1);
+            }
+            readersDone.fetch_add(1);
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < m_producers; ++p)
+    {
+        producers.emplace_back([&, p]
+        {
+            // Round-robin over every connection, one packet each, as a map thread
+            // walking its players does.
+            for (uint32 seq = 0; seq < m_packets; ++seq)
+            {
+                uint32 frame[3] = { uint32(p), seq, FrameCheck(uint32(p), seq) };
+                for (const std::shared_ptr<FanOutSession>& session : m_sessions)
+                {
+                    session->send(reinterpret_cast<const uint8*>(frame), FRAME_SIZE);
+                }
+            }
+        });
+    }
+    for (std::thread& t : producers)
+    {
+        t.join();
+    }
+
+    // Readers return once their whole stream is in. One that never does is cut
+    // loose by the shutdown, and counts as a short stream.
+    if (!WaitFor([&] { return readersDone.load() == int(m_sockets.size()); }))
+    {
+        for (socket_t s : m_sockets)
+        {
+#ifdef _WIN32
+            ::shutdown(s, SD_BOTH);
+#else
+            ::shutdown(s, SHUT_RDWR);
+#endif
+        }
+    }
+    for (std::thread& t : readers)
+    {
+        t.join();
+    }
+
+    Round round;
+    round.badFrames = badFrames.load();
+    round.shortStreams = shortStreams.load();
+    return round;
+}
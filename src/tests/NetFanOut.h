@@ -0,0 +1,90 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_NETFANOUT_H
+#define MANGOS_NETFANOUT_H
+
+#include "NetSockets.h"
+#include "net/Server.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file
+ * @brief Several map threads sending small packets to the same connections at once.
+ *
+ * The shape of SendObjectUpdates: the sends all meet on the workers' ready lists.
+ * NetworkStressTest.cpp checks that every connection gets every packet, each
+ * producer's in order; mangos_bench times the same rounds.
+ */
+
+class FanOutSession;
+
+class FanOut
+{
+    public:
+
+        /// What one round delivered. A clean round has no bad frame and no short stream.
+        struct Round
+        {
+            int badFrames;      ///< frames out of order, duplicated or corrupt
+            int shortStreams;   ///< connections that did not get their whole stream
+        };
+
+        /// Start a server on @p port and connect @p clients to it.
+        FanOut(uint16 port, int clients, int producers, uint32 packets);
+        ~FanOut();
+
+        /// False if the port could not be bound: a busy port is not a defect here.
+        bool Bound() const { return m_bound; }
+
+        /// Every client connected and has its session.
+        bool Ready() const;
+
+        /// @p producers threads each send @p packets to every connection, round robin,
+        /// while one reader per connection checks its stream.
+        Round Send();
+
+        /// Packets one Send() delivers, across all connections.
+        uint32 Packets() const { return uint32(m_clients * m_producers) * m_packets; }
+
+    private:
+
+        int    m_clients;
+        int    m_producers;
+        uint32 m_packets;
+        bool   m_bound;
+
+        netsockets::SocketLayer m_layer;
+        net::Server             m_server;
+        std::vector<socket_t>   m_sockets;
+
+        mutable std::mutex                          m_sessionsMu;
+        std::vector<std::shared_ptr<FanOutSession>> m_sessions;
+};
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+#include "Bench.h"
+
+#include "NetFanOut.h"
+
+#include <string>
+
+/**
+ * @file
+ * @brief The rate at which map threads can fan small packets out over the engine.
+ *
+ * There is no older engine left to race, so this is a single number, to compare
+ * backends and revisions by. The delivery checks are in NetworkStressTest.cpp;
+ * these rounds are checked too, because a fast round that lost packets is no result.
+ */
+
+namespace
+{
+    /// Ports of their own, clear of the 477xx the socket tests take.
+    const uint16 FIRST_PORT = 47900;
+
+    void Time(uint16 port, int clients, int producers, uint32 packets)
+    {
+        FanOut fanOut(port, clients, producers, packets);
+        if (!fanOut.Bound())
+        {
+            std::printf("    (skipped: could not bind 127.0.0.1:%u)\n", unsigned(port));
+            return;
+        }
+        REQUIRE(fanOut.Ready());
+
+        int bad = 0;
+        double ns = bench::BestOf(fanOut.Packets(), [&]()
+        {
+            FanOut::Round round = fanOut.Send();
+            bad += round.badFrames + round.shortStreams;
+        });
+
+        std::string const scenario = std::to_string(producers) + (producers == 1 ? " map thread x " : " map threads x ") + std::to_string(clients) + " connections";
+        bench::Report(scenario.c_str(), { "net::Server", ns }, "a packet");
+        CHECK_EQ(bad, 0);
+    }
+}
+
+TEST(NetFanOut_bench_map_threads_send_concurrently)
+{
+    // The load NetStress_map_threads_send_concurrently checks, then the same
+    // packets from a single map thread, to show what the concurrent sends cost.
+    Time(FIRST_PORT, 32, 4, 2000);
+    Time(FIRST_PORT + 1, 32, 1, 8000);
+}
@@ -0,0 +1,121 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_NETSOCKETS_H
+#define MANGOS_NETSOCKETS_H
+
+#include "Platform/Define.h"
+
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+   typedef SOCKET socket_t;
+#  define CLOSESOCKET closesocket
+#else
+#  include <arpa/inet.h>
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  include <sys/socket.h>
+#  include <unistd.h>
+   typedef int socket_t;
+#  define INVALID_SOCKET (-1)
+#  define CLOSESOCKET ::close
+#endif
+
+/**
+ * @file
+ * @brief The client end of the socket tests: a loopback connect and a bounded wait.
+ *
+ * Shared by NetworkStressTest.cpp and the fan-out that mangos_bench also drives
+ * (NetFanOut.cpp), so both open their connections the same way.
+ */
+namespace netsockets
+{
+    struct SocketLayer
+    {
+        SocketLayer()
+        {
+#ifdef _WIN32
+            WSADATA wsa{};
+            WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+        }
+        ~SocketLayer()
+        {
+#ifdef _WIN32
+            WSACleanup();
+#endif
+        }
+    };
+
+    inline socket_t ConnectTo(uint16 port)
+    {
+        socket_t s = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (s == INVALID_SOCKET)
+        {
+            return INVALID_SOCKET;
+        }
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+        if (::connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        {
+            CLOSESOCKET(s);
+            return INVALID_SOCKET;
+        }
+
+        int one = 1;
+        ::setsockopt(s, IPPROTO_TCP, TCP_NODELAY,
+                     reinterpret_cast<const char*>(&one), sizeof(one));
+        return s;
+    }
+
+    /// Waits for a condition, up to a deadline. Returns false on timeout, which
+    /// is how a hang is reported as a failure instead of stalling the suite.
+    template <typename Predicate>
+    bool WaitFor(Predicate pred, int milliseconds = 15000)
+    {
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (pred())
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return pred();
+    }
+}
+
+#endif
@@ -26,6 +26,8 @@
 #include <algorithm>
 #include "TestHarness.h"
 
+#include "NetFanOut.h"
+#include "NetSockets.h"
 #include "PacketCodec.h"
 #include "net/Server.hpp"
 
@@ -38,21 +40,7 @@
 #include <thread>
 #include <vector>
 
-#ifdef _WIN32
-#  include <winsock2.h>
-#  include <ws2tcpip.h>
-   typedef SOCKET socket_t;
-#  define CLOSESOCKET closesocket
-#else
-#  include <arpa/inet.h>
-#  include <netinet/in.h>
-#  include <netinet/tcp.h>
-#  include <sys/socket.h>
-#  include <unistd.h>
-   typedef int socket_t;
-#  define INVALID_SOCKET (-1)
-#  define CLOSESOCKET ::close
-#endif
+using namespace netsockets;
 
 /**
  * @file
@@ -147,48 +135,6 @@ namespace
             std::atomic<bool> m_closed{false};
     };
 
-    struct SocketLayer
-    {
-        SocketLayer()
-        {
-#ifdef _WIN32
-            WSADATA wsa{};
-            WSAStartup(MAKEWORD(2, 2), &wsa);
-#endif
-        }
-        ~SocketLayer()
-        {
-#ifdef _WIN32
-            WSACleanup();
-#endif
-        }
-    };
-
-    socket_t ConnectTo(uint16 port)
-    {
-        socket_t s = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-        if (s == INVALID_SOCKET)
-        {
-            return INVALID_SOCKET;
-        }
-
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_port   = htons(port);
-        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
-
-        if (::connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
-        {
-            CLOSESOCKET(s);
-            return INVALID_SOCKET;
-        }
-
-        int one = 1;
-        ::setsockopt(s, IPPROTO_TCP, TCP_NODELAY,
-                     reinterpret_cast<const char*>(&one), sizeof(one));
-        return s;
-    }
-
 #ifndef MSG_NOSIGNAL
 #define MSG_NOSIGNAL 0
 #endif
@@ -221,25 +167,6 @@ namespace
         static std::atomic<uint16> port{47700};
         return port.fetch_add(1);
     }
-
-    /// Waits for a condition, up to a deadline. Returns false on timeout, which
-    /// is how a hang is reported as a failure instead of stalling the suite.
-    template <typename Predicate>
-    bool WaitFor(Predicate pred, int milliseconds = 15000)
-    {
-        const auto deadline =
-            std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
-
-        while (std::chrono::steady_clock::now() < deadline)
-        {
-            if (pred())
-            {
-                return true;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
-        }
-        return pred();
-    }
 }
 
 TEST(NetStress_many_connections_random_fragmentation)
@@ -586,6 +513,30 @@ TEST(NetStress_stop_with_traffic_in_flight)
     CHECK(totals.connections.load() > 0);
 }
 
+TEST(NetStress_map_threads_send_concurrently)
+{
+    // Several map threads pushing small packets to the same connections at once,
+    // the shape of SendObjectUpdates: the sends all meet on the workers' ready
+    // lists. Every connection must get every packet, each producer's in order.
+    // mangos_bench times the same rounds.
+    const int    CLIENTS   = 32;
+    const int    PRODUCERS = 4;
+    const uint32 PACKETS   = 2000;                  // per producer, per connection
+
+    const uint16 port = NextPort();
+    FanOut fanOut(port, CLIENTS, PRODUCERS, PACKETS);
+    if (!fanOut.Bound())
+    {
+        std::printf("    (skipped: could not bind 127.0.0.1:%u)\n", unsigned(port));
+        return;
+    }
+    REQUIRE(fanOut.Ready());
+
+    const FanOut::Round round = fanOut.Send();
+    CHECK_EQ(round.badFrames, 0);
+    CHECK_EQ(round.shortStreams, 0);
+}
+
 TEST(NetStress_codec_never_faults_on_hostile_input)
 {
     // Fuzzes the framing layer with random bytes delivered in random chunks. The
@@ -27,6 +27,7 @@
 
 #include "PacketCodec.h"
 
+#include <algorithm>
 #include <vector>
 
 /**
@@ -238,3 +239,33 @@ TEST(PacketCodec_encode_sizes_the_header_the_way_this_expansion_does)
     CHECK_EQ(int(wire[2]), 0x02);
 #endif
 }
+
+// The send path encodes straight into the connection's outbound buffer, so the
+// in-place form must be byte-for-byte what Encode() produces -- header cipher
+// included, and written nowhere outside the span it was given.
+TEST(PacketCodec_encode_into_matches_encode)
+{
+    WorldPacket packet(0x01F6, 4);
+    packet << uint32(0xDEADBEEF);
+
+    uint8 key = 0;
+    const proto::PacketCodec::HeaderEncryptor xorCipher =
+        [&key](uint8* header, size_t len)
+        {
+            for (size_t i = 0; i < len; ++i)
+            {
+                header[i] ^= uint8(0x5A + key++);
+            }
+        };
+
+    const std::vector<uint8> wire = proto::PacketCodec::Encode(packet, xorCipher);
+    CHECK_EQ(int(proto::PacketCodec::EncodedSize(packet)), int(wire.size()));
+
+    key = 0;
+    std::vector<uint8> buffer(wire.size() + 2, 0xEE);
+    proto::PacketCodec::EncodeInto(packet, xorCipher, buffer.data() + 1);
+
+    CHECK_EQ(int(buffer.front()), 0xEE);
+    CHECK_EQ(int(buffer.back()), 0xEE);
+    CHECK(std::equal(wire.begin(), wire.end(), buffer.begin() + 1));
+}
@@ -0,0 +1,90 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+#include "Bench.h"
+#include "PlayerDirectoryFixture.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief A /who from the directory's indexes, against visiting everyone online.
+ */
+
+using namespace DirectoryFixture;
+
+TEST(PlayerDirectory_bench_who_against_visiting_everyone)
+{
+    // A busy realm, and the /who a player types to find a friend in their level range.
+    uint32 const ONLINE = 3000;
+    uint32 const QUERIES = 500;
+
+    std::mt19937 rng(3000);
+    std::vector<PlayerDirectory::Entry> online;
+    PlayerDirectory directory;
+    for (uint32 i = 0; i < ONLINE; ++i)
+    {
+        online.push_back(RandomEntry(rng, i));
+        directory.Insert(online.back());
+    }
+
+    PlayerDirectory::WhoQuery q;
+    q.levelMin = 70;
+    q.levelMax = 80;
+    q.name = Lower("Dra");
+
+    uint64 oldListed = 0;
+    double const oldNs = bench::BestOf(QUERIES, [&]()
+    {
+        for (uint32 n = 0; n < QUERIES; ++n)
+        {
+            uint32 listed = 0;
+            for (PlayerDirectory::Entry const& e : online)
+            {
+                if (listed < q.limit && OldFilter(e, q))
+                {
+                    ++listed;
+                }
+            }
+            oldListed += listed;
+        }
+    });
+
+    uint64 newListed = 0;
+    double const newNs = bench::BestOf(QUERIES, [&]()
+    {
+        for (uint32 n = 0; n < QUERIES; ++n)
+        {
+            newListed += directory.Who(q, NoArea, [](PlayerDirectory::Entry const&) -> bool { return true; });
+        }
+    });
+
+    std::string const scenario = std::to_string(ONLINE) + " online";
+    bench::Report(scenario.c_str(), { "visiting everyone", oldNs }, { "PlayerDirectory", newNs }, "a /who");
+    CHECK_EQ(newListed, oldListed);
+}
@@ -0,0 +1,127 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_TESTS_PLAYER_DIRECTORY_FIXTURE_H
+#define MANGOS_TESTS_PLAYER_DIRECTORY_FIXTURE_H
+
+#include "PlayerDirectory.h"
+#include "Util.h"
+
+#include <random>
+#include <string>
+
+/**
+ * @file
+ * @brief A made-up realm for the player directory, and the /who filter it replaced.
+ *
+ * Shared by the unit tests, which hold the directory to the old filter, and the
+ * benchmark, which times the two.
+ */
+
+namespace DirectoryFixture
+{
+    char const* const SYLLABLES[] = { "ar", "bel", "cor", "dra", "el", "fin", "gor", "hal", "ith", "jor", "kal", "lun" };
+    char const* const GUILDS[] = { "", "Knights of Dawn", "Ashen Verdict", "Dawnbreakers", "Ironforge Irregulars" };
+    uint32 const ZONES[] = { 1519, 1637, 1537, 1497, 3703, 4395, 12, 14 };
+
+    inline PlayerDirectory::Entry RandomEntry(std::mt19937& rng, uint32 i)
+    {
+        PlayerDirectory::Entry e;
+        e.guid = ObjectGuid(HIGHGUID_PLAYER, i + 1);
+        std::string name;
+        for (uint32 s = 0; s < 2 + rng() % 2; ++s)
+        {
+            name += SYLLABLES[rng() % 12];
+        }
+        name[0] = char(name[0] - 'a' + 'A');
+        e.name = name + std::to_string(i);                  // names are unique
+        e.guildId = rng() % 5;
+        e.guildName = GUILDS[e.guildId];
+        e.level = 1 + rng() % 80;
+        e.zone = ZONES[rng() % 8];
+        e.team = rng() % 2 ? 469 : 67;
+        e.race = uint8(1 + rng() % 10);
+        e.classId = uint8(1 + rng() % 11);
+        e.gender = uint8(rng() % 2);
+        return e;
+    }
+
+    inline std::wstring Lower(std::string const& s)
+    {
+        std::wstring w;
+        Utf8toWStr(s, w);
+        wstrToLower(w);
+        return w;
+    }
+
+    /// The old /who filter: every player, every string lowered on the spot.
+    inline bool OldFilter(PlayerDirectory::Entry const& e, PlayerDirectory::WhoQuery const& q)
+    {
+        if (e.level < q.levelMin || e.level > q.levelMax ||
+            !(q.classMask & (1 << e.classId)) || !(q.raceMask & (1 << e.race)) ||
+            (q.team && e.team != q.team))
+        {
+            return false;
+        }
+        bool zoneShown = q.zones.empty();
+        for (uint32 zone : q.zones)
+        {
+            zoneShown = zoneShown || zone == e.zone;
+        }
+        if (!zoneShown)
+        {
+            return false;
+        }
+
+        std::wstring wname = Lower(e.name);
+        std::wstring wguild = Lower(e.guildName);
+        if (!(q.name.empty() || wname.find(q.name) != std::wstring::npos) ||
+            !(q.guild.empty() || wguild.find(q.guild) != std::wstring::npos))
+        {
+            return false;
+        }
+
+        bool shown = true;
+        for (std::wstring const& s : q.strings)
+        {
+            if (!s.empty())
+            {
+                if (wguild.find(s) != std::wstring::npos || wname.find(s) != std::wstring::npos)
+                {
+                    return true;
+                }
+                shown = false;
+            }
+        }
+        return shown;
+    }
+
+    inline bool NoArea(uint32, std::wstring const&)
+    {
+        return false;
+    }
+}
+
+#endif
@@ -0,0 +1,243 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+#include "PlayerDirectoryFixture.h"
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief The online-player directory behind /who and name lookups.
+ *
+ * The directory answers from indexes what /who used to answer by visiting everyone,
+ * so the first test holds it to the old answer: a population and a run of random
+ * queries, each checked against a plain filter over every player, with the players
+ * moving zone, levelling and changing guild in between. The others cover the limit
+ * and the name lookup. PlayerDirectoryBench.cpp times a /who against the
+ * visit-everyone loop it replaces.
+ */
+
+using namespace DirectoryFixture;
+
+namespace
+{
+    PlayerDirectory::WhoQuery RandomQuery(std::mt19937& rng)
+    {
+        PlayerDirectory::WhoQuery q;
+        q.limit = 100000;
+        if (rng() % 2)
+        {
+            q.levelMin = rng() % 60;
+            q.levelMax = q.levelMin + rng() % 40;
+        }
+        if (rng() % 4 == 0)
+        {
+            q.classMask = uint32(rng());
+        }
+        if (rng() % 4 == 0)
+        {
+            q.raceMask = uint32(rng());
+        }
+        if (rng() % 3 == 0)
+        {
+            q.zones.push_back(ZONES[rng() % 8]);
+            q.zones.push_back(ZONES[rng() % 8]);              // possibly the same one twice
+        }
+        if (rng() % 3 == 0)
+        {
+            q.name = Lower(SYLLABLES[rng() % 12]);
+        }
+        if (rng() % 4 == 0)
+        {
+            q.guild = Lower(rng() % 2 ? "dawn" : "IRON");
+        }
+        if (rng() % 4 == 0)
+        {
+            q.strings.push_back(Lower(SYLLABLES[rng() % 12]));
+            q.strings.push_back(std::wstring());
+        }
+        if (rng() % 3 == 0)
+        {
+            q.team = 469;
+        }
+        return q;
+    }
+}
+
+TEST(PlayerDirectory_who_agrees_with_visiting_everyone)
+{
+    std::mt19937 rng(25);
+    std::vector<PlayerDirectory::Entry> online;
+    PlayerDirectory directory;
+    for (uint32 i = 0; i < 2000; ++i)
+    {
+        online.push_back(RandomEntry(rng, i));
+        directory.Insert(online.back());
+    }
+
+    uint32 disagreements = 0;
+    uint32 nonEmpty = 0;
+    for (uint32 round = 0; round < 300; ++round)
+    {
+        // Some of the world moves on between queries.
+        for (uint32 m = 0; m < 20; ++m)
+        {
+            uint32 i = rng() % online.size();
+            PlayerDirectory::Entry& e = online[i];
+            switch (rng() % 4)
+            {
+                case 0:
+                    e.zone = ZONES[rng() % 8];
+                    directory.SetZone(e.guid, e.zone);
+                    break;
+                case 1:
+                    e.level = 1 + rng() % 80;
+                    directory.SetLevel(e.guid, e.level);
+                    break;
+                case 2:
+                    e.guildId = rng() % 5;
+                    e.guildName = GUILDS[e.guildId];
+                    directory.SetGuild(e.guid, e.guildId, e.guildName);
+                    break;
+                default:
+                    directory.Remove(e.guid);                 // logs out and back in
+                    directory.Insert(e);
+                    break;
+            }
+        }
+
+        PlayerDirectory::WhoQuery q = RandomQuery(rng);
+        std::set<uint64> expected;
+        for (PlayerDirectory::Entry const& e : online)
+        {
+            if (OldFilter(e, q))
+            {
+                expected.insert(e.guid.GetRawValue());
+            }
+        }
+
+        std::set<uint64> got;
+        uint32 offeredTwice = 0;
+        directory.Who(q, NoArea, [&](PlayerDirectory::Entry const& e) -> bool
+        {
+            offeredTwice += got.insert(e.guid.GetRawValue()).second ? 0 : 1;
+            return true;
+        });
+
+        disagreements += (got != expected) + offeredTwice;
+        nonEmpty += !expected.empty();
+    }
+
+    CHECK_EQ(disagreements, 0u);
+    CHECK(nonEmpty > 100);
+    CHECK_EQ(uint32(directory.Size()), 2000u);
+}
+
+TEST(PlayerDirectory_who_stops_at_the_limit_with_prefixes_first)
+{
+    PlayerDirectory directory;
+    char const* const names[] = { "Anna", "Hanna", "Annabel", "Joanna", "Annika", "Bob" };
+    for (uint32 i = 0; i < 6; ++i)
+    {
+        PlayerDirectory::Entry e;
+        e.guid = ObjectGuid(HIGHGUID_PLAYER, i + 1);
+        e.name = names[i];
+        e.level = 10;
+        e.race = 1;
+        e.classId = 1;
+        directory.Insert(e);
+    }
+
+    PlayerDirectory::WhoQuery q;
+    q.name = Lower("ANN");
+    q.limit = 3;
+    std::vector<std::string> listed;
+    uint32 count = directory.Who(q, NoArea, [&](PlayerDirectory::Entry const& e) -> bool
+    {
+        listed.push_back(e.name);
+        return true;
+    });
+    CHECK_EQ(count, 3u);
+    CHECK_EQ(uint32(listed.size()), 3u);
+    for (std::string const& name : listed)
+    {
+        CHECK(name.compare(0, 3, "Ann") == 0);
+    }
+
+    // A visitor that turns players down does not use up the limit.
+    q.limit = 2;
+    listed.clear();
+    count = directory.Who(q, NoArea, [&](PlayerDirectory::Entry const& e) -> bool
+    {
+        if (e.name == "Anna" || e.name == "Annabel")
+        {
+            return false;
+        }
+        listed.push_back(e.name);
+        return true;
+    });
+    CHECK_EQ(count, 2u);
+    CHECK(listed[0] == "Annika");
+
+    // Free strings fall back to the zone name.
+    PlayerDirectory::WhoQuery area;
+    area.strings.push_back(Lower("Orgrimmar"));
+    uint32 asked = 0;
+    count = directory.Who(area, [&](uint32, std::wstring const&) -> bool { ++asked; return true; },
+                          [](PlayerDirectory::Entry const&) -> bool { return true; });
+    CHECK_EQ(count, 6u);
+    CHECK_EQ(asked, 6u);
+}
+
+TEST(PlayerDirectory_finds_by_exact_name)
+{
+    PlayerDirectory directory;
+    PlayerDirectory::Entry e;
+    e.guid = ObjectGuid(HIGHGUID_PLAYER, uint32(7));
+    e.name = "Thrall";
+    directory.Insert(e);
+
+    CHECK(directory.FindByName("Thrall") == e.guid);
+    CHECK(directory.FindByName("thrall").IsEmpty());      // case counts, as with strcmp
+    CHECK(directory.FindByName("Thral").IsEmpty());
+    CHECK(directory.FindByName(NULL).IsEmpty());
+
+    PlayerDirectory::Presence presence;
+    directory.SetZone(e.guid, 1637);
+    directory.SetLevel(e.guid, 80);
+    CHECK(directory.FindPresence(e.guid, presence));
+    CHECK_EQ(presence.zone, 1637u);
+    CHECK_EQ(presence.level, 80u);
+
+    directory.Remove(e.guid);
+    CHECK(directory.FindByName("Thrall").IsEmpty());
+    CHECK(!directory.FindPresence(e.guid, presence));
+    directory.SetZone(e.guid, 12);                         // not filed: ignored
+    CHECK_EQ(uint32(directory.Size()), 0u);
+}
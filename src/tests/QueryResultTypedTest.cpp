@@ -0,0 +1,167 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "Database/QueryResultTyped.h"
+
+#include <string>
+
+/**
+ * @file
+ * @brief The binary result set: a typed Field reads back what a text Field would have.
+ *
+ * Callers switch from text queries to prepared statements without touching the code that
+ * reads the rows, so every getter on a number stored as a number has to agree with the
+ * same getter on the number's text -- including the wrap-arounds strtoul and strtol give.
+ */
+
+TEST(QueryResultTyped_rows_read_back_in_order)
+{
+    QueryResultTyped result(4);
+    result.SetColumn(0, Field::VALUE_UINT, MYSQL_TYPE_LONG);
+    result.SetColumn(1, Field::VALUE_INT, MYSQL_TYPE_SHORT);
+    result.SetColumn(2, Field::VALUE_REAL, MYSQL_TYPE_FLOAT);
+    result.SetColumn(3, Field::VALUE_TEXT, MYSQL_TYPE_VAR_STRING);
+    result.Reserve(2);
+
+    result.AddUInt(0, 7);
+    result.AddInt(1, -3);
+    result.AddReal(2, 1.25);
+    result.AddText(3, "Hoggerxx", 6);
+
+    result.AddUInt(0, 300);
+    result.AddNull(1);
+    result.AddNull(2);
+    result.AddText(3, "", 0);
+
+    REQUIRE(result.Start());
+    CHECK_EQ(result.GetRowCount(), 2u);
+    CHECK_EQ(result.GetFieldCount(), 4u);
+
+    Field* fields = result.Fetch();
+    CHECK_EQ(fields[0].GetUInt32(), 7u);
+    CHECK_EQ(fields[1].GetInt32(), -3);
+    CHECK(fields[2].GetFloat() == 1.25f);
+    CHECK_STR(fields[3].GetString(), "Hogger");
+    CHECK(fields[0].GetType() == MYSQL_TYPE_LONG);
+    CHECK(fields[0].GetValueKind() == Field::VALUE_UINT);
+
+    REQUIRE(result.NextRow());
+    fields = result.Fetch();
+    CHECK_EQ(fields[0].GetUInt32(), 300u);
+    CHECK(fields[1].IsNULL());
+    CHECK_EQ(fields[1].GetInt32(), 0);
+    CHECK(fields[2].IsNULL());
+    CHECK(fields[2].GetFloat() == 0.0f);
+    CHECK(!fields[3].IsNULL());
+    CHECK_STR(fields[3].GetString(), "");
+
+    CHECK(!result.NextRow());
+    CHECK(result.Fetch() == NULL);
+    CHECK(!result.NextRow());
+}
+
+TEST(QueryResultTyped_empty_result_does_not_start)
+{
+    QueryResultTyped result(2);
+    CHECK(!result.Start());
+    CHECK(result.Fetch() == NULL);
+}
+
+TEST(QueryResultTyped_typed_getters_agree_with_text)
+{
+    const int64 values[] = { 0, 1, -1, 127, 128, 255, 256, -129, 65535, 65536, 2147483647LL, 2147483648LL, 4294967295LL, 4294967296LL, -2147483648LL };
+
+    for (int64 value : values)
+    {
+        std::string text = std::to_string(value);
+        Field expected(text.c_str(), MYSQL_TYPE_LONGLONG);
+
+        QueryResultTyped result(1);
+        result.SetColumn(0, Field::VALUE_INT, MYSQL_TYPE_LONGLONG);
+        result.AddInt(0, value);
+        REQUIRE(result.Start());
+        Field const& typed = result[0];
+
+        CHECK_EQ(typed.GetUInt8(), expected.GetUInt8());
+        CHECK_EQ(typed.GetInt8(), expected.GetInt8());
+        CHECK_EQ(typed.GetUInt16(), expected.GetUInt16());
+        CHECK_EQ(typed.GetInt16(), expected.GetInt16());
+        CHECK_EQ(typed.GetInt32(), expected.GetInt32());
+        CHECK_EQ(typed.GetUInt64(), expected.GetUInt64());
+        CHECK_EQ(typed.GetInt64(), expected.GetInt64());
+        CHECK(typed.GetDouble() == expected.GetDouble());
+        CHECK_STR(typed.GetString(), text.c_str());
+
+        // strtoul reads "-1" as ULONG_MAX, which is 32 bits on some platforms, and atoi past
+        // int is undefined; compare only where the two readings are defined to agree.
+        if (value >= 0)
+        {
+            CHECK_EQ(typed.GetUInt32(), expected.GetUInt32());
+        }
+        if (value >= -2147483647LL - 1 && value <= 2147483647LL)
+        {
+            CHECK_EQ(typed.GetBool(), expected.GetBool());
+        }
+    }
+}
+
+TEST(QueryResultTyped_unsigned_above_int64_survives)
+{
+    QueryResultTyped result(1);
+    result.SetColumn(0, Field::VALUE_UINT, MYSQL_TYPE_LONGLONG);
+    result.AddUInt(0, 18446744073709551615ULL);
+    REQUIRE(result.Start());
+
+    CHECK(result[0].GetUInt64() == 18446744073709551615ULL);
+    CHECK_STR(result[0].GetString(), "18446744073709551615");
+    CHECK(result[0].GetBool());
+    CHECK(result[0].GetDouble() > 1.8e19);
+}
+
+TEST(QueryResultTyped_reals_render_as_the_text_protocol_would)
+{
+    QueryResultTyped result(2);
+    result.SetColumn(0, Field::VALUE_REAL, MYSQL_TYPE_FLOAT);
+    result.SetColumn(1, Field::VALUE_REAL, MYSQL_TYPE_DOUBLE);
+    result.AddReal(0, double(0.1f));
+    result.AddReal(1, 0.1);
+    result.AddReal(0, -2.5);
+    result.AddReal(1, 1234.5678);
+    REQUIRE(result.Start());
+
+    // A FLOAT column shows its float digits, not the double it was widened to.
+    CHECK_STR(result[0].GetString(), "0.1");
+    CHECK_STR(result[1].GetString(), "0.1");
+    CHECK_EQ(result[0].GetUInt32(), 0u);
+    CHECK_STR(result[0].GetCppString().c_str(), "0.1");
+
+    REQUIRE(result.NextRow());
+    CHECK_STR(result[0].GetString(), "-2.5");
+    CHECK_EQ(result[0].GetInt32(), -2);
+    CHECK_STR(result[1].GetString(), "1234.5678");
+    CHECK_EQ(result[1].GetUInt32(), 1234u);
+}
@@ -0,0 +1,224 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "Database/SQLStorageSnapshot.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief The SQLStorage table snapshot: what goes in comes out, and nothing else opens.
+ *
+ * A snapshot that opens is trusted without another look at the database, so the tests
+ * that matter are the refusals: another table version, another column layout, a file cut
+ * short, a string offset pointing outside the file, and a key the storage cannot index.
+ */
+
+namespace
+{
+    const char* const FORMAT = "isxfbsl";
+
+    /// A source row as the loader sees it: Field's accessors over fixed test values.
+    struct TestRow
+    {
+        uint32 id;
+        char const* name;
+        float speed;
+        uint8 level;
+        char const* script;
+        uint32 flag;
+
+        uint32 GetUInt32(uint32 column) const { return column == 0 ? id : flag; }
+        uint8 GetUInt8(uint32) const { return level; }
+        float GetFloat(uint32) const { return speed; }
+        char const* GetString(uint32 column) const { return column == 1 ? name : script; }
+    };
+
+    std::string TempPath(const char* leaf)
+    {
+        const char* dir = std::getenv("TMPDIR");
+        if (!dir)
+        {
+            dir = std::getenv("TEMP");
+        }
+        if (!dir)
+        {
+            dir = "/tmp";
+        }
+#ifdef _WIN32
+        unsigned long pid = static_cast<unsigned long>(::GetCurrentProcessId());
+#else
+        unsigned long pid = static_cast<unsigned long>(::getpid());
+#endif
+        return std::string(dir) + "/mangos_snapshot_" + std::to_string(pid) + "_" + leaf;
+    }
+
+    struct ScopedFile
+    {
+        std::string path;
+        explicit ScopedFile(const char* leaf) : path(TempPath(leaf)) {}
+        ~ScopedFile() { std::remove(path.c_str()); }
+    };
+
+    bool WriteSample(std::string const& path, uint64 key)
+    {
+        SQLStorageSnapshot::Writer writer(FORMAT, key, 301);
+        TestRow first = { 7, "Hogger", 1.25f, 11, "npc_hogger", 1 };
+        TestRow second = { 300, NULL, 0.5f, 255, "", 0 };
+        writer.Add(first);
+        writer.Add(second);
+        return writer.Commit(path);
+    }
+
+    std::vector<char> ReadAll(std::string const& path)
+    {
+        std::vector<char> bytes;
+        FILE* f = fopen(path.c_str(), "rb");
+        if (f)
+        {
+            char buf[256];
+            size_t n;
+            while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+            {
+                bytes.insert(bytes.end(), buf, buf + n);
+            }
+            fclose(f);
+        }
+        return bytes;
+    }
+
+    void WriteAll(std::string const& path, std::vector<char> const& bytes)
+    {
+        FILE* f = fopen(path.c_str(), "wb");
+        if (f)
+        {
+            fwrite(&bytes[0], 1, bytes.size(), f);
+            fclose(f);
+        }
+    }
+}
+
+TEST(SQLStorageSnapshot_rows_round_trip)
+{
+    ScopedFile file("round_trip");
+    REQUIRE(WriteSample(file.path, 0x1234567890ULL));
+
+    SQLStorageSnapshot::Reader reader;
+    REQUIRE(reader.Open(file.path, FORMAT, 0x1234567890ULL));
+    CHECK_EQ(reader.RowCount(), 2u);
+    CHECK_EQ(reader.MaxRecordId(), 301u);
+
+    SQLStorageSnapshot::Row first = reader.GetRow(0);
+    CHECK_EQ(first.GetUInt32(0), 7u);
+    CHECK_STR(first.GetString(1), "Hogger");
+    CHECK(first.GetFloat(3) == 1.25f);
+    CHECK_EQ(first.GetUInt8(4), 11u);
+    CHECK_STR(first.GetString(5), "npc_hogger");
+    CHECK_EQ(first.GetUInt32(6), 1u);
+
+    // NULL and empty are different values to a loader, and both must survive.
+    SQLStorageSnapshot::Row second = reader.GetRow(1);
+    CHECK_EQ(second.GetUInt32(0), 300u);
+    CHECK(second.GetString(1) == NULL);
+    CHECK_EQ(second.GetUInt8(4), 255u);
+    CHECK(second.GetString(5) != NULL);
+    CHECK_STR(second.GetString(5), "");
+}
+
+TEST(SQLStorageSnapshot_other_key_or_layout_does_not_open)
+{
+    ScopedFile file("mismatch");
+    REQUIRE(WriteSample(file.path, 42));
+
+    SQLStorageSnapshot::Reader reader;
+    CHECK(!reader.Open(file.path, FORMAT, 43));             // the table changed
+    CHECK(!reader.Open(file.path, "isxfbsi", 42));          // same width, other column
+    CHECK(!reader.Open(file.path, "isxfbslx", 42));         // a column was added
+    CHECK(reader.Open(file.path, FORMAT, 42));
+}
+
+TEST(SQLStorageSnapshot_truncated_file_does_not_open)
+{
+    ScopedFile file("truncated");
+    REQUIRE(WriteSample(file.path, 42));
+
+    std::vector<char> bytes = ReadAll(file.path);
+    REQUIRE(bytes.size() > 8);
+    bytes.resize(bytes.size() - 3);
+    WriteAll(file.path, bytes);
+
+    SQLStorageSnapshot::Reader reader;
+    CHECK(!reader.Open(file.path, FORMAT, 42));
+}
+
+TEST(SQLStorageSnapshot_string_offset_outside_pool_does_not_open)
+{
+    ScopedFile file("bad_offset");
+    REQUIRE(WriteSample(file.path, 42));
+
+    // Find the first row's name offset (0, the start of the pool) and push it past the end.
+    std::vector<char> bytes = ReadAll(file.path);
+    size_t rows = bytes.size() - (strlen("Hogger") + strlen("npc_hogger") + strlen("") + 3) - 2 * 21;
+    uint32 bad = 0x00FFFFFF;
+    memcpy(&bytes[rows + 4], &bad, sizeof(bad));
+    WriteAll(file.path, bytes);
+
+    SQLStorageSnapshot::Reader reader;
+    CHECK(!reader.Open(file.path, FORMAT, 42));
+}
+
+TEST(SQLStorageSnapshot_key_past_max_record_id_does_not_open)
+{
+    ScopedFile file("bad_key");
+
+    // The storage is sized by maxRecordId and indexed by the key; 300 would land past it.
+    SQLStorageSnapshot::Writer writer(FORMAT, 42, 300);
+    TestRow first = { 7, "Hogger", 1.25f, 11, "npc_hogger", 1 };
+    TestRow second = { 300, NULL, 0.5f, 255, "", 0 };
+    writer.Add(first);
+    writer.Add(second);
+    REQUIRE(writer.Commit(file.path));
+
+    SQLStorageSnapshot::Reader reader;
+    CHECK(!reader.Open(file.path, FORMAT, 42));
+}
+
+TEST(SQLStorageSnapshot_missing_file_does_not_open)
+{
+    SQLStorageSnapshot::Reader reader;
+    CHECK(!reader.Open(TempPath("never_written"), FORMAT, 42));
+}
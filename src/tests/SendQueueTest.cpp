@@ -0,0 +1,114 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "net/SendQueue.hpp"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/**
+ * @file
+ * @brief The outbound queue's byte stream, driven without a socket.
+ *
+ * The transports only ever see nextSpan()/consume(), so that pair is the whole
+ * contract: whatever was appended -- copied, filled in place, or referenced as a
+ * shared payload -- must come out in order, exactly once, however short the
+ * writes the kernel grants.
+ */
+
+namespace
+{
+    void FillFrom(void* ctx, uint8_t* dst)
+    {
+        const std::vector<uint8_t>& src = *static_cast<const std::vector<uint8_t>*>(ctx);
+        std::memcpy(dst, src.data(), src.size());
+    }
+
+    void Append(net::SendQueue& queue, std::vector<uint8_t> bytes,
+                const net::SharedPayload& tail = net::SharedPayload())
+    {
+        net::SendFill fill = { &FillFrom, &bytes };
+        queue.appendInPlace(bytes.size(), fill, tail);
+    }
+
+    /// Drain the queue as a socket would, granting at most @p chunk bytes a write.
+    std::vector<uint8_t> Drain(net::SendQueue& queue, size_t chunk)
+    {
+        std::vector<uint8_t> wire;
+        const uint8_t* data = nullptr;
+        size_t len = 0;
+        while (queue.nextSpan(data, len))
+        {
+            size_t const n = len < chunk ? len : chunk;
+            wire.insert(wire.end(), data, data + n);
+            queue.consume(n);
+        }
+        return wire;
+    }
+}
+
+TEST(SendQueue_in_place_and_copied_bytes_keep_their_order)
+{
+    net::SendQueue queue;
+    const uint8_t copied[] = { 1, 2 };
+
+    CHECK(queue.append(copied, sizeof(copied)));   // first producer owns the write
+    Append(queue, { 3, 4, 5 });
+
+    const std::vector<uint8_t> wire = Drain(queue, 64);
+    CHECK_EQ(int(wire.size()), 5);
+    for (size_t i = 0; i < wire.size(); ++i)
+    {
+        CHECK_EQ(int(wire[i]), int(i + 1));
+    }
+    CHECK(queue.empty());
+}
+
+// A broadcast payload is referenced, not copied: it has to surface at its offset
+// between the headers around it, and survive being written a few bytes at a time.
+TEST(SendQueue_shared_payload_is_spliced_in_at_its_offset)
+{
+    net::SharedPayload payload = std::make_shared<const std::vector<uint8_t>>(
+        std::vector<uint8_t>{ 10, 11, 12, 13, 14, 15, 16 });
+
+    net::SendQueue queue;
+    Append(queue, { 1, 2 }, payload);
+    Append(queue, { 3 }, payload);
+    Append(queue, { 4, 5 });
+
+    const std::vector<uint8_t> expected = { 1, 2, 10, 11, 12, 13, 14, 15, 16,
+                                            3, 10, 11, 12, 13, 14, 15, 16, 4, 5 };
+
+    const std::vector<uint8_t> wire = Drain(queue, 3);
+    REQUIRE(wire.size() == expected.size());
+    CHECK(wire == expected);
+    CHECK(queue.empty());
+
+    // Both references were dropped once the bytes were out.
+    CHECK_EQ(int(payload.use_count()), 1);
+}
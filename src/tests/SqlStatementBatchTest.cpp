@@ -0,0 +1,196 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "Database/SqlStatementBatch.h"
+#include "Database/SqlPreparedStatement.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+/**
+ * @file
+ * @brief The multi-row statement builder: which statements fold, and into what.
+ *
+ * A statement wrongly taken for batchable would run as different SQL inside a save, so the
+ * refusals matter as much as the output: anything but a bare VALUES row or an equality-only
+ * WHERE has to be left alone.
+ */
+
+namespace
+{
+    /// Doubles single quotes -- enough escaping to see that it happened.
+    void TestEscape(std::string& str)
+    {
+        std::string out;
+        for (size_t i = 0; i < str.size(); ++i)
+        {
+            out += str[i];
+            if (str[i] == '\'')
+            {
+                out += '\'';
+            }
+        }
+        str = out;
+    }
+
+    SqlStmtParameters Row(uint32 a, float b, const char* c)
+    {
+        SqlStmtParameters params(3);
+        SqlStmtFieldData data;
+        data.set(a);
+        params.addParam(data);
+        data.set(b);
+        params.addParam(data);
+        data.set(c);
+        params.addParam(data);
+        return params;
+    }
+
+    SqlStmtParameters Keys(uint32 a, uint32 b)
+    {
+        SqlStmtParameters params(2);
+        SqlStmtFieldData data;
+        data.set(a);
+        params.addParam(data);
+        data.set(b);
+        params.addParam(data);
+        return params;
+    }
+
+    SqlStmtParameters Key(uint64 a)
+    {
+        SqlStmtParameters params(1);
+        SqlStmtFieldData data;
+        data.set(a);
+        params.addParam(data);
+        return params;
+    }
+}
+
+TEST(SqlStatementBatch_insert_rows_fold_into_one_values_list)
+{
+    SqlStatementBatch::Shape shape("INSERT INTO `t` (`a`,`b`,`c`) VALUES (?, ?, ?)");
+    REQUIRE(shape.IsBatchable());
+
+    SqlStatementBatch batch(shape, &TestEscape);
+    CHECK(batch.Add(Row(1, 0.5f, "Hogger")));
+    CHECK(batch.Add(Row(2, -2.0f, "it's")));
+    CHECK_EQ(batch.GetRows(), 2u);
+    CHECK_STR(batch.GetSql().c_str(), "INSERT INTO `t` (`a`,`b`,`c`) VALUES (1, 0.5, 'Hogger'),(2, -2, 'it''s')");
+
+    // GetSql() in the middle of a batch does not stop it growing
+    CHECK(batch.Add(Row(3, 0.0f, "")));
+    CHECK_STR(batch.GetSql().c_str(), "INSERT INTO `t` (`a`,`b`,`c`) VALUES (1, 0.5, 'Hogger'),(2, -2, 'it''s'),(3, 0, '')");
+
+    batch.Clear();
+    CHECK_EQ(batch.GetRows(), 0u);
+    CHECK(batch.Add(Row(4, 1.0f, "x")));
+    CHECK_STR(batch.GetSql().c_str(), "INSERT INTO `t` (`a`,`b`,`c`) VALUES (4, 1, 'x')");
+}
+
+TEST(SqlStatementBatch_deletes_become_in_lists)
+{
+    SqlStatementBatch::Shape single("DELETE FROM `item_instance` WHERE `guid` = ?");
+    REQUIRE(single.IsBatchable());
+    SqlStatementBatch one(single, &TestEscape);
+    CHECK(one.Add(Key(7)));
+    CHECK(one.Add(Key(18446744073709551615ULL)));
+    CHECK_STR(one.GetSql().c_str(), "DELETE FROM `item_instance` WHERE `guid` IN (7,18446744073709551615)");
+
+    SqlStatementBatch::Shape pair("DELETE FROM `character_spell` WHERE `guid` = ? and `spell` = ?");
+    REQUIRE(pair.IsBatchable());
+    SqlStatementBatch two(pair, &TestEscape);
+    CHECK(two.Add(Keys(1, 100)));
+    CHECK(two.Add(Keys(1, 200)));
+    CHECK_STR(two.GetSql().c_str(), "DELETE FROM `character_spell` WHERE (`guid`,`spell`) IN ((1,100),(1,200))");
+}
+
+TEST(SqlStatementBatch_other_statements_are_left_alone)
+{
+    CHECK(!SqlStatementBatch::Shape("UPDATE `t` SET `a` = ? WHERE `b` = ?").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("INSERT INTO `t` (`a`) VALUES (?) ON DUPLICATE KEY UPDATE `a` = ?").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("INSERT INTO `t` (`a`, `b`) VALUES (?, UNIX_TIMESTAMP())").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("INSERT INTO `t` (`a`, `b`) VALUES (?, 'x?')").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("INSERT INTO `t` SELECT * FROM `u` WHERE `a` = ?").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("DELETE FROM `t` WHERE `a` = ? OR `b` = ?").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("DELETE FROM `t` WHERE `a` = ? LIMIT 1").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("DELETE FROM `t` WHERE `a` < ?").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("DELETE FROM `t` WHERE `a` IN (SELECT `b` FROM `u` WHERE `c` = ?)").IsBatchable());
+    CHECK(!SqlStatementBatch::Shape("DELETE FROM `t`").IsBatchable());
+
+    // keywords inside backquotes are names, not syntax
+    CHECK(SqlStatementBatch::Shape("INSERT INTO `t` (`values`, `or`) VALUES (?, ?)").IsBatchable());
+    CHECK(SqlStatementBatch::Shape("REPLACE INTO `t` VALUES (?, 0, ?);").IsBatchable());
+}
+
+TEST(SqlStatementBatch_budget_bounds_every_statement_but_a_lone_row)
+{
+    SqlStatementBatch::Shape shape("DELETE FROM `t` WHERE `a` = ?");
+    std::string head = "DELETE FROM `t` WHERE `a` IN (";
+
+    // The first row is always taken, however small the budget.
+    SqlStatementBatch tiny(shape, &TestEscape, 4);
+    CHECK(tiny.Add(Key(1)));
+    CHECK(!tiny.Add(Key(2)));
+    CHECK_EQ(tiny.GetRows(), 1u);
+    CHECK_STR(tiny.GetSql().c_str(), (head + "1)").c_str());
+
+    // Exactly at the budget fits; one byte over does not, and changes nothing.
+    SqlStatementBatch exact(shape, &TestEscape, head.size() + strlen("1,2)"));
+    CHECK(exact.Add(Key(1)));
+    CHECK(exact.Add(Key(2)));
+    CHECK(!exact.Add(Key(3)));
+    CHECK_EQ(exact.GetRows(), 2u);
+    CHECK_STR(exact.GetSql().c_str(), (head + "1,2)").c_str());
+}
+
+TEST(SqlStatementBatch_reals_read_back_exactly_and_non_finite_is_refused)
+{
+    SqlStatementBatch::Shape shape("INSERT INTO `t` (`a`,`b`,`c`) VALUES (?,?,?)");
+    const float values[] = { 0.1f, 1.0f / 3.0f, 123456.789f, -1.17549435e-38f, 3.40282347e+38f };
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        SqlStatementBatch batch(shape, &TestEscape);
+        REQUIRE(batch.Add(Row(1, values[i], "")));
+        std::string sql = batch.GetSql();
+        size_t at = sql.find("(1,") + 3;
+        CHECK(strtof(sql.c_str() + at, NULL) == values[i]);
+    }
+
+    SqlStatementBatch batch(shape, &TestEscape);
+    CHECK(batch.Add(Row(1, 1.0f, "")));
+    CHECK(!batch.Add(Row(2, std::numeric_limits<float>::quiet_NaN(), "")));
+    CHECK(!batch.Add(Row(3, std::numeric_limits<float>::infinity(), "")));
+    CHECK_EQ(batch.GetRows(), 1u);
+
+    // a row with the wrong number of values is refused too
+    CHECK(!batch.Add(Key(4)));
+}
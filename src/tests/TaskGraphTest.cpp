@@ -0,0 +1,234 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "Utilities/TaskGraph.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @brief The startup task graph: ordering, determinism and the timing report.
+ *
+ * World startup leans on two promises: a task never starts before the ones it names
+ * have finished, and on one thread the tasks run in exactly the order they were
+ * declared, which is what lets the graph stand in for the old sequential loader list.
+ */
+
+namespace
+{
+    /// Records the order tasks ran in, from whichever thread ran them.
+    struct Trace
+    {
+        std::mutex lock;
+        std::vector<TaskGraph::TaskId> order;
+
+        TaskGraph::Task Mark(TaskGraph::TaskId id)
+        {
+            return [this, id]()
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                order.push_back(id);
+            };
+        }
+
+        size_t PositionOf(TaskGraph::TaskId id) const
+        {
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                if (order[i] == id)
+                {
+                    return i;
+                }
+            }
+            return order.size();
+        }
+    };
+}
+
+TEST(TaskGraph_single_thread_runs_in_declaration_order)
+{
+    TaskGraph graph;
+    Trace trace;
+
+    // Dependencies that would allow reordering: 3 only needs 0, 4 needs nothing.
+    TaskGraph::TaskId a = graph.Add("a", trace.Mark(0));
+    TaskGraph::TaskId b = graph.Add("b", trace.Mark(1), { a });
+    graph.Add("c", trace.Mark(2), { b });
+    graph.Add("d", trace.Mark(3), { a });
+    graph.Add("e", trace.Mark(4));
+
+    graph.Run(1);
+
+    REQUIRE(trace.order.size() == 5);
+    for (TaskGraph::TaskId i = 0; i < 5; ++i)
+    {
+        CHECK_EQ(trace.order[i], i);
+    }
+}
+
+TEST(TaskGraph_parallel_run_respects_every_dependency)
+{
+    TaskGraph graph;
+    Trace trace;
+
+    // A wide fan with a few chains through it, like the loader list.
+    std::vector<TaskGraph::TaskId> ids;
+    for (TaskGraph::TaskId i = 0; i < 64; ++i)
+    {
+        if (i >= 8 && i % 3 == 0)
+        {
+            ids.push_back(graph.Add("t", trace.Mark(i), { ids[i - 8], ids[i / 2] }));
+        }
+        else
+        {
+            ids.push_back(graph.Add("t", trace.Mark(i)));
+        }
+    }
+
+    graph.Run(4);
+
+    REQUIRE(trace.order.size() == 64);
+    for (TaskGraph::TaskId i = 8; i < 64; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            CHECK(trace.PositionOf(i - 8) < trace.PositionOf(i));
+            CHECK(trace.PositionOf(i / 2) < trace.PositionOf(i));
+        }
+    }
+}
+
+TEST(TaskGraph_independent_tasks_overlap)
+{
+    TaskGraph graph;
+    std::atomic<int> running(0);
+    std::atomic<int> peak(0);
+
+    auto slow = [&]()
+    {
+        int now = ++running;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now))
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        --running;
+    };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        graph.Add("slow", slow);
+    }
+
+    graph.Run(4);
+
+    CHECK(peak.load() > 1);
+}
+
+TEST(TaskGraph_listeners_count_progress_and_times_are_kept)
+{
+    TaskGraph graph;
+    std::vector<uint32> started;
+    std::vector<uint32> finished;
+
+    TaskGraph::TaskId a = graph.Add("a", []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+    TaskGraph::TaskId b = graph.Add("b", []() {}, { a });
+    TaskGraph::TaskId c = graph.Add("c", []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); }, { b });
+    graph.Add("d", []() {});
+
+    graph.Run(2,
+              [&](TaskGraph const&, TaskGraph::TaskId, uint32 done) { started.push_back(done); },
+              [&](TaskGraph const&, TaskGraph::TaskId, uint32 done) { finished.push_back(done); });
+
+    REQUIRE(started.size() == 4);
+    REQUIRE(finished.size() == 4);
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        CHECK_EQ(finished[i], i + 1);
+    }
+
+    CHECK(graph.ElapsedMs(a) >= 15);
+    CHECK(graph.TotalMs() >= graph.ElapsedMs(a) + graph.ElapsedMs(c));
+
+    std::vector<TaskGraph::TaskId> path;
+    uint32 length = graph.CriticalPath(path);
+    REQUIRE(path.size() == 3);
+    CHECK_EQ(path[0], a);
+    CHECK_EQ(path[1], b);
+    CHECK_EQ(path[2], c);
+    CHECK(length >= 30);
+}
+
+TEST(TaskGraph_empty_graph_runs)
+{
+    TaskGraph graph;
+    graph.Run(4);
+
+    std::vector<TaskGraph::TaskId> path;
+    CHECK_EQ(graph.CriticalPath(path), 0u);
+    CHECK(path.empty());
+}
+
+TEST(TaskGraph_started_threads_run_inside_the_thread_scope)
+{
+    TaskGraph graph;
+    std::atomic<uint32> entered(0);
+    std::atomic<uint32> left(0);
+    std::atomic<uint32> outsideScope(0);
+    thread_local static bool inScope = false;
+    std::thread::id const caller = std::this_thread::get_id();
+
+    graph.SetThreadScope([&](std::function<void()> const& work)
+    {
+        ++entered;
+        inScope = true;
+        work();
+        inScope = false;
+        ++left;
+    });
+
+    for (uint32 i = 0; i < 16; ++i)
+    {
+        graph.Add("t", [&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            if (!inScope && std::this_thread::get_id() != caller)
+            {
+                ++outsideScope;
+            }
+        });
+    }
+    graph.Run(4);
+
+    CHECK_EQ(entered.load(), 3u);                               // the calling thread is not wrapped
+    CHECK_EQ(left.load(), 3u);
+    CHECK_EQ(outsideScope.load(), 0u);
+}
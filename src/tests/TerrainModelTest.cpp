@@ -163,6 +163,50 @@ TEST(BvhAgreesWithBruteForceOnDownwardColumnRays)
     CHECK_EQ(mismatches, size_t(0));
 }
 
+TEST(BvhPacketAgreesWithTheScalarWalkOnEveryLane)
+{
+    // One caster's sight lines to the units around it -- the batch the server makes --
+    // and, every other round, rays with nothing in common. Counts of one to seven cover
+    // a packet with idle lanes and a batch split over two packets.
+    std::mt19937 rng(0xBA7C4);
+    TriSoup soup = RandomSoup(rng, 900, 60.f);
+
+    Bvh bvh;
+    bvh.Build(soup, nullptr, 4);
+
+    std::uniform_real_distribution<float> pos(-70.f, 70.f);
+    std::uniform_int_distribution<int> count(1, 7);
+
+    size_t mismatches = 0;
+    for (int round = 0; round < 1500; ++round)
+    {
+        const int n = count(rng);
+        const Vec3 caster{pos(rng), pos(rng), pos(rng)};
+        Vec3 o[7], d[7];
+        float tMax[7], best[7];
+        for (int i = 0; i < n; ++i)
+        {
+            o[i] = (round & 1) ? Vec3{pos(rng), pos(rng), pos(rng)} : caster;
+            d[i] = Vec3{pos(rng), pos(rng), pos(rng)} - o[i];
+            tMax[i] = (i == 2) ? 0.5f : 1.0f;  // one lane stops short of its target
+            best[i] = tMax[i];
+        }
+
+        bvh.RaycastPacket(soup, o, d, n, best);
+
+        for (int i = 0; i < n; ++i)
+        {
+            const auto scalar = bvh.Raycast(soup, o[i], d[i], tMax[i]);
+            const bool hit = best[i] < tMax[i];
+            if (hit != scalar.has_value() || (hit && std::fabs(best[i] - *scalar) > 1e-5f))
+            {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK_EQ(mismatches, size_t(0));
+}
+
 TEST(BvhBroadphaseIsNeverTighterThanTheNarrowphase)
 {
     // The ray sits 0.05 mm outside the upper triangle's own x-bound, with dx == 0.
@@ -349,7 +393,7 @@ TEST(BvhAdoptRejectsANodeArrayThatIsNotATree)
 
     Bvh built;
     built.Build(soup);
-    const std::vector<Bvh::Node> good = built.Nodes();
+    const std::vector<Bvh::Node> good = built.Nodes().ToVector();
     REQUIRE(good.size() > 2);
     REQUIRE(good[0].left >= 0);           // the root of this soup is not a leaf
 
@@ -49,8 +49,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
+#include <atomic>
+#include <memory>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace world::terrain;
@@ -396,23 +399,21 @@ TEST(TileReaderRejectsCountsLargerThanTheFile)
     // reservation succeeds, so the short read that follows rejects the file anyway and
     // the guard is never what did the work.
     ScopedFile file("hostile.tile");
+    REQUIRE(WriteTile(MakeTile(), file.path));
 
-    std::FILE* f = std::fopen(file.path.c_str(), "wb");
+    // The v9 grid's element count sits at byte 28 of the header: magic, version, file
+    // size, tx, ty, four flag bytes, then the grid's offset and count. Must track
+    // TileSerializer's header; if it moves, this patches some other field, the reader
+    // rejects the file for that instead, and the case goes green testing nothing.
+    std::FILE* f = std::fopen(file.path.c_str(), "r+b");
     REQUIRE(f != nullptr);
-    const uint32_t magic = 0x32474E4D;  // "MNG2"
-    // Must track TileSerializer's VERSION. Leave it behind and the reader rejects this
-    // file on the version alone, the absurd count below is never reached, and the case
-    // goes green while testing nothing at all.
-    const uint32_t version = 2;
-    const int32_t tx = 0, ty = 0;
-    const uint8_t flags[2] = {1, 0};
+    uint32_t count = 0;
+    std::fseek(f, 28, SEEK_SET);
+    REQUIRE(std::fread(&count, 4, 1, f) == 1);
+    REQUIRE(count == uint32_t(V9_SIDE) * V9_SIDE);
     const uint32_t absurd = 0xFFFFFFFFu;
-    std::fwrite(&magic, 4, 1, f);
-    std::fwrite(&version, 4, 1, f);
-    std::fwrite(&tx, 4, 1, f);
-    std::fwrite(&ty, 4, 1, f);
-    std::fwrite(flags, 1, 2, f);
-    std::fwrite(&absurd, 4, 1, f);  // v9 element count
+    std::fseek(f, 28, SEEK_SET);
+    std::fwrite(&absurd, 4, 1, f);
     std::fclose(f);
 
     CHECK(ReadTile(file.path) == nullptr);
@@ -466,6 +467,43 @@ TEST(TileReaderReportsAMissingFileAsAMiss)
     CHECK(ReadTile(TempPath("definitely_absent.tile")) == nullptr);
 }
 
+TEST(TileReaderMapsTheBulkDataInsteadOfCopyingIt)
+{
+    ScopedFile file("mapped.tile");
+    const TerrainTile original = MakeTile();
+    REQUIRE(WriteTile(original, file.path));
+
+    auto back = ReadTile(file.path);
+    REQUIRE(back != nullptr);
+
+    // The grids and the geometry are views of the file: a load that copied them would
+    // still round-trip, so only this tells the two apart.
+    CHECK(back->v9.IsView());
+    CHECK(back->liquidShow.IsView());
+    REQUIRE(back->instances[0].model->Kind() == ModelKind::Wmo);
+    const auto* wmo = static_cast<const WmoModel*>(back->instances[0].model.get());
+    CHECK(wmo->Soup().verts.IsView());
+    CHECK(wmo->Soup().tris.IsView());
+    CHECK(wmo->GetBvh().Nodes().IsView());
+    CHECK(wmo->TriGroups().IsView());
+    CHECK(wmo->Groups()[0].liquid.heights.IsView());
+
+    // A model outlives the tile it came from -- GoModelStore keeps only the model -- so
+    // its views must keep the mapping, not borrow it from the tile.
+    std::shared_ptr<const ICollisionModel> model = back->instances[2].model;
+    back.reset();
+    CHECK(model->RaycastNearest(Vec3{0, 0, 20}, Vec3{0, 0, -1}, 100.f).has_value());
+
+    // Writing to a view copies it out; the file underneath is never written through.
+    auto edited = ReadTile(file.path);
+    REQUIRE(edited != nullptr);
+    edited->v9[0] = -1234.f;
+    CHECK(!edited->v9.IsView());
+    auto again = ReadTile(file.path);
+    REQUIRE(again != nullptr);
+    CHECK(again->v9 == original.v9);
+}
+
 TEST(FusedTerrainServesTheBakedTile)
 {
     const std::string dir = TempPath("dir");
@@ -519,6 +557,66 @@ TEST(FusedTerrainServesTheBakedTile)
     FusedTerrain::SetTileDir(std::string());
 }
 
+TEST(FusedTerrainBatchedSightLinesMatchTheScalarOnes)
+{
+    const std::string dir = TempPath("losdir");
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    // MakeTile's three placements all sit in tile (31, 31).
+    TerrainTile tile = MakeTile();
+    tile.tx = 31;
+    tile.ty = 31;
+    const std::string path = dir + "/" + TileFileName(5555, 31, 31);
+    REQUIRE(WriteTile(tile, path));
+
+    FusedTerrain::SetTileDir(dir);
+    FusedTerrain terrain(5555);
+
+    // Casters at both WMO placements and the small model, each looking at a ring of
+    // points around it: most lines cross the model, a few clear it, one is degenerate.
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<float> offset(-25.f, 25.f);
+    const Vec3 casters[] = {{85.f, 195.f, 33.f}, {315.f, 405.f, 14.f}, {44.f, 55.f, 70.f}};
+
+    std::vector<Vec3> from, to;
+    for (const Vec3& caster : casters)
+    {
+        for (int i = 0; i < 23; ++i)
+        {
+            from.push_back(caster);
+            to.push_back(Vec3{caster.x + 15.f + offset(rng), caster.y + 15.f + offset(rng),
+                              caster.z + offset(rng) * 0.4f});
+        }
+    }
+    from.push_back(casters[0]);
+    to.push_back(casters[0]);
+
+    std::vector<float> batched(from.size());
+    terrain.NearestHitFractions(from.data(), to.data(), from.size(), batched.data());
+    std::unique_ptr<bool[]> visible(new bool[from.size()]);
+    terrain.IsInLineOfSight(from.data(), to.data(), from.size(), visible.get());
+
+    size_t blocked = 0, mismatches = 0;
+    for (size_t i = 0; i < from.size(); ++i)
+    {
+        const float scalar = terrain.NearestHitFraction(from[i].x, from[i].y, from[i].z,
+                                                        to[i].x, to[i].y, to[i].z);
+        if ((scalar > 1.0f) != (batched[i] > 1.0f) ||
+            (scalar <= 1.0f && std::fabs(scalar - batched[i]) > 1e-5f) ||
+            visible[i] != (scalar > 1.0f))
+        {
+            ++mismatches;
+        }
+        blocked += scalar <= 1.0f ? 1 : 0;
+    }
+    CHECK_EQ(mismatches, size_t(0));
+    CHECK(blocked > 0 && blocked < from.size());
+
+    std::remove(path.c_str());
+    FusedTerrain::SetTileDir(std::string());
+}
+
 TEST(FusedTerrainSweepDropsUnpinnedTilesAndKeepsPinnedOnes)
 {
     const std::string dir = TempPath("sweepdir");
@@ -565,3 +663,118 @@ TEST(FusedTerrainSweepDropsUnpinnedTilesAndKeepsPinnedOnes)
     std::remove(b.c_str());
     FusedTerrain::SetTileDir(std::string());
 }
+
+TEST(FusedTerrainSweepNeverFreesATileAQueryIsReading)
+{
+    const std::string dir = TempPath("epochdir");
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    TerrainTile tile = MakeTile();
+    tile.instances.clear();
+    for (float& h : tile.v9) { h = 10.f; }
+    for (float& h : tile.v8) { h = 10.f; }
+    tile.holes.fill(0);
+
+    const std::string a = dir + "/" + TileFileName(7777, 32, 32);
+    const std::string b = dir + "/" + TileFileName(7777, 33, 32);
+    tile.tx = 32; tile.ty = 32;
+    REQUIRE(WriteTile(tile, a));
+    tile.tx = 33;
+    REQUIRE(WriteTile(tile, b));
+
+    FusedTerrain::SetTileDir(dir);
+    FusedTerrain terrain(7777);
+
+    // Readers hammer both tiles while the sweep evicts them over and over, so each read
+    // races a take-down. A tile freed early is a use-after-free the sanitizer builds
+    // catch; a slot read half-way through one is a missing floor counted here.
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> missing{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&terrain, &stop, &missing, t]()
+        {
+            const float x = (t & 1) ? -1.f - TILE_SIZE : -1.f;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                auto floor = terrain.ColumnAt(x, -1.f, 50.f, -10000.f).HighestSolidAtOrBelow(50.f);
+                if (!floor || std::fabs(*floor - 10.f) > 0.01f)
+                {
+                    missing.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 200; ++i)
+    {
+        terrain.Update(10u * 60u * 1000u);
+    }
+    stop.store(true);
+    for (std::thread& r : readers)
+    {
+        r.join();
+    }
+    CHECK_EQ(missing.load(), 0u);
+
+    // With no reader left, the last retired tiles go on the next tick.
+    terrain.Update(1);
+    terrain.Update(10u * 60u * 1000u);
+    CHECK_EQ(terrain.ResidentTiles(), size_t(0));
+
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+    FusedTerrain::SetTileDir(std::string());
+}
+
+TEST(FusedTerrainPrefetchPublishesTheTileTheFirstQueryFinds)
+{
+    const std::string dir = TempPath("prefetchdir");
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    TerrainTile tile = MakeTile();
+    tile.instances.clear();
+    for (float& h : tile.v9) { h = 10.f; }
+    for (float& h : tile.v8) { h = 10.f; }
+    tile.holes.fill(0);
+    tile.tx = 32; tile.ty = 32;
+
+    const std::string a = dir + "/" + TileFileName(6666, 32, 32);
+    REQUIRE(WriteTile(tile, a));
+
+    FusedTerrain::SetTileDir(dir);
+    FusedTerrain terrain(6666);
+
+    // Well into the map's life, so a tile stamped with the clock and one left at zero
+    // look different to the sweep.
+    terrain.Update(10u * 60u * 1000u);
+    CHECK(!terrain.IsResident(32, 32));
+
+    // Read on a thread of its own, as the grid prefetcher does.
+    bool loaded = false;
+    std::thread prefetcher([&terrain, &loaded]() { loaded = terrain.Prefetch(32, 32); });
+    prefetcher.join();
+    CHECK(loaded);
+    CHECK(terrain.IsResident(32, 32));
+    CHECK(!terrain.Prefetch(32, 32));
+    CHECK_EQ(terrain.ResidentTiles(), size_t(1));
+
+    // A cell with no file settles as absent, which spares the query its failed open.
+    CHECK(terrain.Prefetch(40, 40));
+    CHECK(terrain.IsResident(40, 40));
+    CHECK_EQ(terrain.ResidentTiles(), size_t(1));
+
+    // Nothing pins the tile yet, but it was fetched just now and the next sweep keeps it.
+    terrain.Update(60u * 1000u);
+    CHECK_EQ(terrain.ResidentTiles(), size_t(1));
+
+    auto floor = terrain.ColumnAt(-1.f, -1.f, 50.f, -10000.f).HighestSolidAtOrBelow(50.f);
+    REQUIRE(floor.has_value());
+    CHECK(std::fabs(*floor - 10.f) < 0.01f);
+
+    std::remove(a.c_str());
+    FusedTerrain::SetTileDir(std::string());
+}
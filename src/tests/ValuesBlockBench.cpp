@@ -0,0 +1,254 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+#include "Bench.h"
+#include "UpdateMask.h"
+#include "ValuesBlockCache.h"
+#include "Utilities/ByteBuffer.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief A creature's values block built per viewer, against once per kind of viewer.
+ *
+ * The creatures here are synthetic -- a field array and its change flags, nothing that
+ * needs a map or a session -- but the block is laid out the way
+ * Object::BuildValuesUpdateBlockForPlayer lays it out, and the four fields a viewer can
+ * change are the ones UnitValueForViewer trims. Every viewer's bytes are compared
+ * between the two ways before anything is timed.
+ */
+
+namespace
+{
+    /// What a viewer is to the creature: it decides the four trimmed fields.
+    enum ViewerKind
+    {
+        VIEWER_STRANGER,
+        VIEWER_LOOTER,          ///< in the group that tapped it: sees it lootable
+        VIEWER_CLICKER,         ///< on the quest that makes it spellclickable
+        VIEWER_GM,
+        MAX_VIEWER_KIND
+    };
+
+    struct SyntheticCreature
+    {
+        std::vector<uint32> values;
+        std::vector<bool> changed;
+    };
+
+    /// A creature of the shape the server sends: about half its fields set.
+    SyntheticCreature MakeCreature(std::mt19937& rng)
+    {
+        SyntheticCreature creature;
+        creature.values.assign(UNIT_END, 0);
+        creature.changed.assign(UNIT_END, false);
+        for (uint32 index = 0; index < UNIT_END; ++index)
+        {
+            creature.values[index] = rng() % 2 ? rng() : 0;
+        }
+        creature.values[UNIT_NPC_FLAGS] = 0x01000003;           // gossip, quest giver, spellclick
+        creature.values[UNIT_FIELD_AURASTATE] = 0x00000024;
+        creature.values[UNIT_FIELD_FLAGS] = 0x00008000;
+        creature.values[UNIT_DYNAMIC_FLAGS] = 0x0000000D;       // lootable, tapped, tapped by player
+        return creature;
+    }
+
+    /// Mark every non-zero field changed, the heaviest delta, or only @p fields of them.
+    void MarkDelta(SyntheticCreature& creature, std::vector<uint16> const& fields)
+    {
+        creature.changed.assign(UNIT_END, false);
+        if (fields.empty())
+        {
+            for (uint32 index = 0; index < UNIT_END; ++index)
+            {
+                creature.changed[index] = creature.values[index] != 0;
+            }
+            return;
+        }
+        for (uint16 index : fields)
+        {
+            creature.changed[index] = true;
+        }
+    }
+
+    /// The field as @p viewer is sent it; the rest go out as stored.
+    uint32 ValueForViewer(SyntheticCreature const& creature, uint16 index, ViewerKind viewer)
+    {
+        uint32 value = creature.values[index];
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+                return viewer == VIEWER_CLICKER || viewer == VIEWER_GM ? value : value & ~0x01000000u;
+            case UNIT_FIELD_AURASTATE:
+                return viewer == VIEWER_STRANGER ? value & ~0x20u : value;
+            case UNIT_FIELD_FLAGS:
+                return viewer == VIEWER_GM ? value | 0x02000000u : value;
+            case UNIT_DYNAMIC_FLAGS:
+                return viewer == VIEWER_LOOTER ? (value & ~0x4u) | 0x1u : value & ~0x1u;
+            default:
+                return value;
+        }
+    }
+
+    uint16 const TRIMMED[] = { UNIT_NPC_FLAGS, UNIT_FIELD_AURASTATE, UNIT_FIELD_FLAGS, UNIT_DYNAMIC_FLAGS };
+
+    /// As Object::GetValuesViewKey: the trimmed fields this delta carries, as sent.
+    void KeyFor(SyntheticCreature const& creature, ViewerKind viewer, ValuesViewKey& key)
+    {
+        key.self = false;
+        key.count = 0;
+        for (uint16 index : TRIMMED)
+        {
+            if (creature.changed[index])
+            {
+                key.values[key.count++] = ValueForViewer(creature, index, viewer);
+            }
+        }
+    }
+
+    /// As Object::BuildValuesUpdateBlockForPlayer: type, guid, mask, changed fields.
+    void BuildBlock(SyntheticCreature const& creature, ViewerKind viewer, ByteBuffer& buf)
+    {
+        buf << uint8(0);                                        // UPDATETYPE_VALUES
+        buf << uint64(0xF130000100001234ULL);
+
+        UpdateMask mask;
+        mask.SetCount(UNIT_END);
+        for (uint32 index = 0; index < UNIT_END; ++index)
+        {
+            if (creature.changed[index])
+            {
+                mask.SetBit(index);
+            }
+        }
+
+        buf << uint8(mask.GetBlockCount());
+        buf.append(mask.GetMask(), mask.GetLength());
+        for (uint16 index = 0; index < UNIT_END; ++index)
+        {
+            if (mask.GetBit(index))
+            {
+                buf << ValueForViewer(creature, index, viewer);
+            }
+        }
+    }
+
+    /// As Object::BuildValuesUpdateBlockForPlayer with a cache.
+    void BuildBlock(SyntheticCreature const& creature, ViewerKind viewer, ByteBuffer& buf, ValuesBlockCache& cache)
+    {
+        ValuesViewKey key;
+        KeyFor(creature, viewer, key);
+        if (std::vector<uint8> const* bytes = cache.Find(key))
+        {
+            buf.append(bytes->data(), bytes->size());
+            return;
+        }
+
+        size_t const start = buf.wpos();
+        BuildBlock(creature, viewer, buf);
+        cache.Store(key, buf.contents() + start, buf.wpos() - start);
+    }
+
+    void Compare(char const* delta, std::vector<uint16> const& fields, uint32 viewerCount)
+    {
+        std::mt19937 rng(viewerCount);
+        std::vector<SyntheticCreature> creatures;
+        for (uint32 i = 0; i < 50; ++i)
+        {
+            creatures.push_back(MakeCreature(rng));
+            MarkDelta(creatures.back(), fields);
+        }
+
+        // Mostly strangers, a group that tapped it, a few on the quest, one GM.
+        std::vector<ViewerKind> viewers;
+        for (uint32 i = 0; i < viewerCount; ++i)
+        {
+            viewers.push_back(i == 0 ? VIEWER_GM : i % 8 == 1 ? VIEWER_CLICKER : i % 5 == 2 ? VIEWER_LOOTER : VIEWER_STRANGER);
+        }
+
+        std::vector<ByteBuffer> perViewer(viewers.size());
+        std::vector<ByteBuffer> cached(viewers.size());
+        for (SyntheticCreature const& creature : creatures)
+        {
+            ValuesBlockCache cache;
+            for (size_t i = 0; i < viewers.size(); ++i)
+            {
+                perViewer[i].clear();
+                cached[i].clear();
+                BuildBlock(creature, viewers[i], perViewer[i]);
+                BuildBlock(creature, viewers[i], cached[i], cache);
+                CHECK(perViewer[i].size() == cached[i].size() &&
+                      std::equal(perViewer[i].contents(), perViewer[i].contents() + perViewer[i].size(), cached[i].contents()));
+            }
+            CHECK(cache.Classes() <= uint32(MAX_VIEWER_KIND));
+        }
+
+        uint32 const blocks = uint32(creatures.size() * viewers.size());
+        double const perViewerNs = bench::BestOf(blocks, [&]()
+        {
+            for (SyntheticCreature const& creature : creatures)
+            {
+                for (size_t i = 0; i < viewers.size(); ++i)
+                {
+                    perViewer[i].clear();
+                    BuildBlock(creature, viewers[i], perViewer[i]);
+                }
+            }
+        });
+        double const cachedNs = bench::BestOf(blocks, [&]()
+        {
+            for (SyntheticCreature const& creature : creatures)
+            {
+                ValuesBlockCache cache;
+                for (size_t i = 0; i < viewers.size(); ++i)
+                {
+                    cached[i].clear();
+                    BuildBlock(creature, viewers[i], cached[i], cache);
+                }
+            }
+        });
+
+        std::string const scenario = std::string(delta) + ", " + std::to_string(viewerCount) + " viewers";
+        bench::Report(scenario.c_str(), { "per viewer", perViewerNs }, { "per kind of viewer", cachedNs }, "a block");
+    }
+}
+
+TEST(ValuesBlockCache_bench_per_viewer_against_per_kind_of_viewer)
+{
+    // Fifty creatures in a city flushing their delta to everyone who has them at
+    // client: every set field, as after a respawn, and the health tick of a fight.
+    std::vector<uint16> const everything;
+    std::vector<uint16> const health = { UNIT_FIELD_HEALTH, UNIT_DYNAMIC_FLAGS };
+
+    Compare("full delta", everything, 5);
+    Compare("full delta", everything, 40);
+    Compare("health tick", health, 5);
+    Compare("health tick", health, 40);
+}
@@ -0,0 +1,129 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#include "TestHarness.h"
+#include "Bench.h"
+#include "ViewerHash.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief The viewer buckets against visiting every viewer on the map.
+ *
+ * One visibility pass in a crowded city on a busy continent: every player in the
+ * city has moved, and each is matched against the viewers in reach. The pass the hash
+ * replaced measured the distance to every viewer on the map.
+ */
+
+namespace
+{
+    struct Point
+    {
+        float x, y;
+    };
+
+    std::vector<Point> Scatter(std::mt19937& rng, uint32 count, float cx, float cy, float halfSide)
+    {
+        std::uniform_real_distribution<float> offset(-halfSide, halfSide);
+        std::vector<Point> points;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Point p = { cx + offset(rng), cy + offset(rng) };
+            points.push_back(p);
+        }
+        return points;
+    }
+
+    bool InReach(Point const& a, Point const& b, float reach)
+    {
+        float dx = a.x - b.x;
+        float dy = a.y - b.y;
+        return dx * dx + dy * dy <= reach * reach;
+    }
+}
+
+TEST(ViewerHash_bench_city_of_two_hundred_on_a_busy_continent)
+{
+    std::mt19937 rng(11);
+    float const reach = 90.0f + 533.3333f / 8;
+    uint32 const PASSES = 200;
+
+    std::vector<Point> viewers = Scatter(rng, 200, -8900.0f, 600.0f, 120.0f);
+    std::vector<Point> elsewhere = Scatter(rng, 800, -6000.0f, 0.0f, 6000.0f);
+    viewers.insert(viewers.end(), elsewhere.begin(), elsewhere.end());
+
+    uint64 bruteInReach = 0;
+    double const bruteNs = bench::BestOf(PASSES, [&]()
+    {
+        for (uint32 pass = 0; pass < PASSES; ++pass)
+        {
+            for (uint32 moved = 0; moved < 200; ++moved)
+            {
+                for (uint32 i = 0; i < viewers.size(); ++i)
+                {
+                    bruteInReach += InReach(viewers[i], viewers[moved], reach);
+                }
+            }
+        }
+    });
+
+    // The hash is filed afresh every pass, as the map does.
+    ViewerHash hash;
+    uint64 offered = 0;
+    uint64 hashInReach = 0;
+    double const hashNs = bench::BestOf(PASSES, [&]()
+    {
+        for (uint32 pass = 0; pass < PASSES; ++pass)
+        {
+            hash.Reset(reach);
+            for (uint32 i = 0; i < viewers.size(); ++i)
+            {
+                hash.Add(viewers[i].x, viewers[i].y, i);
+            }
+            hash.Build();
+
+            for (uint32 moved = 0; moved < 200; ++moved)
+            {
+                Point const& q = viewers[moved];
+                offered += hash.ForEachNear(q.x, q.y, [&](uint32 index)
+                {
+                    hashInReach += InReach(viewers[index], q, reach);
+                });
+            }
+        }
+    });
+
+    // What the hash offers a mover against what is really in reach: the cost of its cells' slack.
+    double const movers = 200.0 * PASSES * bench::RUNS;
+    std::printf("    200 movers among %u viewers: %.1f offered, %.1f in reach a mover\n",
+                uint32(viewers.size()), offered / movers, hashInReach / movers);
+    bench::Report("200 movers in a city", { "every viewer", bruteNs }, { "ViewerHash", hashNs }, "a pass");
+    CHECK_EQ(hashInReach, bruteInReach);
+}
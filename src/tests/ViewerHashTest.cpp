@@ -0,0 +1,162 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+#include "ViewerHash.h"
+
+#include <random>
+#include <set>
+#include <vector>
+
+/**
+ * @file
+ * @brief The viewer buckets of the batched visibility pass.
+ *
+ * A viewer the hash fails to offer is a player who never sees a creature walk up to
+ * them, so the first test is the guarantee: every viewer in reach is offered, wherever
+ * the point falls in its bucket and on whichever side of the map's origin. The second
+ * is the reason for the hash: in a crowded city on a busy continent, a moved object is
+ * offered the city, not the continent. ViewerHashBench.cpp times it.
+ */
+
+namespace
+{
+    struct Point
+    {
+        float x, y;
+    };
+
+    std::vector<Point> Scatter(std::mt19937& rng, uint32 count, float cx, float cy, float halfSide)
+    {
+        std::uniform_real_distribution<float> offset(-halfSide, halfSide);
+        std::vector<Point> points;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Point p = { cx + offset(rng), cy + offset(rng) };
+            points.push_back(p);
+        }
+        return points;
+    }
+
+    void File(ViewerHash& hash, std::vector<Point> const& viewers, float reach)
+    {
+        hash.Reset(reach);
+        for (uint32 i = 0; i < viewers.size(); ++i)
+        {
+            hash.Add(viewers[i].x, viewers[i].y, i);
+        }
+        hash.Build();
+    }
+
+    bool InReach(Point const& a, Point const& b, float reach)
+    {
+        float dx = a.x - b.x;
+        float dy = a.y - b.y;
+        return dx * dx + dy * dy <= reach * reach;
+    }
+}
+
+TEST(ViewerHash_offers_every_viewer_in_reach)
+{
+    std::mt19937 rng(7);
+    float const reach = 90.0f + 533.3333f / 8;               // visibility distance plus a cell
+
+    // Across the origin on purpose: bucket coordinates go negative there.
+    std::vector<Point> viewers = Scatter(rng, 600, 0.0f, 0.0f, 1500.0f);
+    ViewerHash hash;
+    File(hash, viewers, reach);
+    CHECK_EQ(hash.Size(), 600u);
+
+    std::vector<Point> queries = Scatter(rng, 400, 0.0f, 0.0f, 1600.0f);
+    uint32 missed = 0;
+    for (Point const& q : queries)
+    {
+        std::set<uint32> offered;
+        uint32 count = hash.ForEachNear(q.x, q.y, [&](uint32 index) { offered.insert(index); });
+        CHECK_EQ(count, uint32(offered.size()));             // each viewer offered once
+
+        for (uint32 i = 0; i < viewers.size(); ++i)
+        {
+            if (InReach(viewers[i], q, reach) && offered.find(i) == offered.end())
+            {
+                ++missed;
+            }
+        }
+    }
+    CHECK_EQ(missed, 0u);
+}
+
+TEST(ViewerHash_reset_keeps_nothing_of_the_last_pass)
+{
+    ViewerHash hash;
+    hash.Reset(100.0f);
+    hash.Add(10.0f, 10.0f, 0);
+    hash.Build();
+
+    hash.Reset(100.0f);
+    hash.Add(5000.0f, 5000.0f, 1);
+    hash.Build();
+
+    uint32 offered = hash.ForEachNear(10.0f, 10.0f, [](uint32) {});
+    CHECK_EQ(offered, 0u);
+
+    std::vector<uint32> found;
+    hash.ForEachNear(5010.0f, 4990.0f, [&](uint32 index) { found.push_back(index); });
+    REQUIRE(found.size() == 1u);
+    CHECK_EQ(found[0], 1u);
+}
+
+TEST(ViewerHash_city_of_two_hundred_on_a_busy_continent)
+{
+    std::mt19937 rng(11);
+    float const reach = 90.0f + 533.3333f / 8;
+
+    // Two hundred players in a city a couple of hundred yards across, eight hundred
+    // more about the rest of the continent.
+    std::vector<Point> viewers = Scatter(rng, 200, -8900.0f, 600.0f, 120.0f);
+    std::vector<Point> elsewhere = Scatter(rng, 800, -6000.0f, 0.0f, 6000.0f);
+    viewers.insert(viewers.end(), elsewhere.begin(), elsewhere.end());
+
+    ViewerHash hash;
+    File(hash, viewers, reach);
+
+    // Every player in the city moved this tick.
+    uint64 offered = 0;
+    uint64 inReach = 0;
+    for (uint32 moved = 0; moved < 200; ++moved)
+    {
+        Point const& q = viewers[moved];
+        offered += hash.ForEachNear(q.x, q.y, [&](uint32 index)
+        {
+            if (InReach(viewers[index], q, reach))
+            {
+                ++inReach;
+            }
+        });
+    }
+
+    CHECK(inReach >= 200u * 100u);                           // the city sees most of itself
+    CHECK(offered < 200u * 250u);                            // and little of the continent
+}
@@ -46,6 +46,19 @@
  * of it: one line per probe with the floor, the liquid column and the tile it landed in,
  * for feeding the coordinates out of a "creature falls through the floor" report. Useless
  * over thirty thousand spawns, which is why it is not the default.
+ *
+ * `--bench <threads>` does not score at all. It replays the probe list against one shared
+ * engine per map from 1, 2, 4 ... up to that many threads at once and prints the query
+ * rate of each, which is how mangosd's MapUpdater threads meet the tile cache: many
+ * workers, the same resident tiles. A rate that stops growing with the thread count is
+ * contention in the query path, not work.
+ *
+ * `--bench-los` does not score either. Each probe becomes a caster looking at eight points
+ * on a ring around it, eye height to eye height, the way a spell or a creature sizes up
+ * the units near it. Those sight lines are traced one at a time and then as one batch per
+ * caster, on one thread, and it prints both rates in rays per second -- per core, since
+ * sight lines are only ever asked from a map's own update thread -- along with how many
+ * answers the two ways disagree on, which must be none.
  */
 
 #include "terrain/FusedTerrain.hpp"
@@ -54,6 +67,8 @@
 #include "terrain/Terrain.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -62,6 +77,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace
@@ -142,6 +158,187 @@ namespace
 
         return true;
     }
+
+    using EngineMap = std::map<uint32_t, std::unique_ptr<world::terrain::FusedTerrain>>;
+
+    /// Every probe once, as the scoring pass asks it. Returns how many found a floor, so
+    /// the work cannot be optimised away.
+    uint64_t ReplayProbes(const std::vector<Probe>& probes, const EngineMap& engines,
+                          size_t start)
+    {
+        uint64_t floors = 0;
+        for (size_t i = 0; i < probes.size(); ++i)
+        {
+            const Probe& p = probes[(start + i) % probes.size()];
+            const world::terrain::Column column =
+                engines.at(p.map)->ColumnAt(p.x, p.y, p.z + SEARCH_UP, p.z - SEARCH_DOWN);
+            floors += column.HighestSolidAtOrBelow(p.z + SEARCH_UP) ? 1 : 0;
+        }
+        return floors;
+    }
+
+    /// The thread-scaling run behind `--bench`: for each thread count, every thread
+    /// replays the probe list, each from its own offset, for a fixed wall time.
+    void RunBench(const std::vector<Probe>& probes, const EngineMap& engines, int maxThreads)
+    {
+        constexpr auto RUN_TIME = std::chrono::seconds(2);
+
+        // One untimed pass, so every tile the list touches is resident before the clock
+        // starts; the bench measures the hit path, not the first file read.
+        ReplayProbes(probes, engines, 0);
+
+        std::printf("%8s %14s %14s %9s\n", "threads", "queries/s", "per thread", "scaling");
+
+        double single = 0.0;
+        for (int threads = 1;; threads = std::min(threads * 2, maxThreads))
+        {
+            std::atomic<bool> stop{false};
+            std::vector<uint64_t> done(threads, 0);
+            std::vector<uint64_t> floors(threads, 0);
+            std::vector<std::thread> workers;
+
+            const auto begin = std::chrono::steady_clock::now();
+            for (int t = 0; t < threads; ++t)
+            {
+                workers.emplace_back([&, t]()
+                {
+                    const size_t start = probes.size() * size_t(t) / size_t(threads);
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        floors[t] += ReplayProbes(probes, engines, start);
+                        done[t] += probes.size();
+                    }
+                });
+            }
+            std::this_thread::sleep_for(RUN_TIME);
+            stop.store(true);
+            for (std::thread& w : workers)
+            {
+                w.join();
+            }
+            const double seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+            uint64_t total = 0;
+            for (const uint64_t n : done)
+            {
+                total += n;
+            }
+            const double rate = double(total) / seconds;
+            if (threads == 1)
+            {
+                single = rate;
+            }
+            std::printf("%8d %14.0f %14.0f %8.2fx\n", threads, rate, rate / threads,
+                        single > 0.0 ? rate / single : 0.0);
+
+            if (threads == maxThreads)
+            {
+                break;
+            }
+        }
+    }
+
+    /// One caster's batch for `--bench-los`: the probe at eye height, looking at eight
+    /// points on a ring around it.
+    constexpr int RING_POINTS = 8;
+    constexpr float RING_RADIUS = 30.0f;
+    constexpr float EYE_HEIGHT = 2.0f;
+
+    void RingAround(const Probe& p, world::terrain::Vec3* from, world::terrain::Vec3* to)
+    {
+        for (int k = 0; k < RING_POINTS; ++k)
+        {
+            const float angle = float(k) * (6.2831853f / RING_POINTS);
+            from[k] = world::terrain::Vec3{p.x, p.y, p.z + EYE_HEIGHT};
+            to[k] = world::terrain::Vec3{p.x + RING_RADIUS * std::cos(angle),
+                                         p.y + RING_RADIUS * std::sin(angle),
+                                         p.z + EYE_HEIGHT};
+        }
+    }
+
+    /// The run behind `--bench-los`. Returns how many lines were blocked, so neither pass
+    /// can be optimised away.
+    uint64_t TraceRings(const std::vector<Probe>& probes, const EngineMap& engines,
+                        bool batched, std::vector<float>* answers = nullptr)
+    {
+        uint64_t blocked = 0;
+        world::terrain::Vec3 from[RING_POINTS], to[RING_POINTS];
+        float frac[RING_POINTS];
+        for (const Probe& p : probes)
+        {
+            const world::terrain::FusedTerrain& engine = *engines.at(p.map);
+            RingAround(p, from, to);
+            if (batched)
+            {
+                engine.NearestHitFractions(from, to, RING_POINTS, frac);
+            }
+            else
+            {
+                for (int k = 0; k < RING_POINTS; ++k)
+                {
+                    frac[k] = engine.NearestHitFraction(from[k].x, from[k].y, from[k].z,
+                                                        to[k].x, to[k].y, to[k].z);
+                }
+            }
+            for (int k = 0; k < RING_POINTS; ++k)
+            {
+                blocked += frac[k] <= 1.0f ? 1 : 0;
+                if (answers)
+                {
+                    answers->push_back(frac[k]);
+                }
+            }
+        }
+        return blocked;
+    }
+
+    void RunLineOfSightBench(const std::vector<Probe>& probes, const EngineMap& engines)
+    {
+        constexpr auto RUN_TIME = std::chrono::seconds(2);
+
+        // One untimed pass of each, which also makes every tile resident and is where the
+        // two ways of asking are held to the same answers.
+        std::vector<float> scalar, batched;
+        TraceRings(probes, engines, false, &scalar);
+        const uint64_t blocked = TraceRings(probes, engines, true, &batched);
+        size_t disagree = 0;
+        for (size_t i = 0; i < scalar.size(); ++i)
+        {
+            if ((scalar[i] > 1.0f) != (batched[i] > 1.0f) ||
+                (scalar[i] <= 1.0f && std::fabs(scalar[i] - batched[i]) > 1e-4f))
+            {
+                ++disagree;
+            }
+        }
+        std::printf("%zu sight lines, %llu blocked, %zu answered differently when batched\n\n",
+                    scalar.size(), static_cast<unsigned long long>(blocked), disagree);
+
+        std::printf("%8s %14s %9s\n", "mode", "rays/s/core", "speedup");
+        double single = 0.0;
+        for (const bool batch : {false, true})
+        {
+            uint64_t rays = 0;
+            const auto begin = std::chrono::steady_clock::now();
+            double seconds = 0.0;
+            do
+            {
+                TraceRings(probes, engines, batch);
+                rays += uint64_t(probes.size()) * RING_POINTS;
+                seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                        begin).count();
+            }
+            while (seconds < std::chrono::duration<double>(RUN_TIME).count());
+
+            const double rate = double(rays) / seconds;
+            if (!batch)
+            {
+                single = rate;
+            }
+            std::printf("%8s %14.0f %8.2fx\n", batch ? "batched" : "scalar", rate,
+                        single > 0.0 ? rate / single : 0.0);
+        }
+    }
 }
 
 int main(int argc, char** argv)
@@ -149,12 +346,17 @@ int main(int argc, char** argv)
     if (argc < 3)
     {
         std::printf("usage: mangos-height-check <tileDir> <probes.csv> [gomodelDir] [--verbose]\n"
+                    "                           [--bench <threads>] [--bench-los]\n"
                     "\n"
                     "  probes.csv: one per line, name,map,x,y,z,expectedFloor\n"
                     "  gomodelDir: baked gomodels, so WMO and M2 floors resolve too\n"
                     "              (default: <tileDir>/../gomodels)\n"
                     "  --verbose : one line per probe -- floor, liquid, tile. For chasing\n"
-                    "              a single report, not for scoring a bake.\n");
+                    "              a single report, not for scoring a bake.\n"
+                    "  --bench   : no scoring; the probe list's query rate from 1, 2, 4 ...\n"
+                    "              up to <threads> threads sharing one engine per map.\n"
+                    "  --bench-los: no scoring; sight lines from every probe to a ring\n"
+                    "              around it, one at a time and batched, in rays/s.\n");
         return 2;
     }
 
@@ -162,6 +364,8 @@ int main(int argc, char** argv)
     const std::string probePath = argv[2];
 
     bool verbose = false;
+    int benchThreads = 0;
+    bool benchSight = false;
     std::string goDir = tileDir + "/../gomodels";
     for (int i = 3; i < argc; ++i)
     {
@@ -169,6 +373,14 @@ int main(int argc, char** argv)
         {
             verbose = true;
         }
+        else if (std::string(argv[i]) == "--bench-los")
+        {
+            benchSight = true;
+        }
+        else if (std::string(argv[i]) == "--bench" && i + 1 < argc)
+        {
+            benchThreads = std::max(1, std::atoi(argv[++i]));
+        }
         else
         {
             goDir = argv[i];
@@ -186,7 +398,34 @@ int main(int argc, char** argv)
 
     std::printf("%zu probes, tiles from %s\n\n", probes.size(), tileDir.c_str());
 
-    std::map<uint32_t, std::unique_ptr<world::terrain::FusedTerrain>> engines;
+    EngineMap engines;
+
+    if (benchThreads || benchSight)
+    {
+        if (probes.empty())
+        {
+            return 2;
+        }
+        // Built up front: the workers only read the map, never insert into it.
+        for (const Probe& p : probes)
+        {
+            auto& engine = engines[p.map];
+            if (!engine)
+            {
+                engine.reset(new world::terrain::FusedTerrain(p.map));
+            }
+        }
+        if (benchSight)
+        {
+            RunLineOfSightBench(probes, engines);
+        }
+        else
+        {
+            RunBench(probes, engines, benchThreads);
+        }
+        return 0;
+    }
+
     std::map<uint32_t, MapScore> scores;
     MapScore total;
 